@@ -0,0 +1,70 @@
+#include "BackgroundSolve.h"
+
+BackgroundSolve::BackgroundSolve(Task task, double progressInterval) {
+    worker_ = std::thread([this, task = std::move(task), progressInterval]() {
+        MatrixSolver::SolveControl control;
+        control.cancel = &cancel_;
+        control.progressInterval = progressInterval;
+        control.progress = [this](const MatrixSolver::IterativeResult& result) { publish(result); };
+
+        MatrixSolver::IterativeResult result;
+        std::exception_ptr error;
+        try {
+            result = task(control);
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (error) {
+            error_ = error;
+        } else {
+            best_ = std::move(result);
+        }
+        finished_ = true;
+        done_.notify_all();
+    });
+}
+
+BackgroundSolve::~BackgroundSolve() {
+    cancel();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+void BackgroundSolve::publish(const MatrixSolver::IterativeResult& result) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    best_ = result;
+}
+
+MatrixSolver::IterativeResult BackgroundSolve::best() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return best_;
+}
+
+MatrixSolver::IterativeResult BackgroundSolve::waitUntil(const Deadline& deadline) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (deadline.limited()) {
+        done_.wait_until(lock, deadline.at(), [this] { return finished_; });
+    } else {
+        done_.wait(lock, [this] { return finished_; });
+    }
+    if (error_) {
+        std::rethrow_exception(error_);
+    }
+    MatrixSolver::IterativeResult result = best_;
+    if (!finished_) {
+        result.interrupted = true;
+    }
+    return result;
+}
+
+MatrixSolver::IterativeResult BackgroundSolve::wait() {
+    return waitUntil(Deadline());
+}
+
+bool BackgroundSolve::finished() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return finished_;
+}
@@ -0,0 +1,85 @@
+#ifndef BACKGROUND_SOLVE_H
+#define BACKGROUND_SOLVE_H
+
+#include "MatrixSolver.h"
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/**
+ * @class BackgroundSolve
+ * @brief Iterative solve on a worker thread with anytime access to its best iterate
+ *
+ * The task receives a SolveControl whose progress callback publishes the
+ * current best iterate and whose cancellation flag is set by cancel() and
+ * the destructor. A caller with a time budget takes waitUntil(deadline) as
+ * its answer while the solve keeps refining; wait() returns the final result.
+ *
+ * @code
+ * BackgroundSolve solve([&](const MatrixSolver::SolveControl& control) {
+ *     return solver.solvePreconditionedCG(apply, f, M, x0, 10000, 1e-10, control);
+ * });
+ * auto quick = solve.waitUntil(Deadline::after(0.05));   // Best effort in 50 ms
+ * auto exact = solve.wait();                             // Converged result
+ * @endcode
+ */
+class BackgroundSolve {
+public:
+    using Task = std::function<MatrixSolver::IterativeResult(const MatrixSolver::SolveControl&)>;
+
+    /**
+     * @brief Start the task on a new thread
+     * @param progressInterval Minimum seconds between published iterates
+     */
+    explicit BackgroundSolve(Task task, double progressInterval = 0.01);
+
+    /**
+     * @brief Cancel and join the worker
+     */
+    ~BackgroundSolve();
+
+    BackgroundSolve(const BackgroundSolve&) = delete;
+    BackgroundSolve& operator=(const BackgroundSolve&) = delete;
+
+    /**
+     * @brief Best iterate published so far (empty x before the first report)
+     */
+    MatrixSolver::IterativeResult best() const;
+
+    /**
+     * @brief Block until the solve finishes or the deadline passes
+     *
+     * The returned result has interrupted set if the solve was still running.
+     * @throws Rethrows an exception of the task if it finished with one
+     */
+    MatrixSolver::IterativeResult waitUntil(const Deadline& deadline);
+
+    /**
+     * @brief Block until the solve finishes and return its final result
+     * @throws Rethrows an exception of the task
+     */
+    MatrixSolver::IterativeResult wait();
+
+    bool finished() const;
+
+    /**
+     * @brief Ask the task to stop; it returns its best iterate
+     */
+    void cancel() { cancel_.store(true); }
+
+private:
+    void publish(const MatrixSolver::IterativeResult& result);
+
+    mutable std::mutex mutex_;
+    std::condition_variable done_;
+    MatrixSolver::IterativeResult best_;
+    std::exception_ptr error_;
+    bool finished_ = false;
+    std::atomic<bool> cancel_{false};
+    std::thread worker_;
+};
+
+#endif // BACKGROUND_SOLVE_H
@@ -0,0 +1,43 @@
+#ifndef DEADLINE_H
+#define DEADLINE_H
+
+#include <chrono>
+
+/**
+ * @class Deadline
+ * @brief Point in time after which a solver stops and returns its best iterate
+ *
+ * A default-constructed Deadline never expires.
+ */
+class Deadline {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    Deadline() = default;
+    explicit Deadline(Clock::time_point at) : at_(at), limited_(true) {}
+
+    /**
+     * @brief Deadline a number of seconds from now
+     */
+    static Deadline after(double seconds) {
+        return Deadline(Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                                           std::chrono::duration<double>(seconds)));
+    }
+
+    bool limited() const { return limited_; }
+    bool expired() const { return limited_ && Clock::now() >= at_; }
+    Clock::time_point at() const { return at_; }
+
+    /**
+     * @brief Seconds left (negative once expired, very large if unlimited)
+     */
+    double remaining() const {
+        return limited_ ? std::chrono::duration<double>(at_ - Clock::now()).count() : 1e300;
+    }
+
+private:
+    Clock::time_point at_{};
+    bool limited_ = false;
+};
+
+#endif // DEADLINE_H
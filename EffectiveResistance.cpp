@@ -0,0 +1,173 @@
+#include "EffectiveResistance.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace {
+
+ResistiveNetwork::NodeId firstNode(const ResistiveNetwork& network) {
+    if (network.nodeCount() == 0) {
+        throw std::invalid_argument("Network has no nodes");
+    }
+    return network.id(0);
+}
+
+/// Largest number of distinct nodes for which their d x d block of L⁻¹ is kept
+constexpr size_t MAX_NODE_BLOCK = 4096;
+
+} // namespace
+
+EffectiveResistance::EffectiveResistance(const ResistiveNetwork& network, const NetworkSolveOptions& options)
+    : ResistiveNetworkSolver(network, firstNode(network), options) {
+}
+
+void EffectiveResistance::setDifference(MatrixXd& B, Eigen::Index column, int u, int v) const {
+    if (reducedIndex_[u] >= 0) {
+        B(reducedIndex_[u], column) += 1.0;
+    }
+    if (reducedIndex_[v] >= 0) {
+        B(reducedIndex_[v], column) -= 1.0;
+    }
+}
+
+double EffectiveResistance::resistance(ResistiveNetwork::NodeId u, ResistiveNetwork::NodeId v) {
+    return resistances({{u, v}}).front();
+}
+
+std::vector<double> EffectiveResistance::resistances(const std::vector<NodePair>& pairs, int batch) {
+    batch = std::max(1, batch);
+    std::vector<double> result(pairs.size(), 0.0);
+
+    // Pairs that need a solve: same component, distinct nodes
+    std::vector<size_t> pending;
+    std::vector<std::pair<int, int>> indices(pairs.size());
+    std::unordered_map<int, int> distinct;
+    for (size_t k = 0; k < pairs.size(); ++k) {
+        int u = network_.index(pairs[k].first);
+        int v = network_.index(pairs[k].second);
+        indices[k] = {u, v};
+        if (u == v) {
+            continue;
+        }
+        if (component_[u] != component_[v]) {
+            result[k] = std::numeric_limits<double>::infinity();
+            continue;
+        }
+        pending.push_back(k);
+        for (int node : {u, v}) {
+            if (reducedIndex_[node] >= 0) {
+                distinct.emplace(node, static_cast<int>(distinct.size()));
+            }
+        }
+    }
+    if (pending.empty()) {
+        return result;
+    }
+
+    Eigen::Index m = reduced_.rows();
+    if (distinct.size() < pending.size() && distinct.size() <= MAX_NODE_BLOCK) {
+        // Few distinct nodes: block G of L⁻¹ restricted to them
+        std::vector<int> nodes(distinct.size());
+        for (const auto& entry : distinct) {
+            nodes[entry.second] = entry.first;
+        }
+        Eigen::Index d = static_cast<Eigen::Index>(nodes.size());
+        MatrixXd G(d, d);
+        for (Eigen::Index start = 0; start < d; start += batch) {
+            Eigen::Index count = std::min<Eigen::Index>(batch, d - start);
+            MatrixXd B = MatrixXd::Zero(m, count);
+            for (Eigen::Index c = 0; c < count; ++c) {
+                B(reducedIndex_[nodes[start + c]], c) = 1.0;
+            }
+            MatrixXd X = solveReducedBatch(B);
+            for (Eigen::Index r = 0; r < d; ++r) {
+                G.row(r).segment(start, count) = X.row(reducedIndex_[nodes[r]]);
+            }
+        }
+        auto entry = [&](int a, int b) {
+            auto ia = distinct.find(a);
+            auto ib = distinct.find(b);
+            return (ia == distinct.end() || ib == distinct.end()) ? 0.0 : G(ia->second, ib->second);
+        };
+        for (size_t k : pending) {
+            int u = indices[k].first;
+            int v = indices[k].second;
+            result[k] = entry(u, u) + entry(v, v) - 2.0 * entry(u, v);
+        }
+        return result;
+    }
+
+    // One right-hand side e_u - e_v per pair: R = bᵀ L⁻¹ b
+    for (size_t start = 0; start < pending.size(); start += static_cast<size_t>(batch)) {
+        size_t count = std::min(static_cast<size_t>(batch), pending.size() - start);
+        MatrixXd B = MatrixXd::Zero(m, static_cast<Eigen::Index>(count));
+        for (size_t c = 0; c < count; ++c) {
+            setDifference(B, static_cast<Eigen::Index>(c), indices[pending[start + c]].first,
+                          indices[pending[start + c]].second);
+        }
+        MatrixXd X = solveReducedBatch(B);
+        for (size_t c = 0; c < count; ++c) {
+            result[pending[start + c]] = B.col(static_cast<Eigen::Index>(c)).dot(X.col(static_cast<Eigen::Index>(c)));
+        }
+    }
+    return result;
+}
+
+void EffectiveResistance::buildSketch(const ResistanceSketchOptions& options) {
+    int n = network_.nodeCount();
+    int k = options.dimension > 0
+                ? options.dimension
+                : static_cast<int>(std::ceil(4.0 * std::log(std::max(2, n)) / (options.epsilon * options.epsilon)));
+
+    // Y = B_gᵀ W^½ Qᵀ: edge e adds ±√g_e/√k to the rows of its two ends
+    std::mt19937_64 rng(options.seed);
+    Eigen::Index m = reduced_.rows();
+    MatrixXd Y = MatrixXd::Zero(m, k);
+    double scale = 1.0 / std::sqrt(static_cast<double>(k));
+    for (int e = 0; e < network_.edgeCount(); ++e) {
+        int u = reducedIndex_[network_.edgeFrom(e)];
+        int v = reducedIndex_[network_.edgeTo(e)];
+        double weight = std::sqrt(network_.conductance(e)) * scale;
+        for (int c = 0; c < k; c += 64) {
+            std::uint64_t bits = rng();
+            for (int b = 0; b < 64 && c + b < k; ++b) {
+                double value = ((bits >> b) & 1u) ? weight : -weight;
+                if (u >= 0) {
+                    Y(u, c + b) += value;
+                }
+                if (v >= 0) {
+                    Y(v, c + b) -= value;
+                }
+            }
+        }
+    }
+
+    // Z replaces Y, and the row-major copy is the only other k-wide matrix alive
+    Y = solveReducedBatch(Y);
+    sketch_ = Y;
+    Y.resize(0, 0);
+    sketchRevision_ = revision();
+}
+
+double EffectiveResistance::approximate(ResistiveNetwork::NodeId u, ResistiveNetwork::NodeId v) const {
+    if (sketchRevision_ < 0) {
+        throw std::logic_error("Call buildSketch() before approximate()");
+    }
+    if (sketchRevision_ != revision()) {
+        throw std::logic_error("The network changed since buildSketch(); build the sketch again");
+    }
+    int a = network_.index(u);
+    int b = network_.index(v);
+    if (component_[a] != component_[b]) {
+        return std::numeric_limits<double>::infinity();
+    }
+    int ra = reducedIndex_[a];
+    int rb = reducedIndex_[b];
+    if (ra < 0 || rb < 0) {
+        return ra == rb ? 0.0 : sketch_.row(ra < 0 ? rb : ra).squaredNorm();
+    }
+    return (sketch_.row(ra) - sketch_.row(rb)).squaredNorm();
+}
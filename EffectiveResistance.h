@@ -0,0 +1,84 @@
+#ifndef EFFECTIVE_RESISTANCE_H
+#define EFFECTIVE_RESISTANCE_H
+
+#include "ResistiveNetwork.h"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Johnson–Lindenstrauss sketch parameters for approximate resistances
+ */
+struct ResistanceSketchOptions {
+    double epsilon = 0.3;       // Target relative error (sets the dimension)
+    int dimension = 0;          // Sketch rows k (0: ⌈4 ln n / ε²⌉)
+    std::uint64_t seed = 93;
+};
+
+/**
+ * @class EffectiveResistance
+ * @brief Effective resistance R(u, v) = (e_u - e_v)ᵀ L⁺ (e_u - e_v) between node pairs
+ *
+ * This is the voltage across u and v when 1 A flows from u to v through the
+ * whole network. It is not the admittance entry Y(u, v), and not the
+ * resistance of the shortest path. Nodes in different components have
+ * infinite resistance.
+ *
+ * Exact queries use the grounded Laplacian of ResistiveNetworkSolver and
+ * its cached factorization. Batches are solved as multiple right-hand sides
+ * in one pass over the factor. When the pairs share few distinct nodes, the
+ * solver works on the nodes instead: X = L⁻¹[e_a e_b …] and
+ * R(u, v) = X_uu + X_vv - 2 X_uv.
+ *
+ * The approximate mode (Spielman–Srivastava) uses
+ * R(u, v) = ‖W^½ B L⁻¹ (e_u - e_v)‖², with B the incidence matrix and W the
+ * conductances. A random ±1/√k projection Q of the m edge rows keeps that
+ * norm within 1 ± ε for k = O(log n / ε²). buildSketch() stores
+ * Z = (Q W^½ B L⁻¹)ᵀ with one k-vector per non-grounded node, using k
+ * batched solves. A query then costs O(k), independent of the network size.
+ * addEdge() and setResistance() make the sketch stale; approximate() refuses
+ * to answer until buildSketch() is called again.
+ */
+class EffectiveResistance : public ResistiveNetworkSolver {
+public:
+    using NodePair = std::pair<ResistiveNetwork::NodeId, ResistiveNetwork::NodeId>;
+
+    explicit EffectiveResistance(const ResistiveNetwork& network,
+                                 const NetworkSolveOptions& options = NetworkSolveOptions());
+
+    /**
+     * @brief Exact resistance between two nodes (infinity across components)
+     */
+    double resistance(ResistiveNetwork::NodeId u, ResistiveNetwork::NodeId v);
+
+    /**
+     * @brief Exact resistances of many pairs, solved in batches of `batch` right-hand sides
+     */
+    std::vector<double> resistances(const std::vector<NodePair>& pairs, int batch = 32);
+
+    /**
+     * @brief Build the JL sketch for approximate()
+     */
+    void buildSketch(const ResistanceSketchOptions& options = ResistanceSketchOptions());
+
+    /**
+     * @brief Approximate resistance from the sketch, O(k) per query
+     * @throws std::logic_error if buildSketch() has not been called since the
+     *         last edge change
+     */
+    double approximate(ResistiveNetwork::NodeId u, ResistiveNetwork::NodeId v) const;
+
+    int sketchDimension() const { return static_cast<int>(sketch_.cols()); }
+
+private:
+    /**
+     * @brief Reduced right-hand side column of e_u - e_v (grounded ends dropped)
+     */
+    void setDifference(MatrixXd& B, Eigen::Index column, int u, int v) const;
+
+    // Reduced rows x k, row-major so a node's sketch is contiguous; grounded nodes are zero
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> sketch_;
+    long sketchRevision_ = -1;      // revision() the sketch was built at, -1: none
+};
+
+#endif // EFFECTIVE_RESISTANCE_H
@@ -1,4 +1,5 @@
 #include "ElectrostaticSolver.h"
+#include <algorithm>
 #include <cmath>
 #include <fstream>
 #include <iostream>
@@ -90,6 +91,161 @@ void ElectrostaticSolver::buildFDMSystem(
     }
 }
 
+void ElectrostaticSolver::buildReducedFDMSystem(
+    int nx, int ny,
+    double dx, double dy,
+    const std::vector<double>& rho,
+    double epsilon,
+    SparseMatrix& K,
+    VectorXd& f,
+    const std::vector<double>& boundaryValues) {
+    
+    if (nx < 3 || ny < 3) {
+        throw std::invalid_argument("Grid must have at least one interior point");
+    }
+    
+    int mx = nx - 2;  // Interior points in x
+    int my = ny - 2;  // Interior points in y
+    int m = mx * my;
+    
+    if (static_cast<int>(rho.size()) != m) {
+        throw std::invalid_argument("Charge density size mismatch with interior grid points");
+    }
+    
+    double cx = 1.0 / (dx * dx);
+    double cy = 1.0 / (dy * dy);
+    
+    std::vector<Eigen::Triplet<double>> triplets;
+    triplets.reserve(5 * static_cast<size_t>(m));
+    f.resize(m);
+    buildReducedRightHandSide(nx, ny, dx, dy, rho.data(), epsilon,
+                              boundaryValues.data(), boundaryValues.size(), f.data());
+    
+    for (int j = 1; j <= my; ++j) {
+        for (int i = 1; i <= mx; ++i) {
+            int p = (i - 1) + (j - 1) * mx;
+            double diag = 2.0 * (cx + cy);
+            
+            // x-neighbors: interior unknowns (plates are on the right-hand side)
+            if (i > 1) {
+                triplets.emplace_back(p, p - 1, -cx);
+            }
+            if (i < mx) {
+                triplets.emplace_back(p, p + 1, -cx);
+            }
+            
+            // y-neighbors: interior unknowns or Neumann edges (mirror value)
+            if (j > 1) {
+                triplets.emplace_back(p, p - mx, -cy);
+            } else {
+                diag -= cy;
+            }
+            if (j < my) {
+                triplets.emplace_back(p, p + mx, -cy);
+            } else {
+                diag -= cy;
+            }
+            
+            triplets.emplace_back(p, p, diag);
+        }
+    }
+    
+    K.resize(m, m);
+    K.setFromTriplets(triplets.begin(), triplets.end());
+    K.makeCompressed();
+}
+
+void ElectrostaticSolver::buildReducedRightHandSide(
+    int nx, int ny,
+    double dx, double /* dy: Neumann edges add nothing to f */,
+    const double* rho,
+    double epsilon,
+    const double* boundaryValues,
+    size_t boundaryCount,
+    double* f) {
+    
+    int mx = nx - 2;
+    int my = ny - 2;
+    double cx = 1.0 / (dx * dx);
+    
+    auto dirichlet = [&](int i, int j) {
+        size_t idx = static_cast<size_t>(coordToIndex(i, j, nx));
+        return idx < boundaryCount ? boundaryValues[idx] : 0.0;
+    };
+    
+    for (int j = 1; j <= my; ++j) {
+        for (int i = 1; i <= mx; ++i) {
+            int p = (i - 1) + (j - 1) * mx;
+            f[p] = rho ? rho[p] / epsilon : 0.0;
+            
+            // Dirichlet plates next to the first and last interior columns
+            if (i == 1) {
+                f[p] += cx * dirichlet(0, j);
+            }
+            if (i == mx) {
+                f[p] += cx * dirichlet(nx - 1, j);
+            }
+        }
+    }
+}
+
+MatrixSolver::VectorXd ElectrostaticSolver::expandReducedSolution(
+    int nx, int ny,
+    const VectorXd& u,
+    const std::vector<double>& boundaryValues) {
+    
+    if (u.size() != static_cast<Eigen::Index>(nx - 2) * (ny - 2)) {
+        throw std::invalid_argument("Reduced solution size mismatch with interior grid points");
+    }
+    
+    VectorXd phi(nx * ny);
+    expandReducedSolution(nx, ny, u.data(), boundaryValues.data(), boundaryValues.size(), phi.data());
+    return phi;
+}
+
+void ElectrostaticSolver::expandReducedSolution(
+    int nx, int ny,
+    const double* u,
+    const double* boundaryValues,
+    size_t boundaryCount,
+    double* phi) {
+    
+    int mx = nx - 2;
+    for (int j = 0; j < ny; ++j) {
+        for (int i = 0; i < nx; ++i) {
+            int idx = coordToIndex(i, j, nx);
+            
+            if (i == 0 || i == nx - 1) {
+                phi[idx] = static_cast<size_t>(idx) < boundaryCount ? boundaryValues[idx] : 0.0;
+            } else {
+                // Neumann edges take the value of the adjacent interior row
+                int jj = std::min(std::max(j, 1), ny - 2);
+                phi[idx] = u[(i - 1) + (jj - 1) * mx];
+            }
+        }
+    }
+}
+
+std::uint64_t ElectrostaticSolver::geometryHash(int nx, int ny, double dx, double dy) {
+    // FNV-1a over the raw bytes of the parameters that define the operator
+    std::uint64_t hash = 1469598103934665603ULL;
+    auto mix = [&hash](const void* data, size_t bytes) {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        for (size_t k = 0; k < bytes; ++k) {
+            hash ^= p[k];
+            hash *= 1099511628211ULL;
+        }
+    };
+    
+    const char tag[] = "fdm5-dirichlet-x-neumann-y";
+    mix(tag, sizeof(tag));
+    mix(&nx, sizeof(nx));
+    mix(&ny, sizeof(ny));
+    mix(&dx, sizeof(dx));
+    mix(&dy, sizeof(dy));
+    return hash;
+}
+
 MatrixSolver::MatrixXd ElectrostaticSolver::solvePotential(int nx, int ny, const MatrixSolver::VectorXd& phi) {
     MatrixSolver::MatrixXd phi_field(ny, nx);
     
@@ -103,6 +259,15 @@ MatrixSolver::MatrixXd ElectrostaticSolver::solvePotential(int nx, int ny, const
     return phi_field;
 }
 
+FieldResult ElectrostaticSolver::makeFieldResult(
+    int nx, int ny,
+    const MatrixSolver::VectorXd& phi,
+    double dx, double dy,
+    double epsilon) {
+    
+    return FieldResult(solvePotential(nx, ny, phi), dx, dy, epsilon);
+}
+
 void ElectrostaticSolver::computeElectricField(
     const MatrixSolver::MatrixXd& phi_field,
     double dx, double dy,
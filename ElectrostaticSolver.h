@@ -2,7 +2,9 @@
 #define ELECTROSTATIC_SOLVER_H
 
 #include "MatrixSolver.h"
+#include "FieldResult.h"
 #include <Eigen/Dense>
+#include <cstdint>
 #include <vector>
 #include <stdexcept>
 
@@ -46,6 +48,97 @@ public:
         const std::vector<double>& boundaryValues
     );
 
+    /**
+     * @brief Build the reduced sparse SPD system for the interior grid points
+     * 
+     * Eliminates the rows of buildFDMSystem that only encode boundary
+     * conditions: Dirichlet values on the left/right plates move to the
+     * right-hand side and the Neumann rows (φ(i,0) = φ(i,1) at the bottom,
+     * φ(i,ny-1) = φ(i,ny-2) at the top) fold into the diagonal. The result is
+     * K u = f with K = -∇²ₕ symmetric positive definite, suitable for sparse
+     * Cholesky and Conjugate Gradient. Unknowns use the ordering of rho:
+     * interior_idx = (i - 1) + (j - 1) * (nx - 2).
+     * 
+     * @param nx Number of grid points in x-direction
+     * @param ny Number of grid points in y-direction
+     * @param dx Grid spacing in x-direction (m)
+     * @param dy Grid spacing in y-direction (m)
+     * @param rho Charge density at each interior grid point (C/m³)
+     * @param epsilon Permittivity (F/m)
+     * @param K Output: SPD coefficient matrix ((nx-2)*(ny-2) square)
+     * @param f Output: right-hand side vector ((nx-2)*(ny-2))
+     * @param boundaryValues Boundary potential values (Dirichlet conditions)
+     */
+    void buildReducedFDMSystem(
+        int nx, int ny,
+        double dx, double dy,
+        const std::vector<double>& rho,
+        double epsilon,
+        SparseMatrix& K,
+        VectorXd& f,
+        const std::vector<double>& boundaryValues
+    );
+
+    /**
+     * @brief Expand a reduced (interior) solution to the full nx*ny grid vector
+     * 
+     * @param nx Number of grid points in x-direction
+     * @param ny Number of grid points in y-direction
+     * @param u Interior solution of buildReducedFDMSystem
+     * @param boundaryValues Boundary potential values (Dirichlet conditions)
+     * @return Solution vector in the layout of buildFDMSystem
+     */
+    VectorXd expandReducedSolution(
+        int nx, int ny,
+        const VectorXd& u,
+        const std::vector<double>& boundaryValues
+    );
+
+    /**
+     * @brief Right-hand side f of buildReducedFDMSystem on raw buffers
+     * 
+     * @param rho Interior charge density ((nx-2)*(ny-2) values, nullptr for none)
+     * @param boundaryValues Full-grid boundary values (missing entries count as 0)
+     * @param boundaryCount Number of entries in boundaryValues
+     * @param f Output: (nx-2)*(ny-2) values
+     */
+    void buildReducedRightHandSide(
+        int nx, int ny,
+        double dx, double dy,
+        const double* rho,
+        double epsilon,
+        const double* boundaryValues,
+        size_t boundaryCount,
+        double* f
+    );
+
+    /**
+     * @brief expandReducedSolution on raw buffers (phi: nx*ny values)
+     */
+    void expandReducedSolution(
+        int nx, int ny,
+        const double* u,
+        const double* boundaryValues,
+        size_t boundaryCount,
+        double* phi
+    );
+
+    /**
+     * @brief Hash of the discrete geometry that determines the FDM operator
+     * 
+     * Two problems with equal hashes share the same system matrix, so their
+     * factorizations and preconditioners can be reused (see FactorizationCache).
+     * Charge density and boundary values only affect the right-hand side and
+     * are not part of the key.
+     * 
+     * @param nx Number of grid points in x-direction
+     * @param ny Number of grid points in y-direction
+     * @param dx Grid spacing in x-direction
+     * @param dy Grid spacing in y-direction
+     * @return 64-bit FNV-1a hash
+     */
+    std::uint64_t geometryHash(int nx, int ny, double dx, double dy);
+
     /**
      * @brief Solve for electric potential on 2D grid
      * 
@@ -56,6 +149,27 @@ public:
      */
     MatrixXd solvePotential(int nx, int ny, const VectorXd& phi);
 
+    /**
+     * @brief Wrap a solution vector in a FieldResult with lazy derived fields
+     * 
+     * Ex, Ey, |E| and energy density are only computed when accessed, for the
+     * full grid, a region or individual points.
+     * 
+     * @param nx Number of grid points in x-direction
+     * @param ny Number of grid points in y-direction
+     * @param phi Solution vector (potential at each grid point)
+     * @param dx Grid spacing in x-direction
+     * @param dy Grid spacing in y-direction
+     * @param epsilon Permittivity
+     * @return FieldResult holding the 2D potential field
+     */
+    FieldResult makeFieldResult(
+        int nx, int ny,
+        const VectorXd& phi,
+        double dx, double dy,
+        double epsilon
+    );
+
     /**
      * @brief Compute electric field from potential using finite differences
      * 
@@ -0,0 +1,367 @@
+#include "Factorization.h"
+#include "ParallelFor.h"
+#include <Eigen/SparseCholesky>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct DenseLUStorage {
+    std::vector<double> lu;
+    std::vector<std::int32_t> perm;
+};
+
+struct SparseCholeskyStorage {
+    std::vector<std::int32_t> outer;
+    std::vector<std::int32_t> inner;
+    std::vector<double> values;
+    std::vector<double> diag;
+    std::vector<std::int32_t> perm;
+};
+
+} // namespace
+
+// ========== DenseLUFactor ==========
+
+DenseLUFactor DenseLUFactor::compute(const MatrixXd& A) {
+    if (A.rows() != A.cols()) {
+        throw std::invalid_argument("Matrix must be square for LU factorization");
+    }
+
+    Eigen::PartialPivLU<MatrixXd> lu(A);
+    int n = static_cast<int>(A.rows());
+
+    auto storage = std::make_shared<DenseLUStorage>();
+    storage->lu.assign(lu.matrixLU().data(), lu.matrixLU().data() + static_cast<size_t>(n) * n);
+    storage->perm.resize(n);
+    for (int i = 0; i < n; ++i) {
+        storage->perm[i] = lu.permutationP().indices()(i);
+    }
+
+    DenseLUFactor f;
+    f.n_ = n;
+    f.lu_ = storage->lu.data();
+    f.perm_ = storage->perm.data();
+    f.storage_ = storage;
+    return f;
+}
+
+DenseLUFactor::VectorXd DenseLUFactor::solve(const VectorXd& b) const {
+    if (b.size() != n_) {
+        throw std::invalid_argument("Right-hand side size mismatch with factorization");
+    }
+
+    // y = P b
+    VectorXd y(n_);
+    for (int i = 0; i < n_; ++i) {
+        y(perm_[i]) = b(i);
+    }
+
+    Eigen::Map<const MatrixXd> lu(lu_, n_, n_);
+    lu.triangularView<Eigen::UnitLower>().solveInPlace(y);
+    lu.triangularView<Eigen::Upper>().solveInPlace(y);
+    return y;
+}
+
+// ========== SparseCholeskyFactor ==========
+
+SparseCholeskyFactor SparseCholeskyFactor::compute(const SparseMatrix& A) {
+    if (A.rows() != A.cols()) {
+        throw std::invalid_argument("Matrix must be square for Cholesky factorization");
+    }
+
+    Eigen::SimplicialLDLT<SparseMatrix, Eigen::Lower, Eigen::AMDOrdering<int>> ldlt(A);
+    if (ldlt.info() != Eigen::Success) {
+        throw std::runtime_error("Sparse LDLT factorization failed (matrix not SPD?)");
+    }
+
+    int n = static_cast<int>(A.rows());
+    std::vector<std::int32_t> position(n);
+    for (int i = 0; i < n; ++i) {
+        position[i] = ldlt.permutationP().indices()(i);
+    }
+    return fromFactors(SparseMatrix(ldlt.matrixL()), ldlt.vectorD(), std::move(position));
+}
+
+SparseCholeskyFactor SparseCholeskyFactor::compute(const SparseMatrix& A, const std::vector<int>& order) {
+    if (A.rows() != A.cols()) {
+        throw std::invalid_argument("Matrix must be square for Cholesky factorization");
+    }
+    int n = static_cast<int>(A.rows());
+    if (static_cast<int>(order.size()) != n) {
+        throw std::invalid_argument("Elimination order size mismatch with matrix");
+    }
+    std::vector<std::int32_t> position(n, -1);
+    for (int k = 0; k < n; ++k) {
+        if (order[k] < 0 || order[k] >= n || position[order[k]] >= 0) {
+            throw std::invalid_argument("Elimination order is not a permutation");
+        }
+        position[order[k]] = k;
+    }
+
+    // P A Pᵀ, then LDLᵀ without further reordering
+    std::vector<Eigen::Triplet<double>> triplets;
+    triplets.reserve(A.nonZeros());
+    for (int j = 0; j < A.outerSize(); ++j) {
+        for (SparseMatrix::InnerIterator it(A, j); it; ++it) {
+            triplets.emplace_back(position[it.row()], position[j], it.value());
+        }
+    }
+    SparseMatrix B(n, n);
+    B.setFromTriplets(triplets.begin(), triplets.end());
+
+    Eigen::SimplicialLDLT<SparseMatrix, Eigen::Lower, Eigen::NaturalOrdering<int>> ldlt(B);
+    if (ldlt.info() != Eigen::Success) {
+        throw std::runtime_error("Sparse LDLT factorization failed (matrix not SPD?)");
+    }
+    return fromFactors(SparseMatrix(ldlt.matrixL()), ldlt.vectorD(), std::move(position));
+}
+
+SparseCholeskyFactor SparseCholeskyFactor::fromFactors(const SparseMatrix& factor, const VectorXd& d,
+                                                       std::vector<std::int32_t> position) {
+    int n = static_cast<int>(factor.rows());
+    SparseMatrix L = factor;
+    L.makeCompressed();
+
+    auto storage = std::make_shared<SparseCholeskyStorage>();
+    storage->outer.assign(n + 1, 0);
+    storage->inner.reserve(L.nonZeros());
+    storage->values.reserve(L.nonZeros());
+
+    // Keep the strictly lower part only, the unit diagonal is implicit
+    for (int k = 0; k < n; ++k) {
+        for (SparseMatrix::InnerIterator it(L, k); it; ++it) {
+            if (it.row() > k) {
+                storage->inner.push_back(static_cast<std::int32_t>(it.row()));
+                storage->values.push_back(it.value());
+            }
+        }
+        storage->outer[k + 1] = static_cast<std::int32_t>(storage->inner.size());
+    }
+
+    storage->diag.assign(d.data(), d.data() + n);
+    storage->perm = std::move(position);
+
+    SparseCholeskyFactor f;
+    f.n_ = n;
+    f.nnz_ = static_cast<int>(storage->inner.size());
+    f.outer_ = storage->outer.data();
+    f.inner_ = storage->inner.data();
+    f.values_ = storage->values.data();
+    f.diag_ = storage->diag.data();
+    f.perm_ = storage->perm.data();
+    f.storage_ = storage;
+    return f;
+}
+
+SparseCholeskyFactor::VectorXd SparseCholeskyFactor::solve(const VectorXd& b) const {
+    if (b.size() != n_) {
+        throw std::invalid_argument("Right-hand side size mismatch with factorization");
+    }
+    VectorXd x(n_);
+    solve(b.data(), x.data());
+    return x;
+}
+
+void SparseCholeskyFactor::solve(const double* b, double* x) const {
+    // y = P b
+    std::vector<double> y(n_);
+    for (int i = 0; i < n_; ++i) {
+        y[perm_[i]] = b[i];
+    }
+
+    // Forward substitution L z = y (column-oriented)
+    for (int k = 0; k < n_; ++k) {
+        double yk = y[k];
+        for (int p = outer_[k]; p < outer_[k + 1]; ++p) {
+            y[inner_[p]] -= values_[p] * yk;
+        }
+    }
+
+    // Diagonal D
+    for (int k = 0; k < n_; ++k) {
+        y[k] /= diag_[k];
+    }
+
+    // Backward substitution Lᵀ w = z
+    for (int k = n_ - 1; k >= 0; --k) {
+        double sum = y[k];
+        for (int p = outer_[k]; p < outer_[k + 1]; ++p) {
+            sum -= values_[p] * y[inner_[p]];
+        }
+        y[k] = sum;
+    }
+
+    // x = Pᵀ w
+    for (int i = 0; i < n_; ++i) {
+        x[i] = y[perm_[i]];
+    }
+}
+
+SparseCholeskyFactor::MatrixXd SparseCholeskyFactor::solveBatch(const MatrixXd& B) const {
+    if (B.rows() != n_) {
+        throw std::invalid_argument("Right-hand side size mismatch with factorization");
+    }
+
+    // Row-major work array: the k values of one unknown are contiguous
+    using RowMajorMatrix = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+    RowMajorMatrix Y(n_, B.cols());
+    for (int i = 0; i < n_; ++i) {
+        Y.row(perm_[i]) = B.row(i);
+    }
+
+    for (int k = 0; k < n_; ++k) {
+        for (int p = outer_[k]; p < outer_[k + 1]; ++p) {
+            Y.row(inner_[p]) -= values_[p] * Y.row(k);
+        }
+    }
+
+    for (int k = 0; k < n_; ++k) {
+        Y.row(k) /= diag_[k];
+    }
+
+    for (int k = n_ - 1; k >= 0; --k) {
+        for (int p = outer_[k]; p < outer_[k + 1]; ++p) {
+            Y.row(k) -= values_[p] * Y.row(inner_[p]);
+        }
+    }
+
+    MatrixXd X(n_, B.cols());
+    for (int i = 0; i < n_; ++i) {
+        X.row(i) = Y.row(perm_[i]);
+    }
+    return X;
+}
+
+// ========== DiagonalPreconditioner ==========
+
+DiagonalPreconditioner DiagonalPreconditioner::compute(const SparseMatrix& A) {
+    if (A.rows() != A.cols()) {
+        throw std::invalid_argument("Matrix must be square for a diagonal preconditioner");
+    }
+
+    int n = static_cast<int>(A.rows());
+    auto storage = std::make_shared<std::vector<double>>(n);
+    VectorXd d = A.diagonal();
+
+    for (int i = 0; i < n; ++i) {
+        if (d(i) == 0.0) {
+            throw std::invalid_argument("Zero diagonal entry in diagonal preconditioner");
+        }
+        (*storage)[i] = 1.0 / d(i);
+    }
+
+    DiagonalPreconditioner p;
+    p.n_ = n;
+    p.invDiag_ = storage->data();
+    p.storage_ = storage;
+    return p;
+}
+
+DiagonalPreconditioner::VectorXd DiagonalPreconditioner::apply(const VectorXd& r) const {
+    if (r.size() != n_) {
+        throw std::invalid_argument("Vector size mismatch with preconditioner");
+    }
+    return Eigen::Map<const VectorXd>(invDiag_, n_).cwiseProduct(r);
+}
+
+// ========== IncompleteCholeskyPreconditioner ==========
+
+IncompleteCholeskyPreconditioner IncompleteCholeskyPreconditioner::compute(const SparseMatrix& A) {
+    if (A.rows() != A.cols()) {
+        throw std::invalid_argument("Matrix must be square for an incomplete Cholesky preconditioner");
+    }
+
+    // Right-looking: scale column k, then update later columns within their pattern
+    auto L = std::make_shared<SparseMatrix>(A.triangularView<Eigen::Lower>());
+    L->makeCompressed();
+    int n = static_cast<int>(L->cols());
+    const int* outer = L->outerIndexPtr();
+    const int* inner = L->innerIndexPtr();
+    double* values = L->valuePtr();
+    std::vector<int> position(n, -1);
+    for (int k = 0; k < n; ++k) {
+        if (outer[k] == outer[k + 1] || inner[outer[k]] != k || !(values[outer[k]] > 0.0)) {
+            throw std::runtime_error("Non-positive pivot in incomplete Cholesky at row " + std::to_string(k));
+        }
+        double pivot = std::sqrt(values[outer[k]]);
+        values[outer[k]] = pivot;
+        for (int p = outer[k] + 1; p < outer[k + 1]; ++p) {
+            values[p] /= pivot;
+        }
+        for (int p = outer[k] + 1; p < outer[k + 1]; ++p) {
+            int j = inner[p];
+            for (int q = outer[j]; q < outer[j + 1]; ++q) {
+                position[inner[q]] = q;
+            }
+            for (int r = p; r < outer[k + 1]; ++r) {
+                if (position[inner[r]] >= 0) {
+                    values[position[inner[r]]] -= values[r] * values[p];
+                }
+            }
+            for (int q = outer[j]; q < outer[j + 1]; ++q) {
+                position[inner[q]] = -1;
+            }
+        }
+    }
+
+    IncompleteCholeskyPreconditioner p;
+    p.factor_ = L;
+    return p;
+}
+
+IncompleteCholeskyPreconditioner::VectorXd IncompleteCholeskyPreconditioner::apply(const VectorXd& r) const {
+    if (r.size() != size()) {
+        throw std::invalid_argument("Vector size mismatch with preconditioner");
+    }
+    VectorXd y = factor_->triangularView<Eigen::Lower>().solve(r);
+    return factor_->transpose().triangularView<Eigen::Upper>().solve(y);
+}
+
+// ========== BlockJacobiPreconditioner ==========
+
+BlockJacobiPreconditioner BlockJacobiPreconditioner::compute(const SparseMatrix& A, int blocks, int threads) {
+    if (A.rows() != A.cols()) {
+        throw std::invalid_argument("Matrix must be square for a block Jacobi preconditioner");
+    }
+
+    int n = static_cast<int>(A.rows());
+    blocks = std::max(1, std::min(blocks, n));
+
+    BlockJacobiPreconditioner p;
+    p.threads_ = std::max(1, threads);
+    p.offsets_.resize(blocks + 1);
+    for (int b = 0; b <= blocks; ++b) {
+        p.offsets_[b] = static_cast<int>(static_cast<long>(n) * b / blocks);
+    }
+    p.factors_.resize(blocks);
+
+    parallelFor(p.threads_, blocks, [&](long begin, long end) {
+        for (long b = begin; b < end; ++b) {
+            int o = p.offsets_[b];
+            int len = p.offsets_[b + 1] - o;
+            SparseMatrix block = A.block(o, o, len, len);
+            p.factors_[b] = SparseCholeskyFactor::compute(block);
+        }
+    });
+    return p;
+}
+
+BlockJacobiPreconditioner::VectorXd BlockJacobiPreconditioner::apply(const VectorXd& r) const {
+    if (r.size() != size()) {
+        throw std::invalid_argument("Vector size mismatch with preconditioner");
+    }
+
+    VectorXd z(r.size());
+    parallelFor(threads_, blocks(), [&](long begin, long end) {
+        for (long b = begin; b < end; ++b) {
+            int o = offsets_[b];
+            int len = offsets_[b + 1] - o;
+            z.segment(o, len) = factors_[b].solve(r.segment(o, len));
+        }
+    });
+    return z;
+}
@@ -0,0 +1,238 @@
+#ifndef FACTORIZATION_H
+#define FACTORIZATION_H
+
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class FactorizationCache;
+
+/**
+ * @class DenseLUFactor
+ * @brief Reusable partial-pivoting LU factorization PA = LU of a dense matrix
+ *
+ * Factor data is either owned or a read-only view into a memory-mapped
+ * cache file (see FactorizationCache); solving works the same in both cases.
+ */
+class DenseLUFactor {
+public:
+    using MatrixXd = Eigen::MatrixXd;
+    using VectorXd = Eigen::VectorXd;
+
+    DenseLUFactor() = default;
+
+    /**
+     * @brief Factorize a square dense matrix
+     * @param A Coefficient matrix (n x n)
+     * @return Factorization owning its data
+     */
+    static DenseLUFactor compute(const MatrixXd& A);
+
+    /**
+     * @brief Solve Ax = b with the stored factors
+     * @param b Right-hand side vector (n x 1)
+     * @return Solution vector x (n x 1)
+     */
+    VectorXd solve(const VectorXd& b) const;
+
+    int size() const { return n_; }
+    bool empty() const { return n_ == 0; }
+
+private:
+    friend class FactorizationCache;
+
+    int n_ = 0;
+    const double* lu_ = nullptr;        // n x n, column-major, unit-lower L and upper U
+    const std::int32_t* perm_ = nullptr; // row permutation indices of P
+    std::shared_ptr<const void> storage_;
+};
+
+/**
+ * @class SparseCholeskyFactor
+ * @brief Reusable sparse LDLᵀ factorization P A Pᵀ = L D Lᵀ of an SPD matrix
+ *
+ * Computed with Eigen's SimplicialLDLT (AMD ordering); L is kept in
+ * compressed column form with an implicit unit diagonal so the factor can be
+ * written to and mapped back from a FactorizationCache file.
+ */
+class SparseCholeskyFactor {
+public:
+    using SparseMatrix = Eigen::SparseMatrix<double>;
+    using MatrixXd = Eigen::MatrixXd;
+    using VectorXd = Eigen::VectorXd;
+
+    SparseCholeskyFactor() = default;
+
+    /**
+     * @brief Factorize a symmetric positive-definite sparse matrix
+     * @param A Coefficient matrix (n x n, SPD)
+     * @return Factorization owning its data
+     */
+    static SparseCholeskyFactor compute(const SparseMatrix& A);
+
+    /**
+     * @brief Factorize with a given elimination order instead of AMD
+     *
+     * Rows and columns are eliminated in the order order[0], order[1], …
+     * (e.g. Reordering::nestedDissection for grids); solves are unchanged.
+     *
+     * @param A Coefficient matrix (n x n, SPD)
+     * @param order New-to-old permutation of 0..n-1
+     * @throws std::invalid_argument if order is not a permutation of 0..n-1
+     */
+    static SparseCholeskyFactor compute(const SparseMatrix& A, const std::vector<int>& order);
+
+    /**
+     * @brief Solve Ax = b with the stored factors
+     * @param b Right-hand side vector (n x 1)
+     * @return Solution vector x (n x 1)
+     */
+    VectorXd solve(const VectorXd& b) const;
+
+    /**
+     * @brief Solve Ax = b on raw buffers of length n (b and x may alias)
+     */
+    void solve(const double* b, double* x) const;
+
+    /**
+     * @brief Solve AX = B for several right-hand sides in one pass over L
+     *
+     * Each entry of L is read once and applied to all columns, so k solves
+     * cost far less memory traffic than k calls to solve().
+     *
+     * @param B Right-hand sides as columns (n x k)
+     * @return Solutions as columns (n x k)
+     */
+    MatrixXd solveBatch(const MatrixXd& B) const;
+
+    int size() const { return n_; }
+    int nonZeros() const { return nnz_; }
+    bool empty() const { return n_ == 0; }
+
+private:
+    friend class FactorizationCache;
+
+    /// Stores L (strict lower part), D and the old-to-new permutation
+    static SparseCholeskyFactor fromFactors(const SparseMatrix& L, const VectorXd& d,
+                                            std::vector<std::int32_t> position);
+
+    int n_ = 0;
+    int nnz_ = 0;
+    const std::int32_t* outer_ = nullptr;  // n + 1 column pointers of L
+    const std::int32_t* inner_ = nullptr;  // row indices of L (strictly lower)
+    const double* values_ = nullptr;       // values of L
+    const double* diag_ = nullptr;         // D
+    const std::int32_t* perm_ = nullptr;   // fill-reducing permutation P
+    std::shared_ptr<const void> storage_;
+};
+
+/**
+ * @class DiagonalPreconditioner
+ * @brief Jacobi preconditioner M⁻¹ = diag(A)⁻¹
+ */
+class DiagonalPreconditioner {
+public:
+    using SparseMatrix = Eigen::SparseMatrix<double>;
+    using VectorXd = Eigen::VectorXd;
+
+    DiagonalPreconditioner() = default;
+
+    /**
+     * @brief Build from the diagonal of a sparse matrix
+     * @param A Coefficient matrix (n x n), no zero diagonal entries
+     */
+    static DiagonalPreconditioner compute(const SparseMatrix& A);
+
+    /**
+     * @brief Apply the preconditioner z = M⁻¹ r
+     */
+    VectorXd apply(const VectorXd& r) const;
+
+    int size() const { return n_; }
+    bool empty() const { return n_ == 0; }
+
+private:
+    friend class FactorizationCache;
+
+    int n_ = 0;
+    const double* invDiag_ = nullptr;
+    std::shared_ptr<const void> storage_;
+};
+
+/**
+ * @class IncompleteCholeskyPreconditioner
+ * @brief Incomplete Cholesky preconditioner M = L̃ L̃ᵀ ≈ A
+ *
+ * IC(0): Cholesky restricted to the pattern of the lower triangle of A, in
+ * the given ordering (no fill, no reordering). It cannot break down for
+ * M-matrices such as grounded Laplacians and FDM matrices.
+ */
+class IncompleteCholeskyPreconditioner {
+public:
+    using SparseMatrix = Eigen::SparseMatrix<double>;
+    using VectorXd = Eigen::VectorXd;
+
+    IncompleteCholeskyPreconditioner() = default;
+
+    /**
+     * @brief Factorize an SPD matrix incompletely
+     * @param A Coefficient matrix (n x n, SPD)
+     * @throws std::runtime_error on a non-positive pivot
+     */
+    static IncompleteCholeskyPreconditioner compute(const SparseMatrix& A);
+
+    /**
+     * @brief Apply the preconditioner z = M⁻¹ r
+     */
+    VectorXd apply(const VectorXd& r) const;
+
+    int size() const { return static_cast<int>(factor_ ? factor_->rows() : 0); }
+    bool empty() const { return !factor_; }
+
+private:
+    std::shared_ptr<const SparseMatrix> factor_;    // L̃, lower triangular
+};
+
+/**
+ * @class BlockJacobiPreconditioner
+ * @brief Block-diagonal preconditioner M⁻¹ = blockdiag(A₁₁⁻¹, …, A_kk⁻¹)
+ *
+ * Splits the unknowns into k contiguous blocks (horizontal strips of the
+ * grid for the FDM ordering) and factorizes each diagonal block with its own
+ * sparse LDLᵀ. The blocks are independent, so both factorization and
+ * application run on up to k threads. Symmetric and positive definite for SPD
+ * A, hence usable with preconditioned CG.
+ */
+class BlockJacobiPreconditioner {
+public:
+    using SparseMatrix = Eigen::SparseMatrix<double>;
+    using VectorXd = Eigen::VectorXd;
+
+    BlockJacobiPreconditioner() = default;
+
+    /**
+     * @brief Factorize the diagonal blocks of an SPD matrix
+     * @param A Coefficient matrix (n x n, SPD)
+     * @param blocks Number of blocks k (clamped to [1, n])
+     * @param threads Threads used for compute() and apply()
+     */
+    static BlockJacobiPreconditioner compute(const SparseMatrix& A, int blocks, int threads = 1);
+
+    /**
+     * @brief Apply the preconditioner z = M⁻¹ r
+     */
+    VectorXd apply(const VectorXd& r) const;
+
+    int size() const { return offsets_.empty() ? 0 : offsets_.back(); }
+    int blocks() const { return static_cast<int>(factors_.size()); }
+    bool empty() const { return factors_.empty(); }
+
+private:
+    std::vector<int> offsets_;                  // k + 1 block boundaries
+    std::vector<SparseCholeskyFactor> factors_;
+    int threads_ = 1;
+};
+
+#endif // FACTORIZATION_H
@@ -0,0 +1,643 @@
+#include "FactorizationCache.h"
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const char MAGIC[8] = {'S', 'C', 'H', 'R', 'F', 'A', 'C', 'T'};
+const std::uint32_t ENDIAN_TAG = 0x01020304u;
+const size_t ALIGNMENT = 64;
+const size_t NAME_LENGTH = 64;
+
+enum class SectionKind : std::uint32_t {
+    DenseLU = 1,
+    SparseCholesky = 2,
+    Diagonal = 3,
+    SparseMatrix = 4
+};
+
+struct FileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t endianTag;
+    std::uint64_t key;
+    std::uint32_t sectionCount;
+    std::uint32_t reserved;
+    std::uint64_t fileSize;
+    char padding[24];
+};
+static_assert(sizeof(FileHeader) == 64, "Cache file header must be 64 bytes");
+
+struct SectionEntry {
+    char name[NAME_LENGTH];
+    std::uint32_t kind;
+    std::uint32_t reserved;
+    std::int64_t rows;
+    std::int64_t cols;
+    std::int64_t nnz;
+    std::uint64_t offset;
+    std::uint64_t bytes;
+};
+static_assert(sizeof(SectionEntry) == 112, "Cache section entry must be 112 bytes");
+
+struct ArrayRef {
+    const void* data;
+    size_t bytes;
+};
+
+struct PendingSection {
+    SectionEntry entry;
+    std::vector<ArrayRef> arrays;
+};
+
+/**
+ * Temporary file name unique to this process and call, so concurrent writers never share it
+ */
+std::string temporaryPath(const std::string& path) {
+    static std::atomic<std::uint64_t> counter{0};
+#ifdef _WIN32
+    unsigned long pid = GetCurrentProcessId();
+#else
+    long pid = static_cast<long>(::getpid());
+#endif
+    return path + "." + std::to_string(pid) + "_" + std::to_string(counter++) + ".tmp";
+}
+
+/**
+ * Exclusive advisory lock on a side file, held until destruction
+ */
+class FileLock {
+public:
+    explicit FileLock(const std::string& path) {
+#ifdef _WIN32
+        file_ = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                            nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        OVERLAPPED overlapped{};
+        if (file_ == INVALID_HANDLE_VALUE ||
+            !LockFileEx(file_, LOCKFILE_EXCLUSIVE_LOCK, 0, MAXDWORD, MAXDWORD, &overlapped)) {
+            throw std::runtime_error("Could not lock cache file " + path);
+        }
+#else
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        int rc = -1;
+        if (fd_ >= 0) {
+            do {
+                rc = ::flock(fd_, LOCK_EX);
+            } while (rc != 0 && errno == EINTR);
+        }
+        if (rc != 0) {
+            if (fd_ >= 0) {
+                ::close(fd_);
+            }
+            throw std::runtime_error("Could not lock cache file " + path);
+        }
+#endif
+    }
+
+    ~FileLock() {
+#ifdef _WIN32
+        OVERLAPPED overlapped{};
+        UnlockFileEx(file_, 0, MAXDWORD, MAXDWORD, &overlapped);
+        CloseHandle(file_);
+#else
+        ::flock(fd_, LOCK_UN);
+        ::close(fd_);
+#endif
+    }
+
+    FileLock(const FileLock&) = delete;
+    FileLock& operator=(const FileLock&) = delete;
+
+private:
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+#else
+    int fd_ = -1;
+#endif
+};
+
+size_t alignUp(size_t x) {
+    return (x + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+}
+
+/**
+ * Read-only memory mapping of a whole file, unmapped on destruction
+ */
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+#ifdef _WIN32
+        file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+                            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) {
+            return;
+        }
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file_, &size) || size.QuadPart == 0) {
+            return;
+        }
+        mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping_) {
+            return;
+        }
+        data_ = static_cast<const unsigned char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+        if (data_) {
+            size_ = static_cast<size_t>(size.QuadPart);
+        }
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return;
+        }
+        struct stat st;
+        if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* p = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                data_ = static_cast<const unsigned char*>(p);
+                size_ = static_cast<size_t>(st.st_size);
+            }
+        }
+        ::close(fd);
+#endif
+    }
+
+    ~MappedFile() {
+#ifdef _WIN32
+        if (data_) {
+            UnmapViewOfFile(data_);
+        }
+        if (mapping_) {
+            CloseHandle(mapping_);
+        }
+        if (file_ != INVALID_HANDLE_VALUE) {
+            CloseHandle(file_);
+        }
+#else
+        if (data_) {
+            ::munmap(const_cast<unsigned char*>(data_), size_);
+        }
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool valid() const { return data_ != nullptr; }
+    const unsigned char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const unsigned char* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#endif
+};
+
+SectionEntry makeEntry(const std::string& name, SectionKind kind,
+                       std::int64_t rows, std::int64_t cols, std::int64_t nnz) {
+    if (name.empty() || name.size() >= NAME_LENGTH) {
+        throw std::invalid_argument("Cache entry name must have 1 to 63 characters: " + name);
+    }
+    SectionEntry e;
+    std::memset(&e, 0, sizeof(e));
+    std::memcpy(e.name, name.data(), name.size());
+    e.kind = static_cast<std::uint32_t>(kind);
+    e.rows = rows;
+    e.cols = cols;
+    e.nnz = nnz;
+    return e;
+}
+
+/**
+ * Walks the aligned arrays of one section payload during loading
+ */
+class PayloadReader {
+public:
+    PayloadReader(const MappedFile& file, const SectionEntry& entry)
+        : file_(file), cursor_(entry.offset), end_(entry.offset + entry.bytes) {}
+
+    template <typename T>
+    const T* next(std::int64_t count) {
+        if (count < 0) {
+            ok_ = false;
+            return nullptr;
+        }
+        cursor_ = alignUp(cursor_);
+        // Compare counts, not byte sizes, so a corrupt count cannot overflow
+        if (end_ > file_.size() || cursor_ > end_ ||
+            static_cast<std::uint64_t>(count) > (end_ - cursor_) / sizeof(T)) {
+            ok_ = false;
+            return nullptr;
+        }
+        size_t bytes = static_cast<size_t>(count) * sizeof(T);
+        const T* p = reinterpret_cast<const T*>(file_.data() + cursor_);
+        cursor_ += bytes;
+        return p;
+    }
+
+    bool ok() const { return ok_; }
+
+private:
+    const MappedFile& file_;
+    size_t cursor_;
+    size_t end_;
+    bool ok_ = true;
+};
+
+/**
+ * Compressed column structure: outer starts at 0, never decreases and ends at
+ * nnz, and every inner index lies in [0, rows)
+ */
+bool validCompressed(const std::int32_t* outer, const std::int32_t* inner,
+                     std::int64_t rows, std::int64_t cols, std::int64_t nnz) {
+    if (outer[0] != 0 || outer[cols] != nnz) {
+        return false;
+    }
+    for (std::int64_t j = 0; j < cols; ++j) {
+        if (outer[j + 1] < outer[j]) {
+            return false;
+        }
+    }
+    for (std::int64_t p = 0; p < nnz; ++p) {
+        if (inner[p] < 0 || inner[p] >= rows) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Every index in [0, n) exactly once
+ */
+bool validPermutation(const std::int32_t* perm, std::int64_t n) {
+    std::vector<char> seen(static_cast<size_t>(n), 0);
+    for (std::int64_t i = 0; i < n; ++i) {
+        if (perm[i] < 0 || perm[i] >= n || seen[perm[i]]) {
+            return false;
+        }
+        seen[perm[i]] = 1;
+    }
+    return true;
+}
+
+} // namespace
+
+// ========== FactorizationBundle ==========
+
+void FactorizationBundle::add(const std::string& name, const DenseLUFactor& factor) {
+    denseLU_[name] = factor;
+}
+
+void FactorizationBundle::add(const std::string& name, const SparseCholeskyFactor& factor) {
+    sparseCholesky_[name] = factor;
+}
+
+void FactorizationBundle::add(const std::string& name, const DiagonalPreconditioner& preconditioner) {
+    diagonal_[name] = preconditioner;
+}
+
+void FactorizationBundle::add(const std::string& name, const SparseMatrix& matrix) {
+    auto copy = std::make_shared<SparseMatrix>(matrix);
+    copy->makeCompressed();
+
+    MatrixEntry e;
+    e.rows = static_cast<int>(copy->rows());
+    e.cols = static_cast<int>(copy->cols());
+    e.nnz = static_cast<int>(copy->nonZeros());
+    e.outer = copy->outerIndexPtr();
+    e.inner = copy->innerIndexPtr();
+    e.values = copy->valuePtr();
+    e.storage = copy;
+    matrices_[name] = e;
+}
+
+const DenseLUFactor* FactorizationBundle::denseLU(const std::string& name) const {
+    auto it = denseLU_.find(name);
+    return it == denseLU_.end() ? nullptr : &it->second;
+}
+
+const SparseCholeskyFactor* FactorizationBundle::sparseCholesky(const std::string& name) const {
+    auto it = sparseCholesky_.find(name);
+    return it == sparseCholesky_.end() ? nullptr : &it->second;
+}
+
+const DiagonalPreconditioner* FactorizationBundle::diagonal(const std::string& name) const {
+    auto it = diagonal_.find(name);
+    return it == diagonal_.end() ? nullptr : &it->second;
+}
+
+bool FactorizationBundle::hasMatrix(const std::string& name) const {
+    return matrices_.count(name) > 0;
+}
+
+FactorizationBundle::SparseMatrixView FactorizationBundle::matrix(const std::string& name) const {
+    auto it = matrices_.find(name);
+    if (it == matrices_.end()) {
+        throw std::out_of_range("No sparse operator named " + name + " in bundle");
+    }
+    const MatrixEntry& e = it->second;
+    return SparseMatrixView(e.rows, e.cols, e.nnz, e.outer, e.inner, e.values);
+}
+
+size_t FactorizationBundle::size() const {
+    return denseLU_.size() + sparseCholesky_.size() + diagonal_.size() + matrices_.size();
+}
+
+void FactorizationBundle::merge(const FactorizationBundle& other) {
+    for (const auto& kv : other.denseLU_) {
+        denseLU_[kv.first] = kv.second;
+    }
+    for (const auto& kv : other.sparseCholesky_) {
+        sparseCholesky_[kv.first] = kv.second;
+    }
+    for (const auto& kv : other.diagonal_) {
+        diagonal_[kv.first] = kv.second;
+    }
+    for (const auto& kv : other.matrices_) {
+        matrices_[kv.first] = kv.second;
+    }
+}
+
+void FactorizationBundle::clear() {
+    denseLU_.clear();
+    sparseCholesky_.clear();
+    diagonal_.clear();
+    matrices_.clear();
+}
+
+// ========== FactorizationCache ==========
+
+FactorizationCache::FactorizationCache(const std::string& directory)
+    : directory_(directory) {}
+
+std::string FactorizationCache::pathFor(std::uint64_t key) const {
+    std::ostringstream name;
+    name << "factor_" << std::hex << std::setw(16) << std::setfill('0') << key << ".bin";
+    return (std::filesystem::path(directory_) / name.str()).string();
+}
+
+bool FactorizationCache::contains(std::uint64_t key) const {
+    std::error_code ec;
+    return std::filesystem::exists(pathFor(key), ec);
+}
+
+void FactorizationCache::store(std::uint64_t key, const FactorizationBundle& bundle) const {
+    std::error_code ec;
+    std::filesystem::create_directories(directory_, ec);
+    if (ec) {
+        throw std::runtime_error("Could not create cache directory " + directory_);
+    }
+
+    // Write to a temporary file first so readers never see a partial file
+    std::string path = pathFor(key);
+    std::string tmp = temporaryPath(path);
+    writeFile(tmp, key, bundle);
+
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) {
+        std::filesystem::remove(path, ec);
+        std::filesystem::rename(tmp, path, ec);
+        if (ec) {
+            std::filesystem::remove(tmp, ec);
+            throw std::runtime_error("Could not move cache file into place: " + path);
+        }
+    }
+}
+
+void FactorizationCache::update(std::uint64_t key, const FactorizationBundle& additions) const {
+    std::error_code ec;
+    std::filesystem::create_directories(directory_, ec);
+    if (ec) {
+        throw std::runtime_error("Could not create cache directory " + directory_);
+    }
+
+    // Serialize load-merge-store per key so concurrent updaters keep each other's entries
+    FileLock lock(pathFor(key) + ".lock");
+
+    // Loaded entries view the old file's mapping, which outlives the rename in store()
+    FactorizationBundle merged;
+    load(key, merged);
+    merged.merge(additions);
+    store(key, merged);
+}
+
+bool FactorizationCache::load(std::uint64_t key, FactorizationBundle& bundle) const {
+    return readFile(pathFor(key), key, bundle);
+}
+
+bool FactorizationCache::remove(std::uint64_t key) const {
+    std::error_code ec;
+    return std::filesystem::remove(pathFor(key), ec);
+}
+
+void FactorizationCache::writeFile(const std::string& path, std::uint64_t key, const FactorizationBundle& bundle) {
+    std::vector<PendingSection> sections;
+
+    for (const auto& kv : bundle.denseLU_) {
+        const DenseLUFactor& f = kv.second;
+        PendingSection s{makeEntry(kv.first, SectionKind::DenseLU, f.n_, f.n_, 0), {}};
+        s.arrays.push_back({f.lu_, sizeof(double) * static_cast<size_t>(f.n_) * f.n_});
+        s.arrays.push_back({f.perm_, sizeof(std::int32_t) * f.n_});
+        sections.push_back(s);
+    }
+
+    for (const auto& kv : bundle.sparseCholesky_) {
+        const SparseCholeskyFactor& f = kv.second;
+        PendingSection s{makeEntry(kv.first, SectionKind::SparseCholesky, f.n_, f.n_, f.nnz_), {}};
+        s.arrays.push_back({f.outer_, sizeof(std::int32_t) * (f.n_ + 1)});
+        s.arrays.push_back({f.inner_, sizeof(std::int32_t) * f.nnz_});
+        s.arrays.push_back({f.values_, sizeof(double) * f.nnz_});
+        s.arrays.push_back({f.diag_, sizeof(double) * f.n_});
+        s.arrays.push_back({f.perm_, sizeof(std::int32_t) * f.n_});
+        sections.push_back(s);
+    }
+
+    for (const auto& kv : bundle.diagonal_) {
+        const DiagonalPreconditioner& p = kv.second;
+        PendingSection s{makeEntry(kv.first, SectionKind::Diagonal, p.n_, 1, 0), {}};
+        s.arrays.push_back({p.invDiag_, sizeof(double) * p.n_});
+        sections.push_back(s);
+    }
+
+    for (const auto& kv : bundle.matrices_) {
+        const FactorizationBundle::MatrixEntry& m = kv.second;
+        PendingSection s{makeEntry(kv.first, SectionKind::SparseMatrix, m.rows, m.cols, m.nnz), {}};
+        s.arrays.push_back({m.outer, sizeof(std::int32_t) * (m.cols + 1)});
+        s.arrays.push_back({m.inner, sizeof(std::int32_t) * m.nnz});
+        s.arrays.push_back({m.values, sizeof(double) * m.nnz});
+        sections.push_back(s);
+    }
+
+    // Lay out payloads after the header and section table
+    size_t pos = sizeof(FileHeader) + sections.size() * sizeof(SectionEntry);
+    for (auto& s : sections) {
+        pos = alignUp(pos);
+        s.entry.offset = pos;
+        for (const auto& a : s.arrays) {
+            pos = alignUp(pos) + a.bytes;
+        }
+        s.entry.bytes = pos - s.entry.offset;
+    }
+
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = FORMAT_VERSION;
+    header.endianTag = ENDIAN_TAG;
+    header.key = key;
+    header.sectionCount = static_cast<std::uint32_t>(sections.size());
+    header.fileSize = pos;
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open cache file " + path + " for writing");
+    }
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (const auto& s : sections) {
+        file.write(reinterpret_cast<const char*>(&s.entry), sizeof(SectionEntry));
+    }
+
+    static const char zeros[ALIGNMENT] = {};
+    size_t written = sizeof(FileHeader) + sections.size() * sizeof(SectionEntry);
+    for (const auto& s : sections) {
+        for (const auto& a : s.arrays) {
+            size_t aligned = alignUp(written);
+            file.write(zeros, static_cast<std::streamsize>(aligned - written));
+            file.write(static_cast<const char*>(a.data), static_cast<std::streamsize>(a.bytes));
+            written = aligned + a.bytes;
+        }
+    }
+
+    if (!file) {
+        throw std::runtime_error("Failed writing cache file " + path);
+    }
+}
+
+bool FactorizationCache::readFile(const std::string& path, std::uint64_t key, FactorizationBundle& bundle) {
+    bundle.clear();
+
+    auto file = std::make_shared<MappedFile>(path);
+    if (!file->valid() || file->size() < sizeof(FileHeader)) {
+        return false;
+    }
+
+    FileHeader header;
+    std::memcpy(&header, file->data(), sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        header.version != FORMAT_VERSION ||
+        header.endianTag != ENDIAN_TAG ||
+        header.key != key ||
+        header.fileSize != file->size() ||
+        sizeof(FileHeader) + header.sectionCount * sizeof(SectionEntry) > file->size()) {
+        return false;
+    }
+
+    // Every loaded object holds a reference that keeps the mapping alive
+    std::shared_ptr<const void> storage = file;
+
+    for (std::uint32_t k = 0; k < header.sectionCount; ++k) {
+        SectionEntry e;
+        std::memcpy(&e, file->data() + sizeof(FileHeader) + k * sizeof(SectionEntry), sizeof(e));
+        e.name[NAME_LENGTH - 1] = '\0';
+        std::string name(e.name);
+
+        // Sizes must fit the int32 index arrays the factors use
+        const std::int64_t limit = std::numeric_limits<std::int32_t>::max();
+        if (e.rows < 0 || e.rows >= limit || e.cols < 0 || e.cols >= limit || e.nnz < 0 || e.nnz > limit) {
+            bundle.clear();
+            return false;
+        }
+        PayloadReader reader(*file, e);
+        int n = static_cast<int>(e.rows);
+
+        switch (static_cast<SectionKind>(e.kind)) {
+            case SectionKind::DenseLU: {
+                DenseLUFactor f;
+                f.n_ = n;
+                f.lu_ = reader.next<double>(e.rows * e.rows);
+                f.perm_ = reader.next<std::int32_t>(e.rows);
+                f.storage_ = storage;
+                if (!reader.ok() || !validPermutation(f.perm_, n)) {
+                    bundle.clear();
+                    return false;
+                }
+                bundle.denseLU_[name] = f;
+                break;
+            }
+            case SectionKind::SparseCholesky: {
+                SparseCholeskyFactor f;
+                f.n_ = n;
+                f.nnz_ = static_cast<int>(e.nnz);
+                f.outer_ = reader.next<std::int32_t>(e.rows + 1);
+                f.inner_ = reader.next<std::int32_t>(e.nnz);
+                f.values_ = reader.next<double>(e.nnz);
+                f.diag_ = reader.next<double>(e.rows);
+                f.perm_ = reader.next<std::int32_t>(e.rows);
+                f.storage_ = storage;
+                // The solves index through these arrays unchecked
+                if (!reader.ok() || !validCompressed(f.outer_, f.inner_, n, n, f.nnz_) ||
+                    !validPermutation(f.perm_, n)) {
+                    bundle.clear();
+                    return false;
+                }
+                bundle.sparseCholesky_[name] = f;
+                break;
+            }
+            case SectionKind::Diagonal: {
+                DiagonalPreconditioner p;
+                p.n_ = n;
+                p.invDiag_ = reader.next<double>(e.rows);
+                p.storage_ = storage;
+                if (!reader.ok()) {
+                    bundle.clear();
+                    return false;
+                }
+                bundle.diagonal_[name] = p;
+                break;
+            }
+            case SectionKind::SparseMatrix: {
+                FactorizationBundle::MatrixEntry m;
+                m.rows = n;
+                m.cols = static_cast<int>(e.cols);
+                m.nnz = static_cast<int>(e.nnz);
+                m.outer = reader.next<std::int32_t>(e.cols + 1);
+                m.inner = reader.next<std::int32_t>(e.nnz);
+                m.values = reader.next<double>(e.nnz);
+                m.storage = storage;
+                if (!reader.ok() || !validCompressed(m.outer, m.inner, m.rows, m.cols, m.nnz)) {
+                    bundle.clear();
+                    return false;
+                }
+                bundle.matrices_[name] = m;
+                break;
+            }
+            default:
+                // Unknown kinds come from a newer writer with the same version; skip them
+                break;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,174 @@
+#ifndef FACTORIZATION_CACHE_H
+#define FACTORIZATION_CACHE_H
+
+#include "Factorization.h"
+#include <Eigen/Sparse>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @class FactorizationBundle
+ * @brief Named collection of solver setup objects stored under one geometry key
+ *
+ * Holds everything that is expensive to rebuild for a fixed geometry:
+ * dense LU factors, sparse LDLᵀ factors, diagonal preconditioners and plain
+ * sparse operators (e.g. the levels of a multigrid hierarchy, stored as
+ * "mg/level1/A", "mg/level1/P", ...).
+ */
+class FactorizationBundle {
+public:
+    using SparseMatrix = Eigen::SparseMatrix<double>;
+    using SparseMatrixView = Eigen::Map<const SparseMatrix>;
+
+    void add(const std::string& name, const DenseLUFactor& factor);
+    void add(const std::string& name, const SparseCholeskyFactor& factor);
+    void add(const std::string& name, const DiagonalPreconditioner& preconditioner);
+
+    /**
+     * @brief Add a sparse operator (copied into the bundle)
+     */
+    void add(const std::string& name, const SparseMatrix& matrix);
+
+    /**
+     * @brief Look up a stored object by name
+     * @return Pointer to the object, or nullptr if absent
+     */
+    const DenseLUFactor* denseLU(const std::string& name) const;
+    const SparseCholeskyFactor* sparseCholesky(const std::string& name) const;
+    const DiagonalPreconditioner* diagonal(const std::string& name) const;
+
+    /**
+     * @brief Check whether a sparse operator with this name is stored
+     */
+    bool hasMatrix(const std::string& name) const;
+
+    /**
+     * @brief Read-only view of a stored sparse operator
+     * @throws std::out_of_range if no operator with this name exists
+     */
+    SparseMatrixView matrix(const std::string& name) const;
+
+    /**
+     * @brief Number of stored objects
+     */
+    size_t size() const;
+
+    /**
+     * @brief Copy every object of another bundle, replacing entries with the same name
+     */
+    void merge(const FactorizationBundle& other);
+
+    void clear();
+
+private:
+    friend class FactorizationCache;
+
+    struct MatrixEntry {
+        int rows = 0;
+        int cols = 0;
+        int nnz = 0;
+        const std::int32_t* outer = nullptr;
+        const std::int32_t* inner = nullptr;
+        const double* values = nullptr;
+        std::shared_ptr<const void> storage;
+    };
+
+    std::map<std::string, DenseLUFactor> denseLU_;
+    std::map<std::string, SparseCholeskyFactor> sparseCholesky_;
+    std::map<std::string, DiagonalPreconditioner> diagonal_;
+    std::map<std::string, MatrixEntry> matrices_;
+};
+
+/**
+ * @class FactorizationCache
+ * @brief Persistent on-disk cache of factorizations and preconditioners
+ *
+ * Each geometry key (see ElectrostaticSolver::geometryHash) maps to one
+ * versioned binary file in the cache directory. Files are memory-mapped on
+ * load and the returned factors point straight into the mapping, so a warm
+ * start costs a page-table setup instead of a refactorization; pages are read
+ * on demand by the first solves.
+ *
+ * File layout (native endianness, all arrays 64-byte aligned):
+ * - Header: magic "SCHRFACT", format version, endianness tag, key, section count
+ * - Section table: name, kind, dimensions, payload offset and size
+ * - Payloads: raw int32/double arrays of each object
+ *
+ * Files with another format version, key or endianness are treated as a miss,
+ * and so are files whose index arrays fail validation (column pointers not
+ * monotone or not ending at nnz, row indices out of range, permutations with
+ * repeats). Validation reads the int32 index arrays once on load; the values
+ * are still paged in by the first solves.
+ */
+class FactorizationCache {
+public:
+    static constexpr std::uint32_t FORMAT_VERSION = 1;
+
+    /**
+     * @brief Open a cache rooted at a directory (created on first store)
+     * @param directory Cache directory path
+     */
+    explicit FactorizationCache(const std::string& directory);
+
+    /**
+     * @brief Path of the cache file for a key
+     */
+    std::string pathFor(std::uint64_t key) const;
+
+    /**
+     * @brief Check whether a file exists for a key (without validating it)
+     */
+    bool contains(std::uint64_t key) const;
+
+    /**
+     * @brief Write a bundle for a key, replacing any previous file atomically
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void store(std::uint64_t key, const FactorizationBundle& bundle) const;
+
+    /**
+     * @brief Add objects to the file stored for a key, keeping its other entries
+     *
+     * Loads the current file (a miss or incompatible file counts as empty),
+     * merges the additions over it and stores the result. Use this rather
+     * than store() when several users (daemon, C API, multigrid setup) keep
+     * objects under the same key. An exclusive lock on a per-key ".lock" file
+     * is held across the load-merge-store, so concurrent updaters in other
+     * threads or processes do not drop each other's entries.
+     *
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void update(std::uint64_t key, const FactorizationBundle& additions) const;
+
+    /**
+     * @brief Memory-map the bundle stored for a key
+     * @param key Geometry key
+     * @param bundle Output: objects viewing the mapped file
+     * @return True on a valid hit, false on a miss or incompatible file
+     */
+    bool load(std::uint64_t key, FactorizationBundle& bundle) const;
+
+    /**
+     * @brief Delete the file stored for a key
+     * @return True if a file was removed
+     */
+    bool remove(std::uint64_t key) const;
+
+    /**
+     * @brief Write a bundle to an explicit file path
+     */
+    static void writeFile(const std::string& path, std::uint64_t key, const FactorizationBundle& bundle);
+
+    /**
+     * @brief Memory-map a bundle from an explicit file path
+     */
+    static bool readFile(const std::string& path, std::uint64_t key, FactorizationBundle& bundle);
+
+private:
+    std::string directory_;
+};
+
+#endif // FACTORIZATION_CACHE_H
@@ -0,0 +1,220 @@
+#include "FieldResult.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+FieldResult::FieldResult(const MatrixXd& phi_field, double dx, double dy, double epsilon)
+    : phi_(phi_field), dx_(dx), dy_(dy), epsilon_(epsilon) {}
+
+FieldResult::FieldResult(MatrixXd&& phi_field, double dx, double dy, double epsilon)
+    : phi_(std::move(phi_field)), dx_(dx), dy_(dy), epsilon_(epsilon) {}
+
+FieldResult::Cache& FieldResult::cache(Component component) {
+    return caches_[static_cast<int>(component)];
+}
+
+bool FieldResult::isCached(Component component) const {
+    return caches_[static_cast<int>(component)].fullValid;
+}
+
+void FieldResult::checkPoint(int i, int j) const {
+    if (i < 0 || i >= nx() || j < 0 || j >= ny()) {
+        throw std::out_of_range("Grid point outside of the potential field");
+    }
+}
+
+double FieldResult::evaluate(Component component, int i, int j) {
+    ++evaluations_;
+
+    // Same convention as computeElectricField: no field on the grid boundary
+    if (i == 0 || i == nx() - 1 || j == 0 || j == ny() - 1) {
+        return 0.0;
+    }
+
+    double ex = -(phi_(j, i + 1) - phi_(j, i - 1)) / (2.0 * dx_);
+    double ey = -(phi_(j + 1, i) - phi_(j - 1, i)) / (2.0 * dy_);
+
+    switch (component) {
+        case Component::Ex:
+            return ex;
+        case Component::Ey:
+            return ey;
+        case Component::Magnitude:
+            return std::sqrt(ex * ex + ey * ey);
+        case Component::EnergyDensity:
+            return 0.5 * epsilon_ * (ex * ex + ey * ey);
+    }
+    return 0.0;
+}
+
+double FieldResult::lookup(Component component, int i, int j) {
+    Cache& c = cache(component);
+    if (c.fullValid) {
+        return c.full(j, i);
+    }
+
+    int key = j * nx() + i;
+    auto it = c.points.find(key);
+    if (it != c.points.end()) {
+        return it->second;
+    }
+
+    double value = evaluate(component, i, j);
+    c.points.emplace(key, value);
+    return value;
+}
+
+const FieldResult::MatrixXd& FieldResult::field(Component component) {
+    Cache& c = cache(component);
+    if (c.fullValid) {
+        return c.full;
+    }
+
+    int nx_ = nx();
+    int ny_ = ny();
+    c.full = MatrixXd::Zero(ny_, nx_);
+
+    if (nx_ > 2 && ny_ > 2) {
+        int ni = nx_ - 2;
+        int nj = ny_ - 2;
+
+        // Interior gradients, from the component caches when they are full;
+        // the derived components do not fill (or count) Ex/Ey themselves
+        auto gradientX = [&]() -> MatrixXd {
+            if (isCached(Component::Ex)) {
+                return cache(Component::Ex).full.block(1, 1, nj, ni);
+            }
+            return -(phi_.block(1, 2, nj, ni) - phi_.block(1, 0, nj, ni)) / (2.0 * dx_);
+        };
+        auto gradientY = [&]() -> MatrixXd {
+            if (isCached(Component::Ey)) {
+                return cache(Component::Ey).full.block(1, 1, nj, ni);
+            }
+            return -(phi_.block(2, 1, nj, ni) - phi_.block(0, 1, nj, ni)) / (2.0 * dy_);
+        };
+
+        switch (component) {
+            case Component::Ex:
+                c.full.block(1, 1, nj, ni) = gradientX();
+                break;
+            case Component::Ey:
+                c.full.block(1, 1, nj, ni) = gradientY();
+                break;
+            case Component::Magnitude:
+                c.full.block(1, 1, nj, ni) = (gradientX().array().square() + gradientY().array().square()).sqrt();
+                break;
+            case Component::EnergyDensity:
+                c.full.block(1, 1, nj, ni) =
+                    0.5 * epsilon_ * (gradientX().array().square() + gradientY().array().square());
+                break;
+        }
+        evaluations_ += static_cast<long long>(ni) * nj;
+    }
+
+    // The full grid supersedes partial caches
+    c.fullValid = true;
+    c.points.clear();
+    c.regions.clear();
+    c.regionIndex.clear();
+    return c.full;
+}
+
+double FieldResult::integral(Component component, const ReductionOptions& options) {
+    return Reduction::integral(field(component), dx_, dy_, options);
+}
+
+FieldResult::MatrixXd FieldResult::region(Component component, int i0, int j0, int cols, int rows) {
+    if (cols <= 0 || rows <= 0) {
+        throw std::invalid_argument("Region must have positive size");
+    }
+    checkPoint(i0, j0);
+    checkPoint(i0 + cols - 1, j0 + rows - 1);
+
+    Cache& c = cache(component);
+    if (c.fullValid) {
+        return c.full.block(j0, i0, rows, cols);
+    }
+
+    RegionKey key = std::make_tuple(i0, j0, cols, rows);
+    auto it = c.regionIndex.find(key);
+    if (it != c.regionIndex.end()) {
+        c.regions.splice(c.regions.begin(), c.regions, it->second);
+        return it->second->second;
+    }
+
+    MatrixXd block(rows, cols);
+    for (int j = 0; j < rows; ++j) {
+        for (int i = 0; i < cols; ++i) {
+            auto p = c.points.find((j0 + j) * nx() + (i0 + i));
+            block(j, i) = (p != c.points.end()) ? p->second : evaluate(component, i0 + i, j0 + j);
+        }
+    }
+
+    // Least recently used regions are dropped once the cache is full
+    c.regions.emplace_front(key, block);
+    c.regionIndex.emplace(key, c.regions.begin());
+    if (c.regions.size() > kMaxCachedRegions) {
+        c.regionIndex.erase(c.regions.back().first);
+        c.regions.pop_back();
+    }
+    return block;
+}
+
+double FieldResult::at(Component component, int i, int j) {
+    checkPoint(i, j);
+    return lookup(component, i, j);
+}
+
+std::vector<double> FieldResult::atPoints(
+    Component component,
+    const std::vector<std::pair<int, int>>& points) {
+
+    std::vector<double> values;
+    values.reserve(points.size());
+
+    for (const auto& p : points) {
+        checkPoint(p.first, p.second);
+        values.push_back(lookup(component, p.first, p.second));
+    }
+
+    return values;
+}
+
+std::vector<double> FieldResult::sample(
+    Component component,
+    const std::vector<double>& x,
+    const std::vector<double>& y) {
+
+    if (x.size() != y.size()) {
+        throw std::invalid_argument("Coordinate arrays must have the same length");
+    }
+
+    std::vector<double> values;
+    values.reserve(x.size());
+
+    for (size_t k = 0; k < x.size(); ++k) {
+        double fi = x[k] / dx_;
+        double fj = y[k] / dy_;
+        if (fi < 0.0 || fj < 0.0 || fi > nx() - 1 || fj > ny() - 1) {
+            throw std::out_of_range("Sample point outside of the grid domain");
+        }
+
+        int i = std::min(static_cast<int>(fi), std::max(nx() - 2, 0));
+        int j = std::min(static_cast<int>(fj), std::max(ny() - 2, 0));
+        double tx = fi - i;
+        double ty = fj - j;
+
+        int i1 = std::min(i + 1, nx() - 1);
+        int j1 = std::min(j + 1, ny() - 1);
+
+        double v00 = lookup(component, i, j);
+        double v10 = lookup(component, i1, j);
+        double v01 = lookup(component, i, j1);
+        double v11 = lookup(component, i1, j1);
+
+        values.push_back((1.0 - ty) * ((1.0 - tx) * v00 + tx * v10) +
+                         ty * ((1.0 - tx) * v01 + tx * v11));
+    }
+
+    return values;
+}
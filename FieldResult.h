@@ -0,0 +1,190 @@
+#ifndef FIELD_RESULT_H
+#define FIELD_RESULT_H
+
+#include "Reduction.h"
+#include <Eigen/Dense>
+#include <array>
+#include <cstddef>
+#include <list>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @class FieldResult
+ * @brief Potential solution with lazily evaluated derived fields
+ *
+ * Wraps a solved 2D potential field φ and computes derived quantities only
+ * when they are requested:
+ * - Ex = -∂φ/∂x, Ey = -∂φ/∂y (central differences)
+ * - |E| = sqrt(Ex² + Ey²)
+ * - u = (1/2) * ε * E²
+ *
+ * Each quantity can be requested for the full grid, for a rectangular region
+ * or for a list of points. Results are cached, so repeated access is free and
+ * point or region queries never trigger a full-grid pass. Region blocks are
+ * kept in a bounded least-recently-used cache. Boundary grid points follow
+ * ElectrostaticSolver::computeElectricField and evaluate to zero.
+ *
+ * Not thread-safe: caches are filled on first access.
+ */
+class FieldResult {
+public:
+    using MatrixXd = Eigen::MatrixXd;
+
+    /**
+     * @brief Derived quantities available from a FieldResult
+     */
+    enum class Component {
+        Ex,
+        Ey,
+        Magnitude,
+        EnergyDensity
+    };
+
+    /**
+     * @brief Construct from a 2D potential field
+     *
+     * @param phi_field 2D potential field (ny x nx)
+     * @param dx Grid spacing in x-direction
+     * @param dy Grid spacing in y-direction
+     * @param epsilon Permittivity used for the energy density
+     */
+    FieldResult(const MatrixXd& phi_field, double dx, double dy, double epsilon);
+
+    /**
+     * @brief Construct by taking ownership of a 2D potential field
+     */
+    FieldResult(MatrixXd&& phi_field, double dx, double dy, double epsilon);
+
+    int nx() const { return static_cast<int>(phi_.cols()); }
+    int ny() const { return static_cast<int>(phi_.rows()); }
+    double dx() const { return dx_; }
+    double dy() const { return dy_; }
+    double epsilon() const { return epsilon_; }
+
+    /**
+     * @brief Potential field φ (ny x nx)
+     */
+    const MatrixXd& potential() const { return phi_; }
+
+    /**
+     * @brief Full-grid derived field, computed on first access
+     *
+     * @param component Quantity to return
+     * @return Field (ny x nx), cached for later calls
+     */
+    const MatrixXd& field(Component component);
+
+    const MatrixXd& Ex() { return field(Component::Ex); }
+    const MatrixXd& Ey() { return field(Component::Ey); }
+    const MatrixXd& fieldMagnitude() { return field(Component::Magnitude); }
+    const MatrixXd& energyDensity() { return field(Component::EnergyDensity); }
+
+    /**
+     * @brief Integral of a component over the grid, Σ value·dx·dy
+     *
+     * E.g. the total energy per unit depth for Component::EnergyDensity.
+     * The deterministic default gives the same bits for any thread count.
+     */
+    double integral(Component component, const ReductionOptions& options = ReductionOptions());
+
+    /**
+     * @brief Derived field over a rectangular region of the grid
+     *
+     * Only the requested cells are evaluated unless the full grid is already
+     * cached, in which case the block is copied from it.
+     *
+     * @param component Quantity to return
+     * @param i0 First x-index of the region
+     * @param j0 First y-index of the region
+     * @param cols Number of points in x
+     * @param rows Number of points in y
+     * @return Field block (rows x cols)
+     */
+    MatrixXd region(Component component, int i0, int j0, int cols, int rows);
+
+    /**
+     * @brief Derived field at a single grid point
+     *
+     * @param component Quantity to return
+     * @param i x-grid index
+     * @param j y-grid index
+     * @return Field value at (i, j)
+     */
+    double at(Component component, int i, int j);
+
+    /**
+     * @brief Derived field at a batch of grid points
+     *
+     * @param component Quantity to return
+     * @param points List of {i, j} grid indices
+     * @return Field value at each point, in input order
+     */
+    std::vector<double> atPoints(
+        Component component,
+        const std::vector<std::pair<int, int>>& points
+    );
+
+    /**
+     * @brief Derived field at physical coordinates using bilinear interpolation
+     *
+     * Only the (up to) four surrounding grid points of each query are evaluated.
+     *
+     * @param component Quantity to return
+     * @param x x-coordinates (m), measured from grid point (0, 0)
+     * @param y y-coordinates (m), same length as x
+     * @return Interpolated field value at each coordinate
+     */
+    std::vector<double> sample(
+        Component component,
+        const std::vector<double>& x,
+        const std::vector<double>& y
+    );
+
+    /**
+     * @brief Check whether the full grid of a component is cached
+     */
+    bool isCached(Component component) const;
+
+    /**
+     * @brief Number of region blocks kept per component (least recently used dropped first)
+     */
+    static constexpr std::size_t kMaxCachedRegions = 32;
+
+    /**
+     * @brief Number of grid-point evaluations performed so far (all components)
+     *
+     * A full-grid pass counts its interior points once, also for |E| and u
+     * which are derived from both gradient components.
+     */
+    long long evaluationCount() const { return evaluations_; }
+
+private:
+    using RegionKey = std::tuple<int, int, int, int>;
+    using RegionList = std::list<std::pair<RegionKey, MatrixXd>>;
+
+    struct Cache {
+        MatrixXd full;
+        bool fullValid = false;
+        std::unordered_map<int, double> points;
+        RegionList regions;  // most recently used first
+        std::map<RegionKey, RegionList::iterator> regionIndex;
+    };
+
+    double evaluate(Component component, int i, int j);
+    double lookup(Component component, int i, int j);
+    void checkPoint(int i, int j) const;
+    Cache& cache(Component component);
+
+    MatrixXd phi_;
+    double dx_;
+    double dy_;
+    double epsilon_;
+    long long evaluations_ = 0;
+    std::array<Cache, 4> caches_;
+};
+
+#endif // FIELD_RESULT_H
@@ -0,0 +1,309 @@
+#include "FrameStream.h"
+#include "FieldResult.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace FrameRing;
+
+namespace {
+
+size_t slotBytesFor(long capacity) {
+    size_t bytes = sizeof(SlotHeader) + static_cast<size_t>(FIELDS) * capacity * sizeof(double);
+    return (bytes + 63) / 64 * 64;
+}
+
+SlotHeader* slotAt(void* mapping, std::uint64_t frame) {
+    RingHeader* ring = static_cast<RingHeader*>(mapping);
+    char* base = static_cast<char*>(mapping) + ring->headerBytes;
+    return reinterpret_cast<SlotHeader*>(base + (frame % ring->slotCount) * ring->slotBytes);
+}
+
+const SlotHeader* slotAt(const void* mapping, std::uint64_t frame) {
+    return slotAt(const_cast<void*>(mapping), frame);
+}
+
+} // namespace
+
+// ========== FramePublisher ==========
+
+int FramePublisher::strideFor(int nx, int ny) const {
+    if (options_.downsample > 0) {
+        int s = options_.downsample;
+        if (static_cast<long>((nx - 1) / s + 1) * ((ny - 1) / s + 1) > options_.capacity) {
+            throw std::invalid_argument("Downsampled frame exceeds the ring slot capacity");
+        }
+        return s;
+    }
+    int s = 1;
+    while (static_cast<long>((nx - 1) / s + 1) * ((ny - 1) / s + 1) > options_.capacity) {
+        ++s;
+    }
+    return s;
+}
+
+std::uint64_t FramePublisher::publish(FieldResult& field, double time, const std::string& label) {
+    return publish(field.potential(), field.fieldMagnitude(), field.dx(), field.dy(), time, label);
+}
+
+#ifndef _WIN32
+
+FramePublisher::FramePublisher(const FramePublisherOptions& options)
+    : options_(options) {
+
+    if (options_.slots < 1 || options_.capacity < 1) {
+        throw std::invalid_argument("Frame ring needs at least one slot and a positive capacity");
+    }
+    size_t slotBytes = slotBytesFor(options_.capacity);
+    bytes_ = sizeof(RingHeader) + slotBytes * options_.slots;
+
+    // Never take over a live ring by accident; a stale one is removed on request
+    if (options_.replace) {
+        ::shm_unlink(options_.name.c_str());
+    }
+    int fd = ::shm_open(options_.name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0 && errno == EEXIST) {
+        throw std::runtime_error("Frame ring " + options_.name +
+                                 " already exists (another publisher, or left by a crashed run; "
+                                 "set FramePublisherOptions::replace to remove it)");
+    }
+    if (fd < 0 || ::ftruncate(fd, static_cast<off_t>(bytes_)) != 0) {
+        std::string error = std::strerror(errno);
+        if (fd >= 0) {
+            ::close(fd);
+            ::shm_unlink(options_.name.c_str());
+        }
+        throw std::runtime_error("Cannot create frame ring " + options_.name + ": " + error);
+    }
+    mapping_ = ::mmap(nullptr, bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping_ == MAP_FAILED) {
+        mapping_ = nullptr;
+        ::shm_unlink(options_.name.c_str());
+        throw std::runtime_error("Cannot map frame ring " + options_.name);
+    }
+
+    // ftruncate zero-fills: all sequences start even (empty slots)
+    RingHeader* ring = static_cast<RingHeader*>(mapping_);
+    ring->version = VERSION;
+    ring->slotCount = static_cast<std::uint32_t>(options_.slots);
+    ring->headerBytes = sizeof(RingHeader);
+    ring->slotBytes = slotBytes;
+    ring->capacity = static_cast<std::uint64_t>(options_.capacity);
+    ring->published.store(0, std::memory_order_relaxed);
+
+    // The magic goes last, so a reader never sees a half-initialized header
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(ring->magic, MAGIC, sizeof(MAGIC));
+}
+
+FramePublisher::~FramePublisher() {
+    if (mapping_) {
+        ::munmap(mapping_, bytes_);
+        ::shm_unlink(options_.name.c_str());
+    }
+}
+
+std::uint64_t FramePublisher::publish(const MatrixXd& potential, const MatrixXd& fieldMagnitude,
+                                      double dx, double dy, double time, const std::string& label) {
+    int nx = static_cast<int>(potential.cols());
+    int ny = static_cast<int>(potential.rows());
+    if (fieldMagnitude.rows() != ny || fieldMagnitude.cols() != nx) {
+        throw std::invalid_argument("Potential and field magnitude grids differ in size");
+    }
+    int stride = strideFor(nx, ny);
+    int fx = (nx - 1) / stride + 1;
+    int fy = (ny - 1) / stride + 1;
+
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    RingHeader* ring = static_cast<RingHeader*>(mapping_);
+    std::uint64_t frame = ring->published.load(std::memory_order_relaxed);
+    SlotHeader* slot = slotAt(mapping_, frame);
+
+    // Seqlock: odd sequence before any data is touched
+    std::uint64_t sequence = slot->sequence.load(std::memory_order_relaxed);
+    slot->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot->frame = frame;
+    slot->nx = fx;
+    slot->ny = fy;
+    slot->stride = stride;
+    slot->fieldCount = FIELDS;
+    slot->dx = dx * stride;
+    slot->dy = dy * stride;
+    slot->time = time;
+    slot->phiMin = potential.minCoeff();
+    slot->phiMax = potential.maxCoeff();
+    slot->fieldMax = fieldMagnitude.maxCoeff();
+    std::memset(slot->label, 0, sizeof(slot->label));
+    std::strncpy(slot->label, label.c_str(), sizeof(slot->label) - 1);
+
+    double* data = reinterpret_cast<double*>(slot + 1);
+    size_t points = static_cast<size_t>(fx) * fy;
+    for (int j = 0; j < fy; ++j) {
+        for (int i = 0; i < fx; ++i) {
+            data[i + static_cast<size_t>(j) * fx] = potential(j * stride, i * stride);
+            data[points + i + static_cast<size_t>(j) * fx] = fieldMagnitude(j * stride, i * stride);
+        }
+    }
+
+    slot->sequence.store(sequence + 2, std::memory_order_release);
+    ring->published.store(frame + 1, std::memory_order_release);
+    return frame;
+}
+
+std::uint64_t FramePublisher::published() const {
+    return static_cast<const RingHeader*>(mapping_)->published.load(std::memory_order_acquire);
+}
+
+// ========== FrameSubscriber ==========
+
+FrameSubscriber::FrameSubscriber(const std::string& name) {
+    int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open frame ring " + name + ": " + std::strerror(errno));
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(RingHeader)) {
+        ::close(fd);
+        throw std::runtime_error("Frame ring " + name + " is not initialized");
+    }
+    bytes_ = static_cast<size_t>(info.st_size);
+    void* mapped = ::mmap(nullptr, bytes_, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        throw std::runtime_error("Cannot map frame ring " + name);
+    }
+    mapping_ = mapped;
+
+    const RingHeader* ring = static_cast<const RingHeader*>(mapping_);
+    bool valid = std::memcmp(ring->magic, MAGIC, sizeof(MAGIC)) == 0;
+    // Pairs with the publisher's release fence: the magic is read first, the rest after
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (!valid || ring->version != VERSION ||
+        ring->headerBytes + static_cast<size_t>(ring->slotCount) * ring->slotBytes > bytes_) {
+        ::munmap(const_cast<void*>(mapping_), bytes_);
+        mapping_ = nullptr;
+        throw std::runtime_error("Frame ring " + name + " has an unknown layout");
+    }
+}
+
+FrameSubscriber::~FrameSubscriber() {
+    if (mapping_) {
+        ::munmap(const_cast<void*>(mapping_), bytes_);
+    }
+}
+
+std::uint64_t FrameSubscriber::published() const {
+    return static_cast<const RingHeader*>(mapping_)->published.load(std::memory_order_acquire);
+}
+
+bool FrameSubscriber::read(std::uint64_t frameNumber, StreamFrame& frame, int maxAttempts) {
+    const RingHeader* ring = static_cast<const RingHeader*>(mapping_);
+    const SlotHeader* slot = slotAt(mapping_, frameNumber);
+
+    for (int attempt = 0; attempt < maxAttempts; ++attempt) {
+        if (frameNumber >= published()) {
+            return false;
+        }
+        std::uint64_t before = slot->sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            ++retries_;
+            continue;
+        }
+
+        frame.frame = slot->frame;
+        frame.nx = slot->nx;
+        frame.ny = slot->ny;
+        frame.stride = slot->stride;
+        frame.dx = slot->dx;
+        frame.dy = slot->dy;
+        frame.time = slot->time;
+        frame.phiMin = slot->phiMin;
+        frame.phiMax = slot->phiMax;
+        frame.fieldMax = slot->fieldMax;
+        char label[sizeof(slot->label)];
+        std::memcpy(label, slot->label, sizeof(label));
+        label[sizeof(label) - 1] = '\0';
+
+        size_t points = static_cast<size_t>(std::max(0, frame.nx)) * std::max(0, frame.ny);
+        bool fits = points <= ring->capacity;
+        if (fits) {
+            const double* data = reinterpret_cast<const double*>(slot + 1);
+            frame.potential.assign(data, data + points);
+            frame.fieldMagnitude.assign(data + points, data + 2 * points);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot->sequence.load(std::memory_order_relaxed) != before || !fits) {
+            ++retries_;
+            continue;
+        }
+        if (frame.frame != frameNumber) {
+            return false;   // Overwritten by a newer frame
+        }
+        frame.label = label;
+        return true;
+    }
+    return false;
+}
+
+bool FrameSubscriber::latest(StreamFrame& frame, int maxAttempts) {
+    for (int attempt = 0; attempt < maxAttempts; ++attempt) {
+        std::uint64_t count = published();
+        if (count == 0) {
+            return false;
+        }
+        if (read(count - 1, frame, 1)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+#else
+
+FramePublisher::FramePublisher(const FramePublisherOptions& options)
+    : options_(options) {
+    throw std::runtime_error("FramePublisher requires POSIX shared memory");
+}
+
+FramePublisher::~FramePublisher() = default;
+
+std::uint64_t FramePublisher::publish(const MatrixXd&, const MatrixXd&, double, double, double, const std::string&) {
+    throw std::runtime_error("FramePublisher requires POSIX shared memory");
+}
+
+std::uint64_t FramePublisher::published() const {
+    return 0;
+}
+
+FrameSubscriber::FrameSubscriber(const std::string&) {
+    throw std::runtime_error("FrameSubscriber requires POSIX shared memory");
+}
+
+FrameSubscriber::~FrameSubscriber() = default;
+
+std::uint64_t FrameSubscriber::published() const {
+    return 0;
+}
+
+bool FrameSubscriber::read(std::uint64_t, StreamFrame&, int) {
+    return false;
+}
+
+bool FrameSubscriber::latest(StreamFrame&, int) {
+    return false;
+}
+
+#endif
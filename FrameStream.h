@@ -0,0 +1,185 @@
+#ifndef FRAME_STREAM_H
+#define FRAME_STREAM_H
+
+#include <Eigen/Dense>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class FieldResult;
+
+// ========== Shared-Memory Layout ==========
+//
+// One POSIX shared-memory object holds a RingHeader followed by slotCount
+// slots of slotBytes each. A slot is a SlotHeader followed by the frame data:
+// potential[nx*ny] then |E|[nx*ny] as doubles, x fastest (index i + j*nx).
+// All fields are native-endian; readers on the same machine map the object
+// read-only (see FrameSubscriber and frame_reader.py).
+//
+// Every slot is a seqlock: the writer makes `sequence` odd, writes the slot
+// and makes it even again. A reader copies the slot and accepts the copy only
+// if `sequence` was even and unchanged across the copy. `published` counts
+// finished frames; frame k lives in slot k % slotCount.
+
+namespace FrameRing {
+
+constexpr char MAGIC[4] = {'S', 'C', 'R', 'B'};
+constexpr std::uint32_t VERSION = 1;
+constexpr int FIELDS = 2;   // Potential, |E|
+
+struct RingHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t slotCount;
+    std::uint32_t headerBytes;              // sizeof(RingHeader), offset of slot 0
+    std::uint64_t slotBytes;                // SlotHeader + data, multiple of 64
+    std::uint64_t capacity;                 // Max grid points per frame
+    std::atomic<std::uint64_t> published;   // Frames completed
+    std::uint64_t reserved[3];
+};
+static_assert(sizeof(RingHeader) == 64, "RingHeader layout");
+
+struct SlotHeader {
+    std::atomic<std::uint64_t> sequence;    // Odd while the slot is written
+    std::uint64_t frame;                    // Frame number (0-based)
+    std::int32_t nx;                        // Frame grid after downsampling
+    std::int32_t ny;
+    std::int32_t stride;                    // Downsampling factor
+    std::int32_t fieldCount;                // FIELDS
+    double dx;                              // Frame grid spacing (m)
+    double dy;
+    double time;                            // Caller-defined (time, step, sweep index)
+    double phiMin;                          // Of the full-resolution frame
+    double phiMax;
+    double fieldMax;
+    char label[48];                         // NUL-terminated
+};
+static_assert(sizeof(SlotHeader) == 128, "SlotHeader layout");
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "Shared-memory atomics must be lock-free");
+
+} // namespace FrameRing
+
+/**
+ * @brief Settings of a FramePublisher
+ */
+struct FramePublisherOptions {
+    std::string name = "/electrostatics_frames";    // POSIX shared-memory name
+    int slots = 8;
+    long capacity = 513 * 513;      // Max grid points per published frame
+    int downsample = 0;             // Keep every k-th point; 0: smallest k that fits capacity
+    bool replace = false;           // Remove an existing object of the same name first
+};
+
+/**
+ * @brief One frame copied out of the ring
+ */
+struct StreamFrame {
+    std::uint64_t frame = 0;
+    int nx = 0;
+    int ny = 0;
+    int stride = 1;
+    double dx = 0.0;
+    double dy = 0.0;
+    double time = 0.0;
+    double phiMin = 0.0;
+    double phiMax = 0.0;
+    double fieldMax = 0.0;
+    std::string label;
+    std::vector<double> potential;      // nx*ny, x fastest
+    std::vector<double> fieldMagnitude;
+};
+
+/**
+ * @class FramePublisher
+ * @brief Streams solution frames into a shared-memory ring buffer
+ *
+ * Creates the shared-memory object and, as its owner, removes it on
+ * destruction. An existing object of the same name (another publisher, or one
+ * left by a crashed run) is an error unless FramePublisherOptions::replace is
+ * set. Publishing never blocks on readers: slow readers skip frames.
+ * publish() may be called from several threads; writers are serialized.
+ * POSIX only; the constructor throws on Windows.
+ */
+class FramePublisher {
+public:
+    using MatrixXd = Eigen::MatrixXd;
+
+    /**
+     * @throws std::runtime_error if the object exists and replace is not set,
+     *         or if it cannot be created or mapped
+     */
+    explicit FramePublisher(const FramePublisherOptions& options = FramePublisherOptions());
+    ~FramePublisher();
+
+    FramePublisher(const FramePublisher&) = delete;
+    FramePublisher& operator=(const FramePublisher&) = delete;
+
+    /**
+     * @brief Publish the potential and |E| of a field
+     * @return Frame number
+     */
+    std::uint64_t publish(FieldResult& field, double time = 0.0, const std::string& label = "");
+
+    /**
+     * @brief Publish (ny x nx) potential and field magnitude grids
+     * @return Frame number
+     */
+    std::uint64_t publish(const MatrixXd& potential, const MatrixXd& fieldMagnitude,
+                          double dx, double dy, double time = 0.0, const std::string& label = "");
+
+    std::uint64_t published() const;
+    const std::string& name() const { return options_.name; }
+
+    /**
+     * @brief Downsampling factor used for an nx x ny grid
+     */
+    int strideFor(int nx, int ny) const;
+
+private:
+    FramePublisherOptions options_;
+    std::mutex writeMutex_;
+    void* mapping_ = nullptr;
+    size_t bytes_ = 0;
+};
+
+/**
+ * @class FrameSubscriber
+ * @brief Read-only view of a FramePublisher ring (same machine)
+ */
+class FrameSubscriber {
+public:
+    explicit FrameSubscriber(const std::string& name);
+    ~FrameSubscriber();
+
+    FrameSubscriber(const FrameSubscriber&) = delete;
+    FrameSubscriber& operator=(const FrameSubscriber&) = delete;
+
+    /**
+     * @brief Copy the newest complete frame
+     * @return false if nothing was published yet or no consistent copy was
+     *         obtained within maxAttempts
+     */
+    bool latest(StreamFrame& frame, int maxAttempts = 1000);
+
+    /**
+     * @brief Copy a specific frame
+     * @return false if it is not published yet or already overwritten
+     */
+    bool read(std::uint64_t frameNumber, StreamFrame& frame, int maxAttempts = 1000);
+
+    std::uint64_t published() const;
+
+    /**
+     * @brief Copies discarded because a writer changed the slot meanwhile
+     */
+    std::uint64_t retries() const { return retries_; }
+
+private:
+    const void* mapping_ = nullptr;
+    size_t bytes_ = 0;
+    std::uint64_t retries_ = 0;
+};
+
+#endif // FRAME_STREAM_H
@@ -0,0 +1,330 @@
+#include "Graph.h"
+#include "ParallelFor.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace {
+
+/// Uniform [0, 1) from (seed, edge, attempt) only
+double uniform(std::uint64_t seed, std::int64_t edge, int attempt) {
+    std::uint64_t bits = splitMix64(splitMix64(seed + 0xD1B54A32D192ED03ull * static_cast<std::uint64_t>(edge)) +
+                             static_cast<std::uint64_t>(attempt));
+    return static_cast<double>(bits >> 11) * 0x1.0p-53;
+}
+
+/// Rewired target of an edge leaving u: uniform over the vertices other than u
+int rewiredTarget(std::uint64_t seed, std::int64_t edge, int& attempt, int u, int nodes) {
+    int w;
+    do {
+        w = std::min(nodes - 1, static_cast<int>(uniform(seed, edge, attempt) * nodes));
+        ++attempt;
+    } while (w == u);
+    return w;
+}
+
+} // namespace
+
+Graph Graph::fromEdges(int nodes, const std::vector<int>& from, const std::vector<int>& to, int threads) {
+    if (nodes < 0 || from.size() != to.size()) {
+        throw std::invalid_argument("Edge lists must have the same length");
+    }
+    threads = resolveThreads(threads);
+    long m = static_cast<long>(from.size());
+    for (long e = 0; e < m; ++e) {
+        if (from[e] < 0 || from[e] >= nodes || to[e] < 0 || to[e] >= nodes) {
+            throw std::invalid_argument("Edge " + std::to_string(e) + " has an endpoint outside 0.." +
+                                        std::to_string(nodes - 1));
+        }
+    }
+
+    // Each thread owns a vertex range. One counting pass over contiguous edge
+    // chunks buckets the directed entries by owner, so every entry is handled
+    // a constant number of times; buckets list chunk 0, 1, ... in turn, which
+    // keeps edge order without atomics
+    std::vector<int> low(static_cast<size_t>(threads) + 1);
+    for (int t = 0; t <= threads; ++t) {
+        low[t] = static_cast<int>(static_cast<long>(nodes) * t / threads);
+    }
+    auto owner = [&](int u) {
+        return static_cast<int>(std::upper_bound(low.begin(), low.end(), u) - low.begin()) - 1;
+    };
+    auto chunks = [&](auto entry) {
+        parallelFor(threads, threads, [&](long c, long) {
+            for (long e = m * c / threads; e < m * (c + 1) / threads; ++e) {
+                int u = from[e];
+                int v = to[e];
+                if (u != v) {
+                    entry(c, u, v);
+                    entry(c, v, u);
+                }
+            }
+        });
+    };
+
+    // position[c·threads + t]: next slot of chunk c in the bucket of thread t
+    std::vector<std::int64_t> position(static_cast<size_t>(threads) * threads, 0);
+    chunks([&](long c, int u, int) { ++position[c * threads + owner(u)]; });
+    std::vector<std::int64_t> bucket(static_cast<size_t>(threads) + 1, 0);
+    for (int t = 0; t < threads; ++t) {
+        std::int64_t next = bucket[t];
+        for (int c = 0; c < threads; ++c) {
+            std::int64_t count = position[static_cast<size_t>(c) * threads + t];
+            position[static_cast<size_t>(c) * threads + t] = next;
+            next += count;
+        }
+        bucket[t + 1] = next;
+    }
+    std::vector<std::pair<int, int>> entries(static_cast<size_t>(bucket[threads]));
+    chunks([&](long c, int u, int v) { entries[position[c * threads + owner(u)]++] = {u, v}; });
+    position.clear();
+    position.shrink_to_fit();
+
+    std::vector<std::int64_t> offsets(static_cast<size_t>(nodes) + 1, 0);
+    auto owned = [&](auto entry) {
+        parallelFor(threads, threads, [&](long t, long) {
+            for (std::int64_t k = bucket[t]; k < bucket[t + 1]; ++k) {
+                entry(entries[k].first, entries[k].second);
+            }
+        });
+    };
+    owned([&](int u, int) { ++offsets[u + 1]; });
+    for (int v = 0; v < nodes; ++v) {
+        offsets[v + 1] += offsets[v];
+    }
+    std::vector<int> targets(static_cast<size_t>(offsets[nodes]));
+    std::vector<std::int64_t> cursor(offsets.begin(), offsets.end() - 1);
+    owned([&](int u, int v) { targets[cursor[u]++] = v; });
+    cursor.clear();
+    cursor.shrink_to_fit();
+    entries.clear();
+    entries.shrink_to_fit();
+
+    // Sort each list and drop duplicates
+    std::vector<std::int64_t> unique(static_cast<size_t>(nodes) + 1, 0);
+    parallelFor(threads, nodes, [&](long begin, long end) {
+        for (long v = begin; v < end; ++v) {
+            auto first = targets.begin() + offsets[v];
+            auto last = targets.begin() + offsets[v + 1];
+            std::sort(first, last);
+            unique[v + 1] = std::unique(first, last) - first;
+        }
+    });
+
+    Graph g;
+    g.n_ = nodes;
+    for (int v = 0; v < nodes; ++v) {
+        unique[v + 1] += unique[v];
+    }
+    if (unique[nodes] == offsets[nodes]) {
+        g.offsets_ = std::move(offsets);
+        g.targets_ = std::move(targets);
+        return g;
+    }
+    g.offsets_ = std::move(unique);
+    g.targets_.resize(static_cast<size_t>(g.offsets_[nodes]));
+    parallelFor(threads, nodes, [&](long begin, long end) {
+        for (long v = begin; v < end; ++v) {
+            std::copy(targets.begin() + offsets[v], targets.begin() + offsets[v] + g.degree(static_cast<int>(v)),
+                      g.targets_.begin() + g.offsets_[v]);
+        }
+    });
+    return g;
+}
+
+Graph Graph::ringLattice(int nodes, int k, int threads) {
+    return wattsStrogatz(nodes, k, 0.0, 0, threads);
+}
+
+Graph Graph::wattsStrogatz(int nodes, int k, double p, std::uint64_t seed, int threads) {
+    if (nodes < 0 || k < 0 || (nodes > 0 && k >= nodes)) {
+        throw std::invalid_argument("Watts-Strogatz graph needs 0 <= k < nodes");
+    }
+    if (!(p >= 0.0 && p <= 1.0)) {
+        throw std::invalid_argument("Rewiring probability must be in [0, 1]");
+    }
+    threads = resolveThreads(threads);
+    int half = k / 2;
+    if (2 * half >= nodes - 1) {
+        p = 0.0;    // Complete graph: nothing to rewire to
+    }
+
+    // Edge e = u·half + j - 1 joins u to u + j, or to a random w if rewired.
+    // Rewired targets are stored as ~w (< 0) so one load tells both;
+    // attempt[e] is the next draw index of a rewired edge.
+    long m = static_cast<long>(nodes) * half;
+    std::vector<int> to(static_cast<size_t>(m));
+    std::vector<int> attempt(static_cast<size_t>(m), 0);
+    parallelFor(threads, nodes, [&](long begin, long end) {
+        for (long u = begin; u < end; ++u) {
+            for (int j = 1; j <= half; ++j) {
+                long e = u * half + j - 1;
+                if (p > 0.0 && uniform(seed, e, 0) < p) {
+                    attempt[e] = 1;
+                    to[e] = ~rewiredTarget(seed, e, attempt[e], static_cast<int>(u), nodes);
+                } else {
+                    to[e] = static_cast<int>((u + j) % nodes);
+                }
+            }
+        }
+    });
+    auto source = [half](long e) { return static_cast<int>(e / half); };
+    auto target = [&](long e) { return to[e] < 0 ? ~to[e] : to[e]; };
+
+    // A rewired edge is a duplicate if an unrewired lattice edge or an
+    // earlier rewired edge of either endpoint joins the same pair
+    auto duplicate = [&](long e) {
+        int u = source(e);
+        int w = target(e);
+        int d = w >= u ? w - u : w - u + nodes;
+        if ((d <= half && to[static_cast<long>(u) * half + d - 1] >= 0)
+            || (nodes - d <= half && to[static_cast<long>(w) * half + nodes - d - 1] >= 0)) {
+            return true;
+        }
+        for (int j = 0; j < half; ++j) {
+            long mine = static_cast<long>(u) * half + j;
+            long theirs = static_cast<long>(w) * half + j;
+            if ((mine < e && to[mine] == ~w) || (theirs < e && to[theirs] == ~u)) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    std::vector<long> pending;
+    if (p > 0.0) {
+        std::vector<char> found(static_cast<size_t>(m), 0);
+        parallelFor(threads, m, [&](long begin, long end) {
+            for (long e = begin; e < end; ++e) {
+                found[e] = to[e] < 0 && duplicate(e);
+            }
+        });
+        for (long e = 0; e < m; ++e) {
+            if (found[e]) {
+                pending.push_back(e);
+            }
+        }
+    }
+
+    // Redraw duplicates. Only edges sharing an endpoint with a redrawn edge
+    // can become duplicates, so later rounds check just those.
+    for (int round = 0; !pending.empty(); ++round) {
+        if (round == 1000) {
+            throw std::runtime_error("Watts-Strogatz rewiring does not settle; k is too close to nodes");
+        }
+        std::vector<long> candidates;
+        for (long e : pending) {
+            to[e] = ~rewiredTarget(seed, e, attempt[e], source(e), nodes);
+            for (int end : {source(e), target(e)}) {
+                for (int j = 0; j < half; ++j) {
+                    if (to[static_cast<long>(end) * half + j] < 0) {
+                        candidates.push_back(static_cast<long>(end) * half + j);
+                    }
+                }
+            }
+        }
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+        pending.clear();
+        for (long e : candidates) {
+            if (duplicate(e)) {
+                pending.push_back(e);
+            }
+        }
+    }
+    attempt.clear();
+    attempt.shrink_to_fit();
+
+    std::vector<int> from(static_cast<size_t>(m));
+    parallelFor(threads, m, [&](long begin, long end) {
+        for (long e = begin; e < end; ++e) {
+            from[e] = source(e);
+            to[e] = target(e);
+        }
+    });
+    return fromEdges(nodes, from, to, threads);
+}
+
+Graph Graph::connectedWattsStrogatz(int nodes, int k, double p, std::uint64_t seed, int tries, int threads) {
+    for (int t = 0; t < tries; ++t) {
+        Graph g = wattsStrogatz(nodes, k, p, seed + static_cast<std::uint64_t>(t), threads);
+        if (g.connected(threads)) {
+            return g;
+        }
+    }
+    throw std::runtime_error("No connected Watts-Strogatz graph in " + std::to_string(tries) + " tries");
+}
+
+bool Graph::hasEdge(int u, int v) const {
+    Neighbors adjacent = neighbors(u);
+    return std::binary_search(adjacent.begin(), adjacent.end(), v);
+}
+
+int Graph::components(std::vector<int>* labels, int threads) const {
+    threads = resolveThreads(threads);
+
+    // Roots are always linked under the smaller root, so a root is the
+    // smallest vertex of its set
+    std::unique_ptr<std::atomic<int>[]> parent(new std::atomic<int>[n_]);
+    for (int v = 0; v < n_; ++v) {
+        parent[v].store(v, std::memory_order_relaxed);
+    }
+    auto find = [&](int x) {
+        while (true) {
+            int p = parent[x].load();
+            if (p == x) {
+                return x;
+            }
+            int grand = parent[p].load();
+            if (grand != p) {
+                parent[x].compare_exchange_weak(p, grand);  // Path halving
+            }
+            x = grand;
+        }
+    };
+    parallelFor(threads, n_, [&](long begin, long end) {
+        for (long u = begin; u < end; ++u) {
+            for (int v : neighbors(static_cast<int>(u))) {
+                if (v <= u) {
+                    continue;
+                }
+                int a = static_cast<int>(u);
+                int b = v;
+                while (true) {
+                    a = find(a);
+                    b = find(b);
+                    if (a == b) {
+                        break;
+                    }
+                    if (a < b) {
+                        std::swap(a, b);
+                    }
+                    int expected = a;
+                    if (parent[a].compare_exchange_strong(expected, b)) {
+                        break;
+                    }
+                }
+            }
+        }
+    });
+
+    int count = 0;
+    if (labels) {
+        labels->assign(n_, 0);
+    }
+    for (int v = 0; v < n_; ++v) {
+        int root = find(v);
+        if (root == v) {
+            if (labels) {
+                (*labels)[v] = count;
+            }
+            ++count;
+        } else if (labels) {
+            (*labels)[v] = (*labels)[root];
+        }
+    }
+    return count;
+}
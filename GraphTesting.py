@@ -5,13 +5,55 @@ import random
 import math
 import time
 
+try:
+    import electrostatics  # C++ module (python build.py build electrostatics)
+except ImportError:
+    electrostatics = None
+
 def generate_graph(num_nodes, num_edges):
     # Create a connected watts_strogatz graph
     G = nx.connected_watts_strogatz_graph(num_nodes, num_edges, 0.5)
     return G
 
-def calculate_average_shortest_path_length(G):
+def generate_graph_csr(num_nodes, k, p=0.5, seed=0):
+    """
+    Connected Watts-Strogatz graph in the C++ CSR graph core (electrostatics.Graph).
+
+    Reproducible for a given seed and builds 10^7-node graphs in seconds. Returns None
+    when the electrostatics module is not built.
+    """
+    if electrostatics is None:
+        return None
+    return electrostatics.Graph.connected_watts_strogatz(num_nodes, k, p, seed)
+
+def csr_to_networkx(graph):
+    """networkx copy of a CSR graph (for drawing and cross-checks on small graphs)."""
+    offsets, targets = graph.offsets, graph.targets
+    G = nx.Graph()
+    G.add_nodes_from(range(graph.node_count))
+    G.add_edges_from((u, targets[k]) for u in range(graph.node_count)
+                     for k in range(offsets[u], offsets[u + 1]) if u < targets[k])
+    return G
+
+def networkx_to_csr(G):
+    """C++ CSR graph (electrostatics.Graph) with vertices numbered in G.nodes order."""
+    index = {node: k for k, node in enumerate(G.nodes)}
+    edges = list(G.edges)
+    return electrostatics.Graph.from_edges(len(index), [index[u] for u, _ in edges], [index[v] for _, v in edges])
+
+def calculate_average_shortest_path_length(G, relative_error=None):
     # Calculate the average shortest path length of the graph
+    # (bit-parallel multi-source BFS in C++ when the electrostatics module is built;
+    # with relative_error, an estimate from sampled sources within that 95% bound)
+    if electrostatics is not None:
+        graph = G if isinstance(G, electrostatics.Graph) else networkx_to_csr(G)
+        if relative_error is not None:
+            stats = electrostatics.sampled_average_shortest_path_length(graph, relative_error)
+        else:
+            stats = electrostatics.average_shortest_path_length(graph)
+        return stats.average_distance if stats.connected else float('inf')
+    if relative_error is not None:
+        raise RuntimeError("Sampled ASPL needs the electrostatics module (python build.py build electrostatics)")
     if nx.is_connected(G):
         return nx.average_shortest_path_length(G)
     else:
@@ -20,8 +62,20 @@ def calculate_average_shortest_path_length(G):
 # Function to calculate the clustering coefficient of a graph
 def calculate_clustering_coefficient(G):
     # Calculate the clustering coefficient of the graph
+    # (degree-ordered triangle counting in C++ when the electrostatics module is built)
+    if electrostatics is not None:
+        graph = G if isinstance(G, electrostatics.Graph) else networkx_to_csr(G)
+        return electrostatics.clustering(graph).average
     return nx.average_clustering(G)
 
+def calculate_algebraic_connectivity(G):
+    # Algebraic connectivity (second-smallest Laplacian eigenvalue); Lanczos in C++
+    # when the electrostatics module is built, so 10^6-node graphs stay in reach
+    if electrostatics is not None:
+        graph = G if isinstance(G, electrostatics.Graph) else networkx_to_csr(G)
+        return electrostatics.laplacian_spectrum(graph).algebraic_connectivity
+    return nx.algebraic_connectivity(G)
+
 def time_function(func, *args, **kwargs):
     start_time = time.time()
     result = func(*args, **kwargs)
@@ -40,8 +94,11 @@ def time_function(func, *args, **kwargs):
 #nx.draw(G, node_size=40, node_color='blue', with_labels=False)
 #plt.show()
 
-def analyze_graph_properties():
-    node_counts = [10, 100, 1000, 10000]
+def analyze_graph_properties(node_counts=None, relative_error=None):
+    # With the electrostatics module the graphs stay in the C++ CSR core, so the
+    # study reaches 10^6+ nodes; relative_error switches ASPL to sampled sources
+    if node_counts is None:
+        node_counts = [10, 100, 1000, 10000]
     avg_shortest_path_lengths = []
     clustering_coefficients = []
     run_times_shortest_path = []
@@ -49,18 +106,21 @@ def analyze_graph_properties():
 
     for num_nodes in node_counts:
         # Generate a graph with a fixed average degree of 6
-        G = nx.connected_watts_strogatz_graph(num_nodes, 6, 0.5)
+        if electrostatics is not None:
+            G = generate_graph_csr(num_nodes, 6, 0.5)
+        else:
+            G = nx.connected_watts_strogatz_graph(num_nodes, 6, 0.5)
 
         # Time and calculate average shortest path length
         start_time = time.time()
-        avg_shortest_path_length = nx.average_shortest_path_length(G) if nx.is_connected(G) else float('inf')
+        avg_shortest_path_length = calculate_average_shortest_path_length(G, relative_error)
         end_time = time.time()
         run_times_shortest_path.append(end_time - start_time)
         avg_shortest_path_lengths.append(avg_shortest_path_length)
 
         # Time and calculate clustering coefficient
         start_time = time.time()
-        clustering_coefficient = nx.average_clustering(G)
+        clustering_coefficient = calculate_clustering_coefficient(G)
         end_time = time.time()
         run_times_clustering.append(end_time - start_time)
         clustering_coefficients.append(clustering_coefficient)
@@ -174,7 +234,7 @@ G.add_edge(16, 10, resistance=22)  # Connect mesh to main graph
 
 G_tree = nx.minimum_spanning_tree(G)  # Create a minimum spanning tree from G
 
-# Function to calculate equivalent resistance between two nodes
+# Resistance of the single lowest-resistance path; an upper bound on the equivalent resistance
 def calculate_path_resistance(G, node1, node2):
     try:
         # Use Dijkstra's algorithm to find the shortest path based on resistance
@@ -189,6 +249,8 @@ def calculate_y_parameters(G):
     nodes = list(G.nodes)
     n = len(nodes)
     
+    index = {node: k for k, node in enumerate(nodes)}
+    
     # Initialize the admittance matrix
     Y = np.zeros((n, n), dtype=float)
     
@@ -198,8 +260,8 @@ def calculate_y_parameters(G):
         admittance = 1 / resistance  # Convert resistance to admittance
         
         # Get the indices of the nodes
-        i = nodes.index(u)
-        j = nodes.index(v)
+        i = index[u]
+        j = index[v]
         
         # Update the matrix
         Y[i, i] += admittance  # Self-admittance for node u
@@ -210,34 +272,63 @@ def calculate_y_parameters(G):
     return Y, nodes
 
 def calculate_equivalent_resistance_from_y(G, node1, node2):
-    # Calculate the Y-parameters
-    Y, nodes = calculate_y_parameters(G)
-    
-    # Get the indices of the nodes
-    i = nodes.index(node1)
-    j = nodes.index(node2)
-    
-    # Calculate the equivalent resistance
-    Y_eq = Y[i, i] + Y[j, j] - 2 * Y[i, j]
-    if Y_eq == 0:
+    """
+    Effective resistance between two nodes through the whole network.
+
+    R = P[i, i] + P[j, j] - 2 P[i, j] with P the pseudo-inverse of the admittance matrix Y.
+    (Y[i, i] + Y[j, j] - 2 Y[i, j] is a sum of admittances, not the resistance between i and j.)
+    Uses the sparse C++ EffectiveResistance engine when the electrostatics module is built.
+    """
+    if node1 == node2:
+        return 0.0
+    if not nx.has_path(G, node1, node2):
         return float('inf')  # No connection
-    R_eq = 1 / Y_eq
-    return R_eq
 
+    if electrostatics is not None and all(isinstance(node, int) for node in G.nodes):
+        network = electrostatics.ResistiveNetwork()
+        edges = list(G.edges(data='resistance'))
+        network.add_edges([u for u, _, _ in edges], [v for _, v, _ in edges], [r for _, _, r in edges])
+        return electrostatics.EffectiveResistance(network).resistance(node1, node2)
+
+    # Pseudo-inverse of the connected component only
+    component = G.subgraph(nx.node_connected_component(G, node1))
+    Y, nodes = calculate_y_parameters(component)
+    index = {node: k for k, node in enumerate(nodes)}
+    i = index[node1]
+    j = index[node2]
+    P = np.linalg.pinv(Y)
+    return P[i, i] + P[j, j] - 2 * P[i, j]
 
 def dc_solution_resistive_graph(G, source_node):
-    import numpy as np
+    """
+    Node voltages for +1 A into source_node and -1 A out of the reference node (the last node, grounded).
 
+    Uses the sparse C++ ResistiveNetworkSolver when the electrostatics module is built; the dense
+    numpy fallback is limited to a few thousand nodes.
+    """
     nodes = list(G.nodes)
+    reference = nodes[-1]
+
+    if electrostatics is not None and all(isinstance(node, int) for node in nodes):
+        network = electrostatics.ResistiveNetwork()
+        for node in nodes:
+            network.add_node(node)
+        edges = list(G.edges(data='resistance'))
+        network.add_edges([u for u, _, _ in edges], [v for _, v, _ in edges], [r for _, _, r in edges])
+        solver = electrostatics.ResistiveNetworkSolver(network, reference)
+        V = solver.dc_solution(source_node, reference)
+        return {node: V[network.index(node)] for node in nodes}
+
     n = len(nodes)
+    index = {node: k for k, node in enumerate(nodes)}
     Y = np.zeros((n, n), dtype=float)
 
     # Build admittance matrix
     for u, v, data in G.edges(data=True):
         r = data['resistance']
         y = 1 / r
-        i = nodes.index(u)
-        j = nodes.index(v)
+        i = index[u]
+        j = index[v]
         Y[i, i] += y
         Y[j, j] += y
         Y[i, j] -= y
@@ -245,7 +336,7 @@ def dc_solution_resistive_graph(G, source_node):
 
     # Current vector: +1A at source_node, -1A at reference node (last node)
     I = np.zeros(n)
-    I[nodes.index(source_node)] = 1
+    I[index[source_node]] = 1
     I[-1] = -1  # Reference node
 
     # Remove reference node (ground) for solving
@@ -286,8 +377,9 @@ def draw_dc_solutions_on_graph(G, *dc_solutions):
 
 # Calculate equivalent resistance between two nodes
 node1, node2 = 1, 4
-equivalent_resistance = calculate_path_resistance(G, node1, node2)
+equivalent_resistance = calculate_equivalent_resistance_from_y(G, node1, node2)
 print(f"Equivalent resistance between node {node1} and node {node2}: {equivalent_resistance} ohms")
+print(f"Shortest-path resistance (upper bound): {calculate_path_resistance(G, node1, node2)} ohms")
 
 def plot_graph_with_resistances(G, pos, title):
     plt.figure(figsize=(8, 6))
@@ -328,6 +420,18 @@ def animate_adding_edges_and_dc_solution(G, G_tree, source_node):
     nodes_sorted = sorted(voltages_G_full.keys())
     voltage_values_G_full = [voltages_G_full[node] for node in nodes_sorted]
 
+    # With the C++ module, each added edge is a rank-one update of the tree solution
+    incremental = None
+    if electrostatics is not None and all(isinstance(node, int) for node in G_tree.nodes):
+        network = electrostatics.ResistiveNetwork()
+        for node in G_tree.nodes:
+            network.add_node(node)
+        for a, b, r in G_tree.edges(data='resistance'):
+            network.add_edge(a, b, r)
+        reference = list(G_tree.nodes)[-1]
+        incremental = electrostatics.ResistiveNetworkSolver(network, reference)
+        incremental.dc_solution(source_node, reference)
+
     for idx, (u, v, data) in enumerate(missing_edges, 1):
         # Add the next missing edge
         G_current.add_edge(u, v, **data)
@@ -337,7 +441,12 @@ def animate_adding_edges_and_dc_solution(G, G_tree, source_node):
         G_current[u][v]['resistance'] = epsilon*G_current[u][v]['resistance']  # Replace new_value with your desired value
 
         # Calculate DC solution for the current graph
-        voltages = dc_solution_resistive_graph(G_current, source_node=source_node)
+        if incremental is not None:
+            incremental.add_edge(u, v, G_current[u][v]['resistance'])
+            V = incremental.voltages
+            voltages = {node: V[incremental.network.index(node)] for node in G_current.nodes}
+        else:
+            voltages = dc_solution_resistive_graph(G_current, source_node=source_node)
         voltage_values_current = [voltages[node] for node in nodes_sorted]
 
         # Draw the graph
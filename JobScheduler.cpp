@@ -0,0 +1,443 @@
+#include "JobScheduler.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <numeric>
+#include <queue>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+const size_t MAX_SAMPLES = 1000;   // Per solver; the oldest are dropped
+
+struct Running {
+    int job;
+    int threads;
+    double finish;   // Estimated
+};
+
+/**
+ * Closes a worker pool and joins its threads when the scheduler loop exits,
+ * normally or by exception
+ */
+class PoolGuard {
+public:
+    PoolGuard(std::mutex& mutex, std::condition_variable& work, bool& closing, std::vector<std::thread>& workers)
+        : mutex_(mutex), work_(work), closing_(closing), workers_(workers) {}
+
+    ~PoolGuard() { join(); }
+
+    PoolGuard(const PoolGuard&) = delete;
+    PoolGuard& operator=(const PoolGuard&) = delete;
+
+    void join() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closing_ = true;
+        }
+        work_.notify_all();
+        for (auto& w : workers_) {
+            if (w.joinable()) {
+                w.join();
+            }
+        }
+    }
+
+private:
+    std::mutex& mutex_;
+    std::condition_variable& work_;
+    bool& closing_;
+    std::vector<std::thread>& workers_;
+};
+
+/**
+ * Earliest estimated time at which `need` threads are free
+ */
+double shadowTime(std::vector<Running> running, int freeThreads, int need, double now) {
+    std::sort(running.begin(), running.end(), [](const Running& a, const Running& b) { return a.finish < b.finish; });
+    double shadow = now;
+    for (const Running& r : running) {
+        if (freeThreads >= need) {
+            break;
+        }
+        freeThreads += r.threads;
+        shadow = std::max(now, r.finish);
+    }
+    return shadow;
+}
+
+} // namespace
+
+// ========== CostModel ==========
+
+CostModel::CostModel() {
+    setPrior("default", 1e-7, 1.5);
+    setPrior("ldlt", 3e-8, 1.35);        // Sparse LDLᵀ of the reduced 2D system (AMD)
+    setPrior("pcg", 1e-7, 1.5);          // Preconditioned CG, iterations ~ √n
+    setPrior("block-jacobi", 1e-7, 1.4); // Block factorizations plus fewer PCG iterations
+    setPrior("multigrid", 2e-7, 1.0);
+    setPrior("dense-lu", 1e-10, 3.0);    // buildFDMSystem + solveLU
+}
+
+void CostModel::setPrior(const std::string& solver, double coefficient, double exponent) {
+    Model& m = models_[solver];
+    m.coefficient = coefficient;
+    m.exponent = exponent;
+    refit(m);
+}
+
+CostModel::Model& CostModel::model(const std::string& solver) {
+    auto it = models_.find(solver);
+    if (it != models_.end()) {
+        return it->second;
+    }
+    Model m = lookup("default");
+    m.samples.clear();
+    m.fitted = false;
+    return models_[solver] = m;
+}
+
+const CostModel::Model& CostModel::lookup(const std::string& solver) const {
+    auto it = models_.find(solver);
+    return it != models_.end() ? it->second : models_.at("default");
+}
+
+void CostModel::refit(Model& m) {
+    m.fitted = false;
+    if (m.samples.empty()) {
+        return;
+    }
+
+    std::set<double> sizes;
+    double mx = 0.0;
+    double my = 0.0;
+    for (const auto& s : m.samples) {
+        sizes.insert(s.first);
+        mx += std::log(s.first);
+        my += std::log(s.second);
+    }
+    mx /= m.samples.size();
+    my /= m.samples.size();
+
+    double exponent = m.exponent;
+    if (sizes.size() >= 2) {
+        double sxy = 0.0;
+        double sxx = 0.0;
+        for (const auto& s : m.samples) {
+            double dx = std::log(s.first) - mx;
+            sxy += dx * (std::log(s.second) - my);
+            sxx += dx * dx;
+        }
+        exponent = std::clamp(sxy / sxx, 0.8, 3.5);
+    }
+
+    m.fitExponent = exponent;
+    m.fitCoefficient = std::exp(my - exponent * mx);
+    m.fitted = true;
+}
+
+void CostModel::record(const std::string& solver, long unknowns, double seconds) {
+    if (unknowns <= 0 || !(seconds > 0.0)) {
+        return;
+    }
+    Model& m = model(solver);
+    m.samples.push_back({static_cast<double>(unknowns), seconds});
+    if (m.samples.size() > MAX_SAMPLES) {
+        m.samples.erase(m.samples.begin());
+    }
+    refit(m);
+}
+
+std::pair<double, double> CostModel::parameters(const std::string& solver) const {
+    const Model& m = lookup(solver);
+    return m.fitted ? std::make_pair(m.fitCoefficient, m.fitExponent) : std::make_pair(m.coefficient, m.exponent);
+}
+
+double CostModel::estimate(const std::string& solver, long unknowns) const {
+    auto [c, p] = parameters(solver);
+    return c * std::pow(static_cast<double>(std::max(1L, unknowns)), p);
+}
+
+size_t CostModel::samples(const std::string& solver) const {
+    auto it = models_.find(solver);
+    return it != models_.end() ? it->second.samples.size() : 0;
+}
+
+bool CostModel::load(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        return false;
+    }
+    std::string line;
+    while (std::getline(in, line)) {
+        std::stringstream ss(line);
+        std::string solver, unknowns, seconds;
+        if (!std::getline(ss, solver, ',') || !std::getline(ss, unknowns, ',') || !std::getline(ss, seconds)) {
+            continue;
+        }
+        try {
+            record(solver, std::stol(unknowns), std::stod(seconds));
+        } catch (const std::exception&) {
+            // Header or damaged line
+        }
+    }
+    return true;
+}
+
+void CostModel::save(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        throw std::runtime_error("Cannot write cost model history: " + path);
+    }
+    out.precision(10);
+    out << "solver,unknowns,seconds\n";
+    for (const auto& entry : models_) {
+        for (const auto& s : entry.second.samples) {
+            out << entry.first << "," << static_cast<long>(s.first) << "," << s.second << "\n";
+        }
+    }
+}
+
+// ========== JobScheduler ==========
+
+JobScheduler::JobScheduler(int threads, CostModel* model)
+    : threads_(threads > 0 ? threads : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()))),
+      model_(model ? model : &ownModel_) {}
+
+double JobScheduler::duration(double cost, int threads) const {
+    return cost / (1.0 + (threads - 1) * parallelEfficiency);
+}
+
+JobScheduler::Prepared JobScheduler::prepare(const std::vector<Job>& jobs) const {
+    Prepared p;
+    size_t n = jobs.size();
+    p.cost.resize(n);
+    p.threads.resize(n, 1);
+    p.order.resize(n);
+
+    double total = 0.0;
+    for (size_t j = 0; j < n; ++j) {
+        p.cost[j] = jobs[j].cost >= 0.0 ? jobs[j].cost : model_->estimate(jobs[j].solver, jobs[j].unknowns);
+        total += p.cost[j];
+    }
+
+    // Jobs above the fair share get proportionally more threads
+    double share = total / threads_;
+    for (size_t j = 0; j < n; ++j) {
+        int cap = std::max(1, std::min(jobs[j].maxThreads, threads_));
+        if (share > 0.0 && p.cost[j] > share) {
+            p.threads[j] = std::min(cap, static_cast<int>(std::ceil(p.cost[j] / share)));
+        }
+    }
+
+    // Longest processing time first
+    std::iota(p.order.begin(), p.order.end(), 0);
+    std::stable_sort(p.order.begin(), p.order.end(), [&](int a, int b) { return p.cost[a] > p.cost[b]; });
+    return p;
+}
+
+namespace {
+
+/**
+ * Start the head of the queue if it fits, otherwise backfill jobs that finish
+ * before the head can start. Returns the jobs started at `now`.
+ */
+std::vector<int> selectJobs(
+    std::vector<int>& pending,
+    const std::vector<Running>& running,
+    int& freeThreads,
+    double now,
+    const std::vector<int>& threads,
+    const std::function<double(int)>& duration) {
+
+    std::vector<int> started;
+    std::vector<Running> active = running;
+
+    while (!pending.empty() && threads[pending.front()] <= freeThreads) {
+        int j = pending.front();
+        pending.erase(pending.begin());
+        freeThreads -= threads[j];
+        active.push_back({j, threads[j], now + duration(j)});
+        started.push_back(j);
+    }
+    if (pending.empty() || freeThreads == 0) {
+        return started;
+    }
+
+    double shadow = shadowTime(active, freeThreads, threads[pending.front()], now);
+    for (size_t k = 1; k < pending.size() && freeThreads > 0;) {
+        int j = pending[k];
+        if (threads[j] <= freeThreads && now + duration(j) <= shadow) {
+            pending.erase(pending.begin() + k);
+            freeThreads -= threads[j];
+            started.push_back(j);
+        } else {
+            ++k;
+        }
+    }
+    return started;
+}
+
+} // namespace
+
+std::vector<ScheduleSlot> JobScheduler::plan(const std::vector<Job>& jobs) const {
+    Prepared p = prepare(jobs);
+    auto dur = [&](int j) { return duration(p.cost[j], p.threads[j]); };
+
+    std::vector<ScheduleSlot> slots;
+    std::vector<int> pending = p.order;
+    std::vector<Running> running;
+    int freeThreads = threads_;
+    double now = 0.0;
+
+    while (!pending.empty() || !running.empty()) {
+        for (int j : selectJobs(pending, running, freeThreads, now, p.threads, dur)) {
+            running.push_back({j, p.threads[j], now + dur(j)});
+            slots.push_back({j, p.threads[j], now, now + dur(j)});
+        }
+
+        // Advance to the next completion
+        auto next = std::min_element(running.begin(), running.end(),
+                                     [](const Running& a, const Running& b) { return a.finish < b.finish; });
+        now = next->finish;
+        for (size_t r = 0; r < running.size();) {
+            if (running[r].finish <= now) {
+                freeThreads += running[r].threads;
+                running.erase(running.begin() + r);
+            } else {
+                ++r;
+            }
+        }
+    }
+    return slots;
+}
+
+double JobScheduler::fifoMakespan(const std::vector<double>& costs, int threads) {
+    std::priority_queue<double, std::vector<double>, std::greater<double>> freeAt;
+    for (int t = 0; t < std::max(1, threads); ++t) {
+        freeAt.push(0.0);
+    }
+    double makespan = 0.0;
+    for (double c : costs) {
+        double start = freeAt.top();
+        freeAt.pop();
+        freeAt.push(start + c);
+        makespan = std::max(makespan, start + c);
+    }
+    return makespan;
+}
+
+ScheduleReport JobScheduler::run(const std::vector<Job>& jobs) {
+    ScheduleReport report;
+    report.planned = plan(jobs);
+    for (const ScheduleSlot& s : report.planned) {
+        report.predictedMakespan = std::max(report.predictedMakespan, s.finish);
+    }
+
+    Prepared p = prepare(jobs);
+    report.predictedFifoMakespan = fifoMakespan(p.cost, threads_);
+    auto dur = [&](int j) { return duration(p.cost[j], p.threads[j]); };
+
+    std::mutex mutex;
+    std::condition_variable done;       // A job finished
+    std::condition_variable work;       // A job was dispatched, or the pool is closing
+    std::deque<int> ready;              // Dispatched, not yet picked up by a worker
+    bool closing = false;
+    std::vector<int> finished;
+    std::vector<std::exception_ptr> errors(jobs.size());
+    std::vector<Running> running;
+    std::vector<int> pending = p.order;
+    int freeThreads = threads_;
+
+    auto origin = std::chrono::steady_clock::now();
+    auto elapsed = [&]() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - origin).count();
+    };
+
+    auto worker = [&] {
+        for (;;) {
+            int j;
+            {
+                std::unique_lock<std::mutex> guard(mutex);
+                work.wait(guard, [&] { return closing || !ready.empty(); });
+                if (closing) {
+                    return;
+                }
+                j = ready.front();
+                ready.pop_front();
+            }
+            int t = p.threads[j];
+            double start = elapsed();
+            try {
+                if (jobs[j].run) {
+                    jobs[j].run(t);
+                }
+            } catch (...) {
+                errors[j] = std::current_exception();
+            }
+            double end = elapsed();
+
+            std::lock_guard<std::mutex> guard(mutex);
+            report.executed.push_back({j, t, start, end});
+            if (!errors[j]) {
+                model_->record(jobs[j].solver, jobs[j].unknowns, (end - start) * (1.0 + (t - 1) * parallelEfficiency));
+            }
+            finished.push_back(j);
+            done.notify_all();
+        }
+    };
+
+    // Every running job holds at least one thread of the budget, so a pool of
+    // min(threads, jobs) workers always has one idle for a dispatched job.
+    // The guard closes and joins the pool on every exit path.
+    std::vector<std::thread> workers;
+    PoolGuard pool(mutex, work, closing, workers);
+    size_t poolSize = std::min(static_cast<size_t>(std::max(1, threads_)), jobs.size());
+    workers.reserve(poolSize);
+    for (size_t w = 0; w < poolSize; ++w) {
+        workers.emplace_back(worker);
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!pending.empty() || !running.empty()) {
+        double now = elapsed();
+        for (int j : selectJobs(pending, running, freeThreads, now, p.threads, dur)) {
+            running.push_back({j, p.threads[j], now + dur(j)});
+            ready.push_back(j);
+        }
+        work.notify_all();
+
+        done.wait(lock, [&] { return !finished.empty(); });
+        for (int j : finished) {
+            auto it = std::find_if(running.begin(), running.end(), [&](const Running& r) { return r.job == j; });
+            freeThreads += it->threads;
+            running.erase(it);
+        }
+        finished.clear();
+
+        // Jobs running longer than estimated: push their finish past now for the shadow time
+        double t = elapsed();
+        for (Running& r : running) {
+            r.finish = std::max(r.finish, t);
+        }
+    }
+    lock.unlock();
+    pool.join();
+    report.makespan = elapsed();
+
+    for (auto& e : errors) {
+        if (e) {
+            std::rethrow_exception(e);
+        }
+    }
+    return report;
+}
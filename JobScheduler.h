@@ -0,0 +1,153 @@
+#ifndef JOB_SCHEDULER_H
+#define JOB_SCHEDULER_H
+
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @class CostModel
+ * @brief Run-time estimates t(n) = c · nᵖ per solver, refined by measured timings
+ *
+ * Every solver starts from a prior (c, p). Recorded timings replace the prior:
+ * with samples at two or more distinct sizes, c and p are fitted by least
+ * squares in log-log space (p clamped to [0.8, 3.5]); with samples at a single
+ * size only c is refitted and the prior exponent is kept. Unknown solvers use
+ * the "default" model.
+ *
+ * Timings are single-thread equivalents in seconds. History can be saved to
+ * and loaded from a CSV file (solver,unknowns,seconds).
+ */
+class CostModel {
+public:
+    CostModel();
+
+    void setPrior(const std::string& solver, double coefficient, double exponent);
+
+    void record(const std::string& solver, long unknowns, double seconds);
+
+    /**
+     * @brief Estimated single-thread run time in seconds
+     */
+    double estimate(const std::string& solver, long unknowns) const;
+
+    /**
+     * @brief Fitted (or prior) coefficient and exponent of a solver
+     */
+    std::pair<double, double> parameters(const std::string& solver) const;
+
+    size_t samples(const std::string& solver) const;
+
+    bool load(const std::string& path);
+    void save(const std::string& path) const;
+
+private:
+    struct Model {
+        double coefficient = 1e-7;
+        double exponent = 1.5;
+        std::vector<std::pair<double, double>> samples;   // (unknowns, seconds)
+        bool fitted = false;
+        double fitCoefficient = 0.0;
+        double fitExponent = 0.0;
+    };
+
+    Model& model(const std::string& solver);
+    const Model& lookup(const std::string& solver) const;
+    static void refit(Model& m);
+
+    std::map<std::string, Model> models_;
+};
+
+/**
+ * @brief One unit of work for the JobScheduler
+ */
+struct Job {
+    std::string name;
+    std::string solver = "default";     // CostModel key
+    long unknowns = 0;
+    int maxThreads = 1;                 // Threads the job can use effectively
+    double cost = -1.0;                 // Single-thread seconds; < 0: ask the CostModel
+    std::function<void(int threads)> run;
+};
+
+/**
+ * @brief Planned or executed placement of a job
+ */
+struct ScheduleSlot {
+    int job = -1;
+    int threads = 1;
+    double start = 0.0;     // Seconds from the start of the schedule
+    double finish = 0.0;
+};
+
+/**
+ * @brief Result of JobScheduler::run
+ */
+struct ScheduleReport {
+    std::vector<ScheduleSlot> planned;      // Simulated with estimated costs
+    std::vector<ScheduleSlot> executed;     // Measured
+    double predictedMakespan = 0.0;
+    double predictedFifoMakespan = 0.0;     // Same jobs, arrival order, one thread each
+    double makespan = 0.0;
+};
+
+/**
+ * @class JobScheduler
+ * @brief Makespan-oriented scheduling of mixed-size jobs on a thread budget
+ *
+ * Jobs are ordered longest-first by estimated cost (LPT). A job whose cost
+ * exceeds the fair share W/T (total work over threads) is granted
+ * ⌈cost / (W/T)⌉ threads, capped by its maxThreads and the budget; all other
+ * jobs get one thread. The run time with t threads is modeled as
+ * cost / (1 + (t - 1)·parallelEfficiency).
+ *
+ * Dispatch is list scheduling with backfilling: the first waiting job starts
+ * as soon as enough threads are free; while it waits, later (smaller) jobs
+ * may use the idle threads if they are expected to finish before the head
+ * job could start. Measured run times are fed back into the CostModel.
+ */
+class JobScheduler {
+public:
+    explicit JobScheduler(int threads = 0, CostModel* model = nullptr);
+
+    /**
+     * @brief Simulate the schedule with estimated costs (no job is run)
+     */
+    std::vector<ScheduleSlot> plan(const std::vector<Job>& jobs) const;
+
+    /**
+     * @brief Execute all jobs; rethrows the first job exception after all finished
+     *
+     * Jobs run on a fixed pool of min(threads, jobs) worker threads that take
+     * dispatched jobs from a ready queue; a job granted t threads receives t
+     * in its run callback and counts t against the budget.
+     */
+    ScheduleReport run(const std::vector<Job>& jobs);
+
+    /**
+     * @brief Makespan of one-thread-per-job FIFO list scheduling
+     */
+    static double fifoMakespan(const std::vector<double>& costs, int threads);
+
+    int threads() const { return threads_; }
+
+    double parallelEfficiency = 0.8;
+
+private:
+    struct Prepared {
+        std::vector<double> cost;
+        std::vector<int> threads;
+        std::vector<int> order;
+    };
+
+    Prepared prepare(const std::vector<Job>& jobs) const;
+    double duration(double cost, int threads) const;
+
+    int threads_;
+    CostModel* model_;
+    CostModel ownModel_;
+};
+
+#endif // JOB_SCHEDULER_H
@@ -0,0 +1,332 @@
+#include "LaplacianSpectrum.h"
+#include "ParallelFor.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Eigen::MatrixXd;
+using Eigen::VectorXd;
+
+/// Largest n solved by dense eigendecomposition when the basis would span everything
+constexpr int DENSE_LIMIT = 2000;
+
+/**
+ * @brief Laplacian as an operator: y = L x, plus its nullspace (component labels)
+ */
+struct LaplacianOperator {
+    int n = 0;
+    std::function<void(const double*, double*)> apply;
+    std::vector<int> labels;        // Component of every vertex
+    int components = 0;
+    double norm = 0.0;              // Upper bound on ‖L‖₂
+};
+
+/**
+ * @brief Removes the nullspace: subtracts the mean over each component
+ */
+class Deflation {
+public:
+    explicit Deflation(const LaplacianOperator& op) : labels_(op.labels), sum_(op.components), size_(op.components, 0) {
+        for (int label : labels_) {
+            ++size_[label];
+        }
+    }
+
+    void operator()(VectorXd& x) {
+        std::fill(sum_.begin(), sum_.end(), 0.0);
+        for (Eigen::Index i = 0; i < x.size(); ++i) {
+            sum_[labels_[i]] += x[i];
+        }
+        for (Eigen::Index i = 0; i < x.size(); ++i) {
+            x[i] -= sum_[labels_[i]] / size_[labels_[i]];
+        }
+    }
+
+private:
+    const std::vector<int>& labels_;
+    std::vector<double> sum_;
+    std::vector<int> size_;
+};
+
+/// Deflated unit vector from the hash stream (seed, salt)
+VectorXd randomVector(int n, std::uint64_t seed, std::uint64_t salt, Deflation& deflate) {
+    VectorXd x(n);
+    for (int i = 0; i < n; ++i) {
+        x[i] = static_cast<double>(splitMix64(splitMix64(seed ^ salt) + static_cast<std::uint64_t>(i)) >> 11) * 0x1.0p-53 - 0.5;
+    }
+    deflate(x);
+    return x;
+}
+
+/// Sign convention: the entry of largest magnitude is positive
+void normalizeSign(MatrixXd& vectors) {
+    for (Eigen::Index c = 0; c < vectors.cols(); ++c) {
+        Eigen::Index largest;
+        vectors.col(c).cwiseAbs().maxCoeff(&largest);
+        if (vectors(largest, c) < 0.0) {
+            vectors.col(c) = -vectors.col(c);
+        }
+    }
+}
+
+void finish(const LaplacianOperator& op, LaplacianSpectrum& result) {
+    normalizeSign(result.eigenvectors);
+    result.residuals.resize(result.eigenvalues.size());
+    VectorXd product(op.n);
+    for (Eigen::Index c = 0; c < result.eigenvalues.size(); ++c) {
+        op.apply(result.eigenvectors.col(c).data(), product.data());
+        result.residuals[c] = (product - result.eigenvalues[c] * result.eigenvectors.col(c)).norm();
+    }
+    result.components = op.components;
+    result.algebraicConnectivity = op.components == 1 && result.eigenvalues.size() > 0 ? result.eigenvalues[0] : 0.0;
+}
+
+/**
+ * @brief Small problems: dense eigendecomposition of L, nullspace dropped
+ */
+LaplacianSpectrum dense(const LaplacianOperator& op, int count) {
+    MatrixXd L(op.n, op.n);
+    VectorXd unit = VectorXd::Zero(op.n);
+    for (int j = 0; j < op.n; ++j) {
+        unit[j] = 1.0;
+        op.apply(unit.data(), L.col(j).data());
+        unit[j] = 0.0;
+    }
+    Eigen::SelfAdjointEigenSolver<MatrixXd> solver(L);
+    LaplacianSpectrum result;
+    result.eigenvalues = solver.eigenvalues().segment(op.components, count);
+    result.eigenvectors = solver.eigenvectors().middleCols(op.components, count);
+    result.iterations = op.n;
+    result.converged = true;
+    finish(op, result);
+    return result;
+}
+
+LaplacianSpectrum lanczos(const LaplacianOperator& op, const LanczosOptions& options) {
+    auto t0 = std::chrono::steady_clock::now();
+    if (options.count < 1) {
+        throw std::invalid_argument("Lanczos needs count >= 1");
+    }
+    const int n = op.n;
+    const int rank = n - op.components;   // Nonzero eigenvalues
+    const int count = std::min(options.count, rank);
+    int m = options.basis > 0 ? std::max(options.basis, count + 2) : std::max(2 * count + 20, 40);
+    if (count <= 0) {
+        LaplacianSpectrum result;
+        result.eigenvectors.resize(n, 0);
+        result.converged = true;
+        finish(op, result);
+        return result;
+    }
+    if (rank <= m && n <= DENSE_LIMIT) {
+        LaplacianSpectrum result = dense(op, count);
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        return result;
+    }
+    m = std::min(m, rank);  // The deflated space has only rank dimensions
+
+    Deflation deflate(op);
+    MatrixXd V(n, m);
+    MatrixXd T = MatrixXd::Zero(m, m);
+    VectorXd w(n);
+    VectorXd h;
+    V.col(0) = randomVector(n, options.seed, 0, deflate).normalized();
+
+    // Replaces a vanishing residual (invariant subspace found) by a fresh
+    // direction orthogonal to the basis so far
+    std::uint64_t fresh = 0;
+    auto newDirection = [&](int columns) {
+        VectorXd x = randomVector(n, options.seed, ++fresh, deflate);
+        for (int pass = 0; pass < 2; ++pass) {
+            x -= V.leftCols(columns) * (V.leftCols(columns).transpose() * x);
+        }
+        return VectorXd(x.normalized());
+    };
+
+    LaplacianSpectrum result;
+    int kept = 0;
+    while (true) {
+        double beta = 0.0;
+        for (int j = kept; j < m; ++j) {
+            op.apply(V.col(j).data(), w.data());
+            deflate(w);
+            ++result.iterations;
+
+            // Full reorthogonalization: classical Gram-Schmidt, repeated when
+            // it cancels most of w (DGKS criterion). The first column after a
+            // restart picks up the couplings to the kept Ritz vectors here,
+            // giving T its arrowhead.
+            double before = w.norm();
+            h = V.leftCols(j + 1).transpose() * w;
+            w -= V.leftCols(j + 1) * h;
+            beta = w.norm();
+            if (beta < 0.717 * before) {
+                VectorXd correction = V.leftCols(j + 1).transpose() * w;
+                w -= V.leftCols(j + 1) * correction;
+                h += correction;
+            }
+            T.col(j).head(j + 1) = h;
+            T.row(j).head(j + 1) = h.transpose();
+
+            // Rounding reintroduces the constant vectors, which Lanczos would
+            // amplify as the lowest eigenvalue; remove them again
+            deflate(w);
+            beta = w.norm();
+            if (j + 1 < m) {
+                if (beta <= 1e-12 * op.norm) {
+                    V.col(j + 1) = newDirection(j + 1);
+                    beta = 0.0;
+                } else {
+                    V.col(j + 1) = w / beta;
+                }
+                T(j + 1, j) = beta;
+                T(j, j + 1) = beta;
+            }
+        }
+
+        // Rayleigh-Ritz; the residual of Ritz pair i is |β · y_i(m - 1)|
+        Eigen::SelfAdjointEigenSolver<MatrixXd> ritz(T);
+        const VectorXd& theta = ritz.eigenvalues();
+        const MatrixXd& Y = ritz.eigenvectors();
+        bool converged = true;
+        for (int i = 0; i < count; ++i) {
+            converged = converged && std::abs(beta * Y(m - 1, i)) <= options.tolerance * op.norm;
+        }
+        if (converged || result.iterations >= options.maxIterations) {
+            result.converged = converged;
+            result.eigenvalues = theta.head(count);
+            result.eigenvectors = V * Y.leftCols(count);
+            break;
+        }
+
+        // Thick restart: keep the lowest Ritz vectors, continue from the residual
+        kept = std::min(m - 1, count + (m - count) / 2);
+        MatrixXd ritzVectors = V * Y.leftCols(kept);
+        V.leftCols(kept) = ritzVectors;
+        T.setZero();
+        T.diagonal().head(kept) = theta.head(kept);
+        if (beta <= 1e-12 * op.norm) {
+            V.col(kept) = newDirection(kept);
+        } else {
+            V.col(kept) = w / beta;
+        }
+        ++result.restarts;
+    }
+
+    finish(op, result);
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return result;
+}
+
+} // namespace
+
+LaplacianSpectrum LaplacianEigensolver::lowest(const Graph& g, const LanczosOptions& options) {
+    LaplacianOperator op;
+    op.n = g.nodeCount();
+    op.components = g.components(&op.labels, options.threads);
+    int threads = resolveThreads(options.threads);
+    int maxDegree = 0;
+    for (int v = 0; v < op.n; ++v) {
+        maxDegree = std::max(maxDegree, g.degree(v));
+    }
+    op.norm = std::max(1.0, 2.0 * maxDegree);
+    op.apply = [&g, threads](const double* x, double* y) {
+        parallelFor(threads, g.nodeCount(), [&](long begin, long end) {
+            for (long v = begin; v < end; ++v) {
+                double sum = 0.0;
+                for (int w : g.neighbors(static_cast<int>(v))) {
+                    sum += x[w];
+                }
+                y[v] = g.degree(static_cast<int>(v)) * x[v] - sum;
+            }
+        });
+    };
+    return lanczos(op, options);
+}
+
+LaplacianSpectrum LaplacianEigensolver::lowest(const ResistiveNetwork& network, const LanczosOptions& options) {
+    return lowest(network.laplacian(), options);
+}
+
+LaplacianSpectrum LaplacianEigensolver::lowest(const SparseMatrix& laplacian, const LanczosOptions& options) {
+    if (laplacian.rows() != laplacian.cols()) {
+        throw std::invalid_argument("Laplacian must be square");
+    }
+    SparseMatrix L = laplacian;
+    L.makeCompressed();
+    LaplacianOperator op;
+    op.n = static_cast<int>(L.rows());
+
+    // Gershgorin bound, sign pattern, zero column sums (= row sums once
+    // symmetry is checked below), and the components of the off-diagonal pattern
+    std::vector<int> parent(op.n);
+    for (int v = 0; v < op.n; ++v) {
+        parent[v] = v;
+    }
+    auto find = [&](int x) {
+        while (parent[x] != x) {
+            x = parent[x] = parent[parent[x]];
+        }
+        return x;
+    };
+    for (int j = 0; j < op.n; ++j) {
+        double sum = 0.0;
+        double absolute = 0.0;
+        for (SparseMatrix::InnerIterator it(L, j); it; ++it) {
+            sum += it.value();
+            absolute += std::abs(it.value());
+            if (it.row() != j && it.value() > 0.0) {
+                throw std::invalid_argument("Laplacian has a positive off-diagonal entry in column " +
+                                            std::to_string(j));
+            }
+            if (it.row() != j && it.value() != 0.0) {
+                int a = find(static_cast<int>(it.row()));
+                int b = find(j);
+                parent[std::max(a, b)] = std::min(a, b);
+            }
+        }
+        if (std::abs(sum) > 1e-10 * std::max(1.0, absolute)) {
+            throw std::invalid_argument("Row " + std::to_string(j) + " of the Laplacian does not sum to zero");
+        }
+        op.norm = std::max(op.norm, absolute);
+    }
+    op.norm = std::max(op.norm, 1e-300);
+
+    // The product below reads columns as rows, which needs L = Lᵀ
+    SparseMatrix asymmetry = L - SparseMatrix(L.transpose());
+    for (int j = 0; j < op.n; ++j) {
+        for (SparseMatrix::InnerIterator it(asymmetry, j); it; ++it) {
+            if (std::abs(it.value()) > 1e-12 * op.norm) {
+                throw std::invalid_argument("Laplacian is not symmetric at (" + std::to_string(it.row()) + ", " +
+                                            std::to_string(j) + ")");
+            }
+        }
+    }
+
+    op.labels.resize(op.n);
+    for (int v = 0; v < op.n; ++v) {
+        int root = find(v);
+        op.labels[v] = root == v ? op.components++ : op.labels[root];
+    }
+
+    // Symmetric, so row v of L·x is column v dotted with x: one writer per entry
+    int threads = resolveThreads(options.threads);
+    op.apply = [&L, threads](const double* x, double* y) {
+        parallelFor(threads, L.cols(), [&](long begin, long end) {
+            for (long j = begin; j < end; ++j) {
+                double sum = 0.0;
+                for (SparseMatrix::InnerIterator it(L, j); it; ++it) {
+                    sum += it.value() * x[it.row()];
+                }
+                y[j] = sum;
+            }
+        });
+    };
+    return lanczos(op, options);
+}
@@ -0,0 +1,84 @@
+#ifndef LAPLACIAN_SPECTRUM_H
+#define LAPLACIAN_SPECTRUM_H
+
+#include "Graph.h"
+#include "ResistiveNetwork.h"
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+#include <cstdint>
+
+/**
+ * @brief Parameters of the thick-restart Lanczos iteration
+ */
+struct LanczosOptions {
+    int count = 1;                  // Smallest nonzero eigenvalues wanted (1: λ₂ and the Fiedler vector)
+    int basis = 0;                  // Krylov basis size m before a restart (0: max(2·count + 20, 40))
+    int maxIterations = 20000;      // Operator applications
+    double tolerance = 1e-8;        // ‖L x - λ x‖ ≤ tolerance · ‖L‖ (Gershgorin bound)
+    std::uint64_t seed = 99;        // Start vector
+    int threads = 0;                // Threads for L·x (0: hardware concurrency)
+};
+
+/**
+ * @brief Low end of a Laplacian spectrum
+ */
+struct LaplacianSpectrum {
+    Eigen::VectorXd eigenvalues;    // Smallest nonzero eigenvalues, ascending
+    Eigen::MatrixXd eigenvectors;   // n × count, orthonormal, zero mean on every component
+    Eigen::VectorXd residuals;      // ‖L x - λ x‖ of each pair
+    double algebraicConnectivity = 0.0; // λ₂; 0 for a disconnected graph
+    int components = 0;             // Dimension of the deflated nullspace
+    int iterations = 0;             // Operator applications
+    int restarts = 0;
+    bool converged = false;
+    double seconds = 0.0;
+
+    /**
+     * @brief Eigenvector of the smallest nonzero eigenvalue (λ₂ when connected)
+     */
+    Eigen::VectorXd fiedler() const { return eigenvectors.col(0); }
+};
+
+/**
+ * @class LaplacianEigensolver
+ * @brief Smallest nonzero eigenpairs of graph Laplacians by thick-restart Lanczos
+ *
+ * MatrixSolver::eigenDecomposition is dense, O(n²) memory and O(n³) time,
+ * so it stops at a few thousand nodes. Here L is only applied to vectors, in
+ * parallel and in O(m) per product. The nullspace of a Laplacian is known: the
+ * constant vector on each connected component. It is projected out of every
+ * Krylov vector by subtracting component means, so Lanczos never converges
+ * to the trivial zero eigenvalues and returns λ₂, λ₃, … directly.
+ *
+ * The Krylov basis is fully reorthogonalized and restarted after m vectors,
+ * keeping the lowest Ritz vectors (Wu–Simon thick restart). Memory is then
+ * (m + count) · n doubles, 330 MB for n = 10⁶ and m = 40. The iteration
+ * count grows with ‖L‖ / (λ_{count+2} - λ_{count+1}). Expander-like graphs
+ * such as rewired Watts–Strogatz graphs converge in a few hundred products.
+ * Grids and long rings, whose low eigenvalues are tightly clustered, need
+ * many more. When the basis would span all nonzero eigenvalues, small problems
+ * are solved densely.
+ */
+class LaplacianEigensolver {
+public:
+    using SparseMatrix = Eigen::SparseMatrix<double>;
+
+    /**
+     * @brief Unweighted Laplacian D - A of the CSR graph core
+     */
+    static LaplacianSpectrum lowest(const Graph& g, const LanczosOptions& options = LanczosOptions());
+
+    /**
+     * @brief Conductance-weighted Laplacian of a resistor network (also ResistiveNetworkSolver::network())
+     */
+    static LaplacianSpectrum lowest(const ResistiveNetwork& network, const LanczosOptions& options = LanczosOptions());
+
+    /**
+     * @brief Any symmetric matrix with zero row sums and nonpositive off-diagonals
+     * @throws std::invalid_argument if the matrix is not square or not symmetric, an
+     *         off-diagonal entry is positive or a row sum is not zero
+     */
+    static LaplacianSpectrum lowest(const SparseMatrix& laplacian, const LanczosOptions& options = LanczosOptions());
+};
+
+#endif // LAPLACIAN_SPECTRUM_H
@@ -0,0 +1,185 @@
+#include "LocalResolver.h"
+#include "Factorization.h"
+#include "Reduction.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+LocalResolver::LocalResolver(
+    int nx, int ny,
+    double dx, double dy,
+    const std::vector<double>& rho,
+    double epsilon,
+    const std::vector<double>& boundaryValues,
+    int minCoarsePoints)
+    : nx_(nx), ny_(ny), dx_(dx), dy_(dy), epsilon_(epsilon),
+      rho_(rho), boundaryValues_(boundaryValues) {
+
+    ElectrostaticSolver solver;
+    solver.buildReducedFDMSystem(nx, ny, dx, dy, rho_, epsilon, K_, f_, boundaryValues_);
+    mg_.build(K_, nx - 2, ny - 2, minCoarsePoints);
+
+    const double pi = 3.14159265358979323846;
+    double s = std::sin(pi / (2.0 * (nx - 1)));
+    lambdaMin_ = 4.0 / (dx * dx) * s * s;
+
+    LocalResolveOptions options;
+    LocalResolveReport report;
+    u_ = VectorXd::Zero(f_.size());
+    solveGlobal(options, report);
+}
+
+LocalResolver::VectorXd LocalResolver::residual() const {
+    return f_ - K_ * u_;
+}
+
+void LocalResolver::solveGlobal(const LocalResolveOptions& options, LocalResolveReport& report) {
+    MatrixSolver matSolver;
+    MatrixSolver::LinearOperator A = [this](const VectorXd& v) { return VectorXd(K_ * v); };
+    MatrixSolver::IterativeResult result = matSolver.solvePreconditionedCG(
+        A, f_, mg_.preconditioner(), u_, options.maxGlobalIterations, options.globalTolerance);
+
+    u_ = std::move(result.x);
+    report.global = true;
+    report.globalIterations = result.iterations;
+}
+
+LocalResolveReport LocalResolver::updateChargeDensity(
+    const std::vector<double>& rho,
+    const LocalResolveOptions& options) {
+
+    int mx = nx_ - 2;
+    int my = ny_ - 2;
+    if (static_cast<int>(rho.size()) != mx * my) {
+        throw std::invalid_argument("Charge density size mismatch with interior grid");
+    }
+
+    // ========== Locate the Change ==========
+    // Interior coordinates (0-based); only the source term depends on rho
+    int a0 = mx, b0 = my, a1 = -1, b1 = -1;
+    for (int q = 0; q < my; ++q) {
+        for (int p = 0; p < mx; ++p) {
+            int k = p + q * mx;
+            if (rho[k] != rho_[k]) {
+                f_(k) += (rho[k] - rho_[k]) / epsilon_;
+                a0 = std::min(a0, p);
+                a1 = std::max(a1, p);
+                b0 = std::min(b0, q);
+                b1 = std::max(b1, q);
+            }
+        }
+    }
+    rho_ = rho;
+
+    LocalResolveReport report;
+    auto finish = [&]() {
+        VectorXd r = residual();
+        report.residualNorm = Reduction::norm(r);
+        report.errorEstimate = report.residualNorm / lambdaMin_;
+        return report;
+    };
+
+    if (a1 < 0) {
+        return finish();
+    }
+
+    a0 = std::max(0, a0 - options.halo);
+    b0 = std::max(0, b0 - options.halo);
+    a1 = std::min(mx - 1, a1 + options.halo);
+    b1 = std::min(my - 1, b1 + options.halo);
+    int sx = a1 - a0 + 1;
+    int sy = b1 - b0 + 1;
+
+    report.i0 = a0 + 1;
+    report.j0 = b0 + 1;
+    report.i1 = a1 + 1;
+    report.j1 = b1 + 1;
+    report.subdomainPoints = sx * sy;
+
+    if (report.subdomainPoints > options.maxLocalFraction * mx * my) {
+        solveGlobal(options, report);
+        return finish();
+    }
+
+    // ========== Subdomain Operator ==========
+    // K_SS restricted to the box; entries coupling to the outside are dropped
+    // because those values are held fixed during the local solve
+    std::vector<int> local(static_cast<size_t>(mx) * my, -1);
+    std::vector<int> global(report.subdomainPoints);
+    for (int q = 0; q < sy; ++q) {
+        for (int p = 0; p < sx; ++p) {
+            int s = p + q * sx;
+            int k = (a0 + p) + (b0 + q) * mx;
+            local[k] = s;
+            global[s] = k;
+        }
+    }
+
+    std::vector<Eigen::Triplet<double>> triplets;
+    triplets.reserve(5 * global.size());
+    for (int s = 0; s < report.subdomainPoints; ++s) {
+        for (SparseMatrix::InnerIterator it(K_, global[s]); it; ++it) {
+            int t = local[it.row()];
+            if (t >= 0) {
+                triplets.emplace_back(t, s, it.value());
+            }
+        }
+    }
+    SparseMatrix Kss(report.subdomainPoints, report.subdomainPoints);
+    Kss.setFromTriplets(triplets.begin(), triplets.end());
+    SparseCholeskyFactor localFactor = SparseCholeskyFactor::compute(Kss);
+
+    // ========== Local + Far-Field Sweeps ==========
+    // The sweeps form a contraction u_k = G(u_{k-1}); with the observed rate
+    // q = ||Δu_k|| / ||Δu_{k-1}|| the remaining error is ≈ ||Δu_k|| q / (1 - q).
+    // The first step carries the change itself, so a ratio against it is not a
+    // contraction rate: q is only measured between the second and later steps
+    // (sweep index >= 2); until then the residual bound ||r|| / λ_min is used.
+    VectorXd r = residual();
+    VectorXd rs(report.subdomainPoints);
+    double previousStep = 0.0;
+
+    for (int sweep = 0; sweep < options.maxSweeps; ++sweep) {
+        VectorXd before = u_;
+
+        for (int s = 0; s < report.subdomainPoints; ++s) {
+            rs(s) = r(global[s]);
+        }
+        VectorXd es = localFactor.solve(rs);
+        for (int s = 0; s < report.subdomainPoints; ++s) {
+            u_(global[s]) += es(s);
+        }
+        r = residual();
+
+        u_ += mg_.coarseCorrection(r, options.coarseLevel);
+        mg_.smooth(f_, u_, options.smoothingSweeps);
+        r = residual();
+
+        double step = Reduction::norm(u_ - before);
+        report.sweeps = sweep + 1;
+        report.residualNorm = Reduction::norm(r);
+
+        double bound = report.residualNorm / lambdaMin_;
+        double q = (sweep >= 2) ? step / previousStep : 1.0;
+        report.errorEstimate = (q < 1.0) ? std::min(bound, step * q / (1.0 - q)) : bound;
+        previousStep = step;
+
+        if (report.errorEstimate <= options.tolerance * Reduction::norm(u_)) {
+            return report;
+        }
+    }
+
+    // ========== Fallback ==========
+    solveGlobal(options, report);
+    return finish();
+}
+
+LocalResolver::VectorXd LocalResolver::potential() const {
+    ElectrostaticSolver solver;
+    return solver.expandReducedSolution(nx_, ny_, u_, boundaryValues_);
+}
+
+FieldResult LocalResolver::fieldResult() const {
+    ElectrostaticSolver solver;
+    return solver.makeFieldResult(nx_, ny_, potential(), dx_, dy_, epsilon_);
+}
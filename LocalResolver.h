@@ -0,0 +1,144 @@
+#ifndef LOCAL_RESOLVER_H
+#define LOCAL_RESOLVER_H
+
+#include "ElectrostaticSolver.h"
+#include "FieldResult.h"
+#include "Multigrid.h"
+#include <Eigen/Sparse>
+#include <vector>
+
+/**
+ * @brief Controls for LocalResolver::updateChargeDensity
+ */
+struct LocalResolveOptions {
+    int halo = 4;                      // Grid points added around the changed bounding box
+    int maxSweeps = 6;                 // Local + far-field sweeps before falling back to a global solve
+    double tolerance = 1e-6;           // Accept when the error estimate ≤ tolerance * ||u||
+    double maxLocalFraction = 0.25;    // Changed region larger than this share of the grid: solve globally
+    int coarseLevel = 1;               // Multigrid level for the far-field correction (-1: coarsest)
+    int smoothingSweeps = 1;           // Symmetric Gauss-Seidel sweeps after the far-field correction
+    double globalTolerance = 1e-10;    // Relative residual of the global fallback solve
+    int maxGlobalIterations = 500;
+};
+
+/**
+ * @brief Outcome of an incremental update
+ */
+struct LocalResolveReport {
+    bool global = false;           // True if the update fell back to a global re-solve
+    int sweeps = 0;                // Local + far-field sweeps performed
+    int globalIterations = 0;      // MG-preconditioned CG iterations of the fallback
+    int subdomainPoints = 0;       // Interior unknowns in the local subdomain
+    int i0 = 0, j0 = 0;            // Subdomain bounds (full-grid coordinates, inclusive)
+    int i1 = -1, j1 = -1;
+    double residualNorm = 0.0;     // ||f - K u||₂ after the update
+    double errorEstimate = 0.0;    // Estimate of ||u - u*||₂
+};
+
+/**
+ * @class LocalResolver
+ * @brief Incremental re-solve of the reduced FDM system after localized charge changes
+ *
+ * Keeps the reduced operator, the current interior solution and a multigrid
+ * hierarchy. When the charge density changes only in a small area, the new
+ * solution is obtained without a global solve by alternating
+ *
+ * 1. an exact solve of the residual equation on the changed region plus a halo
+ *    (values outside held fixed), and
+ * 2. a far-field correction from a coarse multigrid level that carries the
+ *    smooth long-range part of the change across the domain, followed by
+ *    symmetric Gauss-Seidel smoothing.
+ *
+ * Every step reduces the energy-norm error, so the sweeps never diverge. The remaining error is estimated from
+ * the observed contraction rate of the sweeps, capped by the strict bound
+ * ||u - u*||₂ ≤ ||r||₂ / λ_min(K) with λ_min = (4/dx²) sin²(π / (2(nx-1))),
+ * the smallest eigenvalue of the reduced operator (Dirichlet in x, Neumann
+ * in y). If the estimate does not drop below the tolerance, or the change
+ * covers too much of the grid, the update falls back to a warm-started
+ * multigrid-preconditioned CG solve.
+ */
+class LocalResolver {
+public:
+    using SparseMatrix = Eigen::SparseMatrix<double>;
+    using VectorXd = Eigen::VectorXd;
+
+    /**
+     * @brief Assemble the system, build the hierarchy and solve once globally
+     *
+     * @param nx Number of grid points in x-direction
+     * @param ny Number of grid points in y-direction
+     * @param dx Grid spacing in x-direction (m)
+     * @param dy Grid spacing in y-direction (m)
+     * @param rho Interior charge density ((nx-2)*(ny-2), C/m³)
+     * @param epsilon Permittivity (F/m)
+     * @param boundaryValues Full-grid boundary potentials (V)
+     * @param minCoarsePoints Coarsest multigrid level size
+     */
+    LocalResolver(
+        int nx, int ny,
+        double dx, double dy,
+        const std::vector<double>& rho,
+        double epsilon,
+        const std::vector<double>& boundaryValues,
+        int minCoarsePoints = 256
+    );
+
+    /**
+     * @brief Replace the charge density and update the solution
+     *
+     * Only entries that differ from the current density define the local
+     * subdomain. If nothing changed the solution is left untouched.
+     *
+     * @param rho New interior charge density ((nx-2)*(ny-2), C/m³)
+     * @param options Subdomain, acceptance and fallback settings
+     * @return How the update was performed and the final error estimate
+     */
+    LocalResolveReport updateChargeDensity(
+        const std::vector<double>& rho,
+        const LocalResolveOptions& options = LocalResolveOptions()
+    );
+
+    /**
+     * @brief Current potential on the full grid (layout of buildFDMSystem)
+     */
+    VectorXd potential() const;
+
+    /**
+     * @brief Current interior solution of the reduced system
+     */
+    const VectorXd& interiorSolution() const { return u_; }
+
+    /**
+     * @brief Current potential with lazily evaluated derived fields
+     */
+    FieldResult fieldResult() const;
+
+    /**
+     * @brief Lower bound of the spectrum of the reduced operator
+     */
+    double lambdaMin() const { return lambdaMin_; }
+
+    const Multigrid& multigrid() const { return mg_; }
+    int nx() const { return nx_; }
+    int ny() const { return ny_; }
+
+private:
+    VectorXd residual() const;
+    void solveGlobal(const LocalResolveOptions& options, LocalResolveReport& report);
+
+    int nx_;
+    int ny_;
+    double dx_;
+    double dy_;
+    double epsilon_;
+    std::vector<double> rho_;
+    std::vector<double> boundaryValues_;
+
+    SparseMatrix K_;
+    VectorXd f_;
+    VectorXd u_;
+    Multigrid mg_;
+    double lambdaMin_;
+};
+
+#endif // LOCAL_RESOLVER_H
@@ -1,31 +1,36 @@
 #include "MatrixSolver.h"
 #include <Eigen/IterativeLinearSolvers>
+#include <Eigen/SparseCholesky>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
 
-MatrixSolver::VectorXd MatrixSolver::solveLU(const MatrixXd& A, const VectorXd& b) {
+MatrixSolver::VectorXd MatrixSolver::solveLU(const MatrixRef& A, const VectorRef& b) {
     // LU decomposition and back substitution
     return A.lu().solve(b);
 }
 
-MatrixSolver::VectorXd MatrixSolver::solveQR(const MatrixXd& A, const VectorXd& b) {
+MatrixSolver::VectorXd MatrixSolver::solveQR(const MatrixRef& A, const VectorRef& b) {
     // QR decomposition (useful for overdetermined systems)
     return A.colPivHouseholderQr().solve(b);
 }
 
-double MatrixSolver::determinant(const MatrixXd& A) {
+double MatrixSolver::determinant(const MatrixRef& A) {
     if (A.rows() != A.cols()) {
         throw std::invalid_argument("Matrix must be square to compute determinant");
     }
     return A.determinant();
 }
 
-MatrixSolver::MatrixXd MatrixSolver::inverse(const MatrixXd& A) {
+MatrixSolver::MatrixXd MatrixSolver::inverse(const MatrixRef& A) {
     if (A.rows() != A.cols()) {
         throw std::invalid_argument("Matrix must be square to compute inverse");
     }
     return A.inverse();
 }
 
-void MatrixSolver::eigenDecomposition(const MatrixXd& A, VectorXd& eigenvalues, MatrixXd& eigenvectors) {
+void MatrixSolver::eigenDecomposition(const MatrixRef& A, VectorXd& eigenvalues, MatrixXd& eigenvectors) {
     if (A.rows() != A.cols()) {
         throw std::invalid_argument("Matrix must be square for eigenvalue decomposition");
     }
@@ -44,8 +49,8 @@ void MatrixSolver::printVector(const std::string& name, const VectorXd& vector)
 }
 
 MatrixSolver::VectorXd MatrixSolver::solveConjugateGradient(
-    const MatrixXd& A,
-    const VectorXd& b,
+    const MatrixRef& A,
+    const VectorRef& b,
     int maxIterations,
     double tolerance) {
     
@@ -69,8 +74,8 @@ MatrixSolver::VectorXd MatrixSolver::solveConjugateGradient(
 }
 
 MatrixSolver::VectorXd MatrixSolver::solveGMRES(
-    const MatrixXd& A,
-    const VectorXd& b,
+    const MatrixRef& A,
+    const VectorRef& b,
     int restart,
     int maxIterations,
     double tolerance) {
@@ -96,3 +101,357 @@ MatrixSolver::VectorXd MatrixSolver::solveGMRES(
     
     return x;
 }
+
+MatrixSolver::VectorXd MatrixSolver::solveSparseCG(
+    const SparseMatrix& A,
+    const VectorRef& b,
+    int maxIterations,
+    double tolerance) {
+    
+    Eigen::ConjugateGradient<SparseMatrix, Eigen::Lower | Eigen::Upper> cg;
+    cg.compute(A);
+    
+    if (maxIterations > 0) {
+        cg.setMaxIterations(maxIterations);
+    } else {
+        cg.setMaxIterations(A.cols());
+    }
+    
+    cg.setTolerance(tolerance);
+    VectorXd x = cg.solve(b);
+    
+    std::cout << "Sparse ConjugateGradient Info:" << std::endl;
+    std::cout << "  Iterations: " << cg.iterations() << std::endl;
+    std::cout << "  Estimated error: " << cg.error() << std::endl;
+    
+    return x;
+}
+
+MatrixSolver::IterativeResult MatrixSolver::solveConjugateGradient(
+    const MatrixRef& A,
+    const VectorRef& b,
+    int maxIterations,
+    double tolerance,
+    const SolveControl& control) {
+    
+    if (A.rows() != A.cols() || A.rows() != b.size()) {
+        throw std::invalid_argument("CG needs a square matrix matching the right-hand side");
+    }
+    VectorXd inverseDiagonal = A.diagonal().cwiseInverse();
+    return solvePreconditionedCG(
+        [&](const VectorXd& x) { return VectorXd(A * x); }, b,
+        [&](const VectorXd& r) { return VectorXd(inverseDiagonal.cwiseProduct(r)); }, VectorXd(),
+        maxIterations > 0 ? maxIterations : static_cast<int>(A.cols()), tolerance, control);
+}
+
+MatrixSolver::IterativeResult MatrixSolver::solveSparseCG(
+    const SparseMatrix& A,
+    const VectorRef& b,
+    int maxIterations,
+    double tolerance,
+    const SolveControl& control) {
+    
+    if (A.rows() != A.cols() || A.rows() != b.size()) {
+        throw std::invalid_argument("CG needs a square matrix matching the right-hand side");
+    }
+    VectorXd inverseDiagonal = A.diagonal().cwiseInverse();
+    return solvePreconditionedCG(
+        [&](const VectorXd& x) { return VectorXd(A * x); }, b,
+        [&](const VectorXd& r) { return VectorXd(inverseDiagonal.cwiseProduct(r)); }, VectorXd(),
+        maxIterations > 0 ? maxIterations : static_cast<int>(A.cols()), tolerance, control);
+}
+
+MatrixSolver::IterativeResult MatrixSolver::solveGMRES(
+    const LinearOperator& A,
+    const VectorXd& b,
+    const Preconditioner& M,
+    const VectorXd& x0,
+    int restart,
+    int maxIterations,
+    double tolerance,
+    const SolveControl& control) {
+    
+    if (restart < 1) {
+        throw std::invalid_argument("GMRES restart must be at least 1");
+    }
+    IterativeResult result;
+    result.x = (x0.size() == b.size()) ? x0 : VectorXd::Zero(b.size());
+    
+    double bnorm = norm(b);
+    if (bnorm == 0.0) {
+        result.x.setZero();
+        result.converged = true;
+        return result;
+    }
+    
+    const Eigen::Index n = b.size();
+    const int m = static_cast<int>(std::min<Eigen::Index>(restart, n));
+    MatrixXd V(n, m + 1);
+    MatrixXd H(m + 1, m);
+    VectorXd cs(m);
+    VectorXd sn(m);
+    VectorXd g(m + 1);
+    auto lastReport = Deadline::Clock::now();
+    
+    // x + M⁻¹ V y for the first `columns` Arnoldi vectors
+    auto update = [&](const VectorXd& x, int columns) {
+        if (columns == 0) {
+            return x;
+        }
+        VectorXd y = H.topLeftCorner(columns, columns).triangularView<Eigen::Upper>().solve(g.head(columns));
+        VectorXd step = V.leftCols(columns) * y;
+        return VectorXd(x + (M ? M(step) : step));
+    };
+    
+    VectorXd r = b - A(result.x);
+    result.relativeResidual = norm(r) / bnorm;
+    while (result.relativeResidual > tolerance && result.iterations < maxIterations && !result.interrupted) {
+        double beta = norm(r);
+        V.col(0) = r / beta;
+        H.setZero();
+        g.setZero();
+        g[0] = beta;
+        
+        int columns = 0;
+        while (columns < m && result.iterations < maxIterations) {
+            if (control.stop()) {
+                result.interrupted = true;
+                break;
+            }
+            const int j = columns;
+            VectorXd w = A(M ? M(V.col(j)) : VectorXd(V.col(j)));
+            for (int i = 0; i <= j; ++i) {
+                H(i, j) = dot(w, V.col(i));
+                w -= H(i, j) * V.col(i);
+            }
+            double h = norm(w);
+            H(j + 1, j) = h;
+            
+            // Previous rotations, then a new one zeroing H(j + 1, j)
+            for (int i = 0; i < j; ++i) {
+                double t = cs[i] * H(i, j) + sn[i] * H(i + 1, j);
+                H(i + 1, j) = -sn[i] * H(i, j) + cs[i] * H(i + 1, j);
+                H(i, j) = t;
+            }
+            double radius = std::hypot(H(j, j), H(j + 1, j));
+            cs[j] = radius > 0.0 ? H(j, j) / radius : 1.0;
+            sn[j] = radius > 0.0 ? H(j + 1, j) / radius : 0.0;
+            H(j, j) = radius;
+            H(j + 1, j) = 0.0;
+            g[j + 1] = -sn[j] * g[j];
+            g[j] *= cs[j];
+            
+            ++columns;
+            ++result.iterations;
+            result.relativeResidual = std::abs(g[j + 1]) / bnorm;
+            result.errorEstimate = result.relativeResidual;
+            
+            if (control.progress && std::chrono::duration<double>(Deadline::Clock::now() - lastReport).count()
+                                        >= control.progressInterval) {
+                IterativeResult snapshot = result;
+                snapshot.x = update(result.x, columns);
+                control.progress(snapshot);
+                lastReport = Deadline::Clock::now();
+            }
+            
+            // Converged, or an invariant subspace: the solution lies in the current space
+            if (result.relativeResidual <= tolerance || h <= 1e-14 * beta) {
+                break;
+            }
+            V.col(j + 1) = w / h;
+        }
+        
+        result.x = update(result.x, columns);
+        r = b - A(result.x);
+        result.relativeResidual = norm(r) / bnorm;
+        result.errorEstimate = result.relativeResidual;
+        if (columns == 0) {
+            break;
+        }
+    }
+    
+    result.converged = result.relativeResidual <= tolerance;
+    if (control.progress) {
+        control.progress(result);
+    }
+    return result;
+}
+
+MatrixSolver::VectorXd MatrixSolver::solveSparseCholesky(const SparseMatrix& A, const VectorRef& b) {
+    if (A.rows() != A.cols()) {
+        throw std::invalid_argument("Matrix must be square for Cholesky factorization");
+    }
+    
+    Eigen::SimplicialLDLT<SparseMatrix> ldlt(A);
+    if (ldlt.info() != Eigen::Success) {
+        throw std::runtime_error("Sparse Cholesky factorization failed (matrix not SPD?)");
+    }
+    return ldlt.solve(b);
+}
+
+MatrixSolver::IterativeResult MatrixSolver::solvePreconditionedCG(
+    const LinearOperator& A,
+    const VectorXd& b,
+    const Preconditioner& M,
+    const VectorXd& x0,
+    int maxIterations,
+    double tolerance,
+    const SolveControl& control) {
+    
+    IterativeResult result;
+    result.x = (x0.size() == b.size()) ? x0 : VectorXd::Zero(b.size());
+    
+    double bnorm = norm(b);
+    if (bnorm == 0.0) {
+        result.x.setZero();
+        result.converged = true;
+        return result;
+    }
+    
+    VectorXd r = b - A(result.x);
+    VectorXd z = M ? M(r) : r;
+    VectorXd p = z;
+    double rz = dot(r, z);
+    
+    result.relativeResidual = norm(r) / bnorm;
+    
+    // Preconditioned relative residual √(rᵀM⁻¹r) / √(bᵀM⁻¹b), the quantity the
+    // error bound of cgErrorEstimate needs (equal to ||r|| / ||b|| without M)
+    double bMb = M ? dot(b, M(b)) : bnorm * bnorm;
+    auto preconditioned = [&](double rMr) {
+        return bMb > 0.0 ? std::sqrt(std::max(rMr, 0.0) / bMb) : result.relativeResidual;
+    };
+    double precResidual = preconditioned(rz);
+    double bestPrecResidual = precResidual;
+    
+    // CG coefficients: they define the Lanczos tridiagonal matrix whose
+    // extreme eigenvalues estimate the spectrum of the preconditioned operator
+    std::vector<double> alphas;
+    std::vector<double> betas;
+    
+    // Under a deadline the residual is not monotone, so the best iterate is kept
+    bool controlled = control.active();
+    IterativeResult best;
+    auto lastReport = Deadline::Clock::now();
+    auto finish = [&](IterativeResult& reported, double reportedPrecResidual) {
+        reported.errorEstimate = cgErrorEstimate(alphas, betas, reportedPrecResidual);
+        reported.converged = reported.relativeResidual <= tolerance;
+    };
+    if (controlled) {
+        best = result;
+    }
+    
+    for (int k = 0; k < maxIterations && result.relativeResidual > tolerance; ++k) {
+        if (controlled && control.stop()) {
+            result.interrupted = true;
+            break;
+        }
+        
+        VectorXd Ap = A(p);
+        double pAp = dot(p, Ap);
+        if (pAp <= 0.0) {
+            // Operator is not positive definite along p: stop with the current iterate
+            break;
+        }
+        
+        double alpha = rz / pAp;
+        result.x += alpha * p;
+        r -= alpha * Ap;
+        result.iterations = k + 1;
+        result.relativeResidual = norm(r) / bnorm;
+        alphas.push_back(alpha);
+        
+        z = M ? M(r) : r;
+        double rzNew = dot(r, z);
+        precResidual = preconditioned(rzNew);
+        
+        if (controlled) {
+            if (result.relativeResidual < best.relativeResidual) {
+                best.x = result.x;
+                best.relativeResidual = result.relativeResidual;
+                bestPrecResidual = precResidual;
+            }
+            best.iterations = result.iterations;
+            if (control.progress && std::chrono::duration<double>(Deadline::Clock::now() - lastReport).count()
+                                        >= control.progressInterval) {
+                finish(best, bestPrecResidual);
+                control.progress(best);
+                lastReport = Deadline::Clock::now();
+            }
+        }
+        
+        if (result.relativeResidual <= tolerance) {
+            break;
+        }
+        
+        betas.push_back(rzNew / rz);
+        p = z + (rzNew / rz) * p;
+        rz = rzNew;
+    }
+    
+    if (controlled) {
+        best.interrupted = result.interrupted;
+        result = std::move(best);
+        precResidual = bestPrecResidual;
+    }
+    finish(result, precResidual);
+    if (control.progress) {
+        control.progress(result);
+    }
+    return result;
+}
+
+double MatrixSolver::cgErrorEstimate(const std::vector<double>& alphas,
+                                     const std::vector<double>& betas,
+                                     double preconditionedResidual) {
+    // Lanczos matrix T: T(k,k) = 1/α_k + β_{k-1}/α_{k-1}, T(k,k+1) = sqrt(β_k)/α_k
+    size_t k = alphas.size();
+    if (k == 0) {
+        return preconditionedResidual;
+    }
+    std::vector<double> diagonal(k);
+    std::vector<double> offSquared(k, 0.0);
+    double lower = 1e300;
+    double upper = -1e300;
+    for (size_t i = 0; i < k; ++i) {
+        diagonal[i] = 1.0 / alphas[i] + (i > 0 ? betas[i - 1] / alphas[i - 1] : 0.0);
+        if (i + 1 < k) {
+            offSquared[i] = betas[i] / (alphas[i] * alphas[i]);
+        }
+    }
+    for (size_t i = 0; i < k; ++i) {
+        double radius = (i > 0 ? std::sqrt(offSquared[i - 1]) : 0.0) + std::sqrt(offSquared[i]);
+        lower = std::min(lower, diagonal[i] - radius);
+        upper = std::max(upper, diagonal[i] + radius);
+    }
+
+    // Extreme eigenvalues by Sturm-sequence bisection: O(k) per step instead
+    // of the O(k²) of a full tridiagonal eigensolve, so progress reports stay cheap
+    auto countBelow = [&](double x) {
+        size_t count = 0;
+        double d = 1.0;
+        for (size_t i = 0; i < k; ++i) {
+            d = diagonal[i] - x - (i > 0 ? offSquared[i - 1] / d : 0.0);
+            if (d == 0.0) {
+                d = -1e-300;
+            }
+            if (d < 0.0) {
+                ++count;
+            }
+        }
+        return count;
+    };
+    auto eigenvalue = [&](size_t index) {
+        double lo = lower;
+        double hi = upper;
+        for (int step = 0; step < 100 && hi - lo > 1e-12 * std::max(std::abs(lo), std::abs(hi)); ++step) {
+            double mid = 0.5 * (lo + hi);
+            (countBelow(mid) > index ? hi : lo) = mid;
+        }
+        return 0.5 * (lo + hi);
+    };
+    double lambdaMin = eigenvalue(0);
+    double lambdaMax = eigenvalue(k - 1);
+    double kappa = lambdaMin > 0.0 ? lambdaMax / lambdaMin : 1.0;
+    return kappa * preconditionedResidual;
+}
@@ -1,7 +1,12 @@
 #ifndef MATRIX_SOLVER_H
 #define MATRIX_SOLVER_H
 
+#include "Deadline.h"
+#include "Reduction.h"
 #include <Eigen/Dense>
+#include <Eigen/Sparse>
+#include <atomic>
+#include <functional>
 #include <iostream>
 #include <vector>
 
@@ -19,6 +24,56 @@ class MatrixSolver {
 public:
     using MatrixXd = Eigen::MatrixXd;
     using VectorXd = Eigen::VectorXd;
+    using SparseMatrix = Eigen::SparseMatrix<double>;
+
+    /**
+     * @brief Read-only views accepted by the dense solvers
+     *
+     * Bind to MatrixXd/VectorXd, blocks and mapped external buffers (e.g.
+     * Fortran-ordered numpy arrays) without copying.
+     */
+    using MatrixRef = Eigen::Ref<const MatrixXd>;
+    using VectorRef = Eigen::Ref<const VectorXd>;
+
+    /**
+     * @brief Matrix-free linear operator y = A x
+     */
+    using LinearOperator = std::function<VectorXd(const VectorXd&)>;
+
+    /**
+     * @brief Preconditioner application z = M⁻¹ r
+     */
+    using Preconditioner = std::function<VectorXd(const VectorXd&)>;
+
+    /**
+     * @brief Outcome of an iterative solve
+     */
+    struct IterativeResult {
+        VectorXd x;                   ///< Final iterate
+        int iterations = 0;           ///< Iterations performed
+        double relativeResidual = 0;  ///< ||b - A x|| / ||b||
+        double errorEstimate = 0;     ///< Estimated relative error ||x - x*|| / ||x*|| (M-norm for PCG)
+        bool converged = false;       ///< True if the tolerance was reached
+        bool interrupted = false;     ///< Stopped by the deadline or cancellation
+    };
+
+    /**
+     * @brief Limits and progress reporting of an iterative solve
+     *
+     * With a deadline or a cancellation flag, the solver returns the iterate
+     * with the smallest residual seen so far once either triggers. progress
+     * receives that best iterate at most every progressInterval seconds and
+     * once at the end, e.g. to publish intermediate results (BackgroundSolve).
+     */
+    struct SolveControl {
+        Deadline deadline;
+        const std::atomic<bool>* cancel = nullptr;
+        std::function<void(const IterativeResult&)> progress;
+        double progressInterval = 0.01;
+
+        bool active() const { return deadline.limited() || cancel || progress; }
+        bool stop() const { return deadline.expired() || (cancel && cancel->load(std::memory_order_relaxed)); }
+    };
 
     /**
      * @brief Solve a linear system Ax = b using LU decomposition
@@ -26,7 +81,7 @@ public:
      * @param b Right-hand side vector (n x 1)
      * @return Solution vector x (n x 1)
      */
-    VectorXd solveLU(const MatrixXd& A, const VectorXd& b);
+    VectorXd solveLU(const MatrixRef& A, const VectorRef& b);
 
     /**
      * @brief Solve a linear system Ax = b using QR decomposition
@@ -34,7 +89,7 @@ public:
      * @param b Right-hand side vector (m x 1)
      * @return Solution vector x (n x 1)
      */
-    VectorXd solveQR(const MatrixXd& A, const VectorXd& b);
+    VectorXd solveQR(const MatrixRef& A, const VectorRef& b);
 
     /**
      * @brief Solve Ax = b using Conjugate Gradient (for symmetric positive-definite matrices)
@@ -51,12 +106,27 @@ public:
      * @return Solution vector x
      */
     VectorXd solveConjugateGradient(
-        const MatrixXd& A,
-        const VectorXd& b,
+        const MatrixRef& A,
+        const VectorRef& b,
         int maxIterations = -1,
         double tolerance = 1e-6
     );
 
+    /**
+     * @brief Dense Jacobi-preconditioned CG under a SolveControl
+     * 
+     * The method of solveConjugateGradient (Eigen's default diagonal
+     * preconditioner), run through solvePreconditionedCG so a deadline or
+     * cancellation returns the best iterate. Nothing is printed.
+     */
+    IterativeResult solveConjugateGradient(
+        const MatrixRef& A,
+        const VectorRef& b,
+        int maxIterations,
+        double tolerance,
+        const SolveControl& control
+    );
+
     /**
      * @brief Solve Ax = b using GMRES (for general matrices)
      * 
@@ -73,13 +143,144 @@ public:
      * @return Solution vector x
      */
     VectorXd solveGMRES(
-        const MatrixXd& A,
-        const VectorXd& b,
+        const MatrixRef& A,
+        const VectorRef& b,
         int restart = 30,
         int maxIterations = -1,
         double tolerance = 1e-6
     );
 
+    /**
+     * @brief Restarted GMRES(m) on a matrix-free operator under a SolveControl
+     * 
+     * Right-preconditioned: the Krylov space is built for A M⁻¹, so the
+     * residual minimized (and reported) is that of the original system.
+     * Arnoldi uses modified Gram-Schmidt, the least-squares problem is kept
+     * triangular by Givens rotations. The residual never increases, so on a
+     * deadline or cancellation the current iterate is the best one; it is
+     * formed from the Krylov basis built so far. errorEstimate is the relative
+     * residual (no condition estimate is available for nonsymmetric A).
+     * 
+     * @param A Linear operator (any nonsingular)
+     * @param b Right-hand side vector
+     * @param M Preconditioner (pass nullptr for none)
+     * @param x0 Initial guess (empty vector for zero)
+     * @param restart Krylov dimension m before a restart
+     * @param maxIterations Maximum total inner iterations
+     * @param tolerance Relative residual tolerance ||r|| / ||b||
+     * @param control Deadline, cancellation and progress reporting
+     * @return Final (or, when interrupted, current) iterate and convergence information
+     * @throws std::invalid_argument if restart < 1
+     */
+    IterativeResult solveGMRES(
+        const LinearOperator& A,
+        const VectorXd& b,
+        const Preconditioner& M,
+        const VectorXd& x0,
+        int restart,
+        int maxIterations,
+        double tolerance,
+        const SolveControl& control
+    );
+
+    IterativeResult solveGMRES(
+        const LinearOperator& A,
+        const VectorXd& b,
+        const Preconditioner& M,
+        const VectorXd& x0,
+        int restart,
+        int maxIterations,
+        double tolerance
+    ) {
+        return solveGMRES(A, b, M, x0, restart, maxIterations, tolerance, SolveControl());
+    }
+
+    /**
+     * @brief Solve a sparse SPD system Ax = b using Conjugate Gradient
+     * 
+     * Uses Eigen's ConjugateGradient with a Jacobi preconditioner on the
+     * lower and upper triangle of A.
+     * 
+     * @param A Sparse coefficient matrix (must be SPD)
+     * @param b Right-hand side vector
+     * @param maxIterations Maximum iterations (default: automatic)
+     * @param tolerance Convergence tolerance (default: 1e-6)
+     * @return Solution vector x
+     */
+    VectorXd solveSparseCG(
+        const SparseMatrix& A,
+        const VectorRef& b,
+        int maxIterations = -1,
+        double tolerance = 1e-6
+    );
+
+    /**
+     * @brief Sparse Jacobi-preconditioned CG under a SolveControl
+     * 
+     * Same method as solveSparseCG, run through solvePreconditionedCG so a
+     * deadline or cancellation returns the best iterate. Nothing is printed.
+     */
+    IterativeResult solveSparseCG(
+        const SparseMatrix& A,
+        const VectorRef& b,
+        int maxIterations,
+        double tolerance,
+        const SolveControl& control
+    );
+
+    /**
+     * @brief Solve a sparse SPD system Ax = b using sparse Cholesky (LDLᵀ)
+     * 
+     * @param A Sparse coefficient matrix (must be SPD)
+     * @param b Right-hand side vector
+     * @return Solution vector x
+     */
+    VectorXd solveSparseCholesky(const SparseMatrix& A, const VectorRef& b);
+
+    /**
+     * @brief Preconditioned Conjugate Gradient on a matrix-free operator
+     * 
+     * Building block for inexact inner solves (e.g. Newton-Krylov): the
+     * operator and preconditioner are callbacks, the starting guess is
+     * explicit and nothing is printed.
+     * 
+     * The error estimate uses the bound
+     * ||x - x*||_M / ||x*||_M <= κ(M⁻¹A) · √(rᵀM⁻¹r) / √(bᵀM⁻¹b),
+     * with κ estimated from the extreme eigenvalues of the CG Lanczos matrix.
+     * Without a preconditioner this is κ(A)·||r||/||b|| in the 2-norm. The
+     * Lanczos eigenvalues approach those of M⁻¹A from inside, so early
+     * iterates can still get a low κ; treat the number as an estimate.
+     * 
+     * @param A SPD linear operator
+     * @param b Right-hand side vector
+     * @param M Preconditioner (pass nullptr for none)
+     * @param x0 Initial guess (empty vector for zero)
+     * @param maxIterations Maximum iterations
+     * @param tolerance Relative residual tolerance ||r|| / ||b||
+     * @param control Deadline, cancellation and progress reporting
+     * @return Final (or, when interrupted, best) iterate and convergence information
+     */
+    IterativeResult solvePreconditionedCG(
+        const LinearOperator& A,
+        const VectorXd& b,
+        const Preconditioner& M,
+        const VectorXd& x0,
+        int maxIterations,
+        double tolerance,
+        const SolveControl& control
+    );
+
+    IterativeResult solvePreconditionedCG(
+        const LinearOperator& A,
+        const VectorXd& b,
+        const Preconditioner& M,
+        const VectorXd& x0,
+        int maxIterations,
+        double tolerance
+    ) {
+        return solvePreconditionedCG(A, b, M, x0, maxIterations, tolerance, SolveControl());
+    }
+
     /**
      * @brief Solve a linear system Ax = b using QR decomposition
 
@@ -88,22 +289,26 @@ public:
      * @param A Input matrix
      * @return Determinant value
      */
-    double determinant(const MatrixXd& A);
+    double determinant(const MatrixRef& A);
 
     /**
      * @brief Compute the inverse of a matrix
      * @param A Input matrix
      * @return Inverse matrix
      */
-    MatrixXd inverse(const MatrixXd& A);
+    MatrixXd inverse(const MatrixRef& A);
 
     /**
      * @brief Compute eigenvalues and eigenvectors
+     *
+     * Dense; for the low spectrum of large graph Laplacians use
+     * LaplacianEigensolver (LaplacianSpectrum.h).
+     *
      * @param A Input matrix
      * @param eigenvalues Output eigenvalues
      * @param eigenvectors Output eigenvectors
      */
-    void eigenDecomposition(const MatrixXd& A, VectorXd& eigenvalues, MatrixXd& eigenvectors);
+    void eigenDecomposition(const MatrixRef& A, VectorXd& eigenvalues, MatrixXd& eigenvectors);
 
     /**
      * @brief Print a matrix in a formatted way
@@ -118,6 +323,30 @@ public:
      * @param vector Vector to print
      */
     void printVector(const std::string& name, const VectorXd& vector);
+
+    /**
+     * @brief Reduction used for the dot products and norms of the iterative solvers
+     *
+     * Deterministic (default) gives bitwise identical iterates for any
+     * thread count; Fast uses plain Eigen reductions.
+     */
+    void setReduction(const ReductionOptions& options) { reduction_ = options; }
+    const ReductionOptions& reduction() const { return reduction_; }
+
+    /**
+     * @brief Dot product and norm under the configured reduction
+     */
+    double dot(const VectorRef& x, const VectorRef& y) const { return Reduction::dot(x, y, reduction_); }
+    double norm(const VectorRef& x) const { return Reduction::norm(x, reduction_); }
+
+private:
+    /**
+     * @brief κ·√(rᵀM⁻¹r)/√(bᵀM⁻¹b), κ from the Lanczos matrix of the CG coefficients
+     */
+    static double cgErrorEstimate(const std::vector<double>& alphas, const std::vector<double>& betas,
+                                  double preconditionedResidual);
+
+    ReductionOptions reduction_;
 };
 
 #endif // MATRIX_SOLVER_H
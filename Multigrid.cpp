@@ -0,0 +1,298 @@
+#include "Multigrid.h"
+#include "FactorizationCache.h"
+#include "Reduction.h"
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+namespace {
+
+using SparseMatrix = Eigen::SparseMatrix<double>;
+using Triplet = Eigen::Triplet<double>;
+
+/**
+ * 1D linear interpolation from every other interior point.
+ *
+ * Coarse point c sits on fine point 2c + 1. Fine points between two coarse
+ * points take the average; next to the domain boundary the missing neighbor
+ * is either zero (Dirichlet) or a mirror of the existing one (Neumann).
+ * Returns identity if the direction cannot be coarsened.
+ */
+SparseMatrix prolongation1D(int m, bool neumann) {
+    int mc = m / 2;
+    std::vector<Triplet> t;
+
+    if (mc == 0) {
+        for (int i = 0; i < m; ++i) {
+            t.emplace_back(i, i, 1.0);
+        }
+        SparseMatrix P(m, m);
+        P.setFromTriplets(t.begin(), t.end());
+        return P;
+    }
+
+    for (int i = 0; i < m; ++i) {
+        if (i % 2 == 1) {
+            t.emplace_back(i, i / 2, 1.0);
+            continue;
+        }
+        int left = i / 2 - 1;
+        int right = i / 2;
+        bool hasLeft = left >= 0;
+        bool hasRight = right < mc;
+        if (hasLeft && hasRight) {
+            t.emplace_back(i, left, 0.5);
+            t.emplace_back(i, right, 0.5);
+        } else {
+            double w = neumann ? 1.0 : 0.5;
+            t.emplace_back(i, hasLeft ? left : right, w);
+        }
+    }
+
+    SparseMatrix P(m, mc);
+    P.setFromTriplets(t.begin(), t.end());
+    return P;
+}
+
+/**
+ * Kronecker product Py ⊗ Px for the ordering p = ix + iy * mx
+ */
+SparseMatrix kron(const SparseMatrix& Py, const SparseMatrix& Px) {
+    std::vector<Triplet> t;
+    t.reserve(static_cast<size_t>(Py.nonZeros()) * Px.nonZeros());
+
+    for (int cy = 0; cy < Py.outerSize(); ++cy) {
+        for (SparseMatrix::InnerIterator iy(Py, cy); iy; ++iy) {
+            for (int cx = 0; cx < Px.outerSize(); ++cx) {
+                for (SparseMatrix::InnerIterator ix(Px, cx); ix; ++ix) {
+                    t.emplace_back(ix.row() + iy.row() * Px.rows(),
+                                   cx + cy * Px.cols(),
+                                   ix.value() * iy.value());
+                }
+            }
+        }
+    }
+
+    SparseMatrix P(Px.rows() * Py.rows(), Px.cols() * Py.cols());
+    P.setFromTriplets(t.begin(), t.end());
+    return P;
+}
+
+} // namespace
+
+void Multigrid::build(const SparseMatrix& K, int mx, int my, int minCoarsePoints, int maxLevels) {
+    if (K.rows() != static_cast<Eigen::Index>(mx) * my || K.rows() != K.cols()) {
+        throw std::invalid_argument("Operator size mismatch with interior grid");
+    }
+
+    ops_.clear();
+    prolongations_.clear();
+    ops_.push_back(K);
+
+    while (static_cast<int>(ops_.size()) < maxLevels && mx * my > minCoarsePoints) {
+        SparseMatrix Px = prolongation1D(mx, false);
+        SparseMatrix Py = prolongation1D(my, true);
+        int cmx = static_cast<int>(Px.cols());
+        int cmy = static_cast<int>(Py.cols());
+        if (cmx * cmy == mx * my) {
+            break;
+        }
+
+        SparseMatrix P = kron(Py, Px);
+        SparseMatrix Ac = SparseMatrix(P.transpose()) * ops_.back() * P;
+        Ac.prune(0.0);
+        Ac.makeCompressed();
+
+        prolongations_.push_back(P);
+        ops_.push_back(Ac);
+        mx = cmx;
+        my = cmy;
+    }
+
+    coarse_ = SparseCholeskyFactor::compute(ops_.back());
+}
+
+void Multigrid::smooth(int level, const VectorXd& b, VectorXd& x, int sweeps, bool forward) const {
+    // Gauss-Seidel; the operator is symmetric, so column i holds row i
+    const SparseMatrix& A = ops_[level];
+    int n = static_cast<int>(A.rows());
+
+    for (int s = 0; s < sweeps; ++s) {
+        for (int k = 0; k < n; ++k) {
+            int i = forward ? k : n - 1 - k;
+            double sum = b(i);
+            double diag = 0.0;
+            for (SparseMatrix::InnerIterator it(A, i); it; ++it) {
+                if (it.row() == i) {
+                    diag = it.value();
+                } else {
+                    sum -= it.value() * x(it.row());
+                }
+            }
+            x(i) = sum / diag;
+        }
+    }
+}
+
+void Multigrid::smooth(const VectorXd& b, VectorXd& x, int sweeps) const {
+    if (empty()) {
+        throw std::logic_error("Multigrid hierarchy has not been built");
+    }
+    for (int s = 0; s < sweeps; ++s) {
+        smooth(0, b, x, 1, true);
+        smooth(0, b, x, 1, false);
+    }
+}
+
+void Multigrid::cycle(int level, const VectorXd& b, VectorXd& x) const {
+    if (level == levels() - 1) {
+        x = coarse_.solve(b);
+        return;
+    }
+
+    smooth(level, b, x, preSmoothing, true);
+
+    const SparseMatrix& P = prolongations_[level];
+    VectorXd r = b - ops_[level] * x;
+    VectorXd rc = P.transpose() * r;
+    VectorXd ec = VectorXd::Zero(rc.size());
+    cycle(level + 1, rc, ec);
+    x += P * ec;
+
+    smooth(level, b, x, postSmoothing, false);
+}
+
+void Multigrid::vcycle(const VectorXd& b, VectorXd& x) const {
+    if (empty()) {
+        throw std::logic_error("Multigrid hierarchy has not been built");
+    }
+    if (x.size() != b.size()) {
+        x = VectorXd::Zero(b.size());
+    }
+    cycle(0, b, x);
+}
+
+MatrixSolver::IterativeResult Multigrid::solve(
+    const VectorXd& b,
+    const VectorXd& x0,
+    double tolerance,
+    int maxCycles,
+    const MatrixSolver::SolveControl& control) const {
+
+    MatrixSolver::IterativeResult result;
+    result.x = (x0.size() == b.size()) ? x0 : VectorXd::Zero(b.size());
+
+    double bnorm = Reduction::norm(b);
+    if (bnorm == 0.0) {
+        result.x.setZero();
+        result.converged = true;
+        return result;
+    }
+
+    result.relativeResidual = Reduction::norm(b - ops_[0] * result.x) / bnorm;
+    result.errorEstimate = result.relativeResidual;
+    auto lastReport = Deadline::Clock::now();
+    for (int k = 0; k < maxCycles && result.relativeResidual > tolerance; ++k) {
+        if (control.stop()) {
+            result.interrupted = true;
+            break;
+        }
+        VectorXd previous = result.x;
+        double previousResidual = result.relativeResidual;
+        vcycle(b, result.x);
+        result.iterations = k + 1;
+        result.relativeResidual = Reduction::norm(b - ops_[0] * result.x) / bnorm;
+
+        double q = std::min(result.relativeResidual / previousResidual, 0.99);
+        double xnorm = Reduction::norm(result.x);
+        if (xnorm > 0.0) {
+            result.errorEstimate = q / (1.0 - q) * Reduction::norm(result.x - previous) / xnorm;
+        }
+        if (control.progress && std::chrono::duration<double>(Deadline::Clock::now() - lastReport).count()
+                                    >= control.progressInterval) {
+            control.progress(result);
+            lastReport = Deadline::Clock::now();
+        }
+    }
+
+    result.converged = result.relativeResidual <= tolerance;
+    if (control.progress) {
+        control.progress(result);
+    }
+    return result;
+}
+
+MatrixSolver::Preconditioner Multigrid::preconditioner() const {
+    return [this](const VectorXd& r) {
+        VectorXd z = VectorXd::Zero(r.size());
+        vcycle(r, z);
+        return z;
+    };
+}
+
+Multigrid::VectorXd Multigrid::coarseCorrection(const VectorXd& r, int level) const {
+    if (empty()) {
+        throw std::logic_error("Multigrid hierarchy has not been built");
+    }
+    if (level < 0 || level >= levels()) {
+        level = levels() - 1;
+    }
+
+    // Restrict to the requested level
+    std::vector<VectorXd> rs(level + 1);
+    rs[0] = r;
+    for (int l = 0; l < level; ++l) {
+        rs[l + 1] = prolongations_[l].transpose() * rs[l];
+    }
+
+    VectorXd e = VectorXd::Zero(rs[level].size());
+    if (level == levels() - 1) {
+        e = coarse_.solve(rs[level]);
+    } else {
+        for (int c = 0; c < 2; ++c) {
+            cycle(level, rs[level], e);
+        }
+    }
+
+    // Prolongate back to the finest level
+    for (int l = level - 1; l >= 0; --l) {
+        e = prolongations_[l] * e;
+    }
+    return e;
+}
+
+void Multigrid::store(FactorizationBundle& bundle, const std::string& prefix) const {
+    for (int l = 0; l < levels(); ++l) {
+        bundle.add(prefix + "/L" + std::to_string(l) + "/A", ops_[l]);
+        if (l + 1 < levels()) {
+            bundle.add(prefix + "/L" + std::to_string(l) + "/P", prolongations_[l]);
+        }
+    }
+    bundle.add(prefix + "/coarse", coarse_);
+}
+
+bool Multigrid::load(const FactorizationBundle& bundle, const std::string& prefix) {
+    const SparseCholeskyFactor* coarse = bundle.sparseCholesky(prefix + "/coarse");
+    if (!coarse) {
+        return false;
+    }
+
+    std::vector<SparseMatrix> ops;
+    std::vector<SparseMatrix> prolongations;
+    for (int l = 0; bundle.hasMatrix(prefix + "/L" + std::to_string(l) + "/A"); ++l) {
+        ops.emplace_back(bundle.matrix(prefix + "/L" + std::to_string(l) + "/A"));
+        std::string pName = prefix + "/L" + std::to_string(l) + "/P";
+        if (bundle.hasMatrix(pName)) {
+            prolongations.emplace_back(bundle.matrix(pName));
+        }
+    }
+
+    if (ops.empty() || prolongations.size() + 1 != ops.size() || coarse->size() != ops.back().rows()) {
+        return false;
+    }
+
+    ops_ = std::move(ops);
+    prolongations_ = std::move(prolongations);
+    coarse_ = *coarse;
+    return true;
+}
@@ -0,0 +1,141 @@
+#ifndef MULTIGRID_H
+#define MULTIGRID_H
+
+#include "Factorization.h"
+#include "MatrixSolver.h"
+#include <Eigen/Sparse>
+#include <string>
+#include <vector>
+
+class FactorizationBundle;
+
+/**
+ * @class Multigrid
+ * @brief Geometric multigrid hierarchy for the reduced FDM system
+ *
+ * Coarsens the interior grid of buildReducedFDMSystem by a factor of two per
+ * direction with linear interpolation (Dirichlet plates in x, Neumann edges
+ * in y) and Galerkin coarse operators A_c = Pᵀ A P. The coarsest level is
+ * solved directly with a sparse LDLᵀ factor. Smoothing is symmetric
+ * Gauss-Seidel, so a V-cycle is a valid SPD preconditioner for CG.
+ *
+ * Level 0 is the finest grid; prolongation(l) maps level l + 1 to level l.
+ */
+class Multigrid {
+public:
+    using SparseMatrix = Eigen::SparseMatrix<double>;
+    using VectorXd = Eigen::VectorXd;
+
+    Multigrid() = default;
+
+    /**
+     * @brief Build the hierarchy for the reduced system of an nx x ny grid
+     *
+     * @param K Reduced SPD operator ((nx-2)*(ny-2) square)
+     * @param mx Interior points in x (nx - 2)
+     * @param my Interior points in y (ny - 2)
+     * @param minCoarsePoints Stop coarsening at or below this many unknowns
+     * @param maxLevels Maximum number of levels including the finest
+     */
+    void build(const SparseMatrix& K, int mx, int my, int minCoarsePoints = 256, int maxLevels = 20);
+
+    int levels() const { return static_cast<int>(ops_.size()); }
+    bool empty() const { return ops_.empty(); }
+
+    /**
+     * @brief Operator of a level (0 = finest)
+     */
+    const SparseMatrix& op(int level) const { return ops_[level]; }
+
+    /**
+     * @brief Prolongation from level + 1 to level
+     */
+    const SparseMatrix& prolongation(int level) const { return prolongations_[level]; }
+
+    /**
+     * @brief Number of unknowns of a level
+     */
+    int size(int level) const { return static_cast<int>(ops_[level].rows()); }
+
+    /**
+     * @brief One V(ν, ν) cycle on the finest level
+     * @param b Right-hand side
+     * @param x Initial guess, updated in place
+     */
+    void vcycle(const VectorXd& b, VectorXd& x) const;
+
+    /**
+     * @brief Symmetric Gauss-Seidel sweeps on the finest level
+     * @param b Right-hand side
+     * @param x Current iterate, updated in place
+     * @param sweeps Number of forward + backward sweep pairs
+     */
+    void smooth(const VectorXd& b, VectorXd& x, int sweeps = 1) const;
+
+    /**
+     * @brief Standalone multigrid solve (repeated V-cycles)
+     *
+     * V-cycles contract the energy-norm error, so the last iterate is the
+     * best one when the deadline stops the solve. The error estimate is
+     * q/(1-q)·||Δx||/||x|| with the contraction factor q observed from the
+     * residuals of the last two cycles.
+     *
+     * @param b Right-hand side
+     * @param x0 Initial guess (empty vector for zero)
+     * @param tolerance Relative residual tolerance
+     * @param maxCycles Maximum number of V-cycles
+     * @param control Deadline, cancellation and progress reporting
+     * @return Final iterate and convergence information
+     */
+    MatrixSolver::IterativeResult solve(
+        const VectorXd& b,
+        const VectorXd& x0,
+        double tolerance = 1e-8,
+        int maxCycles = 50,
+        const MatrixSolver::SolveControl& control = MatrixSolver::SolveControl()
+    ) const;
+
+    /**
+     * @brief V-cycle preconditioner for MatrixSolver::solvePreconditionedCG
+     */
+    MatrixSolver::Preconditioner preconditioner() const;
+
+    /**
+     * @brief Smooth far-field correction from a coarse level
+     *
+     * Restricts the residual to the given level, solves there (directly on
+     * the coarsest level, otherwise with two V-cycles) and prolongates the
+     * correction back to the finest grid.
+     *
+     * @param r Fine-level residual
+     * @param level Coarse level to solve on (-1: coarsest)
+     * @return Fine-level correction
+     */
+    VectorXd coarseCorrection(const VectorXd& r, int level = -1) const;
+
+    /**
+     * @brief Store operators, prolongations and the coarse factor in a bundle
+     * @param bundle Destination (see FactorizationCache)
+     * @param prefix Name prefix, e.g. "mg"
+     */
+    void store(FactorizationBundle& bundle, const std::string& prefix = "mg") const;
+
+    /**
+     * @brief Restore a hierarchy written by store()
+     * @return False if the bundle does not contain a hierarchy under prefix
+     */
+    bool load(const FactorizationBundle& bundle, const std::string& prefix = "mg");
+
+    int preSmoothing = 2;
+    int postSmoothing = 2;
+
+private:
+    void cycle(int level, const VectorXd& b, VectorXd& x) const;
+    void smooth(int level, const VectorXd& b, VectorXd& x, int sweeps, bool forward) const;
+
+    std::vector<SparseMatrix> ops_;
+    std::vector<SparseMatrix> prolongations_;
+    SparseCholeskyFactor coarse_;
+};
+
+#endif // MULTIGRID_H
@@ -0,0 +1,260 @@
+#include "NonlinearPoissonSolver.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+ChargeModel ChargeModel::boltzmann(
+    double n0, double temperature, double charge) {
+
+    const double kB = 1.380649e-23;  // J/K
+    double beta = charge / (kB * temperature);
+    double scale = 2.0 * charge * n0;
+
+    ChargeModel model;
+    model.rho = [=](double phi, int) { return -scale * std::sinh(beta * phi); };
+    model.dRho = [=](double phi, int) { return -scale * beta * std::cosh(beta * phi); };
+    return model;
+}
+
+NewtonReport NonlinearPoissonSolver::solveNonlinear(
+    int nx, int ny,
+    double dx, double dy,
+    const std::vector<double>& rhoFixed,
+    const ChargeModel& model,
+    double epsilon,
+    const std::vector<double>& boundaryValues,
+    const NewtonOptions& options,
+    const VectorXd* initialGuess) {
+
+    if (!model.rho || (!model.dRho && !options.jacobianFree)) {
+        throw std::invalid_argument("Charge model needs rho(phi) and, unless Jacobian-free, its derivative");
+    }
+
+    SparseMatrix K;
+    VectorXd f;
+    buildReducedFDMSystem(nx, ny, dx, dy, rhoFixed, epsilon, K, f, boundaryValues);
+
+    int m = static_cast<int>(K.rows());
+    int mx = nx - 2;
+    NewtonReport report;
+
+    // ========== Residual and Jacobian ==========
+    auto residual = [&](const VectorXd& u) {
+        ++report.residualEvaluations;
+        VectorXd F = K * u - f;
+        for (int p = 0; p < m; ++p) {
+            F(p) -= model.rho(u(p), p) / epsilon;
+        }
+        return F;
+    };
+
+    auto jacobianShift = [&](const VectorXd& u) {
+        VectorXd d(m);
+        for (int p = 0; p < m; ++p) {
+            d(p) = -model.dRho(u(p), p) / epsilon;
+        }
+        return d;
+    };
+
+    // ========== Preconditioner (reused across Newton steps) ==========
+    SparseCholeskyFactor ownFactor;
+    const SparseCholeskyFactor* factor = nullptr;
+    if (options.preconditioner && options.preconditioner->size() == m) {
+        factor = options.preconditioner;
+    }
+
+    auto setupPreconditioner = [&](const VectorXd& u) {
+        SparseMatrix J = K;
+        if (model.dRho) {
+            VectorXd d = jacobianShift(u);
+            for (int p = 0; p < m; ++p) {
+                J.coeffRef(p, p) += d(p);
+            }
+        }
+        ownFactor = SparseCholeskyFactor::compute(J);
+        factor = &ownFactor;
+        ++report.preconditionerSetups;
+    };
+
+    // ========== Initial Guess ==========
+    VectorXd u(m);
+    if (initialGuess) {
+        if (initialGuess->size() != static_cast<Eigen::Index>(nx) * ny) {
+            throw std::invalid_argument("Initial guess size mismatch with grid");
+        }
+        for (int j = 1; j <= ny - 2; ++j) {
+            for (int i = 1; i <= mx; ++i) {
+                u((i - 1) + (j - 1) * mx) = (*initialGuess)(coordToIndex(i, j, nx));
+            }
+        }
+    } else if (factor) {
+        // Linear Poisson solution without ρ(φ), preconditioned by the external factor
+        IterativeResult linear = solvePreconditionedCG(
+            [&](const VectorXd& v) { return VectorXd(K * v); }, f,
+            [&](const VectorXd& r) { return factor->solve(r); },
+            VectorXd(), options.maxInnerIterations, 1e-10);
+        u = linear.x;
+    } else {
+        // Linear Poisson solution without ρ(φ)
+        ownFactor = SparseCholeskyFactor::compute(K);
+        factor = &ownFactor;
+        ++report.preconditionerSetups;
+        u = factor->solve(f);
+    }
+
+    // Precondition with the Jacobian at u₀ unless an external factor was given
+    bool external = options.preconditioner && factor == options.preconditioner;
+    if (!external && model.dRho) {
+        setupPreconditioner(u);
+    }
+
+    // ========== Newton Iteration ==========
+    VectorXd F = residual(u);
+    double normF = norm(F);
+    double target = std::max(options.tolerance * normF, options.absoluteTolerance);
+    double eta = std::min(0.5, options.etaMax);
+    double normFPrev = normF;
+    int innerBaseline = -1;
+    bool refreshNext = false;
+
+    report.residualHistory.push_back(normF);
+
+    if (options.verbose) {
+        std::cout << "Newton-Krylov (" << (options.jacobianFree ? "Jacobian-free" : "assembled Jacobian")
+                  << ", " << m << " unknowns)" << std::endl;
+        // Formatting goes through a local stream so the caller's std::cout settings are untouched
+        std::ostringstream line;
+        line << "  step 0: ||F|| = " << std::scientific << std::setprecision(3) << normF;
+        std::cout << line.str() << std::endl;
+    }
+
+    for (int k = 0; k < options.maxNewtonIterations && normF > target; ++k) {
+        // Eisenstat-Walker forcing term (choice 2) with safeguards
+        if (k > 0) {
+            double etaNew = options.ewGamma * std::pow(normF / normFPrev, options.ewAlpha);
+            double safeguard = options.ewGamma * std::pow(eta, options.ewAlpha);
+            if (safeguard > 0.1) {
+                etaNew = std::max(etaNew, safeguard);
+            }
+            // Avoid oversolving near convergence
+            etaNew = std::max(etaNew, 0.5 * target / normF);
+            eta = std::min(etaNew, options.etaMax);
+        }
+
+        bool refresh = refreshNext ||
+            (options.preconditionerRefresh > 0 && k > 0 && k % options.preconditionerRefresh == 0);
+        if (refresh && model.dRho && !external) {
+            setupPreconditioner(u);
+            innerBaseline = -1;
+        }
+        refreshNext = false;
+
+        // Jacobian action
+        VectorXd shift = model.dRho && !options.jacobianFree ? jacobianShift(u) : VectorXd();
+        LinearOperator J;
+        if (options.jacobianFree) {
+            J = [&](const VectorXd& v) {
+                double vnorm = norm(v);
+                if (vnorm == 0.0) {
+                    return VectorXd(VectorXd::Zero(m));
+                }
+                double h = std::sqrt(1e-16) * (1.0 + norm(u)) / vnorm;
+                VectorXd Jv = (residual(u + h * v) - F) / h;
+                return Jv;
+            };
+        } else {
+            J = [&](const VectorXd& v) {
+                VectorXd Jv = K * v + shift.cwiseProduct(v);
+                return Jv;
+            };
+        }
+
+        Preconditioner M = [&](const VectorXd& r) { return factor->solve(r); };
+
+        IterativeResult inner = solvePreconditionedCG(
+            J, -F, M, VectorXd(), options.maxInnerIterations, eta);
+        report.innerIterations += inner.iterations;
+
+        // Refresh the preconditioner once inner solves degrade noticeably
+        if (innerBaseline < 0) {
+            innerBaseline = inner.iterations;
+        } else if (!inner.converged || inner.iterations > 2 * innerBaseline + 10) {
+            refreshNext = true;
+        }
+
+        // Backtracking line search on ||F||
+        const VectorXd& s = inner.x;
+        double lambda = 1.0;
+        bool accepted = false;
+        VectorXd uTrial;
+        VectorXd FTrial;
+        double normTrial = normF;
+
+        for (int ls = 0; ls <= options.maxLineSearchSteps; ++ls) {
+            uTrial = u + lambda * s;
+            FTrial = residual(uTrial);
+            normTrial = norm(FTrial);
+
+            if (std::isfinite(normTrial) &&
+                normTrial <= (1.0 - 1e-4 * lambda * (1.0 - eta)) * normF) {
+                accepted = true;
+                break;
+            }
+
+            // Safeguarded quadratic model of ||F(u + λs)||², clamped to [0.1λ, 0.5λ]
+            double next = 0.5 * lambda;
+            if (std::isfinite(normTrial)) {
+                double g0 = normF * normF;
+                double g1 = normTrial * normTrial;
+                double slope = -2.0 * g0 * (1.0 - eta);
+                double denom = 2.0 * (g1 - g0 - slope * lambda);
+                if (denom > 0.0) {
+                    next = -slope * lambda * lambda / denom;
+                }
+            }
+            lambda = std::min(std::max(next, 0.1 * lambda), 0.5 * lambda);
+        }
+
+        if (!accepted) {
+            if (options.verbose) {
+                std::cout << "  Line search failed at step " << k + 1 << std::endl;
+            }
+            break;
+        }
+
+        u = uTrial;
+        F = FTrial;
+        normFPrev = normF;
+        normF = normTrial;
+        report.newtonIterations = k + 1;
+        report.residualHistory.push_back(normF);
+
+        if (options.verbose) {
+            std::ostringstream line;
+            line << "  step " << k + 1 << ": ||F|| = " << std::scientific << std::setprecision(3) << normF
+                 << ", eta = " << eta << ", CG iterations = " << inner.iterations
+                 << ", lambda = " << std::fixed << std::setprecision(3) << lambda;
+            std::cout << line.str() << std::endl;
+        }
+    }
+
+    report.residualNorm = normF;
+    report.converged = normF <= target;
+    report.phi = expandReducedSolution(nx, ny, u, boundaryValues);
+
+    if (options.verbose) {
+        std::cout << "Newton-Krylov Info:" << std::endl;
+        std::cout << "  Converged: " << (report.converged ? "yes" : "no") << std::endl;
+        std::cout << "  Newton iterations: " << report.newtonIterations << std::endl;
+        std::cout << "  Total CG iterations: " << report.innerIterations << std::endl;
+        std::cout << "  Preconditioner setups: " << report.preconditionerSetups << std::endl;
+        std::ostringstream line;
+        line << "  Final ||F||: " << std::scientific << std::setprecision(3) << report.residualNorm;
+        std::cout << line.str() << std::endl;
+    }
+
+    return report;
+}
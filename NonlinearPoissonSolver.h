@@ -0,0 +1,114 @@
+#ifndef NONLINEAR_POISSON_SOLVER_H
+#define NONLINEAR_POISSON_SOLVER_H
+
+#include "ElectrostaticSolver.h"
+#include "Factorization.h"
+#include <functional>
+#include <vector>
+
+/**
+ * @brief Potential-dependent charge density ρ(φ) and its derivative
+ *
+ * Both callbacks receive the potential and the interior index
+ * (i - 1) + (j - 1) * (nx - 2) of the grid point.
+ */
+struct ChargeModel {
+    std::function<double(double phi, int index)> rho;
+    std::function<double(double phi, int index)> dRho;
+
+    /**
+     * @brief Symmetric 1:1 electrolyte (Poisson-Boltzmann)
+     *
+     * ρ(φ) = -2 q n₀ sinh(q φ / k_B T)
+     *
+     * @param n0 Bulk ion number density (1/m³)
+     * @param temperature Temperature (K)
+     * @param charge Ion charge q (C), default elementary charge
+     */
+    static ChargeModel boltzmann(double n0, double temperature, double charge = 1.602176634e-19);
+};
+
+/**
+ * @brief Newton-Krylov parameters
+ */
+struct NewtonOptions {
+    int maxNewtonIterations = 50;
+    double tolerance = 1e-8;          ///< Stop when ||F|| <= tolerance * ||F(u₀)||
+    double absoluteTolerance = 0.0;   ///< Or when ||F|| <= absoluteTolerance
+    bool jacobianFree = false;        ///< Finite-difference J·v instead of assembled J
+    double etaMax = 0.9;              ///< Upper bound of the forcing term
+    double ewGamma = 0.9;             ///< Eisenstat-Walker γ
+    double ewAlpha = 2.0;             ///< Eisenstat-Walker α
+    int maxInnerIterations = 500;
+    int maxLineSearchSteps = 20;
+    int preconditionerRefresh = 0;    ///< Refactor every N steps (0: only when inner solves degrade)
+    const SparseCholeskyFactor* preconditioner = nullptr;  ///< Optional external factor, e.g. from FactorizationCache
+    bool verbose = true;
+};
+
+/**
+ * @brief Outcome of a nonlinear solve
+ */
+struct NewtonReport {
+    Eigen::VectorXd phi;                   ///< Full-grid potential (layout of buildFDMSystem)
+    int newtonIterations = 0;
+    int innerIterations = 0;               ///< Total CG iterations over all steps
+    int residualEvaluations = 0;
+    int preconditionerSetups = 0;
+    double residualNorm = 0.0;
+    bool converged = false;
+    std::vector<double> residualHistory;   ///< ||F|| after each Newton step (index 0: initial)
+};
+
+/**
+ * @class NonlinearPoissonSolver
+ * @brief Solves ∇·(ε∇φ) = -ρ(φ) with an inexact Newton-Krylov method
+ *
+ * Extends ElectrostaticSolver to potential-dependent charge densities, e.g.
+ * electrolytes (Poisson-Boltzmann) or carriers in semiconductors. The problem
+ * is discretized with the reduced SPD system of buildReducedFDMSystem:
+ *
+ *   F(u) = K u - f - ρ(u)/ε = 0,   J(u) = K - diag(ρ'(u))/ε
+ *
+ * Each Newton step solves J s = -F approximately with preconditioned CG to a
+ * relative tolerance η_k chosen by the Eisenstat-Walker rule (choice 2),
+ * followed by a backtracking line search on ||F||. The Jacobian can be
+ * assembled or applied matrix-free by finite differences (JFNK). One sparse
+ * LDLᵀ preconditioner is reused across Newton steps and only refreshed on
+ * request or when inner iterations degrade.
+ *
+ * The inner CG requires J to be SPD, i.e. ρ'(φ) ≤ 0 everywhere (true for
+ * Poisson-Boltzmann and other screening models). For a model with ρ' > 0, J
+ * can become indefinite; CG then stops at the first direction with pᵀJp ≤ 0
+ * and the Newton step is taken from an unconverged inner solve.
+ */
+class NonlinearPoissonSolver : public ElectrostaticSolver {
+public:
+    /**
+     * @brief Solve the nonlinear Poisson problem on a 2D grid
+     *
+     * @param nx Number of grid points in x-direction
+     * @param ny Number of grid points in y-direction
+     * @param dx Grid spacing in x-direction (m)
+     * @param dy Grid spacing in y-direction (m)
+     * @param rhoFixed Potential-independent charge density at interior points (C/m³)
+     * @param model Potential-dependent charge density
+     * @param epsilon Permittivity (F/m)
+     * @param boundaryValues Boundary potential values (Dirichlet conditions)
+     * @param options Newton-Krylov parameters
+     * @param initialGuess Optional full-grid starting potential (nullptr: linear solve without ρ(φ))
+     * @return Solution and convergence history
+     */
+    NewtonReport solveNonlinear(
+        int nx, int ny,
+        double dx, double dy,
+        const std::vector<double>& rhoFixed,
+        const ChargeModel& model,
+        double epsilon,
+        const std::vector<double>& boundaryValues,
+        const NewtonOptions& options = NewtonOptions(),
+        const VectorXd* initialGuess = nullptr
+    );
+};
+
+#endif // NONLINEAR_POISSON_SOLVER_H
@@ -0,0 +1,400 @@
+#include "OutOfCore.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+/**
+ * @brief Interior points along one grid axis, checked before any file is created
+ */
+int interiorPoints(int n) {
+    if (n < 3) {
+        throw std::invalid_argument("Grid must have at least one interior point");
+    }
+    return n - 2;
+}
+
+std::string vectorPath(const OutOfCoreOptions& options, const char* name) {
+#ifndef _WIN32
+    long pid = static_cast<long>(getpid());
+#else
+    long pid = 0;
+#endif
+    return options.directory + "/" + options.prefix + "_" + std::to_string(pid) + "_" + name + ".bin";
+}
+
+/**
+ * @brief Row-wise partial sums, combined independently of the tiling
+ */
+double rowTotal(const std::vector<double>& rows) {
+    return Reduction::sum(Eigen::Map<const Eigen::VectorXd>(rows.data(), static_cast<Eigen::Index>(rows.size())));
+}
+
+template <typename Term>
+double rowSum(int mx, Term term) {
+    return Reduction::detail::compensatedSum(0, mx, term);
+}
+
+} // namespace
+
+// ========== MappedGridVector ==========
+
+int MappedGridVector::rowsIn(int tile) const {
+    return std::min(tileRows_, my_ - firstRow(tile));
+}
+
+Eigen::VectorXd MappedGridVector::toVector() const {
+    Eigen::VectorXd v(static_cast<Eigen::Index>(mx_) * my_);
+    std::memcpy(v.data(), data_, bytes_);
+    return v;
+}
+
+#ifndef _WIN32
+
+MappedGridVector::MappedGridVector(const std::string& path, int mx, int my, int tileRows, bool removeOnClose)
+    : path_(path), mx_(mx), my_(my), tileRows_(std::max(1, std::min(tileRows, my))),
+      removeOnClose_(removeOnClose), bytes_(static_cast<size_t>(mx) * my * sizeof(double)) {
+
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot create " + path + ": " + std::strerror(errno));
+    }
+    // A sparse file: untouched pages read as zero and take no disk space
+    if (::ftruncate(fd, static_cast<off_t>(bytes_)) != 0) {
+        int error = errno;
+        ::close(fd);
+        ::unlink(path.c_str());
+        throw std::runtime_error("Cannot size " + path + ": " + std::strerror(error));
+    }
+    void* mapping = ::mmap(nullptr, bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        ::unlink(path.c_str());
+        throw std::runtime_error("Cannot map " + path + ": " + std::strerror(errno));
+    }
+    data_ = static_cast<double*>(mapping);
+}
+
+MappedGridVector::~MappedGridVector() {
+    if (data_) {
+        ::munmap(data_, bytes_);
+    }
+    if (removeOnClose_) {
+        ::unlink(path_.c_str());
+    }
+}
+
+void MappedGridVector::advise(int tile, int advice) const {
+    if (tile < 0 || tile >= tiles()) {
+        return;
+    }
+    // madvise needs page-aligned ranges; neighbouring pages are only re-read
+    static const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    size_t begin = static_cast<size_t>(firstRow(tile)) * mx_ * sizeof(double);
+    size_t end = begin + static_cast<size_t>(rowsIn(tile)) * mx_ * sizeof(double);
+    begin = begin / page * page;
+    ::madvise(reinterpret_cast<char*>(data_) + begin, end - begin, advice);
+}
+
+void MappedGridVector::prefetch(int tile) const {
+    advise(tile, MADV_WILLNEED);
+}
+
+void MappedGridVector::release(int tile) const {
+    advise(tile, MADV_DONTNEED);
+}
+
+#else
+
+MappedGridVector::MappedGridVector(const std::string& path, int mx, int my, int tileRows, bool removeOnClose)
+    : path_(path), mx_(mx), my_(my), tileRows_(tileRows), removeOnClose_(removeOnClose) {
+    throw std::runtime_error("MappedGridVector requires POSIX mmap");
+}
+
+MappedGridVector::~MappedGridVector() = default;
+
+void MappedGridVector::advise(int, int) const {
+}
+
+void MappedGridVector::prefetch(int) const {
+}
+
+void MappedGridVector::release(int) const {
+}
+
+#endif
+
+// ========== OutOfCoreSolver ==========
+
+int OutOfCoreSolver::tileRowsFor(int mx, int my, size_t memoryBytes) {
+    // Three resident tiles (previous, current, prefetched) of five vectors
+    double rowBytes = 15.0 * mx * sizeof(double);
+    int rows = static_cast<int>(static_cast<double>(memoryBytes) / rowBytes);
+    return std::max(1, std::min(rows, my));
+}
+
+OutOfCoreSolver::OutOfCoreSolver(int nx, int ny, double dx, double dy, double epsilon,
+                                 const OutOfCoreOptions& options)
+    : mx_(interiorPoints(nx)), my_(interiorPoints(ny)), cx_(1.0 / (dx * dx)), cy_(1.0 / (dy * dy)), epsilon_(epsilon),
+      tileRows_(options.tileRows > 0 ? std::min(options.tileRows, my_) : tileRowsFor(mx_, my_, options.memoryBytes)),
+      options_(options),
+      x_(vectorPath(options, "x"), mx_, my_, tileRows_, !options.keepSolution),
+      b_(vectorPath(options, "b"), mx_, my_, tileRows_),
+      r_(vectorPath(options, "r"), mx_, my_, tileRows_),
+      p_(vectorPath(options, "p"), mx_, my_, tileRows_),
+      q_(vectorPath(options, "q"), mx_, my_, tileRows_) {}
+
+double OutOfCoreSolver::diagonal(int j) const {
+    // Neumann edges (mirror value) remove the missing y-neighbor
+    return 2.0 * (cx_ + cy_) - (j == 0 ? cy_ : 0.0) - (j == my_ - 1 ? cy_ : 0.0);
+}
+
+void OutOfCoreSolver::stencilRow(const MappedGridVector& v, int j, double* out) const {
+    const double* row = v.row(j);
+    const double* below = j > 0 ? v.row(j - 1) : nullptr;
+    const double* above = j < my_ - 1 ? v.row(j + 1) : nullptr;
+    double d = diagonal(j);
+    for (int i = 0; i < mx_; ++i) {
+        double value = d * row[i];
+        if (i > 0) {
+            value -= cx_ * row[i - 1];
+        }
+        if (i < mx_ - 1) {
+            value -= cx_ * row[i + 1];
+        }
+        if (below) {
+            value -= cy_ * below[i];
+        }
+        if (above) {
+            value -= cy_ * above[i];
+        }
+        out[i] = value;
+    }
+}
+
+void OutOfCoreSolver::stream(std::initializer_list<const MappedGridVector*> read,
+                             std::initializer_list<const MappedGridVector*> written,
+                             bool forward, const std::function<void(int tile)>& body) {
+    std::vector<const MappedGridVector*> all(read);
+    for (const MappedGridVector* v : written) {
+        if (std::find(all.begin(), all.end(), v) == all.end()) {
+            all.push_back(v);
+        }
+    }
+
+    int tiles = x_.tiles();
+    int step = forward ? 1 : -1;
+    int first = forward ? 0 : tiles - 1;
+    for (const MappedGridVector* v : all) {
+        v->prefetch(first);
+    }
+    for (int t = first; t >= 0 && t < tiles; t += step) {
+        // Read ahead while this tile is computed
+        if (t + step >= 0 && t + step < tiles) {
+            for (const MappedGridVector* v : all) {
+                v->prefetch(t + step);
+            }
+            io_.tilesPrefetched += static_cast<long>(all.size());
+        }
+
+        body(t);
+
+        double tileBytes = static_cast<double>(x_.rowsIn(t)) * mx_ * sizeof(double);
+        io_.bytesRead += tileBytes * read.size();
+        io_.bytesWritten += tileBytes * written.size();
+
+        // The previous tile was needed for this tile's halo row; drop it now
+        for (const MappedGridVector* v : all) {
+            v->release(t - step);
+        }
+    }
+    for (const MappedGridVector* v : all) {
+        v->release(forward ? tiles - 1 : 0);
+    }
+}
+
+void OutOfCoreSolver::setRightHandSide(const std::function<double(int, int)>& rho,
+                                       const std::vector<double>& leftPlate,
+                                       const std::vector<double>& rightPlate) {
+    auto plate = [](const std::vector<double>& values, int j) {
+        return static_cast<size_t>(j) < values.size() ? values[j] : 0.0;
+    };
+    stream({}, {&b_}, true, [&](int tile) {
+        for (int j = x_.firstRow(tile); j < x_.firstRow(tile) + x_.rowsIn(tile); ++j) {
+            double* row = b_.row(j);
+            for (int i = 0; i < mx_; ++i) {
+                row[i] = rho ? rho(i + 1, j + 1) / epsilon_ : 0.0;
+            }
+            row[0] += cx_ * plate(leftPlate, j + 1);
+            row[mx_ - 1] += cx_ * plate(rightPlate, j + 1);
+        }
+    });
+}
+
+double OutOfCoreSolver::relativeResidual() {
+    std::vector<double> rr(my_);
+    std::vector<double> bb(my_);
+    std::vector<double> Kx(mx_);
+    stream({&x_, &b_}, {}, true, [&](int tile) {
+        for (int j = x_.firstRow(tile); j < x_.firstRow(tile) + x_.rowsIn(tile); ++j) {
+            stencilRow(x_, j, Kx.data());
+            const double* b = b_.row(j);
+            rr[j] = rowSum(mx_, [&](long i) { return (b[i] - Kx[i]) * (b[i] - Kx[i]); });
+            bb[j] = rowSum(mx_, [&](long i) { return b[i] * b[i]; });
+        }
+    });
+    double bnorm = std::sqrt(rowTotal(bb));
+    return bnorm > 0.0 ? std::sqrt(rowTotal(rr)) / bnorm : 0.0;
+}
+
+OutOfCoreResult OutOfCoreSolver::solve(int maxIterations, double tolerance,
+                                       const MatrixSolver::SolveControl& control) {
+    auto t0 = std::chrono::steady_clock::now();
+    IoStats start = io_;
+    OutOfCoreResult result;
+
+    std::vector<double> rowA(my_);
+    std::vector<double> rowB(my_);
+    std::vector<double> rowC(my_);
+    std::vector<double> Kx(mx_);
+
+    // r = b - K x, p = z = D⁻¹ r
+    stream({&x_, &b_}, {&r_, &p_}, true, [&](int tile) {
+        for (int j = x_.firstRow(tile); j < x_.firstRow(tile) + x_.rowsIn(tile); ++j) {
+            stencilRow(x_, j, Kx.data());
+            const double* b = b_.row(j);
+            double* r = r_.row(j);
+            double* p = p_.row(j);
+            double inverse = 1.0 / diagonal(j);
+            for (int i = 0; i < mx_; ++i) {
+                r[i] = b[i] - Kx[i];
+                p[i] = inverse * r[i];
+            }
+            rowA[j] = rowSum(mx_, [&](long i) { return r[i] * r[i]; });
+            rowB[j] = rowSum(mx_, [&](long i) { return inverse * r[i] * r[i]; });
+            rowC[j] = rowSum(mx_, [&](long i) { return b[i] * b[i]; });
+        }
+    });
+    double bnorm = std::sqrt(rowTotal(rowC));
+    double rz = rowTotal(rowB);
+    result.relativeResidual = bnorm > 0.0 ? std::sqrt(rowTotal(rowA)) / bnorm : 0.0;
+    IoStats setup = io_;
+
+    for (int k = 0; k < maxIterations && result.relativeResidual > tolerance; ++k) {
+        if (control.stop()) {
+            result.interrupted = true;
+            break;
+        }
+
+        // q = K p, p·q
+        stream({&p_}, {&q_}, true, [&](int tile) {
+            for (int j = x_.firstRow(tile); j < x_.firstRow(tile) + x_.rowsIn(tile); ++j) {
+                double* q = q_.row(j);
+                stencilRow(p_, j, q);
+                const double* p = p_.row(j);
+                rowA[j] = rowSum(mx_, [&](long i) { return p[i] * q[i]; });
+            }
+        });
+        double pq = rowTotal(rowA);
+        if (pq <= 0.0) {
+            break;
+        }
+        double alpha = rz / pq;
+
+        // x += α p, r -= α q, r·r and r·z
+        stream({&x_, &p_, &r_, &q_}, {&x_, &r_}, true, [&](int tile) {
+            for (int j = x_.firstRow(tile); j < x_.firstRow(tile) + x_.rowsIn(tile); ++j) {
+                double* x = x_.row(j);
+                double* r = r_.row(j);
+                const double* p = p_.row(j);
+                const double* q = q_.row(j);
+                for (int i = 0; i < mx_; ++i) {
+                    x[i] += alpha * p[i];
+                    r[i] -= alpha * q[i];
+                }
+                double inverse = 1.0 / diagonal(j);
+                rowA[j] = rowSum(mx_, [&](long i) { return r[i] * r[i]; });
+                rowB[j] = rowSum(mx_, [&](long i) { return inverse * r[i] * r[i]; });
+            }
+        });
+        result.iterations = k + 1;
+        result.relativeResidual = std::sqrt(rowTotal(rowA)) / bnorm;
+        if (result.relativeResidual <= tolerance) {
+            break;
+        }
+        double rzNew = rowTotal(rowB);
+        double beta = rzNew / rz;
+        rz = rzNew;
+
+        // p = D⁻¹ r + β p
+        stream({&r_, &p_}, {&p_}, true, [&](int tile) {
+            for (int j = x_.firstRow(tile); j < x_.firstRow(tile) + x_.rowsIn(tile); ++j) {
+                const double* r = r_.row(j);
+                double* p = p_.row(j);
+                double inverse = 1.0 / diagonal(j);
+                for (int i = 0; i < mx_; ++i) {
+                    p[i] = inverse * r[i] + beta * p[i];
+                }
+            }
+        });
+    }
+
+    result.converged = result.relativeResidual <= tolerance;
+    result.io.bytesRead = io_.bytesRead - start.bytesRead;
+    result.io.bytesWritten = io_.bytesWritten - start.bytesWritten;
+    result.io.tilesPrefetched = io_.tilesPrefetched - start.tilesPrefetched;
+    if (result.iterations > 0) {
+        result.bytesPerIteration = (io_.total() - setup.total()) / result.iterations;
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return result;
+}
+
+void OutOfCoreSolver::smooth(int sweeps) {
+    // Lexicographic Gauss-Seidel is in place and reads rows in streaming
+    // order: row j-1 is already updated, row j+1 is still old
+    auto sweep = [&](bool forward) {
+        stream({&x_, &b_}, {&x_}, forward, [&](int tile) {
+            int begin = x_.firstRow(tile);
+            int end = begin + x_.rowsIn(tile);
+            for (int j = forward ? begin : end - 1; forward ? j < end : j >= begin; j += forward ? 1 : -1) {
+                double* x = x_.row(j);
+                const double* b = b_.row(j);
+                const double* below = j > 0 ? x_.row(j - 1) : nullptr;
+                const double* above = j < my_ - 1 ? x_.row(j + 1) : nullptr;
+                double inverse = 1.0 / diagonal(j);
+                for (int n = 0; n < mx_; ++n) {
+                    int i = forward ? n : mx_ - 1 - n;
+                    double sum = b[i];
+                    if (i > 0) {
+                        sum += cx_ * x[i - 1];
+                    }
+                    if (i < mx_ - 1) {
+                        sum += cx_ * x[i + 1];
+                    }
+                    if (below) {
+                        sum += cy_ * below[i];
+                    }
+                    if (above) {
+                        sum += cy_ * above[i];
+                    }
+                    x[i] = inverse * sum;
+                }
+            }
+        });
+    };
+    for (int s = 0; s < sweeps; ++s) {
+        sweep(true);
+        sweep(false);
+    }
+}
@@ -0,0 +1,186 @@
+#ifndef OUT_OF_CORE_H
+#define OUT_OF_CORE_H
+
+#include "MatrixSolver.h"
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Logical tile traffic between the solver and its mapped files
+ */
+struct IoStats {
+    double bytesRead = 0.0;
+    double bytesWritten = 0.0;
+    long tilesPrefetched = 0;
+
+    double total() const { return bytesRead + bytesWritten; }
+};
+
+/**
+ * @class MappedGridVector
+ * @brief Interior grid vector stored in a memory-mapped file, split into row tiles
+ *
+ * Values are stored x fastest (index i + j*mx), so tile t is the contiguous
+ * band of rows [t·tileRows, (t+1)·tileRows). Row bands are the natural tile
+ * for the 5-point stencil: a tile needs only one halo row from each
+ * neighbouring tile. prefetch() asks the kernel to read a tile ahead
+ * (MADV_WILLNEED); release() drops it from the process (MADV_DONTNEED), after
+ * which dirty pages are written back from the page cache.
+ */
+class MappedGridVector {
+public:
+    /**
+     * @brief Create (or truncate) the backing file and map it
+     * @param removeOnClose Delete the file when the vector is destroyed
+     * @throws std::runtime_error if the file cannot be created or mapped
+     */
+    MappedGridVector(const std::string& path, int mx, int my, int tileRows, bool removeOnClose = true);
+    ~MappedGridVector();
+
+    MappedGridVector(const MappedGridVector&) = delete;
+    MappedGridVector& operator=(const MappedGridVector&) = delete;
+
+    int mx() const { return mx_; }
+    int my() const { return my_; }
+    int tileRows() const { return tileRows_; }
+    int tiles() const { return (my_ + tileRows_ - 1) / tileRows_; }
+    int firstRow(int tile) const { return tile * tileRows_; }
+    int rowsIn(int tile) const;
+
+    double* row(int j) { return data_ + static_cast<size_t>(j) * mx_; }
+    const double* row(int j) const { return data_ + static_cast<size_t>(j) * mx_; }
+
+    void prefetch(int tile) const;
+    void release(int tile) const;
+
+    /**
+     * @brief Copy into memory (for grids that fit, e.g. verification)
+     */
+    Eigen::VectorXd toVector() const;
+
+    const std::string& path() const { return path_; }
+
+private:
+    void advise(int tile, int advice) const;
+
+    std::string path_;
+    int mx_;
+    int my_;
+    int tileRows_;
+    bool removeOnClose_;
+    double* data_ = nullptr;
+    size_t bytes_ = 0;
+};
+
+/**
+ * @brief Storage and tiling of an out-of-core solve
+ */
+struct OutOfCoreOptions {
+    std::string directory = "/tmp";     // Location of the vector files
+    std::string prefix = "ooc";         // File names <prefix>_<pid>_<vector>.bin
+    size_t memoryBytes = 64u << 20;     // Resident tile window of all vectors
+    int tileRows = 0;                   // Rows per tile (0: derived from memoryBytes)
+    bool keepSolution = false;          // Keep the solution file after destruction
+};
+
+/**
+ * @brief Outcome of OutOfCoreSolver::solve
+ */
+struct OutOfCoreResult {
+    int iterations = 0;
+    double relativeResidual = 0.0;
+    bool converged = false;
+    bool interrupted = false;
+    IoStats io;                         // Whole solve, including setup passes
+    double bytesPerIteration = 0.0;
+    double seconds = 0.0;
+};
+
+/**
+ * @class OutOfCoreSolver
+ * @brief Jacobi-preconditioned CG on the reduced Poisson system with file-backed vectors
+ *
+ * Solves the system of ElectrostaticSolver::buildReducedFDMSystem (Dirichlet
+ * plates left and right, Neumann top and bottom) without assembling K: the
+ * 5-point stencil is applied matrix-free, and the vectors x, b, r, p and q
+ * live in MappedGridVector files. Every kernel streams over the tiles in
+ * order, prefetches tile t+1 while computing tile t and releases tile t-1
+ * afterwards, so only about three tiles per vector are resident.
+ *
+ * An iteration makes three passes: q = K·p with p·q, then the x and r
+ * updates with r·z, then p = z + β·p. That reads seven and writes four
+ * vectors, 11·m·8 bytes. io() and OutOfCoreResult report the bytes requested
+ * from the mapped files (logical tile sizes), not device traffic, which the
+ * page cache may absorb.
+ */
+class OutOfCoreSolver {
+public:
+    /**
+     * @throws std::invalid_argument for grids without interior points, before
+     *         any vector file is created
+     * @throws std::runtime_error if the vector files cannot be created
+     */
+    OutOfCoreSolver(int nx, int ny, double dx, double dy, double epsilon,
+                    const OutOfCoreOptions& options = OutOfCoreOptions());
+
+    /**
+     * @brief Stream the right-hand side into b
+     * @param rho Charge density at interior point (i, j), 1 <= i <= nx-2 (nullptr: none)
+     * @param leftPlate Potential at i = 0 for each j (empty: grounded)
+     * @param rightPlate Potential at i = nx-1 for each j (empty: grounded)
+     */
+    void setRightHandSide(const std::function<double(int, int)>& rho,
+                          const std::vector<double>& leftPlate,
+                          const std::vector<double>& rightPlate);
+
+    /**
+     * @brief Solve from the current x (zero after construction)
+     * @param control Deadline and cancellation, checked once per iteration
+     */
+    OutOfCoreResult solve(int maxIterations, double tolerance,
+                          const MatrixSolver::SolveControl& control = MatrixSolver::SolveControl());
+
+    /**
+     * @brief Symmetric Gauss-Seidel sweeps on x, streamed forward then backward
+     */
+    void smooth(int sweeps = 1);
+
+    /**
+     * @brief Relative residual ||b - K x|| / ||b|| of the current x
+     */
+    double relativeResidual();
+
+    const MappedGridVector& solution() const { return x_; }
+    int tileRows() const { return tileRows_; }
+    const IoStats& io() const { return io_; }
+
+    /**
+     * @brief Rows per tile so that three tiles of five vectors fit in memoryBytes
+     */
+    static int tileRowsFor(int mx, int my, size_t memoryBytes);
+
+private:
+    double diagonal(int j) const;
+    void stencilRow(const MappedGridVector& v, int j, double* out) const;
+    void stream(std::initializer_list<const MappedGridVector*> read,
+                std::initializer_list<const MappedGridVector*> written,
+                bool forward, const std::function<void(int tile)>& body);
+
+    int mx_;
+    int my_;
+    double cx_;
+    double cy_;
+    double epsilon_;
+    int tileRows_;
+    OutOfCoreOptions options_;
+    MappedGridVector x_;
+    MappedGridVector b_;
+    MappedGridVector r_;
+    MappedGridVector p_;
+    MappedGridVector q_;
+    IoStats io_;
+};
+
+#endif // OUT_OF_CORE_H
@@ -0,0 +1,73 @@
+#ifndef PARALLEL_FOR_H
+#define PARALLEL_FOR_H
+
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Thread count to use: `threads` if positive, else the hardware concurrency
+ */
+inline int resolveThreads(int threads) {
+    return threads > 0 ? threads : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+}
+
+/**
+ * @brief splitmix64 finalizer
+ *
+ * Random values drawn as splitMix64(f(seed, index)) depend on the index only,
+ * not on which chunk or thread computes them.
+ */
+inline std::uint64_t splitMix64(std::uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+/**
+ * @brief Run body(begin, end) on contiguous chunks of [0, count) in parallel
+ *
+ * Chunk t of `threads` covers [count·t/threads, count·(t+1)/threads), so the
+ * split depends only on count and threads. The calling thread runs the last
+ * chunk; an exception thrown by any chunk is rethrown after all have joined.
+ *
+ * @param threads Number of chunks (≤ 1 runs body(0, count) inline)
+ * @param count Number of items
+ * @param body Callable taking (long begin, long end)
+ */
+template <typename Body>
+void parallelFor(int threads, long count, Body body) {
+    threads = static_cast<int>(std::max(1L, std::min<long>(threads, count)));
+    if (threads == 1) {
+        body(0L, count);
+        return;
+    }
+
+    std::vector<std::thread> pool;
+    std::vector<std::exception_ptr> errors(threads);
+    auto chunk = [&](int t) {
+        try {
+            body(count * t / threads, count * (t + 1) / threads);
+        } catch (...) {
+            errors[t] = std::current_exception();
+        }
+    };
+
+    for (int t = 0; t + 1 < threads; ++t) {
+        pool.emplace_back(chunk, t);
+    }
+    chunk(threads - 1);
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    for (auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+#endif // PARALLEL_FOR_H
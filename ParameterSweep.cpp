@@ -0,0 +1,543 @@
+#include "ParameterSweep.h"
+#include "ElectrostaticSolver.h"
+#include "Factorization.h"
+#include "FrameStream.h"
+#include "JobScheduler.h"
+#include "MatrixSolver.h"
+#include "ParallelFor.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+const double EPSILON_0 = 8.854e-12;   // F/m
+
+// Points at least this large may be solved with several threads
+const long PARALLEL_SOLVE_UNKNOWNS = 100000;
+
+/**
+ * y = K x for symmetric K, rows computed in parallel from the columns
+ */
+Eigen::VectorXd multiplySymmetric(const MatrixSolver::SparseMatrix& K, const Eigen::VectorXd& x, int threads) {
+    Eigen::VectorXd y(K.cols());
+    parallelFor(threads, K.outerSize(), [&](long begin, long end) {
+        for (long i = begin; i < end; ++i) {
+            double sum = 0.0;
+            for (MatrixSolver::SparseMatrix::InnerIterator it(K, i); it; ++it) {
+                sum += it.value() * x[it.row()];
+            }
+            y[i] = sum;
+        }
+    });
+    return y;
+}
+
+std::string trim(const std::string& s) {
+    size_t a = s.find_first_not_of(" \t\r\n");
+    if (a == std::string::npos) {
+        return "";
+    }
+    size_t b = s.find_last_not_of(" \t\r\n");
+    return s.substr(a, b - a + 1);
+}
+
+std::vector<std::string> split(const std::string& s, char delimiter) {
+    std::vector<std::string> parts;
+    std::stringstream in(s);
+    std::string item;
+    while (std::getline(in, item, delimiter)) {
+        item = trim(item);
+        if (!item.empty()) {
+            parts.push_back(item);
+        }
+    }
+    return parts;
+}
+
+double toDouble(const std::string& s) {
+    size_t used = 0;
+    double v = std::stod(s, &used);
+    if (used != s.size()) {
+        throw std::invalid_argument("Invalid number: " + s);
+    }
+    return v;
+}
+
+/**
+ * Comma-separated list or inclusive start:stop:count range
+ */
+std::vector<double> parseValues(const std::string& text) {
+    std::vector<double> values;
+    for (const std::string& item : split(text, ',')) {
+        std::vector<std::string> range = split(item, ':');
+        if (range.size() == 3) {
+            double start = toDouble(range[0]);
+            double stop = toDouble(range[1]);
+            int count = std::stoi(range[2]);
+            if (count < 1) {
+                throw std::invalid_argument("Range needs at least one point: " + item);
+            }
+            for (int k = 0; k < count; ++k) {
+                values.push_back(count == 1 ? start : start + (stop - start) * k / (count - 1));
+            }
+        } else if (range.size() == 1) {
+            values.push_back(toDouble(range[0]));
+        } else {
+            throw std::invalid_argument("Invalid value or range: " + item);
+        }
+    }
+    if (values.empty()) {
+        throw std::invalid_argument("Empty value list");
+    }
+    return values;
+}
+
+std::uint64_t fnv1a(const std::string& s) {
+    std::uint64_t h = 1469598103934665603ull;
+    for (unsigned char c : s) {
+        h ^= c;
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+std::string formatDouble(double v) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.17g", v);
+    return buffer;
+}
+
+const size_t RESULT_COLUMNS = 13;
+
+} // namespace
+
+// ========== SweepPoint ==========
+
+std::string SweepPoint::runId() const {
+    std::string key = "nx=" + std::to_string(nx) + ";ny=" + std::to_string(ny) +
+                      ";h=" + formatDouble(spacing) + ";V=" + formatDouble(voltage) +
+                      ";er=" + formatDouble(epsilonR) + ";charge=" + charge;
+    char buffer[17];
+    std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(fnv1a(key)));
+    return buffer;
+}
+
+// ========== SweepDefinition ==========
+
+SweepDefinition SweepDefinition::parse(std::istream& in) {
+    SweepDefinition definition;
+    std::string line;
+    int lineNumber = 0;
+
+    while (std::getline(in, line)) {
+        ++lineNumber;
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) {
+            continue;
+        }
+
+        size_t eq = line.find('=');
+        if (eq == std::string::npos) {
+            throw std::invalid_argument("Line " + std::to_string(lineNumber) + ": expected key = values");
+        }
+        std::string key = trim(line.substr(0, eq));
+        std::string value = trim(line.substr(eq + 1));
+
+        try {
+            if (key == "grid") {
+                definition.grids.clear();
+                for (const std::string& item : split(value, ',')) {
+                    size_t x = item.find('x');
+                    if (x == std::string::npos) {
+                        throw std::invalid_argument("Grid must be NXxNY: " + item);
+                    }
+                    int gx = std::stoi(item.substr(0, x));
+                    int gy = std::stoi(item.substr(x + 1));
+                    if (gx < 3 || gy < 3) {
+                        throw std::invalid_argument("Grid needs at least 3x3 points: " + item);
+                    }
+                    definition.grids.push_back({gx, gy});
+                }
+            } else if (key == "spacing") {
+                definition.spacings = parseValues(value);
+            } else if (key == "voltage") {
+                definition.voltages = parseValues(value);
+            } else if (key == "epsilon_r") {
+                definition.relativePermittivities = parseValues(value);
+            } else if (key == "charge") {
+                definition.charges = split(value, ';');
+                for (const std::string& layout : definition.charges) {
+                    ParameterSweep::chargeDensity(layout, 3, 3, 1.0);   // Validate early
+                }
+            } else {
+                throw std::invalid_argument("Unknown key '" + key + "'");
+            }
+        } catch (const std::exception& e) {
+            throw std::invalid_argument("Line " + std::to_string(lineNumber) + ": " + e.what());
+        }
+    }
+
+    if (definition.grids.empty() || definition.charges.empty()) {
+        throw std::invalid_argument("Sweep definition has an empty grid or charge list");
+    }
+    return definition;
+}
+
+SweepDefinition SweepDefinition::fromFile(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("Cannot open sweep definition: " + path);
+    }
+    return parse(in);
+}
+
+std::vector<SweepPoint> SweepDefinition::points() const {
+    std::vector<SweepPoint> result;
+    for (const auto& grid : grids) {
+        for (double h : spacings) {
+            for (double v : voltages) {
+                for (const std::string& charge : charges) {
+                    for (double er : relativePermittivities) {
+                        SweepPoint p;
+                        p.nx = grid.first;
+                        p.ny = grid.second;
+                        p.spacing = h;
+                        p.voltage = v;
+                        p.charge = charge;
+                        p.epsilonR = er;
+                        result.push_back(p);
+                    }
+                }
+            }
+        }
+    }
+    return result;
+}
+
+// ========== ResultsLog ==========
+
+std::string ResultsLog::header() {
+    return "run_id,nx,ny,spacing,voltage,charge,epsilon_r,phi_min,phi_max,e_max,energy,solve_ms,status";
+}
+
+ResultsLog::ResultsLog(const std::string& path)
+    : path_(path) {
+
+    std::string content;
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (in) {
+            std::ostringstream buffer;
+            buffer << in.rdbuf();
+            content = buffer.str();
+        }
+    }
+
+    // Complete rows end with a newline and the "ok" status column
+    size_t start = 0;
+    while (start < content.size()) {
+        size_t end = content.find('\n', start);
+        if (end == std::string::npos) {
+            break;
+        }
+        std::string line = trim(content.substr(start, end - start));
+        start = end + 1;
+
+        std::vector<std::string> columns;
+        std::stringstream in(line);
+        std::string column;
+        while (std::getline(in, column, ',')) {
+            columns.push_back(column);
+        }
+        if (columns.size() == RESULT_COLUMNS && columns.back() == "ok") {
+            done_.insert(columns.front());
+            try {
+                long unknowns = static_cast<long>(std::stoi(columns[1]) - 2) * (std::stoi(columns[2]) - 2);
+                timings_.push_back({unknowns, std::stod(columns[11]) / 1000.0});
+            } catch (const std::exception&) {
+                // Timing column unreadable; the run ID still counts
+            }
+        }
+    }
+
+    std::ofstream out(path, std::ios::app | std::ios::binary);
+    if (!out) {
+        throw std::runtime_error("Cannot open results file: " + path);
+    }
+    if (content.empty()) {
+        out << header() << "\n";
+    } else if (content.back() != '\n') {
+        out << "\n";   // Terminate a row cut off by an interruption
+    }
+}
+
+bool ResultsLog::contains(const std::string& runId) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return done_.count(runId) > 0;
+}
+
+size_t ResultsLog::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return done_.size();
+}
+
+std::vector<std::pair<long, double>> ResultsLog::timings() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return timings_;
+}
+
+void ResultsLog::append(const SweepRecord& record) {
+    const SweepPoint& p = record.point;
+    std::ostringstream line;
+    line.precision(10);
+    line << p.runId() << "," << p.nx << "," << p.ny << "," << p.spacing << "," << p.voltage << ","
+         << p.charge << "," << p.epsilonR << "," << record.phiMin << "," << record.phiMax << ","
+         << record.fieldMax << "," << record.energy << "," << record.solveMs << ",ok\n";
+    std::string text = line.str();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::ofstream out(path_, std::ios::app | std::ios::binary);
+    out.write(text.data(), static_cast<std::streamsize>(text.size()));
+    out.flush();
+    if (!out) {
+        throw std::runtime_error("Cannot append to results file: " + path_);
+    }
+    done_.insert(p.runId());
+    timings_.push_back({static_cast<long>(p.nx - 2) * (p.ny - 2), record.solveMs / 1000.0});
+}
+
+// ========== ParameterSweep ==========
+
+std::vector<double> ParameterSweep::chargeDensity(const std::string& layout, int nx, int ny, double spacing) {
+    int mx = nx - 2;
+    int my = ny - 2;
+    std::vector<double> rho(static_cast<size_t>(mx) * my, 0.0);
+    std::vector<std::string> parts = split(layout, ':');
+    if (parts.empty()) {
+        throw std::invalid_argument("Empty charge layout");
+    }
+
+    const std::string& kind = parts[0];
+    if (kind == "none" && parts.size() == 1) {
+        return rho;
+    }
+    if (kind == "uniform" && parts.size() == 2) {
+        std::fill(rho.begin(), rho.end(), toDouble(parts[1]));
+        return rho;
+    }
+    if (kind == "point" && parts.size() == 4) {
+        double x = toDouble(parts[1]);
+        double y = toDouble(parts[2]);
+        double q = toDouble(parts[3]);
+        int i = std::clamp(static_cast<int>(std::lround(x * (nx - 1))), 1, nx - 2);
+        int j = std::clamp(static_cast<int>(std::lround(y * (ny - 1))), 1, ny - 2);
+        rho[(i - 1) + (j - 1) * mx] = q / (spacing * spacing);
+        return rho;
+    }
+    if (kind == "gaussian" && parts.size() == 5) {
+        double x0 = toDouble(parts[1]);
+        double y0 = toDouble(parts[2]);
+        double sigma = toDouble(parts[3]);
+        double peak = toDouble(parts[4]);
+        if (sigma <= 0.0) {
+            throw std::invalid_argument("Gaussian sigma must be positive");
+        }
+        for (int j = 1; j < ny - 1; ++j) {
+            for (int i = 1; i < nx - 1; ++i) {
+                double ux = static_cast<double>(i) / (nx - 1) - x0;
+                double uy = static_cast<double>(j) / (ny - 1) - y0;
+                rho[(i - 1) + (j - 1) * mx] = peak * std::exp(-(ux * ux + uy * uy) / (2.0 * sigma * sigma));
+            }
+        }
+        return rho;
+    }
+    throw std::invalid_argument("Unknown charge layout: " + layout);
+}
+
+SweepSummary ParameterSweep::run(
+    const SweepDefinition& definition,
+    ResultsLog& log,
+    int threads,
+    long maxPoints,
+    bool verbose,
+    FramePublisher* publisher) {
+
+    auto start = std::chrono::steady_clock::now();
+    SweepSummary summary;
+
+    std::vector<SweepPoint> all = definition.points();
+    std::vector<SweepPoint> todo;
+    summary.total = all.size();
+    for (const SweepPoint& p : all) {
+        if (log.contains(p.runId())) {
+            summary.skipped++;
+        } else {
+            todo.push_back(p);
+        }
+    }
+
+    if (threads <= 0) {
+        threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+
+    // Solve times of earlier runs calibrate the cost model
+    CostModel costs;
+    for (const auto& timing : log.timings()) {
+        costs.record("sweep", timing.first, timing.second);
+    }
+
+    // Factors depend only on the geometry and are shared between points. The first
+    // point of a geometry factorizes outside the lock; later points wait on its
+    // future. A factor is dropped once no point of its geometry is left to solve.
+    struct GeometryFactor {
+        std::shared_future<std::shared_ptr<const SparseCholeskyFactor>> factor;
+        size_t pointsLeft = 0;
+    };
+    std::mutex factorsMutex;
+    std::map<std::uint64_t, GeometryFactor> factors;
+    {
+        ElectrostaticSolver solver;
+        for (const SweepPoint& p : todo) {
+            factors[solver.geometryHash(p.nx, p.ny, p.spacing, p.spacing)].pointsLeft++;
+        }
+    }
+    auto releaseGeometry = [&](std::uint64_t key) {
+        std::lock_guard<std::mutex> lock(factorsMutex);
+        auto it = factors.find(key);
+        if (it != factors.end() && --it->second.pointsLeft == 0) {
+            factors.erase(it);
+        }
+    };
+
+    std::atomic<long> claimed{0};
+    std::atomic<size_t> computed{0};
+    std::atomic<size_t> failed{0};
+    std::mutex printMutex;
+
+    auto solvePoint = [&](const SweepPoint& p, int solveThreads) {
+        ElectrostaticSolver solver;
+        std::uint64_t key = solver.geometryHash(p.nx, p.ny, p.spacing, p.spacing);
+        if (maxPoints >= 0 && claimed++ >= maxPoints) {
+            releaseGeometry(key);
+            return;
+        }
+
+        try {
+            auto t0 = std::chrono::steady_clock::now();
+            double h = p.spacing;
+            double epsilon = p.epsilonR * EPSILON_0;
+
+            std::vector<double> rho = chargeDensity(p.charge, p.nx, p.ny, h);
+            std::vector<double> boundaryValues(static_cast<size_t>(p.nx) * p.ny, 0.0);
+            for (int j = 0; j < p.ny; ++j) {
+                boundaryValues[solver.coordToIndex(0, j, p.nx)] = p.voltage;
+            }
+
+            MatrixSolver::SparseMatrix K;
+            Eigen::VectorXd f;
+            solver.buildReducedFDMSystem(p.nx, p.ny, h, h, rho, epsilon, K, f, boundaryValues);
+
+            Eigen::VectorXd u;
+            if (solveThreads > 1) {
+                // Large point with several threads: block-Jacobi PCG, blocks and SpMV in parallel
+                BlockJacobiPreconditioner M = BlockJacobiPreconditioner::compute(K, 2 * solveThreads, solveThreads);
+                MatrixSolver iterative;
+                iterative.setReduction({ReductionMode::Deterministic, solveThreads});
+                MatrixSolver::IterativeResult r = iterative.solvePreconditionedCG(
+                    [&](const Eigen::VectorXd& x) { return multiplySymmetric(K, x, solveThreads); },
+                    f,
+                    [&](const Eigen::VectorXd& x) { return M.apply(x); },
+                    Eigen::VectorXd(),
+                    static_cast<int>(K.rows()),
+                    1e-12);
+                if (!r.converged) {
+                    throw std::runtime_error("Block-Jacobi PCG did not converge");
+                }
+                u = r.x;
+            } else {
+                std::promise<std::shared_ptr<const SparseCholeskyFactor>> promise;
+                std::shared_future<std::shared_ptr<const SparseCholeskyFactor>> pending;
+                bool factorizes = false;
+                {
+                    std::lock_guard<std::mutex> lock(factorsMutex);
+                    GeometryFactor& entry = factors[key];
+                    if (!entry.factor.valid()) {
+                        entry.factor = promise.get_future().share();
+                        factorizes = true;
+                    }
+                    pending = entry.factor;
+                }
+                if (factorizes) {
+                    try {
+                        promise.set_value(std::make_shared<SparseCholeskyFactor>(SparseCholeskyFactor::compute(K)));
+                    } catch (...) {
+                        promise.set_exception(std::current_exception());
+                    }
+                }
+                u = pending.get()->solve(f);
+            }
+
+            Eigen::VectorXd phi = solver.expandReducedSolution(p.nx, p.ny, u, boundaryValues);
+            FieldResult result = solver.makeFieldResult(p.nx, p.ny, phi, h, h, epsilon);
+
+            SweepRecord record;
+            record.point = p;
+            record.phiMin = result.potential().minCoeff();
+            record.phiMax = result.potential().maxCoeff();
+            record.fieldMax = result.fieldMagnitude().maxCoeff();
+            record.energy = result.integral(FieldResult::Component::EnergyDensity);
+            record.solveMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+            log.append(record);
+            size_t order = computed++;
+            if (publisher) {
+                publisher->publish(result, static_cast<double>(order), p.runId());
+            }
+
+            if (verbose) {
+                std::lock_guard<std::mutex> lock(printMutex);
+                std::cout << "  [" << p.runId() << "] " << p.nx << "x" << p.ny << " h=" << h
+                          << " V=" << p.voltage << " charge=" << p.charge << " eps_r=" << p.epsilonR
+                          << "  |E|max=" << record.fieldMax << " V/m";
+                if (solveThreads > 1) {
+                    std::cout << "  (" << solveThreads << " threads)";
+                }
+                std::cout << std::endl;
+            }
+        } catch (const std::exception& e) {
+            failed++;
+            std::lock_guard<std::mutex> lock(printMutex);
+            std::cerr << "  [" << p.runId() << "] failed: " << e.what() << std::endl;
+        }
+        releaseGeometry(key);
+    };
+
+    // Longest points first; large points get several threads
+    std::vector<Job> jobs;
+    for (const SweepPoint& p : todo) {
+        Job job;
+        job.name = p.runId();
+        job.solver = "sweep";
+        job.unknowns = static_cast<long>(p.nx - 2) * (p.ny - 2);
+        job.maxThreads = job.unknowns >= PARALLEL_SOLVE_UNKNOWNS ? threads : 1;
+        job.run = [&solvePoint, &p](int t) { solvePoint(p, t); };
+        jobs.push_back(job);
+    }
+    JobScheduler scheduler(threads, &costs);
+    scheduler.run(jobs);
+
+    summary.computed = computed;
+    summary.failed = failed;
+    summary.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return summary;
+}
@@ -0,0 +1,169 @@
+#ifndef PARAMETER_SWEEP_H
+#define PARAMETER_SWEEP_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+class FramePublisher;
+/**
+ * @brief One point of a parameter sweep (parallel plate problem)
+ *
+ * Left plate at `voltage`, right plate grounded, Neumann top/bottom edges,
+ * square cells of size `spacing` and a charge layout (see SweepDefinition).
+ */
+struct SweepPoint {
+    int nx = 25;
+    int ny = 25;
+    double spacing = 0.1;       // dx = dy (m)
+    double voltage = 100.0;     // Left plate potential (V)
+    double epsilonR = 1.0;      // Relative permittivity
+    std::string charge = "none";
+
+    /**
+     * @brief Stable identifier derived from the parameters (16 hex digits)
+     *
+     * Independent of the position in the sweep, so a reordered or extended
+     * sweep definition still recognizes completed points.
+     */
+    std::string runId() const;
+};
+
+/**
+ * @brief Scalars recorded for each completed sweep point
+ */
+struct SweepRecord {
+    SweepPoint point;
+    double phiMin = 0.0;        // V
+    double phiMax = 0.0;        // V
+    double fieldMax = 0.0;      // max |E| (V/m)
+    double energy = 0.0;        // Σ u dx dy (J per unit depth)
+    double solveMs = 0.0;
+};
+
+/**
+ * @brief Cartesian product of parameter ranges
+ *
+ * Text format, one `key = values` per line, `#` starts a comment:
+ *
+ *     grid      = 25x25, 49x49
+ *     spacing   = 0.05, 0.1
+ *     voltage   = 0:100:11          # start:stop:count (inclusive)
+ *     charge    = none; point:0.5:0.5:1e-9; uniform:1e-10; gaussian:0.3:0.5:0.1:1e-9
+ *     epsilon_r = 1
+ *
+ * Numeric values are comma-separated lists or start:stop:count ranges.
+ * Charge layouts are separated by ';' and use fractional coordinates (0..1)
+ * of the domain:
+ * - none
+ * - uniform:rho                    Constant density (C/m³)
+ * - point:x:y:q                    Line charge q (C/m) in the nearest cell
+ * - gaussian:x:y:sigma:peak        Gaussian blob, sigma as a domain fraction
+ */
+struct SweepDefinition {
+    std::vector<std::pair<int, int>> grids{{25, 25}};
+    std::vector<double> spacings{0.1};
+    std::vector<double> voltages{100.0};
+    std::vector<std::string> charges{"none"};
+    std::vector<double> relativePermittivities{1.0};
+
+    static SweepDefinition parse(std::istream& in);
+    static SweepDefinition fromFile(const std::string& path);
+
+    /**
+     * @brief All points in a fixed order (grid, spacing, voltage, charge, ε_r)
+     */
+    std::vector<SweepPoint> points() const;
+};
+
+/**
+ * @class ResultsLog
+ * @brief Append-only CSV results file keyed by run ID
+ *
+ * Existing rows are read on construction; complete rows mark their run ID as
+ * done. Every new row is written with a single write and flushed, so an
+ * interrupted sweep leaves at most one partial last line, which is ignored
+ * (and terminated) on the next start. Safe to append from several threads.
+ */
+class ResultsLog {
+public:
+    explicit ResultsLog(const std::string& path);
+
+    bool contains(const std::string& runId) const;
+    size_t size() const;
+    void append(const SweepRecord& record);
+
+    /**
+     * @brief (interior unknowns, solve seconds) of every recorded point
+     */
+    std::vector<std::pair<long, double>> timings() const;
+
+    const std::string& path() const { return path_; }
+
+    static std::string header();
+
+private:
+    std::string path_;
+    mutable std::mutex mutex_;
+    std::unordered_set<std::string> done_;
+    std::vector<std::pair<long, double>> timings_;
+};
+
+/**
+ * @brief Outcome of ParameterSweep::run
+ */
+struct SweepSummary {
+    size_t total = 0;
+    size_t skipped = 0;         // Already in the results file
+    size_t computed = 0;
+    size_t failed = 0;          // Not recorded; retried on the next run
+    double seconds = 0.0;
+};
+
+/**
+ * @class ParameterSweep
+ * @brief Parallel, resumable execution of a SweepDefinition
+ *
+ * Points are dispatched by a JobScheduler, largest first, with costs from a
+ * CostModel calibrated on the solve times already in the results file. Each
+ * point solves the reduced SPD system with a sparse LDLᵀ factor; factors are
+ * shared between points with the same grid and spacing, computed once per
+ * geometry without blocking other workers, and released when the last point
+ * of that geometry is done. Points with at least
+ * 100000 unknowns may be granted several threads and then use block-Jacobi
+ * PCG with a parallel matrix-vector product instead. Completed points go to
+ * the ResultsLog and are skipped when the sweep is started again.
+ */
+class ParameterSweep {
+public:
+    /**
+     * @brief Interior charge density of a layout ((nx-2)*(ny-2), C/m³)
+     */
+    static std::vector<double> chargeDensity(const std::string& layout, int nx, int ny, double spacing);
+
+    /**
+     * @brief Run the sweep
+     *
+     * @param definition Parameter ranges
+     * @param log Results file; completed points are skipped
+     * @param threads Worker threads (0: hardware concurrency)
+     * @param maxPoints Stop after computing this many new points (-1: all)
+     * @param verbose Print one line per computed point
+     * @param publisher Optional frame ring; every computed point is published
+     *        with its run id as label and its completion order as time
+     */
+    static SweepSummary run(
+        const SweepDefinition& definition,
+        ResultsLog& log,
+        int threads = 0,
+        long maxPoints = -1,
+        bool verbose = false,
+        FramePublisher* publisher = nullptr
+    );
+};
+
+#endif // PARAMETER_SWEEP_H
@@ -0,0 +1,178 @@
+#ifndef REDUCTION_H
+#define REDUCTION_H
+
+#include "ParallelFor.h"
+#include <Eigen/Dense>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @brief How sums, dot products, norms and integrals are accumulated
+ */
+enum class ReductionMode {
+    /**
+     * Fixed blocks of Reduction::BLOCK values, each summed with compensated
+     * (Neumaier) summation, combined by a fixed pairwise tree. The split does
+     * not depend on the thread count, so results are bitwise identical for
+     * any number of threads, and the rounding error hardly grows with length.
+     */
+    Deterministic,
+
+    /**
+     * Plain vectorized Eigen reductions, one per thread, added in thread
+     * order. Fastest, but the last bits change with the thread count.
+     */
+    Fast
+};
+
+/**
+ * @brief Reduction mode and number of threads working on one reduction
+ */
+struct ReductionOptions {
+    ReductionMode mode = ReductionMode::Deterministic;
+    int threads = 1;
+};
+
+namespace Reduction {
+
+using VectorRef = Eigen::Ref<const Eigen::VectorXd>;
+
+/// Values per block of a deterministic reduction (independent of the thread count)
+constexpr long BLOCK = 2048;
+
+/// Below this many values per thread, threads cost more than they save
+constexpr long MIN_PER_THREAD = 32768;
+
+namespace detail {
+
+/**
+ * @brief Neumaier-compensated sum of term(k) for k in [begin, end)
+ */
+template <typename Term>
+inline double compensatedSum(long begin, long end, Term term) {
+    double sum = 0.0;
+    double compensation = 0.0;
+    for (long k = begin; k < end; ++k) {
+        double value = term(k);
+        double t = sum + value;
+        if (std::abs(sum) >= std::abs(value)) {
+            compensation += (sum - t) + value;
+        } else {
+            compensation += (value - t) + sum;
+        }
+        sum = t;
+    }
+    return sum + compensation;
+}
+
+inline int usefulThreads(int threads, long n) {
+    return static_cast<int>(std::max(1L, std::min<long>(threads, n / MIN_PER_THREAD)));
+}
+
+/**
+ * @brief Deterministic reduction of term(0) + ... + term(n-1)
+ */
+template <typename Term>
+inline double deterministic(long n, int threads, Term term) {
+    long blocks = (n + BLOCK - 1) / BLOCK;
+    if (blocks <= 1) {
+        return compensatedSum(0, n, term);
+    }
+
+    std::vector<double> partial(blocks);
+    parallelFor(usefulThreads(threads, n), blocks, [&](long first, long last) {
+        for (long b = first; b < last; ++b) {
+            partial[b] = compensatedSum(b * BLOCK, std::min(n, (b + 1) * BLOCK), term);
+        }
+    });
+
+    // Pairwise tree over block sums: (0+1)+(2+3), ... in a fixed order
+    for (long width = blocks; width > 1; width = (width + 1) / 2) {
+        for (long b = 0; b < width / 2; ++b) {
+            partial[b] = partial[2 * b] + partial[2 * b + 1];
+        }
+        if (width % 2) {
+            partial[width / 2] = partial[width - 1];
+        }
+    }
+    return partial[0];
+}
+
+/**
+ * @brief Fast reduction: one Eigen reduction per thread chunk
+ */
+template <typename Chunk>
+inline double fast(long n, int threads, Chunk chunk) {
+    threads = usefulThreads(threads, n);
+    if (threads == 1) {
+        return chunk(0, n);
+    }
+    std::vector<double> partial(threads, 0.0);
+    parallelFor(threads, threads, [&](long first, long last) {
+        for (long t = first; t < last; ++t) {
+            long begin = n * t / threads;
+            partial[t] = chunk(begin, n * (t + 1) / threads - begin);
+        }
+    });
+    double sum = 0.0;
+    for (double p : partial) {
+        sum += p;
+    }
+    return sum;
+}
+
+} // namespace detail
+
+/**
+ * @brief Σ x[k]
+ */
+inline double sum(const VectorRef& x, const ReductionOptions& options = ReductionOptions()) {
+    long n = static_cast<long>(x.size());
+    if (options.mode == ReductionMode::Fast) {
+        return detail::fast(n, options.threads, [&](long begin, long count) { return x.segment(begin, count).sum(); });
+    }
+    const double* data = x.data();
+    return detail::deterministic(n, options.threads, [=](long k) { return data[k]; });
+}
+
+/**
+ * @brief Σ x[k]·y[k]
+ * @throws std::invalid_argument if x and y differ in size
+ */
+inline double dot(const VectorRef& x, const VectorRef& y, const ReductionOptions& options = ReductionOptions()) {
+    if (x.size() != y.size()) {
+        throw std::invalid_argument("Dot product size mismatch: " + std::to_string(x.size()) + " vs " +
+                                    std::to_string(y.size()));
+    }
+    long n = static_cast<long>(x.size());
+    if (options.mode == ReductionMode::Fast) {
+        return detail::fast(n, options.threads, [&](long begin, long count) {
+            return x.segment(begin, count).dot(y.segment(begin, count));
+        });
+    }
+    const double* a = x.data();
+    const double* b = y.data();
+    return detail::deterministic(n, options.threads, [=](long k) { return a[k] * b[k]; });
+}
+
+/**
+ * @brief Euclidean norm ‖x‖₂
+ */
+inline double norm(const VectorRef& x, const ReductionOptions& options = ReductionOptions()) {
+    return std::sqrt(dot(x, x, options));
+}
+
+/**
+ * @brief Σ f(j, i)·dx·dy over all grid points (rectangle rule, as u.sum()·dx·dy)
+ */
+inline double integral(const Eigen::MatrixXd& f, double dx, double dy,
+                       const ReductionOptions& options = ReductionOptions()) {
+    Eigen::Map<const Eigen::VectorXd> values(f.data(), f.size());
+    return sum(values, options) * dx * dy;
+}
+
+} // namespace Reduction
+
+#endif // REDUCTION_H
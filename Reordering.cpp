@@ -0,0 +1,344 @@
+#include "Reordering.h"
+#include <Eigen/OrderingMethods>
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+/**
+ * @brief Breadth-first levels from one root, reusing a distance array
+ *
+ * Every vertex of the root's component is appended to `visited`; the
+ * distances are reset to -1 before returning.
+ */
+class LevelSearch {
+public:
+    explicit LevelSearch(const Graph& g) : g_(g), distance_(g.nodeCount(), -1) {}
+
+    /// Eccentricity of root; lastLevel receives the farthest vertices
+    int run(int root, std::vector<int>& lastLevel) {
+        visited_.clear();
+        visited_.push_back(root);
+        distance_[root] = 0;
+        for (size_t head = 0; head < visited_.size(); ++head) {
+            int v = visited_[head];
+            for (int w : g_.neighbors(v)) {
+                if (distance_[w] < 0) {
+                    distance_[w] = distance_[v] + 1;
+                    visited_.push_back(w);
+                }
+            }
+        }
+        int eccentricity = distance_[visited_.back()];
+        lastLevel.clear();
+        for (int v : visited_) {
+            if (distance_[v] == eccentricity) {
+                lastLevel.push_back(v);
+            }
+            distance_[v] = -1;
+        }
+        return eccentricity;
+    }
+
+private:
+    const Graph& g_;
+    std::vector<int> distance_;
+    std::vector<int> visited_;
+};
+
+/**
+ * @brief Pseudo-peripheral vertex of start's component (George–Liu)
+ *
+ * Restarts from the lowest-degree vertex of the last BFS level while the
+ * eccentricity keeps growing.
+ */
+int pseudoPeripheral(const Graph& g, int start, LevelSearch& search) {
+    std::vector<int> lastLevel;
+    int root = start;
+    int eccentricity = search.run(root, lastLevel);
+    while (true) {
+        int candidate = *std::min_element(lastLevel.begin(), lastLevel.end(), [&](int a, int b) {
+            return g.degree(a) < g.degree(b) || (g.degree(a) == g.degree(b) && a < b);
+        });
+        int reach = search.run(candidate, lastLevel);
+        if (reach <= eccentricity) {
+            return root;
+        }
+        root = candidate;
+        eccentricity = reach;
+    }
+}
+
+/// Off-diagonal pattern of a sparse matrix as a graph
+Graph patternGraph(const Eigen::SparseMatrix<double>& A) {
+    std::vector<int> from;
+    std::vector<int> to;
+    from.reserve(A.nonZeros());
+    to.reserve(A.nonZeros());
+    for (int j = 0; j < A.outerSize(); ++j) {
+        for (Eigen::SparseMatrix<double>::InnerIterator it(A, j); it; ++it) {
+            if (it.row() != j) {
+                from.push_back(static_cast<int>(it.row()));
+                to.push_back(j);
+            }
+        }
+    }
+    return Graph::fromEdges(static_cast<int>(A.rows()), from, to);
+}
+
+/**
+ * @brief Numbers the grid block [x0, x1) × [y0, y1): both halves, then the separator line
+ */
+void dissect(int nx, int x0, int x1, int y0, int y1, int leaf, std::vector<int>& order) {
+    int width = x1 - x0;
+    int height = y1 - y0;
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+    if (static_cast<long>(width) * height <= leaf) {
+        for (int j = y0; j < y1; ++j) {
+            for (int i = x0; i < x1; ++i) {
+                order.push_back(i + j * nx);
+            }
+        }
+        return;
+    }
+    if (width >= height) {
+        int mid = x0 + width / 2;
+        dissect(nx, x0, mid, y0, y1, leaf, order);
+        dissect(nx, mid + 1, x1, y0, y1, leaf, order);
+        for (int j = y0; j < y1; ++j) {
+            order.push_back(mid + j * nx);
+        }
+    } else {
+        int mid = y0 + height / 2;
+        dissect(nx, x0, x1, y0, mid, leaf, order);
+        dissect(nx, x0, x1, mid + 1, y1, leaf, order);
+        for (int i = x0; i < x1; ++i) {
+            order.push_back(i + mid * nx);
+        }
+    }
+}
+
+} // namespace
+
+Reordering Reordering::natural(int n) {
+    std::vector<int> order(std::max(0, n));
+    for (int k = 0; k < n; ++k) {
+        order[k] = k;
+    }
+    return fromOrder(std::move(order));
+}
+
+Reordering Reordering::fromOrder(std::vector<int> order) {
+    int n = static_cast<int>(order.size());
+    std::vector<int> position(n, -1);
+    for (int k = 0; k < n; ++k) {
+        if (order[k] < 0 || order[k] >= n || position[order[k]] >= 0) {
+            throw std::invalid_argument("Entry " + std::to_string(k) + " breaks the permutation of 0.." +
+                                        std::to_string(n - 1));
+        }
+        position[order[k]] = k;
+    }
+    Reordering r;
+    r.order_ = std::move(order);
+    r.position_ = std::move(position);
+    return r;
+}
+
+Reordering Reordering::reverseCuthillMcKee(const SparseMatrix& A) {
+    if (A.rows() != A.cols()) {
+        throw std::invalid_argument("Reordering needs a square matrix");
+    }
+    return reverseCuthillMcKee(patternGraph(A));
+}
+
+Reordering Reordering::reverseCuthillMcKee(const Graph& g) {
+    const int n = g.nodeCount();
+    std::vector<int> order;
+    order.reserve(n);
+    std::vector<char> numbered(n, 0);
+    std::vector<int> fresh;
+    LevelSearch search(g);
+    auto byDegree = [&](int a, int b) {
+        return g.degree(a) < g.degree(b) || (g.degree(a) == g.degree(b) && a < b);
+    };
+
+    for (int start = 0; start < n; ++start) {
+        if (numbered[start]) {
+            continue;
+        }
+        // Cuthill–McKee: BFS, unnumbered neighbours by increasing degree
+        int root = pseudoPeripheral(g, start, search);
+        size_t head = order.size();
+        order.push_back(root);
+        numbered[root] = 1;
+        for (; head < order.size(); ++head) {
+            fresh.clear();
+            for (int w : g.neighbors(order[head])) {
+                if (!numbered[w]) {
+                    numbered[w] = 1;
+                    fresh.push_back(w);
+                }
+            }
+            std::sort(fresh.begin(), fresh.end(), byDegree);
+            order.insert(order.end(), fresh.begin(), fresh.end());
+        }
+    }
+    std::reverse(order.begin(), order.end());
+    return fromOrder(std::move(order));
+}
+
+Reordering Reordering::minimumDegree(const SparseMatrix& A) {
+    if (A.rows() != A.cols()) {
+        throw std::invalid_argument("Reordering needs a square matrix");
+    }
+    // AMDOrdering returns P⁻¹, whose indices are the new-to-old order
+    Eigen::AMDOrdering<int> amd;
+    Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic, int> inverse;
+    amd(A, inverse);
+    std::vector<int> order(inverse.indices().data(), inverse.indices().data() + inverse.indices().size());
+    return fromOrder(std::move(order));
+}
+
+Reordering Reordering::nestedDissection(int nx, int ny, int leaf) {
+    if (nx < 0 || ny < 0 || leaf < 1) {
+        throw std::invalid_argument("Nested dissection needs nx, ny >= 0 and leaf >= 1");
+    }
+    std::vector<int> order;
+    order.reserve(static_cast<size_t>(nx) * ny);
+    dissect(nx, 0, nx, 0, ny, leaf, order);
+    return fromOrder(std::move(order));
+}
+
+OrderingStats Reordering::statistics(const SparseMatrix& A) {
+    if (A.rows() != A.cols()) {
+        throw std::invalid_argument("Ordering statistics need a square matrix");
+    }
+    const int n = static_cast<int>(A.rows());
+    OrderingStats stats;
+
+    // Column k of upper holds the lower-triangle entries of row k: A(k, j), j ≤ k
+    SparseMatrix lower = A.triangularView<Eigen::Lower>();
+    SparseMatrix upper = lower.transpose();
+    for (int k = 0; k < n; ++k) {
+        int first = k;
+        for (SparseMatrix::InnerIterator it(upper, k); it; ++it) {
+            first = std::min(first, static_cast<int>(it.row()));
+        }
+        stats.bandwidth = std::max(stats.bandwidth, k - first);
+        stats.profile += k - first;
+    }
+
+    // Elimination tree (Liu, with path compression to the current root)
+    std::vector<int> parent(n, -1);
+    std::vector<int> ancestor(n, -1);
+    for (int k = 0; k < n; ++k) {
+        for (SparseMatrix::InnerIterator it(upper, k); it; ++it) {
+            for (int i = static_cast<int>(it.row()); i != -1 && i < k;) {
+                int next = ancestor[i];
+                ancestor[i] = k;
+                if (next == -1) {
+                    parent[i] = k;
+                }
+                i = next;
+            }
+        }
+    }
+
+    // Row k of L is the row subtree: the etree paths from each A(k, j) up to k
+    std::vector<int> mark(n, -1);
+    for (int k = 0; k < n; ++k) {
+        mark[k] = k;
+        std::int64_t count = 1;
+        for (SparseMatrix::InnerIterator it(upper, k); it; ++it) {
+            for (int j = static_cast<int>(it.row()); mark[j] != k; j = parent[j]) {
+                mark[j] = k;
+                ++count;
+            }
+        }
+        stats.factorNonZeros += count;
+    }
+    return stats;
+}
+
+ReorderingReport Reordering::report(const SparseMatrix& A) const {
+    ReorderingReport r;
+    r.before = statistics(A);
+    r.after = statistics(apply(A));
+    return r;
+}
+
+Reordering::SparseMatrix Reordering::apply(const SparseMatrix& A) const {
+    if (A.rows() != size() || A.cols() != size()) {
+        throw std::invalid_argument("Matrix size mismatch with ordering");
+    }
+    std::vector<Eigen::Triplet<double>> triplets;
+    triplets.reserve(A.nonZeros());
+    for (int j = 0; j < A.outerSize(); ++j) {
+        for (SparseMatrix::InnerIterator it(A, j); it; ++it) {
+            triplets.emplace_back(position_[it.row()], position_[j], it.value());
+        }
+    }
+    SparseMatrix B(A.rows(), A.cols());
+    B.setFromTriplets(triplets.begin(), triplets.end());
+    return B;
+}
+
+Reordering::VectorXd Reordering::apply(const VectorXd& x) const {
+    if (x.size() != size()) {
+        throw std::invalid_argument("Vector size mismatch with ordering");
+    }
+    VectorXd y(x.size());
+    apply(x.data(), y.data());
+    return y;
+}
+
+Reordering::MatrixXd Reordering::apply(const MatrixXd& X) const {
+    if (X.rows() != size()) {
+        throw std::invalid_argument("Field size mismatch with ordering");
+    }
+    MatrixXd Y(X.rows(), X.cols());
+    for (int k = 0; k < size(); ++k) {
+        Y.row(k) = X.row(order_[k]);
+    }
+    return Y;
+}
+
+Reordering::VectorXd Reordering::restore(const VectorXd& y) const {
+    if (y.size() != size()) {
+        throw std::invalid_argument("Vector size mismatch with ordering");
+    }
+    VectorXd x(y.size());
+    restore(y.data(), x.data());
+    return x;
+}
+
+Reordering::MatrixXd Reordering::restore(const MatrixXd& Y) const {
+    if (Y.rows() != size()) {
+        throw std::invalid_argument("Field size mismatch with ordering");
+    }
+    MatrixXd X(Y.rows(), Y.cols());
+    for (int k = 0; k < size(); ++k) {
+        X.row(order_[k]) = Y.row(k);
+    }
+    return X;
+}
+
+void Reordering::apply(const double* in, double* out) const {
+    for (int k = 0; k < size(); ++k) {
+        out[k] = in[order_[k]];
+    }
+}
+
+void Reordering::restore(const double* in, double* out) const {
+    for (int k = 0; k < size(); ++k) {
+        out[order_[k]] = in[k];
+    }
+}
+
+Reordering Reordering::inverse() const {
+    return fromOrder(position_);
+}
@@ -0,0 +1,436 @@
+#include "ResistiveNetwork.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+// ========== ResistiveNetwork ==========
+
+ResistiveNetwork ResistiveNetwork::fromCSR(const std::vector<std::int64_t>& offsets,
+                                           const std::vector<std::int64_t>& targets,
+                                           const std::vector<double>& resistances,
+                                           const std::vector<NodeId>& ids,
+                                           bool symmetric) {
+    if (offsets.empty() || targets.size() != resistances.size()
+        || offsets.back() != static_cast<std::int64_t>(targets.size())) {
+        throw std::invalid_argument("CSR arrays are inconsistent");
+    }
+    std::int64_t rows = static_cast<std::int64_t>(offsets.size()) - 1;
+    if (!ids.empty() && static_cast<std::int64_t>(ids.size()) != rows) {
+        throw std::invalid_argument("Need one node ID per CSR row");
+    }
+
+    auto idOf = [&](std::int64_t row) { return ids.empty() ? static_cast<NodeId>(row) : ids[row]; };
+
+    ResistiveNetwork network;
+    network.reserve(static_cast<size_t>(rows), symmetric ? targets.size() / 2 : targets.size());
+    for (std::int64_t u = 0; u < rows; ++u) {
+        network.addNode(idOf(u));
+    }
+    for (std::int64_t u = 0; u < rows; ++u) {
+        for (std::int64_t k = offsets[u]; k < offsets[u + 1]; ++k) {
+            std::int64_t v = targets[k];
+            if (v < 0 || v >= rows) {
+                throw std::invalid_argument("CSR target out of range");
+            }
+            if (symmetric && v < u) {
+                continue;
+            }
+            network.addEdge(idOf(u), idOf(v), resistances[k]);
+        }
+    }
+    return network;
+}
+
+int ResistiveNetwork::addNode(NodeId id) {
+    auto inserted = index_.emplace(id, static_cast<int>(ids_.size()));
+    if (inserted.second) {
+        ids_.push_back(id);
+    }
+    return inserted.first->second;
+}
+
+void ResistiveNetwork::addEdge(NodeId u, NodeId v, double resistance) {
+    if (!(resistance > 0.0)) {
+        throw std::invalid_argument("Resistance must be positive");
+    }
+    if (u == v) {
+        throw std::invalid_argument("Resistor connects node " + std::to_string(u) + " to itself");
+    }
+    from_.push_back(addNode(u));
+    to_.push_back(addNode(v));
+    conductance_.push_back(1.0 / resistance);
+}
+
+void ResistiveNetwork::reserve(size_t nodes, size_t edges) {
+    ids_.reserve(nodes);
+    index_.reserve(nodes);
+    from_.reserve(edges);
+    to_.reserve(edges);
+    conductance_.reserve(edges);
+}
+
+void ResistiveNetwork::setResistance(int edge, double resistance) {
+    if (!(resistance > 0.0)) {
+        throw std::invalid_argument("Resistance must be positive");
+    }
+    conductance_.at(static_cast<size_t>(edge)) = 1.0 / resistance;
+}
+
+int ResistiveNetwork::index(NodeId id) const {
+    auto it = index_.find(id);
+    if (it == index_.end()) {
+        throw std::out_of_range("Unknown node " + std::to_string(id));
+    }
+    return it->second;
+}
+
+ResistiveNetwork::SparseMatrix ResistiveNetwork::laplacian() const {
+    int n = nodeCount();
+    std::vector<Eigen::Triplet<double>> triplets;
+    triplets.reserve(4 * from_.size());
+    for (size_t e = 0; e < from_.size(); ++e) {
+        int u = from_[e];
+        int v = to_[e];
+        double g = conductance_[e];
+        triplets.emplace_back(u, u, g);
+        triplets.emplace_back(v, v, g);
+        triplets.emplace_back(u, v, -g);
+        triplets.emplace_back(v, u, -g);
+    }
+    SparseMatrix L(n, n);
+    L.setFromTriplets(triplets.begin(), triplets.end());
+    L.makeCompressed();
+    return L;
+}
+
+// ========== ResistiveNetworkSolver ==========
+
+namespace {
+
+int findRoot(std::vector<int>& parent, int x) {
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+} // namespace
+
+ResistiveNetworkSolver::ResistiveNetworkSolver(const ResistiveNetwork& network, ResistiveNetwork::NodeId ground,
+                                               const NetworkSolveOptions& options)
+    : network_(network), options_(options), ground_(network.index(ground)) {
+    rebuild();
+}
+
+void ResistiveNetworkSolver::rebuild() {
+    // Connected components by union-find over the edges
+    int n = network_.nodeCount();
+    std::vector<int> parent(n);
+    std::iota(parent.begin(), parent.end(), 0);
+    for (int e = 0; e < network_.edgeCount(); ++e) {
+        int a = findRoot(parent, network_.edgeFrom(e));
+        int b = findRoot(parent, network_.edgeTo(e));
+        if (a != b) {
+            parent[std::max(a, b)] = std::min(a, b);
+        }
+    }
+
+    // One grounded node per component: the ground, otherwise the first node
+    component_.assign(n, -1);
+    componentGround_.clear();
+    std::vector<int> rootComponent(n, -1);
+    int groundRoot = findRoot(parent, ground_);
+    rootComponent[groundRoot] = 0;
+    componentGround_.push_back(ground_);
+    for (int node = 0; node < n; ++node) {
+        int root = findRoot(parent, node);
+        if (rootComponent[root] < 0) {
+            rootComponent[root] = static_cast<int>(componentGround_.size());
+            componentGround_.push_back(node);
+        }
+        component_[node] = rootComponent[root];
+    }
+
+    // Eliminate the grounded rows and columns
+    reducedIndex_.assign(n, -1);
+    fullIndex_.clear();
+    std::vector<char> grounded(n, 0);
+    for (int node : componentGround_) {
+        grounded[node] = 1;
+    }
+    for (int node = 0; node < n; ++node) {
+        if (!grounded[node]) {
+            reducedIndex_[node] = static_cast<int>(fullIndex_.size());
+            fullIndex_.push_back(node);
+        }
+    }
+
+    int m = static_cast<int>(fullIndex_.size());
+    std::vector<Eigen::Triplet<double>> triplets;
+    triplets.reserve(4 * static_cast<size_t>(network_.edgeCount()));
+    for (int e = 0; e < network_.edgeCount(); ++e) {
+        int u = reducedIndex_[network_.edgeFrom(e)];
+        int v = reducedIndex_[network_.edgeTo(e)];
+        double g = network_.conductance(e);
+        if (u >= 0) {
+            triplets.emplace_back(u, u, g);
+        }
+        if (v >= 0) {
+            triplets.emplace_back(v, v, g);
+        }
+        if (u >= 0 && v >= 0) {
+            triplets.emplace_back(u, v, -g);
+            triplets.emplace_back(v, u, -g);
+        }
+    }
+    reduced_.resize(m, m);
+    reduced_.setFromTriplets(triplets.begin(), triplets.end());
+    reduced_.makeCompressed();
+
+    switch (options_.method) {
+    case NetworkSolveMethod::Cholesky:
+        direct_ = true;
+        break;
+    case NetworkSolveMethod::ConjugateGradient:
+        direct_ = false;
+        break;
+    default:
+        direct_ = m <= options_.directLimit;
+        break;
+    }
+    factor_ = SparseCholeskyFactor();
+    jacobi_ = DiagonalPreconditioner();
+    incomplete_ = IncompleteCholeskyPreconditioner();
+    tree_ = TreePreconditioner();
+    updates_.clear();
+}
+
+ResistiveNetworkSolver::VectorXd ResistiveNetworkSolver::solveReduced(const VectorXd& rhs, const VectorXd& x0) {
+    if (reduced_.rows() == 0) {
+        return VectorXd();
+    }
+    if (direct_) {
+        if (factor_.empty()) {
+            factor_ = SparseCholeskyFactor::compute(reduced_);
+        }
+        lastIterations_ = 0;
+
+        // (L + Σ Δg b bᵀ)⁻¹ y = L⁻¹y - Σ γ_i z_i (z_iᵀ y), applied in update order
+        VectorXd x = factor_.solve(rhs);
+        for (const RankOneUpdate& update : updates_) {
+            x -= (update.gamma * update.z.dot(rhs)) * update.z;
+        }
+        return x;
+    }
+
+    auto apply = [this](const VectorXd& x) {
+        VectorXd y = reduced_ * x;
+        for (const RankOneUpdate& update : updates_) {
+            double bx = (update.u >= 0 ? x(update.u) : 0.0) - (update.v >= 0 ? x(update.v) : 0.0);
+            if (update.u >= 0) {
+                y(update.u) += update.dg * bx;
+            }
+            if (update.v >= 0) {
+                y(update.v) -= update.dg * bx;
+            }
+        }
+        return y;
+    };
+    int maxIterations = options_.maxIterations > 0 ? options_.maxIterations
+                                                   : std::max(1000, static_cast<int>(reduced_.rows()));
+    IterativeResult result = solvePreconditionedCG(
+        apply, rhs, [this](const VectorXd& r) { return precondition(r); }, x0, maxIterations, options_.tolerance);
+    lastIterations_ = result.iterations;
+    if (!result.converged) {
+        throw std::runtime_error("Network CG did not converge (relative residual " +
+                                 std::to_string(result.relativeResidual) + ")");
+    }
+    return result.x;
+}
+
+ResistiveNetworkSolver::VectorXd ResistiveNetworkSolver::precondition(const VectorXd& r) {
+    // Pending rank-one updates are left out: the preconditioner only needs to be SPD
+    switch (options_.preconditioner) {
+    case NetworkPreconditioner::IncompleteCholesky:
+        if (incomplete_.empty()) {
+            incomplete_ = IncompleteCholeskyPreconditioner::compute(reduced_);
+        }
+        return incomplete_.apply(r);
+    case NetworkPreconditioner::SpanningTree:
+    case NetworkPreconditioner::AugmentedTree:
+        if (tree_.empty()) {
+            int subtrees = 0;
+            if (options_.preconditioner == NetworkPreconditioner::AugmentedTree) {
+                subtrees = options_.treeSubtrees > 0 ? options_.treeSubtrees
+                                                     : std::max(1, static_cast<int>(reduced_.rows() / 1000));
+            }
+            tree_ = TreePreconditioner::compute(reduced_, subtrees);
+        }
+        return tree_.apply(r);
+    default:
+        if (jacobi_.empty()) {
+            jacobi_ = DiagonalPreconditioner::compute(reduced_);
+        }
+        return jacobi_.apply(r);
+    }
+}
+
+ResistiveNetworkSolver::MatrixXd ResistiveNetworkSolver::solveReducedBatch(const MatrixXd& rhs) {
+    if (reduced_.rows() == 0) {
+        return MatrixXd(0, rhs.cols());
+    }
+    if (!direct_) {
+        MatrixXd x(rhs.rows(), rhs.cols());
+        for (Eigen::Index c = 0; c < rhs.cols(); ++c) {
+            x.col(c) = solveReduced(rhs.col(c));
+        }
+        return x;
+    }
+    if (factor_.empty()) {
+        factor_ = SparseCholeskyFactor::compute(reduced_);
+    }
+    lastIterations_ = 0;
+    MatrixXd x = factor_.solveBatch(rhs);
+    for (const RankOneUpdate& update : updates_) {
+        x -= update.z * (update.gamma * (update.z.transpose() * rhs));
+    }
+    return x;
+}
+
+ResistiveNetworkSolver::VectorXd ResistiveNetworkSolver::expand(const VectorXd& reducedVoltages) const {
+    VectorXd voltages = VectorXd::Zero(network_.nodeCount());
+    for (size_t k = 0; k < fullIndex_.size(); ++k) {
+        voltages(fullIndex_[k]) = reducedVoltages(static_cast<Eigen::Index>(k));
+    }
+    return voltages;
+}
+
+ResistiveNetworkSolver::VectorXd ResistiveNetworkSolver::solveCurrents(const VectorXd& currents) {
+    if (currents.size() != network_.nodeCount()) {
+        throw std::invalid_argument("Need one current per node");
+    }
+
+    // A floating component has no path to ground: its injections must cancel
+    std::vector<double> net(componentGround_.size(), 0.0);
+    double scale = 0.0;
+    for (int node = 0; node < network_.nodeCount(); ++node) {
+        net[component_[node]] += currents(node);
+        scale = std::max(scale, std::abs(currents(node)));
+    }
+    for (size_t c = 1; c < net.size(); ++c) {
+        if (std::abs(net[c]) > 1e-12 * std::max(1.0, scale)) {
+            throw std::invalid_argument("Net current " + std::to_string(net[c]) + " A into floating component of node " +
+                                        std::to_string(network_.id(componentGround_[c])));
+        }
+    }
+
+    VectorXd rhs(static_cast<Eigen::Index>(fullIndex_.size()));
+    for (size_t k = 0; k < fullIndex_.size(); ++k) {
+        rhs(static_cast<Eigen::Index>(k)) = currents(fullIndex_[k]);
+    }
+    VectorXd x0 = solution_.size() == rhs.size() && currents_.size() == currents.size() ? solution_ : VectorXd();
+    solution_ = solveReduced(rhs, x0);
+    currents_ = currents;
+    voltages_ = expand(solution_);
+    return voltages_;
+}
+
+ResistiveNetworkSolver::VectorXd ResistiveNetworkSolver::dcSolution(ResistiveNetwork::NodeId source,
+                                                                    ResistiveNetwork::NodeId sink) {
+    VectorXd currents = VectorXd::Zero(network_.nodeCount());
+    currents(network_.index(source)) += 1.0;
+    currents(network_.index(sink)) -= 1.0;
+    return solveCurrents(currents);
+}
+
+int ResistiveNetworkSolver::addEdge(ResistiveNetwork::NodeId u, ResistiveNetwork::NodeId v, double resistance) {
+    int nodes = network_.nodeCount();
+    network_.addEdge(u, v, resistance);
+    ++revision_;
+    int edge = network_.edgeCount() - 1;
+    int a = network_.edgeFrom(edge);
+    int b = network_.edgeTo(edge);
+
+    if (network_.nodeCount() != nodes || component_[a] != component_[b]) {
+        // New nodes or a bridge between components: the grounding changes
+        rebuild();
+        if (currents_.size() > 0) {
+            VectorXd currents = VectorXd::Zero(network_.nodeCount());
+            currents.head(currents_.size()) = currents_;
+            currents_.resize(0);
+            solution_.resize(0);
+            solveCurrents(currents);
+        }
+        return edge;
+    }
+
+    update(reducedIndex_[a], reducedIndex_[b], network_.conductance(edge));
+    return edge;
+}
+
+void ResistiveNetworkSolver::setResistance(int edge, double resistance) {
+    if (edge < 0 || edge >= network_.edgeCount()) {
+        throw std::out_of_range("Edge index out of range: " + std::to_string(edge));
+    }
+    double before = network_.conductance(edge);
+    network_.setResistance(edge, resistance);
+    ++revision_;
+    update(reducedIndex_[network_.edgeFrom(edge)], reducedIndex_[network_.edgeTo(edge)],
+           network_.conductance(edge) - before);
+}
+
+void ResistiveNetworkSolver::update(int u, int v, double dg) {
+    if (u < 0 && v < 0) {
+        return;     // Both ends grounded: no current flows
+    }
+
+    // The change is already in network_, so refactorizing picks it up
+    if (static_cast<int>(updates_.size()) + 1 >= options_.refactorInterval) {
+        refactorize();
+        return;
+    }
+
+    if (!direct_) {
+        updates_.push_back({u, v, dg, 0.0, VectorXd()});
+        if (currents_.size() > 0) {
+            solveCurrents(currents_);
+        }
+        return;
+    }
+
+    // z = (current Laplacian)⁻¹ b with b = e_u - e_v
+    VectorXd b = VectorXd::Zero(reduced_.rows());
+    if (u >= 0) {
+        b(u) = 1.0;
+    }
+    if (v >= 0) {
+        b(v) = -1.0;
+    }
+    VectorXd z = solveReduced(b);
+    double bz = (u >= 0 ? z(u) : 0.0) - (v >= 0 ? z(v) : 0.0);
+    double denominator = 1.0 + dg * bz;
+    if (std::abs(denominator) < 1e-12) {
+        // Near-singular update (an edge almost removed)
+        refactorize();
+        return;
+    }
+
+    double gamma = dg / denominator;
+    if (solution_.size() > 0) {
+        double bx = (u >= 0 ? solution_(u) : 0.0) - (v >= 0 ? solution_(v) : 0.0);
+        solution_ -= (gamma * bx) * z;
+        voltages_ = expand(solution_);
+    }
+    updates_.push_back({u, v, dg, gamma, std::move(z)});
+}
+
+void ResistiveNetworkSolver::refactorize() {
+    rebuild();
+    ++refactorizations_;
+    if (currents_.size() > 0) {
+        solveCurrents(currents_);
+    }
+}
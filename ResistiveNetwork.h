@@ -0,0 +1,286 @@
+#ifndef RESISTIVE_NETWORK_H
+#define RESISTIVE_NETWORK_H
+
+#include "Factorization.h"
+#include "MatrixSolver.h"
+#include "TreePreconditioner.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class ResistiveNetwork
+ * @brief Resistor network with arbitrary 64-bit node IDs
+ *
+ * Node IDs are mapped to dense indices 0..n-1 through a hash table in order
+ * of first appearance, so building a network is O(1) per edge (GraphTesting.py
+ * used nodes.index(u), O(n) per edge). Parallel resistors between the same
+ * pair of nodes are kept as separate edges and add up in the Laplacian.
+ */
+class ResistiveNetwork {
+public:
+    using NodeId = std::int64_t;
+    using SparseMatrix = Eigen::SparseMatrix<double>;
+
+    ResistiveNetwork() = default;
+
+    /**
+     * @brief Build from CSR adjacency: edges offsets[u]..offsets[u+1]-1 leave row u
+     *
+     * Each resistor may appear once (u→v) or in both directions; a pair
+     * listed both ways is added once, from its row with u < v.
+     *
+     * @param offsets Row pointers (rows + 1 entries)
+     * @param targets Column (neighbour row) of each entry
+     * @param resistances Resistance of each entry (ohms, > 0)
+     * @param ids Node ID of each row (empty: the row number)
+     * @param symmetric True if every resistor is listed in both directions
+     * @throws std::invalid_argument on inconsistent sizes or non-positive resistances
+     */
+    static ResistiveNetwork fromCSR(const std::vector<std::int64_t>& offsets,
+                                    const std::vector<std::int64_t>& targets,
+                                    const std::vector<double>& resistances,
+                                    const std::vector<NodeId>& ids = {},
+                                    bool symmetric = false);
+
+    /**
+     * @brief Add a node without edges (no effect if it exists)
+     * @return Dense index of the node
+     */
+    int addNode(NodeId id);
+
+    /**
+     * @brief Add a resistor between two nodes, creating them if needed
+     * @throws std::invalid_argument for non-positive resistances or self-loops
+     */
+    void addEdge(NodeId u, NodeId v, double resistance);
+
+    void reserve(size_t nodes, size_t edges);
+
+    int nodeCount() const { return static_cast<int>(ids_.size()); }
+    int edgeCount() const { return static_cast<int>(from_.size()); }
+
+    /**
+     * @brief Dense index of a node ID
+     * @throws std::out_of_range for unknown IDs
+     */
+    int index(NodeId id) const;
+    bool contains(NodeId id) const { return index_.count(id) != 0; }
+    NodeId id(int index) const { return ids_[index]; }
+
+    /**
+     * @brief Change the resistance of an existing edge
+     */
+    void setResistance(int edge, double resistance);
+
+    int edgeFrom(int edge) const { return from_[edge]; }
+    int edgeTo(int edge) const { return to_[edge]; }
+    double conductance(int edge) const { return conductance_[edge]; }
+
+    /**
+     * @brief Weighted Laplacian (admittance matrix) over all nodes
+     */
+    SparseMatrix laplacian() const;
+
+private:
+    std::vector<NodeId> ids_;
+    std::unordered_map<NodeId, int> index_;
+    std::vector<int> from_;
+    std::vector<int> to_;
+    std::vector<double> conductance_;
+};
+
+/**
+ * @brief How ResistiveNetworkSolver solves the grounded Laplacian system
+ */
+enum class NetworkSolveMethod {
+    Auto,               // Cholesky up to directLimit unknowns, CG above
+    Cholesky,           // Sparse LDLᵀ, factorized once and reused
+    ConjugateGradient   // Preconditioned CG (NetworkSolveOptions::preconditioner)
+};
+
+/**
+ * @brief Preconditioner for the CG path of ResistiveNetworkSolver
+ */
+enum class NetworkPreconditioner {
+    Jacobi,             // diag(L)⁻¹
+    IncompleteCholesky, // IC(0) in node order
+    SpanningTree,       // Maximum-conductance spanning tree, O(n) solve
+    AugmentedTree       // Spanning tree plus Vaidya off-tree edges, sparse LDLᵀ
+};
+
+struct NetworkSolveOptions {
+    NetworkSolveMethod method = NetworkSolveMethod::Auto;
+    double tolerance = 1e-10;       // Relative residual for CG
+    int maxIterations = 0;          // CG iterations (0: unknowns, at least 1000)
+    int directLimit = 200000;       // Auto: largest system factorized directly
+    int refactorInterval = 16;      // Rank-one updates kept before refactorizing
+    NetworkPreconditioner preconditioner = NetworkPreconditioner::Jacobi;
+    int treeSubtrees = 0;           // AugmentedTree pieces (0: unknowns / 1000, at least 1)
+};
+
+/**
+ * @class ResistiveNetworkSolver
+ * @brief DC nodal analysis: node voltages for given injected currents
+ *
+ * Assembles the sparse Laplacian L and eliminates one grounded node per
+ * connected component (the given ground in its component, the first node in
+ * every other, "floating" component). The remaining system is SPD and is
+ * solved through MatrixSolver's sparse Cholesky or preconditioned CG paths.
+ * Grounded nodes have voltage 0. For large irregular networks, where Jacobi
+ * CG converges slowly, the spanning-tree preconditioners (TreePreconditioner)
+ * usually need an order of magnitude fewer iterations.
+ *
+ * Edges can be added or reweighted after construction. Each change adds
+ * Δg·b·bᵀ (b = e_u - e_v) to the grounded Laplacian. With a factorization,
+ * the cached solution is updated by Sherman–Morrison,
+ *
+ *     x' = x - γ·z·(bᵀx),  z = L⁻¹b,  γ = Δg / (1 + Δg·bᵀz)
+ *
+ * where L⁻¹b is one solve with the factor plus O(n) per earlier update. After
+ * refactorInterval updates the Laplacian is refactorized. On a spanning tree
+ * the factor has no fill, so each update costs O(n). Without a factor, CG is
+ * restarted from the previous solution. An edge joining two components
+ * changes the grounding and triggers a full rebuild.
+ */
+class ResistiveNetworkSolver : public MatrixSolver {
+public:
+    /**
+     * @param network Network to analyze (copied)
+     * @param ground Reference node (0 V)
+     * @throws std::out_of_range if ground is not in the network
+     */
+    ResistiveNetworkSolver(const ResistiveNetwork& network, ResistiveNetwork::NodeId ground,
+                           const NetworkSolveOptions& options = NetworkSolveOptions());
+
+    /**
+     * @brief Node voltages for injected currents (amperes, by node index)
+     *
+     * Current leaving through the grounded nodes balances the injections.
+     * The currents and voltages are kept and follow later edge updates.
+     * @throws std::invalid_argument if a floating component has a nonzero
+     *         net injection (no return path) or the size is wrong
+     * @throws std::runtime_error if CG does not converge
+     */
+    VectorXd solveCurrents(const VectorXd& currents);
+
+    /**
+     * @brief +1 A into source, -1 A out of sink, as dc_solution_resistive_graph
+     */
+    VectorXd dcSolution(ResistiveNetwork::NodeId source, ResistiveNetwork::NodeId sink);
+
+    /**
+     * @brief Add a resistor and update the cached solution
+     * @return Index of the new edge
+     */
+    int addEdge(ResistiveNetwork::NodeId u, ResistiveNetwork::NodeId v, double resistance);
+
+    /**
+     * @brief Change an edge's resistance and update the cached solution
+     */
+    void setResistance(int edge, double resistance);
+
+    /**
+     * @brief Voltages of the last solve, updated by addEdge and setResistance
+     */
+    const VectorXd& voltages() const { return voltages_; }
+
+    /**
+     * @brief Rank-one updates applied since the last factorization
+     */
+    int pendingUpdates() const { return static_cast<int>(updates_.size()); }
+    int refactorizations() const { return refactorizations_; }
+
+    /**
+     * @brief Number of edge changes (addEdge, setResistance) applied so far
+     *
+     * Caches derived from the network compare it to detect that they are stale.
+     */
+    long revision() const { return revision_; }
+
+    const ResistiveNetwork& network() const { return network_; }
+    int ground() const { return ground_; }
+    int components() const { return static_cast<int>(componentGround_.size()); }
+    int component(int node) const { return component_[node]; }
+
+    /**
+     * @brief Grounded, reduced Laplacian (one row per non-grounded node)
+     *
+     * Pending rank-one updates are not included; they are merged when the
+     * Laplacian is refactorized.
+     */
+    const SparseMatrix& reducedLaplacian() const { return reduced_; }
+
+    /**
+     * @brief Reduced row of a node, -1 if the node is grounded
+     */
+    int reducedIndex(int node) const { return reducedIndex_[node]; }
+
+    bool direct() const { return direct_; }
+    int lastIterations() const { return lastIterations_; }
+
+protected:
+    /**
+     * @brief Components, grounds and the reduced Laplacian from network_
+     */
+    void rebuild();
+
+    /**
+     * @brief Solve the reduced system including pending updates
+     * @param x0 Initial guess for CG (empty: zero)
+     */
+    VectorXd solveReduced(const VectorXd& rhs, const VectorXd& x0 = VectorXd());
+
+    /**
+     * @brief Solve the reduced system for several right-hand sides (columns)
+     *
+     * One pass over the factor for all columns (SparseCholeskyFactor::solveBatch);
+     * CG solves the columns one after another.
+     */
+    MatrixXd solveReducedBatch(const MatrixXd& rhs);
+
+    /**
+     * @brief Apply a conductance change dg between two nodes to the cached solution
+     */
+    void update(int u, int v, double dg);
+
+    void refactorize();
+
+    /**
+     * @brief Apply the CG preconditioner, building it on first use
+     */
+    VectorXd precondition(const VectorXd& r);
+
+    VectorXd expand(const VectorXd& reducedVoltages) const;
+
+    struct RankOneUpdate {
+        int u;              // Reduced indices, -1 for a grounded end
+        int v;
+        double dg;
+        double gamma;       // Δg / (1 + Δg bᵀz)
+        VectorXd z;         // L⁻¹b before this update (direct solves only)
+    };
+
+    ResistiveNetwork network_;
+    NetworkSolveOptions options_;
+    int ground_;
+    std::vector<int> component_;
+    std::vector<int> componentGround_;
+    std::vector<int> reducedIndex_;
+    std::vector<int> fullIndex_;
+    SparseMatrix reduced_;
+    bool direct_ = true;
+    SparseCholeskyFactor factor_;
+    DiagonalPreconditioner jacobi_;
+    IncompleteCholeskyPreconditioner incomplete_;
+    TreePreconditioner tree_;
+    int lastIterations_ = 0;
+    std::vector<RankOneUpdate> updates_;
+    int refactorizations_ = 0;
+    long revision_ = 0;
+    VectorXd currents_;
+    VectorXd solution_;
+    VectorXd voltages_;
+};
+
+#endif // RESISTIVE_NETWORK_H
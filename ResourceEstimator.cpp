@@ -0,0 +1,245 @@
+#include "ResourceEstimator.h"
+#include "ElectrostaticSolver.h"
+#include "Factorization.h"
+#include "Multigrid.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+
+namespace {
+
+constexpr double DOUBLE = sizeof(double);
+constexpr double INDEX = sizeof(std::int32_t);    // Eigen::SparseMatrix<double> storage index
+
+/**
+ * @brief Compressed column storage of nnz entries in `columns` columns
+ */
+double compressedBytes(double nnz, double columns) {
+    return nnz * (DOUBLE + INDEX) + (columns + 1.0) * INDEX;
+}
+
+/**
+ * @brief Triplets used to assemble a sparse matrix (row, col, value)
+ */
+double tripletBytes(double nnz) {
+    return nnz * (2.0 * INDEX + DOUBLE);
+}
+
+/**
+ * @brief Sparse LDLᵀ factor: L without its unit diagonal, D and P
+ */
+double factorBytes(double fill, double m) {
+    double nnz = fill * m * std::log2(std::max(2.0, m));
+    return compressedBytes(nnz, m) + m * (DOUBLE + INDEX);
+}
+
+std::string formatBytes(double bytes) {
+    char text[32];
+    if (bytes >= 1024.0 * 1024.0 * 1024.0) {
+        std::snprintf(text, sizeof(text), "%.2f GiB", bytes / (1024.0 * 1024.0 * 1024.0));
+    } else {
+        std::snprintf(text, sizeof(text), "%.1f MiB", bytes / (1024.0 * 1024.0));
+    }
+    return text;
+}
+
+double secondsSince(const std::chrono::steady_clock::time_point& t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+} // namespace
+
+std::string ResourceEstimate::summary() const {
+    char text[160];
+    std::string name = solver + (preconditioner.empty() || preconditioner == "none" ? "" : "+" + preconditioner);
+    std::snprintf(text, sizeof(text), "%s, %ld unknowns: peak %s, ~%.3g s", name.c_str(), unknowns,
+                  formatBytes(static_cast<double>(peakBytes)).c_str(), seconds);
+    return text;
+}
+
+ResourceEstimator::ResourceEstimator(const CostModel& costs)
+    : costs_(costs) {
+}
+
+ResourceEstimate ResourceEstimator::estimate(int nx, int ny, const std::string& solver,
+                                             const std::string& preconditioner) const {
+    if (nx < 3 || ny < 3) {
+        throw std::invalid_argument("Grid needs at least 3x3 points");
+    }
+
+    ResourceEstimate e;
+    e.solver = solver;
+    e.preconditioner = preconditioner;
+
+    double N = static_cast<double>(nx) * ny;
+    double m = static_cast<double>(nx - 2) * (ny - 2);
+    double nnzK = 5.0 * m - 2.0 * (nx - 2) - 2.0 * (ny - 2);   // 5-point stencil, interior only
+    double reducedMatrix = compressedBytes(nnzK, m);
+    double grids = 2.0 * N * DOUBLE + m * DOUBLE;             // Boundary values, potential, ρ
+    double matrixSize = 0.0;
+    double factorSize = 0.0;
+    double vectorSize = 0.0;
+    double transientSize = 0.0;
+    std::string costKey = solver;
+
+    if (solver == "dense-lu") {
+        // A (N x N), b, then PartialPivLU's own copy of A and its pivots
+        matrixSize = N * N * DOUBLE;
+        factorSize = N * N * DOUBLE + N * INDEX;
+        vectorSize = 3.0 * N * DOUBLE + m * DOUBLE;
+        e.unknowns = static_cast<long>(N);
+    } else if (solver == "ldlt") {
+        // Eigen's SimplicialLDLT keeps its own L and a permuted copy of K while
+        // SparseCholeskyFactor copies L out
+        matrixSize = reducedMatrix;
+        factorSize = factorBytes(fill_, m);
+        vectorSize = 2.0 * m * DOUBLE + grids;
+        transientSize = std::max(tripletBytes(nnzK), factorSize + compressedBytes(nnzK, m));
+        e.unknowns = static_cast<long>(m);
+    } else if (solver == "pcg" || solver == "multigrid") {
+        matrixSize = reducedMatrix;
+        vectorSize = (solver == "pcg" ? 6.0 : 3.0) * m * DOUBLE + grids;
+        transientSize = tripletBytes(nnzK);
+        e.unknowns = static_cast<long>(m);
+
+        std::string pre = solver == "multigrid" ? "multigrid" : preconditioner;
+        if (pre == "multigrid") {
+            // Coarse levels hold m/3 unknowns in total with 9-point Galerkin
+            // operators; bilinear prolongations average 2.25 entries per fine
+            // row; each level keeps three work vectors
+            factorSize = compressedBytes(9.0 * m / 3.0, m / 3.0)
+                       + compressedBytes(2.25 * (m + m / 3.0), m / 3.0)
+                       + 3.0 * (m + m / 3.0) * DOUBLE;
+            transientSize = std::max(transientSize, compressedBytes(9.0 * m / 4.0 * 2.0, m / 4.0));
+            costKey = "multigrid";
+        } else if (pre == "block-jacobi") {
+            double blocks = std::max(1, blocks_);
+            factorSize = blocks * factorBytes(fill_, m / blocks);
+            transientSize = std::max(transientSize, compressedBytes(nnzK / blocks, m / blocks));
+            costKey = "block-jacobi";
+        } else if (pre == "jacobi") {
+            factorSize = m * DOUBLE;
+        } else if (pre != "none" && !pre.empty()) {
+            throw std::invalid_argument("Unknown preconditioner: " + pre);
+        }
+    } else {
+        throw std::invalid_argument("Unknown solver: " + solver);
+    }
+
+    e.matrixBytes = static_cast<size_t>(matrixSize);
+    e.factorBytes = static_cast<size_t>(factorSize);
+    e.vectorBytes = static_cast<size_t>(vectorSize);
+    e.transientBytes = static_cast<size_t>(transientSize);
+    e.peakBytes = e.matrixBytes + e.factorBytes + e.vectorBytes + e.transientBytes;
+    e.seconds = costs_.estimate(costKey, e.unknowns);
+    return e;
+}
+
+AdmissionDecision ResourceEstimator::admit(int nx, int ny, const std::string& solver,
+                                           const std::string& preconditioner,
+                                           const ResourceBudget& budget, bool allowReroute) const {
+    auto fits = [&](const ResourceEstimate& e) {
+        return (budget.memoryBytes == 0 || budget.committedBytes + e.peakBytes <= budget.memoryBytes)
+            && (budget.seconds <= 0.0 || e.seconds <= budget.seconds);
+    };
+
+    AdmissionDecision decision;
+    decision.requested = estimate(nx, ny, solver, preconditioner);
+    if (fits(decision.requested)) {
+        decision.action = AdmissionDecision::Action::Accept;
+        decision.chosen = decision.requested;
+        return decision;
+    }
+
+    char limit[64] = "";
+    if (budget.seconds > 0.0) {
+        std::snprintf(limit, sizeof(limit), ", %.3g s", budget.seconds);
+    }
+    std::string committed;
+    if (budget.memoryBytes && budget.committedBytes) {
+        committed = " with " + formatBytes(static_cast<double>(budget.committedBytes)) + " committed";
+    }
+    std::string over = decision.requested.summary() + " exceeds the budget (" +
+                       (budget.memoryBytes ? formatBytes(static_cast<double>(budget.memoryBytes)) : "any memory") +
+                       committed + limit + ")";
+    if (allowReroute) {
+        const std::pair<const char*, const char*> alternatives[] = {
+            {"ldlt", "none"}, {"pcg", "multigrid"}, {"pcg", "block-jacobi"}, {"pcg", "jacobi"}};
+        bool found = false;
+        for (const auto& alternative : alternatives) {
+            ResourceEstimate e = estimate(nx, ny, alternative.first, alternative.second);
+            if (fits(e) && (!found || e.seconds < decision.chosen.seconds)) {
+                decision.chosen = e;
+                found = true;
+            }
+        }
+        if (found) {
+            decision.action = AdmissionDecision::Action::Reroute;
+            decision.reason = over + "; rerouted to " + decision.chosen.summary();
+            return decision;
+        }
+    }
+
+    decision.action = AdmissionDecision::Action::Reject;
+    decision.reason = over;
+    return decision;
+}
+
+void ResourceEstimator::calibrate(const std::vector<int>& sizes) {
+    ElectrostaticSolver solver;
+    double fillSum = 0.0;
+    double weightSum = 0.0;
+
+    for (int n : sizes) {
+        if (n < 5) {
+            continue;
+        }
+        double h = 1.0 / (n - 1);
+        std::vector<double> rho(static_cast<size_t>(n - 2) * (n - 2), 1e-9);
+        std::vector<double> boundaryValues(static_cast<size_t>(n) * n, 0.0);
+        for (int j = 0; j < n; ++j) {
+            boundaryValues[solver.coordToIndex(0, j, n)] = 1.0;
+        }
+        MatrixSolver::SparseMatrix K;
+        Eigen::VectorXd f;
+        solver.buildReducedFDMSystem(n, n, h, h, rho, 8.854e-12, K, f, boundaryValues);
+        long m = static_cast<long>(K.rows());
+
+        // LDLᵀ: fill and factorize + solve time
+        auto t0 = std::chrono::steady_clock::now();
+        SparseCholeskyFactor factor = SparseCholeskyFactor::compute(K);
+        factor.solve(f);
+        costs_.record("ldlt", m, secondsSince(t0));
+        double measured = factor.nonZeros() / (m * std::log2(static_cast<double>(m)));
+        fillSum += measured * m;
+        weightSum += m;
+
+        // Jacobi PCG and multigrid PCG to the sweep tolerance
+        auto apply = [&](const Eigen::VectorXd& x) { return Eigen::VectorXd(K * x); };
+        t0 = std::chrono::steady_clock::now();
+        DiagonalPreconditioner jacobi = DiagonalPreconditioner::compute(K);
+        solver.solvePreconditionedCG(apply, f, [&](const Eigen::VectorXd& r) { return jacobi.apply(r); },
+                                     Eigen::VectorXd(), 10 * n, 1e-10);
+        costs_.record("pcg", m, secondsSince(t0));
+
+        t0 = std::chrono::steady_clock::now();
+        BlockJacobiPreconditioner blockJacobi = BlockJacobiPreconditioner::compute(K, blocks_);
+        solver.solvePreconditionedCG(apply, f, [&](const Eigen::VectorXd& r) { return blockJacobi.apply(r); },
+                                     Eigen::VectorXd(), 10 * n, 1e-10);
+        costs_.record("block-jacobi", m, secondsSince(t0));
+
+        t0 = std::chrono::steady_clock::now();
+        Multigrid mg;
+        mg.build(K, n - 2, n - 2);
+        solver.solvePreconditionedCG(apply, f, mg.preconditioner(), Eigen::VectorXd(), 200, 1e-10);
+        costs_.record("multigrid", m, secondsSince(t0));
+    }
+
+    // Larger grids weigh more: the constant is used for extrapolation
+    if (weightSum > 0.0) {
+        fill_ = fillSum / weightSum;
+    }
+}
@@ -0,0 +1,125 @@
+#ifndef RESOURCE_ESTIMATOR_H
+#define RESOURCE_ESTIMATOR_H
+
+#include "JobScheduler.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Predicted resources of one solve
+ *
+ * Byte counts follow the data structures the solvers actually allocate;
+ * peakBytes is the resident set plus the largest transient (assembly
+ * triplets, factorization workspace) that coexists with it.
+ */
+struct ResourceEstimate {
+    std::string solver;
+    std::string preconditioner;
+    long unknowns = 0;              // Reduced interior unknowns (full grid for dense-lu)
+    size_t matrixBytes = 0;         // System matrix
+    size_t factorBytes = 0;         // Factor or preconditioner
+    size_t vectorBytes = 0;         // Right-hand side, iterates, Krylov vectors, output grid
+    size_t transientBytes = 0;      // Freed before the solve phase
+    size_t peakBytes = 0;
+    double seconds = 0.0;           // Single-thread run time (CostModel)
+
+    /**
+     * @brief One line, e.g. "ldlt, 64009 unknowns: peak 41.3 MiB, ~0.21 s"
+     */
+    std::string summary() const;
+};
+
+/**
+ * @brief Limits for admission control (0: unlimited)
+ */
+struct ResourceBudget {
+    size_t memoryBytes = 0;
+    double seconds = 0.0;
+    size_t committedBytes = 0;      // Already held (e.g. resident factors), counted against memoryBytes
+};
+
+/**
+ * @brief Outcome of ResourceEstimator::admit
+ */
+struct AdmissionDecision {
+    enum class Action {
+        Accept,     // Requested configuration fits
+        Reroute,    // Requested one does not fit; `chosen` does
+        Reject      // Nothing fits
+    };
+
+    Action action = Action::Reject;
+    ResourceEstimate requested;
+    ResourceEstimate chosen;        // Valid for Accept and Reroute
+    std::string reason;
+};
+
+/**
+ * @class ResourceEstimator
+ * @brief Pre-solve prediction of peak memory and run time
+ *
+ * Memory comes from analytic formulas per solver:
+ * - "dense-lu": buildFDMSystem + solveLU, two N² double matrices (N = nx·ny)
+ * - "ldlt": reduced CSC matrix plus the sparse LDLᵀ factor, whose size is
+ *   fill · m · log₂ m for AMD on the 5-point grid (m interior unknowns)
+ * - "pcg": reduced matrix, six work vectors and the preconditioner
+ *   ("none", "jacobi", "block-jacobi" or "multigrid")
+ * - "multigrid": standalone V-cycles on the multigrid hierarchy
+ *
+ * Run times come from a CostModel under the solver name, except for PCG with
+ * multigrid or block-Jacobi preconditioning, which use the "multigrid" and
+ * "block-jacobi" entries. calibrate() measures the fill constant
+ * and records timings by factorizing and solving a few small grids, so both
+ * follow the machine and the Eigen version in use.
+ */
+class ResourceEstimator {
+public:
+    /**
+     * @param costs Run-time model, copied (default: built-in priors)
+     */
+    explicit ResourceEstimator(const CostModel& costs = CostModel());
+
+    /**
+     * @brief Predict the resources of a solve on an nx x ny grid
+     * @throws std::invalid_argument for unknown solvers or preconditioners
+     */
+    ResourceEstimate estimate(int nx, int ny, const std::string& solver,
+                              const std::string& preconditioner = "none") const;
+
+    /**
+     * @brief Accept, reroute or reject a solve under a budget
+     *
+     * The memory check is on committedBytes plus the peak of the new solve.
+     * If the requested configuration exceeds the budget and rerouting is
+     * allowed, the fastest alternative that fits is chosen among ldlt and
+     * PCG with multigrid, block-Jacobi or Jacobi preconditioning.
+     */
+    AdmissionDecision admit(int nx, int ny, const std::string& solver, const std::string& preconditioner,
+                            const ResourceBudget& budget, bool allowReroute = true) const;
+
+    /**
+     * @brief Measure fill and run times on small grids (e.g. {33, 65, 129})
+     *
+     * Fits the fill constant to the measured LDLᵀ factors and records the
+     * ldlt, pcg, block-jacobi and multigrid timings in this estimator's CostModel.
+     */
+    void calibrate(const std::vector<int>& sizes = {33, 65, 129});
+
+    double fillConstant() const { return fill_; }
+    void setFillConstant(double fill) { fill_ = fill; }
+
+    /**
+     * @brief Blocks assumed for block-Jacobi preconditioning
+     */
+    void setBlocks(int blocks) { blocks_ = blocks; }
+
+    const CostModel& costs() const { return costs_; }
+
+private:
+    CostModel costs_;
+    double fill_ = 1.6;     // nnz(L) / (m log₂ m), AMD on the 5-point grid
+    int blocks_ = 8;
+};
+
+#endif // RESOURCE_ESTIMATOR_H
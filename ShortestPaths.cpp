@@ -0,0 +1,338 @@
+#include "ShortestPaths.h"
+#include "ParallelFor.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace {
+
+int popcount(std::uint64_t x) {
+#ifdef _MSC_VER
+    return static_cast<int>(__popcnt64(x));
+#else
+    return __builtin_popcountll(x);
+#endif
+}
+
+/// Standard normal quantile by bisection on the CDF
+double normalQuantile(double p) {
+    double low = -40.0;
+    double high = 40.0;
+    for (int i = 0; i < 200; ++i) {
+        double mid = 0.5 * (low + high);
+        if (0.5 * std::erfc(-mid / std::sqrt(2.0)) < p) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
+    return 0.5 * (low + high);
+}
+
+/// Distances seen by one BFS source
+struct SourceTotals {
+    std::int64_t sum = 0;       // Σ d(s, v)
+    std::int64_t reached = 0;   // Vertices v ≠ s reached
+    int eccentricity = 0;
+};
+
+/// Push while the frontier touches fewer than 1/PULL_RATIO of the adjacency entries
+constexpr std::int64_t PULL_RATIO = 16;
+
+/**
+ * @brief Per-thread MS-BFS workspace; all words are zero between batches except `seen`
+ */
+class BatchSearch {
+public:
+    explicit BatchSearch(const Graph& g)
+        : g_(g), seen_(g.nodeCount()), frontier_(g.nodeCount(), 0), next_(g.nodeCount(), 0) {}
+
+    /**
+     * @brief BFS from up to 64 sources at once; adds to the totals
+     * @param perSource If given, receives the totals of each of the count sources
+     */
+    void run(const int* sources, int count, DistanceStats& totals, SourceTotals* perSource) {
+        const int n = g_.nodeCount();
+        const std::int64_t entries = static_cast<std::int64_t>(g_.targets().size());
+        const std::uint64_t full = count == 64 ? ~0ull : (1ull << count) - 1;
+        std::fill(seen_.begin(), seen_.end(), 0);
+        current_.clear();
+        for (int i = 0; i < count; ++i) {
+            int s = sources[i];
+            if (frontier_[s] == 0) {
+                current_.push_back(s);
+            }
+            frontier_[s] |= 1ull << i;
+            seen_[s] |= 1ull << i;
+        }
+
+        std::int64_t sum = 0;
+        std::int64_t pairs = 0;
+        int level = 0;
+        std::int64_t frontierEntries = 0;
+        for (int v : current_) {
+            frontierEntries += g_.degree(v);
+        }
+        while (!current_.empty()) {
+            ++level;
+            upcoming_.clear();
+            if (frontierEntries * PULL_RATIO < entries) {
+                // Push: OR each frontier word into the unseen bits of its neighbours
+                for (int v : current_) {
+                    std::uint64_t f = frontier_[v];
+                    for (int w : g_.neighbors(v)) {
+                        std::uint64_t bits = f & ~seen_[w];
+                        if (bits) {
+                            if (!next_[w]) {
+                                upcoming_.push_back(w);
+                            }
+                            next_[w] |= bits;
+                        }
+                    }
+                }
+            } else {
+                // Pull: gather the frontier bits of the neighbours
+                for (int v = 0; v < n; ++v) {
+                    if ((seen_[v] & full) == full) {
+                        continue;
+                    }
+                    std::uint64_t bits = 0;
+                    for (int w : g_.neighbors(v)) {
+                        bits |= frontier_[w];
+                    }
+                    bits &= ~seen_[v];
+                    if (bits) {
+                        next_[v] = bits;
+                        upcoming_.push_back(v);
+                    }
+                }
+            }
+
+            for (int v : current_) {
+                frontier_[v] = 0;
+            }
+            frontierEntries = 0;
+            for (int v : upcoming_) {
+                std::uint64_t bits = next_[v];
+                next_[v] = 0;
+                seen_[v] |= bits;
+                frontier_[v] = bits;
+                int reached = popcount(bits);
+                sum += static_cast<std::int64_t>(level) * reached;
+                pairs += reached;
+                frontierEntries += g_.degree(v);
+                if (perSource) {
+                    addVertical(bits);
+                }
+            }
+            if (perSource) {
+                takeVertical(level, count, perSource);
+            }
+            if (!upcoming_.empty()) {
+                totals.diameter = std::max(totals.diameter, level);
+            }
+            current_.swap(upcoming_);
+        }
+
+        totals.distanceSum += sum;
+        totals.pairs += pairs;
+        totals.sources += count;
+        totals.connected = totals.connected && pairs == static_cast<std::int64_t>(count) * (n - 1);
+    }
+
+private:
+    /// Adds one to the per-bit counters set in bits (bit-sliced ripple carry, amortized O(1))
+    void addVertical(std::uint64_t bits) {
+        for (int j = 0; bits; ++j) {
+            std::uint64_t carry = slices_[j] & bits;
+            slices_[j] ^= bits;
+            bits = carry;
+        }
+    }
+
+    /// Moves the per-bit counters of this level into the source totals
+    void takeVertical(int level, int count, SourceTotals* perSource) {
+        for (int j = 0; j < SLICES; ++j) {
+            for (std::uint64_t word = slices_[j]; word; word &= word - 1) {
+                int i = popcount((word & (0 - word)) - 1);
+                if (i < count) {
+                    perSource[i].sum += (static_cast<std::int64_t>(level) << j);
+                    perSource[i].reached += (std::int64_t{1} << j);
+                    perSource[i].eccentricity = level;
+                }
+            }
+            slices_[j] = 0;
+        }
+    }
+
+    static constexpr int SLICES = 32;   // Counters up to 2³² - 1 > any vertex count
+
+    const Graph& g_;
+    std::vector<std::uint64_t> seen_;       // Bit i: reached by source i
+    std::vector<std::uint64_t> frontier_;   // Bit i: reached by source i at this level
+    std::vector<std::uint64_t> next_;
+    std::vector<int> current_;              // Vertices with a nonzero frontier word
+    std::vector<int> upcoming_;
+    std::uint64_t slices_[SLICES] = {};     // Bit j of counter i lives in bit i of slices_[j]
+};
+
+/**
+ * @brief MS-BFS from the given sources; per-source totals land in perSource[k] for sources[k]
+ */
+DistanceStats search(const Graph& g, const std::vector<int>& sources, int threads, SourceTotals* perSource) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int s : sources) {
+        if (s < 0 || s >= g.nodeCount()) {
+            throw std::invalid_argument("BFS source " + std::to_string(s) + " is not a vertex");
+        }
+    }
+    long batches = (static_cast<long>(sources.size()) + 63) / 64;
+    threads = static_cast<int>(std::min<long>(resolveThreads(threads), std::max(1L, batches)));
+
+    // Workers take batches of 64 sources from a shared counter
+    DistanceStats stats;
+    std::mutex merge;
+    std::atomic<long> nextBatch(0);
+    parallelFor(threads, threads, [&](long, long) {
+        BatchSearch batch(g);
+        DistanceStats local;
+        for (long b = nextBatch++; b < batches; b = nextBatch++) {
+            long first = b * 64;
+            int count = static_cast<int>(std::min<long>(64, static_cast<long>(sources.size()) - first));
+            batch.run(sources.data() + first, count, local, perSource ? perSource + first : nullptr);
+        }
+        std::lock_guard<std::mutex> lock(merge);
+        stats.distanceSum += local.distanceSum;
+        stats.pairs += local.pairs;
+        stats.sources += local.sources;
+        stats.diameter = std::max(stats.diameter, local.diameter);
+        stats.connected = stats.connected && local.connected;
+    });
+
+    stats.averageDistance = stats.pairs > 0 ? static_cast<double>(stats.distanceSum) / static_cast<double>(stats.pairs)
+                                            : 0.0;
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return stats;
+}
+
+} // namespace
+
+DistanceStats ShortestPaths::exact(const Graph& g, int threads) {
+    std::vector<int> sources(g.nodeCount());
+    for (int v = 0; v < g.nodeCount(); ++v) {
+        sources[v] = v;
+    }
+    return fromSources(g, sources, threads);
+}
+
+DistanceStats ShortestPaths::fromSources(const Graph& g, const std::vector<int>& sources, int threads) {
+    return search(g, sources, threads, nullptr);
+}
+
+SampledDistanceStats ShortestPaths::sampled(const Graph& g, double relativeError, double confidence,
+                                            std::uint64_t seed, std::int64_t maxSources, int threads) {
+    if (!(relativeError > 0.0)) {
+        throw std::invalid_argument("Relative error bound must be positive");
+    }
+    if (!(confidence > 0.0 && confidence < 1.0)) {
+        throw std::invalid_argument("Confidence must be in (0, 1)");
+    }
+    auto t0 = std::chrono::steady_clock::now();
+    const int n = g.nodeCount();
+    const std::int64_t budget = maxSources > 0 ? std::min<std::int64_t>(maxSources, n) : n;
+    const double z = normalQuantile(0.5 + 0.5 * confidence);
+
+    SampledDistanceStats result;
+    result.confidence = confidence;
+
+    // Sources in sampling order: a lazily stored Fisher-Yates shuffle, so
+    // every prefix is a uniform sample without replacement
+    std::vector<int> sources;
+    std::unordered_map<int, int> swapped;
+    auto at = [&](int i) {
+        auto it = swapped.find(i);
+        return it == swapped.end() ? i : it->second;
+    };
+    std::vector<SourceTotals> totals;
+    std::int64_t sum = 0;
+    std::int64_t reached = 0;
+    for (std::int64_t target = std::min<std::int64_t>(budget, 64); n > 0; ) {
+        size_t first = sources.size();
+        for (int i = static_cast<int>(first); i < target; ++i) {
+            double u = static_cast<double>(splitMix64(seed ^ splitMix64(static_cast<std::uint64_t>(i))) >> 11) * 0x1.0p-53;
+            int j = i + std::min(n - 1 - i, static_cast<int>(u * (n - i)));
+            int pick = at(j);
+            swapped[j] = at(i);
+            sources.push_back(pick);
+        }
+        totals.resize(sources.size());
+        std::vector<int> batch(sources.begin() + first, sources.end());
+        DistanceStats part = search(g, batch, threads, totals.data() + first);
+        sum += part.distanceSum;
+        reached += part.pairs;
+        result.diameterLowerBound = std::max(result.diameterLowerBound, part.diameter);
+        result.connected = result.connected && part.connected;
+
+        // Ratio estimator Σ d / Σ reached; delta-method variance with the
+        // finite-population correction (1 - k/n)
+        const std::int64_t k = static_cast<std::int64_t>(sources.size());
+        double ratio = reached > 0 ? static_cast<double>(sum) / static_cast<double>(reached) : 0.0;
+        result.averageDistance = ratio;
+        result.sources = k;
+        if (k == n) {
+            result.halfWidth = 0.0;
+            result.exact = true;
+            result.converged = true;
+            break;
+        }
+        double squares = 0.0;
+        for (const SourceTotals& t : totals) {
+            double residual = static_cast<double>(t.sum) - ratio * static_cast<double>(t.reached);
+            squares += residual * residual;
+        }
+        double meanReached = static_cast<double>(reached) / static_cast<double>(k);
+        double variance = k > 1 ? squares / static_cast<double>(k - 1) : 0.0;
+        double fraction = static_cast<double>(k) / static_cast<double>(n);
+        result.halfWidth = meanReached > 0.0
+            ? z * std::sqrt(variance / static_cast<double>(k) * (1.0 - fraction)) / meanReached : 0.0;
+        result.converged = k > 1 && result.halfWidth <= relativeError * ratio;
+        if (result.converged || k >= budget) {
+            break;
+        }
+        target = std::min(budget, 2 * k);
+    }
+    if (n <= 1) {
+        result.exact = true;
+        result.converged = true;
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return result;
+}
+
+std::vector<int> ShortestPaths::distances(const Graph& g, int source) {
+    if (source < 0 || source >= g.nodeCount()) {
+        throw std::invalid_argument("BFS source " + std::to_string(source) + " is not a vertex");
+    }
+    std::vector<int> distance(g.nodeCount(), -1);
+    std::vector<int> queue{source};
+    queue.reserve(g.nodeCount());
+    distance[source] = 0;
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int v = queue[head];
+        for (int w : g.neighbors(v)) {
+            if (distance[w] < 0) {
+                distance[w] = distance[v] + 1;
+                queue.push_back(w);
+            }
+        }
+    }
+    return distance;
+}
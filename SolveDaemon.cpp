@@ -0,0 +1,790 @@
+#include "SolveDaemon.h"
+#include "ElectrostaticSolver.h"
+#include "Factorization.h"
+#include "FactorizationCache.h"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+using namespace SolveProtocol;
+
+namespace {
+
+double microsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Memory held by a resident LDLᵀ factor: L without its diagonal, D and P
+ */
+size_t residentBytes(const SparseCholeskyFactor& factor) {
+    size_t n = static_cast<size_t>(factor.size());
+    return static_cast<size_t>(factor.nonZeros()) * (sizeof(double) + sizeof(std::int32_t))
+         + (n + 1) * sizeof(std::int32_t) + n * (sizeof(double) + sizeof(std::int32_t));
+}
+
+#ifndef _WIN32
+
+bool readFully(int fd, void* data, size_t bytes) {
+    char* p = static_cast<char*>(data);
+    while (bytes > 0) {
+        ssize_t n = ::recv(fd, p, bytes, 0);
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        p += n;
+        bytes -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool writeFully(int fd, const void* data, size_t bytes) {
+    const char* p = static_cast<const char*>(data);
+    while (bytes > 0) {
+        ssize_t n = ::send(fd, p, bytes, MSG_NOSIGNAL);
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        p += n;
+        bytes -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool sendFrame(int fd, MessageType type, std::uint64_t requestId, const void* payload, size_t bytes) {
+    FrameHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.type = static_cast<std::uint16_t>(type);
+    header.payloadBytes = static_cast<std::uint32_t>(bytes);
+    header.requestId = requestId;
+    return writeFully(fd, &header, sizeof(header)) && (bytes == 0 || writeFully(fd, payload, bytes));
+}
+
+bool receiveFrame(int fd, FrameHeader& header, std::vector<char>& payload) {
+    if (!readFully(fd, &header, sizeof(header))) {
+        return false;
+    }
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION) {
+        throw std::runtime_error("Invalid frame header (magic or protocol version mismatch)");
+    }
+    if (header.payloadBytes > MAX_PAYLOAD) {
+        throw std::runtime_error("Frame payload too large");
+    }
+    payload.resize(header.payloadBytes);
+    return header.payloadBytes == 0 || readFully(fd, payload.data(), payload.size());
+}
+
+// Read frames until the reply to requestId arrives. Replies to earlier requests
+// (for example an Error sent after the client already gave up) are dropped, and
+// the shared memory of a stale SolveResponse is released. Error frames with id 0
+// report a connection-level failure and are always returned.
+bool receiveReply(int fd, std::uint64_t requestId, FrameHeader& header, std::vector<char>& payload) {
+    while (receiveFrame(fd, header, payload)) {
+        bool connectionError = static_cast<MessageType>(header.type) == MessageType::Error && header.requestId == 0;
+        if (header.requestId == requestId || connectionError) {
+            return true;
+        }
+        if (static_cast<MessageType>(header.type) == MessageType::SolveResponse &&
+            payload.size() == sizeof(SolveResponseHeader)) {
+            SolveResponseHeader stale;
+            std::memcpy(&stale, payload.data(), sizeof(stale));
+            stale.sharedMemoryName[sizeof(stale.sharedMemoryName) - 1] = '\0';
+            ::shm_unlink(stale.sharedMemoryName);
+        }
+    }
+    return false;
+}
+
+#endif
+
+} // namespace
+
+// ========== LatencyHistogram ==========
+
+void LatencyHistogram::record(double micros) {
+    int b = micros < 1.0 ? 0 : static_cast<int>(std::floor(std::log2(micros)));
+    buckets_[std::min(b, BUCKETS - 1)]++;
+    count_++;
+    sum_ += micros;
+    max_ = std::max(max_, micros);
+}
+
+double LatencyHistogram::percentile(double q) const {
+    if (count_ == 0) {
+        return 0.0;
+    }
+    auto target = static_cast<std::uint64_t>(std::ceil(q * static_cast<double>(count_)));
+    std::uint64_t cumulative = 0;
+    for (int b = 0; b < BUCKETS; ++b) {
+        cumulative += buckets_[b];
+        if (cumulative >= target) {
+            return std::ldexp(1.0, b + 1);
+        }
+    }
+    return max_;
+}
+
+std::string LatencyHistogram::format(const std::string& name) const {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1);
+    out << name << ": n=" << count_ << ", mean=" << mean() << " us"
+        << ", p50<=" << percentile(0.5) << " us"
+        << ", p99<=" << percentile(0.99) << " us"
+        << ", max=" << max_ << " us\n";
+    for (int b = 0; b < BUCKETS; ++b) {
+        if (buckets_[b] > 0) {
+            out << "  [" << std::setw(9) << std::ldexp(1.0, b) << ", " << std::setw(9) << std::ldexp(1.0, b + 1)
+                << ") us: " << buckets_[b] << "\n";
+        }
+    }
+    return out.str();
+}
+
+// ========== SolveDaemon ==========
+
+SolveDaemon::SolveDaemon(const SolveDaemonOptions& options)
+    : options_(options) {}
+
+SolveDaemon::~SolveDaemon() {
+    stop();
+}
+
+std::uint64_t SolveDaemon::solvedRequests() const {
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    return solvedRequests_;
+}
+
+std::uint64_t SolveDaemon::solvedBatches() const {
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    return solvedBatches_;
+}
+
+std::string SolveDaemon::statsReport() const {
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    std::ostringstream out;
+    out << "Solved requests: " << solvedRequests_ << " in " << solvedBatches_ << " batches\n";
+    out << queueLatency_.format("Queue latency");
+    out << solveLatency_.format("Batch solve latency");
+    out << totalLatency_.format("Server latency");
+    out << "Batch sizes:\n";
+    const char* labels[] = {"1", "2", "3-4", "5-8", "9-16", "17-32", "33-64", ">64"};
+    for (size_t b = 0; b < batchSizes_.size(); ++b) {
+        if (batchSizes_[b] > 0) {
+            out << "  " << std::setw(5) << labels[b] << ": " << batchSizes_[b] << "\n";
+        }
+    }
+    return out.str();
+}
+
+void SolveDaemon::requestShutdown() {
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    shutdownRequested_ = true;
+    queueCv_.notify_all();
+}
+
+void SolveDaemon::wait() {
+    std::unique_lock<std::mutex> lock(queueMutex_);
+    queueCv_.wait(lock, [&] { return shutdownRequested_ || !running_; });
+}
+
+std::shared_ptr<FactorizationBundle> SolveDaemon::residentFactor(std::uint64_t key) {
+    auto it = factors_.find(key);
+    if (it != factors_.end()) {
+        return it->second;
+    }
+    if (options_.cacheDirectory.empty()) {
+        return nullptr;
+    }
+
+    auto bundle = std::make_shared<FactorizationBundle>();
+    if (!FactorizationCache(options_.cacheDirectory).load(key, *bundle)) {
+        return nullptr;
+    }
+    const SparseCholeskyFactor* factor = bundle->sparseCholesky("reduced/ldlt");
+    if (!factor) {
+        return nullptr;
+    }
+    factors_[key] = bundle;
+    factorBytes_[key] = residentBytes(*factor);
+    return bundle;
+}
+
+bool SolveDaemon::admit(const SolveRequestHeader& spec, std::string& reason) {
+    if (options_.memoryBudgetBytes == 0) {
+        return true;
+    }
+    ElectrostaticSolver solver;
+    std::uint64_t key = solver.geometryHash(spec.nx, spec.ny, spec.dx, spec.dy);
+
+    std::lock_guard<std::mutex> lock(factorsMutex_);
+    // Factors in memory, on disk or already admitted need no new factorization
+    if (factorBytes_.count(key) || residentFactor(key)) {
+        return true;
+    }
+
+    // New geometries must fit next to every factor the daemon already holds
+    ResourceBudget budget;
+    budget.memoryBytes = options_.memoryBudgetBytes;
+    for (const auto& entry : factorBytes_) {
+        budget.committedBytes += entry.second;
+    }
+    AdmissionDecision decision = estimator_.admit(spec.nx, spec.ny, "ldlt", "none", budget, false);
+    if (decision.action != AdmissionDecision::Action::Accept) {
+        reason = decision.reason;
+        return false;
+    }
+    factorBytes_[key] = decision.requested.factorBytes;
+    return true;
+}
+
+std::shared_ptr<FactorizationBundle> SolveDaemon::factorFor(
+    std::uint64_t key, int nx, int ny, double dx, double dy, bool& hit) {
+
+    {
+        std::lock_guard<std::mutex> lock(factorsMutex_);
+        if (std::shared_ptr<FactorizationBundle> resident = residentFactor(key)) {
+            hit = true;
+            return resident;
+        }
+    }
+
+    // Miss: factorize the operator (it does not depend on rho, ε or boundary values).
+    // The lock is not held here so admission keeps running during a cold factorization.
+    FactorizationBundle additions;
+    try {
+        ElectrostaticSolver solver;
+        std::vector<double> rho(static_cast<size_t>(nx - 2) * static_cast<size_t>(ny - 2), 0.0);
+        std::vector<double> boundaryValues(static_cast<size_t>(nx) * static_cast<size_t>(ny), 0.0);
+        MatrixSolver::SparseMatrix K;
+        Eigen::VectorXd f;
+        solver.buildReducedFDMSystem(nx, ny, dx, dy, rho, 1.0, K, f, boundaryValues);
+        additions.add("reduced/ldlt", SparseCholeskyFactor::compute(K));
+
+        // Other users of this key (e.g. multigrid levels) keep their entries in the file
+        if (!options_.cacheDirectory.empty()) {
+            FactorizationCache(options_.cacheDirectory).update(key, additions);
+        }
+    } catch (...) {
+        // Release the memory reserved at admission, unless another thread published the key
+        std::lock_guard<std::mutex> lock(factorsMutex_);
+        if (!factors_.count(key)) {
+            factorBytes_.erase(key);
+        }
+        throw;
+    }
+    auto bundle = std::make_shared<FactorizationBundle>();
+    bundle->merge(additions);
+
+    hit = false;
+    std::lock_guard<std::mutex> lock(factorsMutex_);
+    auto published = factors_.emplace(key, bundle);
+    if (!published.second) {
+        return published.first->second;     // Another thread factorized the same key first
+    }
+    factorBytes_[key] = residentBytes(*bundle->sparseCholesky("reduced/ldlt"));
+    return bundle;
+}
+
+#ifndef _WIN32
+
+SolveDaemon::Connection::~Connection() {
+    ::close(fd);
+}
+
+void SolveDaemon::start() {
+    if (running_) {
+        return;
+    }
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (options_.socketPath.size() >= sizeof(address.sun_path)) {
+        throw std::invalid_argument("Socket path too long: " + options_.socketPath);
+    }
+    std::strncpy(address.sun_path, options_.socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+    listenFd_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd_ < 0) {
+        throw std::runtime_error("Cannot create Unix socket");
+    }
+    ::unlink(options_.socketPath.c_str());
+    if (::bind(listenFd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listenFd_, 64) != 0) {
+        ::close(listenFd_);
+        listenFd_ = -1;
+        throw std::runtime_error("Cannot listen on " + options_.socketPath + ": " + std::strerror(errno));
+    }
+
+    stopping_ = false;
+    solverStop_ = false;
+    shutdownRequested_ = false;
+    running_ = true;
+    solveThread_ = std::thread(&SolveDaemon::solveLoop, this);
+    acceptThread_ = std::thread(&SolveDaemon::acceptLoop, this);
+
+    if (options_.verbose) {
+        std::cout << "Solve daemon listening on " << options_.socketPath << std::endl;
+    }
+}
+
+void SolveDaemon::stop() {
+    if (!running_) {
+        return;
+    }
+    stopping_ = true;
+
+    // Stop accepting new connections
+    ::shutdown(listenFd_, SHUT_RDWR);
+    ::close(listenFd_);
+    listenFd_ = -1;
+    if (acceptThread_.joinable()) {
+        acceptThread_.join();
+    }
+
+    // Solve what is already queued, then stop the solver
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        solverStop_ = true;
+    }
+    queueCv_.notify_all();
+    if (solveThread_.joinable()) {
+        solveThread_.join();
+    }
+
+    // Wake up and join the connection readers
+    std::vector<std::thread> readers;
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex_);
+        for (auto& connection : connections_) {
+            ::shutdown(connection->fd, SHUT_RDWR);
+        }
+        readers.swap(readers_);
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex_);
+        connections_.clear();
+    }
+
+    ::unlink(options_.socketPath.c_str());
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        running_ = false;
+    }
+    queueCv_.notify_all();
+}
+
+void SolveDaemon::acceptLoop() {
+    while (!stopping_) {
+        int fd = ::accept(listenFd_, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+
+        auto connection = std::make_shared<Connection>(fd);
+        std::lock_guard<std::mutex> lock(connectionsMutex_);
+
+        // Reap readers of clients that have disconnected
+        for (size_t i = 0; i < connections_.size();) {
+            if (connections_[i]->finished) {
+                readers_[i].join();
+                readers_.erase(readers_.begin() + i);
+                connections_.erase(connections_.begin() + i);
+            } else {
+                ++i;
+            }
+        }
+
+        connections_.push_back(connection);
+        readers_.emplace_back(&SolveDaemon::readLoop, this, connection);
+    }
+}
+
+void SolveDaemon::readLoop(std::shared_ptr<Connection> connection) {
+    FrameHeader header{};
+    std::vector<char> payload;
+
+    while (!stopping_) {
+        try {
+            if (!receiveFrame(connection->fd, header, payload)) {
+                break;
+            }
+        } catch (const std::exception& e) {
+            // Framing is lost; report and drop the connection
+            std::lock_guard<std::mutex> lock(connection->writeMutex);
+            sendFrame(connection->fd, MessageType::Error, 0, e.what(), std::strlen(e.what()));
+            break;
+        }
+
+        auto reply = [&](MessageType type, const std::string& text) {
+            std::lock_guard<std::mutex> lock(connection->writeMutex);
+            sendFrame(connection->fd, type, header.requestId, text.data(), text.size());
+        };
+
+        switch (static_cast<MessageType>(header.type)) {
+            case MessageType::SolveRequest: {
+                Pending pending;
+                if (payload.size() < sizeof(SolveRequestHeader)) {
+                    reply(MessageType::Error, "Truncated solve request");
+                    break;
+                }
+                std::memcpy(&pending.spec, payload.data(), sizeof(SolveRequestHeader));
+                const SolveRequestHeader& spec = pending.spec;
+                if (spec.nx < 3 || spec.ny < 3 || spec.dx <= 0.0 || spec.dy <= 0.0 || spec.epsilon <= 0.0) {
+                    reply(MessageType::Error, "Invalid grid, spacing or permittivity");
+                    break;
+                }
+                size_t interior = static_cast<size_t>(spec.nx - 2) * (spec.ny - 2);
+                size_t full = static_cast<size_t>(spec.nx) * spec.ny;
+                if (payload.size() != sizeof(SolveRequestHeader) + sizeof(double) * (interior + full)) {
+                    reply(MessageType::Error, "Solve request size does not match the grid");
+                    break;
+                }
+                std::string reason;
+                if (!admit(spec, reason)) {
+                    reply(MessageType::Error, "Rejected: " + reason);
+                    break;
+                }
+
+                const char* data = payload.data() + sizeof(SolveRequestHeader);
+                pending.rho.resize(interior);
+                pending.boundaryValues.resize(full);
+                std::memcpy(pending.rho.data(), data, sizeof(double) * interior);
+                std::memcpy(pending.boundaryValues.data(), data + sizeof(double) * interior, sizeof(double) * full);
+                pending.connection = connection;
+                pending.requestId = header.requestId;
+                pending.arrival = std::chrono::steady_clock::now();
+
+                {
+                    std::lock_guard<std::mutex> lock(queueMutex_);
+                    queue_.push_back(std::move(pending));
+                }
+                queueCv_.notify_all();
+                break;
+            }
+            case MessageType::StatsRequest:
+                reply(MessageType::StatsResponse, statsReport());
+                break;
+            case MessageType::Shutdown:
+                reply(MessageType::Shutdown, "");
+                requestShutdown();
+                break;
+            default:
+                reply(MessageType::Error, "Unexpected message type " + std::to_string(header.type));
+                break;
+        }
+    }
+
+    connection->finished = true;
+}
+
+void SolveDaemon::solveLoop() {
+    for (;;) {
+        std::vector<Pending> batch;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex_);
+            queueCv_.wait(lock, [&] { return !queue_.empty() || solverStop_; });
+            if (queue_.empty()) {
+                return;
+            }
+
+            // Give compatible requests a short window to join the batch
+            auto deadline = queue_.front().arrival + std::chrono::microseconds(options_.batchWindowMicros);
+            queueCv_.wait_until(lock, deadline, [&] {
+                return static_cast<int>(queue_.size()) >= options_.maxBatchSize || solverStop_;
+            });
+
+            size_t take = std::min(queue_.size(), static_cast<size_t>(options_.maxBatchSize));
+            for (size_t i = 0; i < take; ++i) {
+                batch.push_back(std::move(queue_.front()));
+                queue_.pop_front();
+            }
+        }
+
+        // Group by geometry: one factorization and one multi-RHS solve per group
+        ElectrostaticSolver solver;
+        std::map<std::uint64_t, std::vector<Pending>> groups;
+        for (auto& pending : batch) {
+            const SolveRequestHeader& s = pending.spec;
+            groups[solver.geometryHash(s.nx, s.ny, s.dx, s.dy)].push_back(std::move(pending));
+        }
+        for (auto& group : groups) {
+            solveBatch(group.second);
+        }
+    }
+}
+
+void SolveDaemon::solveBatch(std::vector<Pending>& batch) {
+    auto start = std::chrono::steady_clock::now();
+    const SolveRequestHeader& spec = batch.front().spec;
+    int k = static_cast<int>(batch.size());
+    int answered = 0;   // Requests in front of this index already have their SolveResponse
+
+    try {
+        ElectrostaticSolver solver;
+        bool hit = false;
+        std::uint64_t key = solver.geometryHash(spec.nx, spec.ny, spec.dx, spec.dy);
+        std::shared_ptr<FactorizationBundle> bundle = factorFor(key, spec.nx, spec.ny, spec.dx, spec.dy, hit);
+        const SparseCholeskyFactor* factor = bundle->sparseCholesky("reduced/ldlt");
+
+        // ========== Multi-RHS Solve ==========
+        // K is already factored; only the right-hand sides are assembled
+        Eigen::MatrixXd F(factor->size(), k);
+        for (int c = 0; c < k; ++c) {
+            solver.buildReducedRightHandSide(spec.nx, spec.ny, spec.dx, spec.dy, batch[c].rho.data(),
+                                             batch[c].spec.epsilon, batch[c].boundaryValues.data(),
+                                             batch[c].boundaryValues.size(), F.col(c).data());
+        }
+        auto solveStart = std::chrono::steady_clock::now();
+        Eigen::MatrixXd U = factor->solveBatch(F);
+        double solveMicros = microsSince(solveStart);
+
+        // ========== Results via Shared Memory ==========
+        size_t full = static_cast<size_t>(spec.nx) * spec.ny;
+        size_t bytes = sizeof(double) * full;
+        for (int c = 0; c < k; ++c) {
+            Pending& pending = batch[c];
+            Eigen::VectorXd phi = solver.expandReducedSolution(spec.nx, spec.ny, U.col(c), pending.boundaryValues);
+
+            SolveResponseHeader response{};
+            response.nx = spec.nx;
+            response.ny = spec.ny;
+            response.batchSize = k;
+            response.cacheHit = hit ? 1 : 0;
+            response.resultBytes = bytes;
+            response.queueMicros = std::chrono::duration<double, std::micro>(start - pending.arrival).count();
+            response.solveMicros = solveMicros;
+
+            std::uint64_t serial;
+            {
+                std::lock_guard<std::mutex> lock(statsMutex_);
+                serial = sharedMemoryCounter_++;
+            }
+            std::snprintf(response.sharedMemoryName, sizeof(response.sharedMemoryName), "/schd_%ld_%llu",
+                          static_cast<long>(::getpid()), static_cast<unsigned long long>(serial));
+
+            int shm = ::shm_open(response.sharedMemoryName, O_CREAT | O_EXCL | O_RDWR, 0600);
+            if (shm < 0 || ::ftruncate(shm, static_cast<off_t>(bytes)) != 0) {
+                if (shm >= 0) {
+                    ::close(shm);
+                    ::shm_unlink(response.sharedMemoryName);
+                }
+                throw std::runtime_error("Cannot create shared memory for the result");
+            }
+            void* mapped = ::mmap(nullptr, bytes, PROT_WRITE, MAP_SHARED, shm, 0);
+            ::close(shm);
+            if (mapped == MAP_FAILED) {
+                ::shm_unlink(response.sharedMemoryName);
+                throw std::runtime_error("Cannot map shared memory for the result");
+            }
+            std::memcpy(mapped, phi.data(), bytes);
+            ::munmap(mapped, bytes);
+
+            bool sent;
+            {
+                std::lock_guard<std::mutex> lock(pending.connection->writeMutex);
+                sent = sendFrame(pending.connection->fd, MessageType::SolveResponse, pending.requestId,
+                                 &response, sizeof(response));
+            }
+            if (!sent) {
+                ::shm_unlink(response.sharedMemoryName);   // Client is gone
+            }
+            answered = c + 1;
+
+            std::lock_guard<std::mutex> lock(statsMutex_);
+            queueLatency_.record(response.queueMicros);
+            totalLatency_.record(microsSince(pending.arrival));
+        }
+
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        solveLatency_.record(solveMicros);
+        int b = 0;
+        while (b < 7 && (1 << b) < k) {
+            ++b;
+        }
+        batchSizes_[b]++;
+        solvedRequests_ += k;
+        solvedBatches_++;
+    } catch (const std::exception& e) {
+        // Requests that already received a SolveResponse must not also get an Error
+        for (int c = answered; c < k; ++c) {
+            Pending& pending = batch[c];
+            std::lock_guard<std::mutex> lock(pending.connection->writeMutex);
+            sendFrame(pending.connection->fd, MessageType::Error, pending.requestId, e.what(), std::strlen(e.what()));
+        }
+    }
+
+    if (options_.verbose) {
+        std::cout << "Solved batch of " << k << " (" << spec.nx << "x" << spec.ny << ") in "
+                  << microsSince(start) << " us" << std::endl;
+    }
+}
+
+// ========== SolveClient ==========
+
+SolveClient::SolveClient(const std::string& socketPath) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        throw std::invalid_argument("Socket path too long: " + socketPath);
+    }
+    std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+    fd_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd_ < 0 || ::connect(fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+        throw std::runtime_error("Cannot connect to solve daemon at " + socketPath);
+    }
+}
+
+SolveClient::~SolveClient() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+SolveClient::VectorXd SolveClient::solve(
+    int nx, int ny,
+    double dx, double dy,
+    const std::vector<double>& rho,
+    double epsilon,
+    const std::vector<double>& boundaryValues,
+    SolveTiming* timing) {
+
+    auto start = std::chrono::steady_clock::now();
+
+    SolveRequestHeader spec{nx, ny, dx, dy, epsilon};
+    std::vector<char> payload(sizeof(spec) + sizeof(double) * (rho.size() + boundaryValues.size()));
+    std::memcpy(payload.data(), &spec, sizeof(spec));
+    std::memcpy(payload.data() + sizeof(spec), rho.data(), sizeof(double) * rho.size());
+    std::memcpy(payload.data() + sizeof(spec) + sizeof(double) * rho.size(),
+                boundaryValues.data(), sizeof(double) * boundaryValues.size());
+
+    std::uint64_t id = nextId_++;
+    if (!sendFrame(fd_, MessageType::SolveRequest, id, payload.data(), payload.size())) {
+        throw std::runtime_error("Lost connection to solve daemon");
+    }
+
+    FrameHeader header{};
+    std::vector<char> reply;
+    if (!receiveReply(fd_, id, header, reply)) {
+        throw std::runtime_error("Lost connection to solve daemon");
+    }
+    if (static_cast<MessageType>(header.type) == MessageType::Error) {
+        throw std::runtime_error("Solve daemon error: " + std::string(reply.begin(), reply.end()));
+    }
+    if (static_cast<MessageType>(header.type) != MessageType::SolveResponse ||
+        reply.size() != sizeof(SolveResponseHeader)) {
+        throw std::runtime_error("Unexpected reply from solve daemon");
+    }
+
+    SolveResponseHeader response;
+    std::memcpy(&response, reply.data(), sizeof(response));
+    response.sharedMemoryName[sizeof(response.sharedMemoryName) - 1] = '\0';
+    if (response.nx <= 0 || response.ny <= 0 ||
+        response.resultBytes < sizeof(double) * static_cast<size_t>(response.nx) * static_cast<size_t>(response.ny)) {
+        ::shm_unlink(response.sharedMemoryName);
+        throw std::runtime_error("Solve daemon result is smaller than its grid");
+    }
+
+    // Map the result, copy it out and release the object
+    int shm = ::shm_open(response.sharedMemoryName, O_RDONLY, 0);
+    if (shm < 0) {
+        throw std::runtime_error("Cannot open result shared memory " + std::string(response.sharedMemoryName));
+    }
+    ::shm_unlink(response.sharedMemoryName);
+    void* mapped = ::mmap(nullptr, response.resultBytes, PROT_READ, MAP_SHARED, shm, 0);
+    ::close(shm);
+    if (mapped == MAP_FAILED) {
+        throw std::runtime_error("Cannot map result shared memory");
+    }
+    VectorXd phi = Eigen::Map<const VectorXd>(static_cast<const double*>(mapped),
+                                              static_cast<Eigen::Index>(response.nx) * response.ny);
+    ::munmap(mapped, response.resultBytes);
+
+    if (timing) {
+        timing->batchSize = response.batchSize;
+        timing->cacheHit = response.cacheHit != 0;
+        timing->queueMicros = response.queueMicros;
+        timing->solveMicros = response.solveMicros;
+        timing->roundTripMicros = microsSince(start);
+    }
+    return phi;
+}
+
+std::string SolveClient::stats() {
+    std::uint64_t id = nextId_++;
+    FrameHeader header{};
+    std::vector<char> reply;
+    if (!sendFrame(fd_, MessageType::StatsRequest, id, nullptr, 0) || !receiveReply(fd_, id, header, reply)) {
+        throw std::runtime_error("Lost connection to solve daemon");
+    }
+    return std::string(reply.begin(), reply.end());
+}
+
+void SolveClient::shutdown() {
+    std::uint64_t id = nextId_++;
+    FrameHeader header{};
+    std::vector<char> reply;
+    if (!sendFrame(fd_, MessageType::Shutdown, id, nullptr, 0) || !receiveReply(fd_, id, header, reply)) {
+        throw std::runtime_error("Lost connection to solve daemon");
+    }
+}
+
+#else
+
+SolveDaemon::Connection::~Connection() {}
+
+void SolveDaemon::start() {
+    throw std::runtime_error("SolveDaemon requires Unix domain sockets and POSIX shared memory");
+}
+
+void SolveDaemon::stop() {}
+void SolveDaemon::acceptLoop() {}
+void SolveDaemon::readLoop(std::shared_ptr<Connection>) {}
+void SolveDaemon::solveLoop() {}
+void SolveDaemon::solveBatch(std::vector<Pending>&) {}
+
+SolveClient::SolveClient(const std::string&) {
+    throw std::runtime_error("SolveClient requires Unix domain sockets");
+}
+
+SolveClient::~SolveClient() {}
+
+SolveClient::VectorXd SolveClient::solve(int, int, double, double, const std::vector<double>&, double,
+                                         const std::vector<double>&, SolveTiming*) {
+    return VectorXd();
+}
+
+std::string SolveClient::stats() { return std::string(); }
+void SolveClient::shutdown() {}
+
+#endif
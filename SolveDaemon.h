@@ -0,0 +1,305 @@
+#ifndef SOLVE_DAEMON_H
+#define SOLVE_DAEMON_H
+
+#include "ResourceEstimator.h"
+#include <Eigen/Dense>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class FactorizationBundle;
+
+// ========== Wire Format ==========
+//
+// Every message is a FrameHeader followed by payloadBytes bytes. All fields
+// are native-endian; the socket never leaves the machine.
+//
+// SolveRequest payload:  SolveRequestHeader, rho[(nx-2)*(ny-2)], boundaryValues[nx*ny]
+// SolveResponse payload: SolveResponseHeader (the potential is in shared memory)
+// StatsResponse payload: UTF-8 text of SolveDaemon::statsReport()
+// Error payload:         UTF-8 error message
+
+namespace SolveProtocol {
+
+constexpr char MAGIC[4] = {'S', 'C', 'H', 'D'};
+constexpr std::uint16_t VERSION = 1;
+
+enum class MessageType : std::uint16_t {
+    SolveRequest = 1,
+    SolveResponse = 2,
+    StatsRequest = 3,
+    StatsResponse = 4,
+    Shutdown = 5,
+    Error = 6
+};
+
+struct FrameHeader {
+    char magic[4];
+    std::uint16_t version;
+    std::uint16_t type;
+    std::uint32_t payloadBytes;
+    std::uint32_t reserved;
+    std::uint64_t requestId;
+};
+static_assert(sizeof(FrameHeader) == 24, "FrameHeader layout");
+
+struct SolveRequestHeader {
+    std::int32_t nx;
+    std::int32_t ny;
+    double dx;
+    double dy;
+    double epsilon;
+};
+static_assert(sizeof(SolveRequestHeader) == 32, "SolveRequestHeader layout");
+
+struct SolveResponseHeader {
+    std::int32_t nx;
+    std::int32_t ny;
+    std::int32_t batchSize;         // Number of requests solved together with this one
+    std::int32_t cacheHit;          // 1 if the factorization came from memory or disk
+    std::uint64_t resultBytes;      // nx*ny doubles in the shared-memory object
+    double queueMicros;             // Time from arrival to start of the batch
+    double solveMicros;             // Time of the batched triangular solves
+    char sharedMemoryName[64];      // POSIX shm name; the client unlinks it after mapping
+};
+static_assert(sizeof(SolveResponseHeader) == 104, "SolveResponseHeader layout");
+
+constexpr std::uint32_t MAX_PAYLOAD = 1u << 30;
+
+} // namespace SolveProtocol
+
+/**
+ * @class LatencyHistogram
+ * @brief Log₂-bucketed latency histogram (bucket b holds [2ᵇ, 2ᵇ⁺¹) µs)
+ *
+ * Not synchronized; SolveDaemon guards its histograms with a mutex.
+ */
+class LatencyHistogram {
+public:
+    static constexpr int BUCKETS = 40;
+
+    void record(double micros);
+
+    std::uint64_t count() const { return count_; }
+    double mean() const { return count_ ? sum_ / static_cast<double>(count_) : 0.0; }
+    double max() const { return max_; }
+
+    /**
+     * @brief Upper bound of the bucket containing quantile q (0 < q ≤ 1)
+     */
+    double percentile(double q) const;
+
+    const std::array<std::uint64_t, BUCKETS>& buckets() const { return buckets_; }
+
+    /**
+     * @brief One summary line plus the non-empty buckets
+     */
+    std::string format(const std::string& name) const;
+
+private:
+    std::array<std::uint64_t, BUCKETS> buckets_{};
+    std::uint64_t count_ = 0;
+    double sum_ = 0.0;
+    double max_ = 0.0;
+};
+
+/**
+ * @brief Configuration of a SolveDaemon
+ */
+struct SolveDaemonOptions {
+    std::string socketPath = "/tmp/schrodinger_solve.sock";
+    std::string cacheDirectory = "factor_cache";   // Shared with FactorizationCache users; empty disables
+    int batchWindowMicros = 2000;                  // How long the first request of a batch waits for company
+    int maxBatchSize = 64;
+    size_t memoryBudgetBytes = 0;                  // Limit for resident factors plus a new solve; 0: no limit
+    bool verbose = false;
+};
+
+/**
+ * @class SolveDaemon
+ * @brief Long-lived solve server on a Unix domain socket
+ *
+ * Clients send problem specs (grid, spacing, permittivity, charge density and
+ * boundary values) as binary frames. Requests that arrive within the batch
+ * window and share a geometry (same geometryHash, i.e. the same reduced
+ * operator) are solved together: the right-hand sides are stacked and solved
+ * with one multi-RHS pass of the sparse LDLᵀ factor. Factors are kept in
+ * memory and shared on disk through FactorizationCache, so a restarted daemon
+ * or another process starts warm.
+ *
+ * Each potential is written to its own POSIX shared-memory object; the
+ * response frame carries only the object name, so large grids are not
+ * pushed through the socket. Queue, solve and end-to-end latencies are
+ * recorded in histograms, available through statsReport() and the
+ * StatsRequest message.
+ *
+ * With a memory budget, a request for a geometry without a factor (in
+ * memory or in the cache directory) is checked by a ResourceEstimator before
+ * it is queued: the peak of its LDLᵀ solve must fit next to all factors the
+ * daemon already holds. Otherwise it is answered with an Error frame instead
+ * of being factorized. Cache hits are never rejected.
+ *
+ * Threading: one accept thread, one reader thread per connection and one
+ * solver thread that forms and executes batches. Only available on POSIX
+ * systems; on Windows start() throws.
+ */
+class SolveDaemon {
+public:
+    using VectorXd = Eigen::VectorXd;
+
+    explicit SolveDaemon(const SolveDaemonOptions& options = SolveDaemonOptions());
+    ~SolveDaemon();
+
+    SolveDaemon(const SolveDaemon&) = delete;
+    SolveDaemon& operator=(const SolveDaemon&) = delete;
+
+    /**
+     * @brief Bind the socket and start the worker threads
+     */
+    void start();
+
+    /**
+     * @brief Stop accepting, finish queued batches and join all threads
+     */
+    void stop();
+
+    /**
+     * @brief Block until a Shutdown message arrives or stop() is called
+     */
+    void wait();
+
+    bool running() const { return running_; }
+
+    /**
+     * @brief Text report of the latency and batch-size histograms
+     */
+    std::string statsReport() const;
+
+    std::uint64_t solvedRequests() const;
+    std::uint64_t solvedBatches() const;
+
+private:
+    struct Connection {
+        explicit Connection(int fd) : fd(fd) {}
+        ~Connection();
+        int fd;
+        std::mutex writeMutex;
+        std::atomic<bool> finished{false};
+    };
+
+    struct Pending {
+        std::shared_ptr<Connection> connection;
+        std::uint64_t requestId;
+        SolveProtocol::SolveRequestHeader spec;
+        std::vector<double> rho;
+        std::vector<double> boundaryValues;
+        std::chrono::steady_clock::time_point arrival;
+    };
+
+    void acceptLoop();
+    void readLoop(std::shared_ptr<Connection> connection);
+    void solveLoop();
+    void solveBatch(std::vector<Pending>& batch);
+    std::shared_ptr<FactorizationBundle> factorFor(std::uint64_t key, int nx, int ny, double dx, double dy, bool& hit);
+    std::shared_ptr<FactorizationBundle> residentFactor(std::uint64_t key);    // Caller holds factorsMutex_
+    bool admit(const SolveProtocol::SolveRequestHeader& spec, std::string& reason);
+    void requestShutdown();
+
+    SolveDaemonOptions options_;
+    ResourceEstimator estimator_;
+    int listenFd_ = -1;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> stopping_{false};
+    bool solverStop_ = false;
+
+    std::thread acceptThread_;
+    std::thread solveThread_;
+    std::mutex connectionsMutex_;
+    std::vector<std::thread> readers_;                     // readers_[i] serves connections_[i]
+    std::vector<std::shared_ptr<Connection>> connections_;
+
+    std::mutex queueMutex_;
+    std::condition_variable queueCv_;
+    std::deque<Pending> queue_;
+    bool shutdownRequested_ = false;
+
+    std::mutex factorsMutex_;
+    std::map<std::uint64_t, std::shared_ptr<FactorizationBundle>> factors_;
+    std::map<std::uint64_t, size_t> factorBytes_;         // Resident or admitted factors, for the memory budget
+
+    mutable std::mutex statsMutex_;
+    LatencyHistogram queueLatency_;
+    LatencyHistogram solveLatency_;
+    LatencyHistogram totalLatency_;
+    std::array<std::uint64_t, 8> batchSizes_{};    // 1, 2, 3-4, 5-8, ..., >64
+    std::uint64_t solvedRequests_ = 0;
+    std::uint64_t solvedBatches_ = 0;
+    std::uint64_t sharedMemoryCounter_ = 0;
+};
+
+/**
+ * @brief Timing returned with each daemon solve
+ */
+struct SolveTiming {
+    int batchSize = 0;
+    bool cacheHit = false;
+    double queueMicros = 0.0;
+    double solveMicros = 0.0;
+    double roundTripMicros = 0.0;
+};
+
+/**
+ * @class SolveClient
+ * @brief Blocking client for SolveDaemon (one connection, one request at a time)
+ */
+class SolveClient {
+public:
+    using VectorXd = Eigen::VectorXd;
+
+    explicit SolveClient(const std::string& socketPath);
+    ~SolveClient();
+
+    SolveClient(const SolveClient&) = delete;
+    SolveClient& operator=(const SolveClient&) = delete;
+
+    /**
+     * @brief Solve the reduced FDM problem on the daemon
+     *
+     * Arguments match ElectrostaticSolver::buildReducedFDMSystem.
+     *
+     * @return Full-grid potential (layout of buildFDMSystem), read from shared memory
+     */
+    VectorXd solve(
+        int nx, int ny,
+        double dx, double dy,
+        const std::vector<double>& rho,
+        double epsilon,
+        const std::vector<double>& boundaryValues,
+        SolveTiming* timing = nullptr
+    );
+
+    /**
+     * @brief Latency histograms of the daemon as text
+     */
+    std::string stats();
+
+    /**
+     * @brief Ask the daemon to stop (SolveDaemon::wait() returns)
+     */
+    void shutdown();
+
+private:
+    int fd_ = -1;
+    std::uint64_t nextId_ = 1;
+};
+
+#endif // SOLVE_DAEMON_H
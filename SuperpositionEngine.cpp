@@ -0,0 +1,155 @@
+#include "SuperpositionEngine.h"
+#include "Factorization.h"
+#include <Eigen/SVD>
+#include <algorithm>
+#include <stdexcept>
+
+SuperpositionEngine::SuperpositionEngine(
+    int nx, int ny,
+    double dx, double dy,
+    double epsilon,
+    const std::vector<Electrode>& electrodes,
+    Compression compression,
+    double rankTolerance)
+    : nx_(nx), ny_(ny), dx_(dx), dy_(dy), epsilon_(epsilon),
+      electrodes_(electrodes), compression_(compression) {
+
+    if (electrodes_.empty()) {
+        throw std::invalid_argument("Superposition engine needs at least one electrode");
+    }
+
+    int n = nx * ny;
+    int k = static_cast<int>(electrodes_.size());
+
+    // Electrodes must sit on the Dirichlet plates and must not overlap
+    std::vector<int> owner(n, -1);
+    for (int e = 0; e < k; ++e) {
+        for (int idx : electrodes_[e].indices) {
+            if (idx < 0 || idx >= n) {
+                throw std::out_of_range("Electrode index outside of the grid: " + electrodes_[e].name);
+            }
+            int i = idx % nx;
+            if (i != 0 && i != nx - 1) {
+                throw std::invalid_argument("Electrode point is not on a Dirichlet plate: " + electrodes_[e].name);
+            }
+            if (owner[idx] >= 0 && owner[idx] != e) {
+                throw std::invalid_argument("Electrodes overlap at grid index " + std::to_string(idx));
+            }
+            owner[idx] = e;
+        }
+    }
+
+    // ========== Basis Solutions (one assembly and factorization, k solves) ==========
+    ElectrostaticSolver solver;
+    std::vector<double> rho((nx - 2) * (ny - 2), 0.0);
+    std::vector<double> boundaryValues(n, 0.0);
+
+    MatrixSolver::SparseMatrix K;
+    VectorXd f;
+    solver.buildReducedFDMSystem(nx, ny, dx, dy, rho, epsilon, K, f, boundaryValues);
+    SparseCholeskyFactor factor = SparseCholeskyFactor::compute(K);
+
+    // Only the right-hand side depends on the electrode: unit potential on its points
+    std::vector<std::vector<double>> unitBoundaries(k, std::vector<double>(n, 0.0));
+    MatrixXd F(K.rows(), k);
+    for (int e = 0; e < k; ++e) {
+        for (int idx : electrodes_[e].indices) {
+            unitBoundaries[e][idx] = 1.0;
+        }
+        solver.buildReducedRightHandSide(nx, ny, dx, dy, rho.data(), epsilon,
+                                         unitBoundaries[e].data(), unitBoundaries[e].size(), F.col(e).data());
+    }
+    MatrixXd U = factor.solveBatch(F);
+
+    MatrixXd bases(n, k);
+    for (int e = 0; e < k; ++e) {
+        bases.col(e) = solver.expandReducedSolution(nx, ny, U.col(e), unitBoundaries[e]);
+    }
+
+    // ========== Storage Format ==========
+    switch (compression_) {
+        case Compression::None:
+            bases_ = std::move(bases);
+            break;
+        case Compression::Float32:
+            basesF_ = bases.cast<float>();
+            break;
+        case Compression::LowRank: {
+            Eigen::BDCSVD<MatrixXd> svd(bases, Eigen::ComputeThinU | Eigen::ComputeThinV);
+            const VectorXd& sigma = svd.singularValues();
+            int r = 0;
+            while (r < sigma.size() && sigma(r) > rankTolerance * sigma(0)) {
+                ++r;
+            }
+            r = std::max(r, 1);
+            lowRankU_ = svd.matrixU().leftCols(r) * sigma.head(r).asDiagonal();
+            lowRankW_ = svd.matrixV().leftCols(r);
+            break;
+        }
+    }
+}
+
+int SuperpositionEngine::rank() const {
+    switch (compression_) {
+        case Compression::None:
+            return static_cast<int>(bases_.cols());
+        case Compression::Float32:
+            return static_cast<int>(basesF_.cols());
+        case Compression::LowRank:
+            return static_cast<int>(lowRankU_.cols());
+    }
+    return 0;
+}
+
+size_t SuperpositionEngine::memoryBytes() const {
+    return sizeof(double) * (bases_.size() + lowRankU_.size() + lowRankW_.size()) +
+           sizeof(float) * basesF_.size();
+}
+
+void SuperpositionEngine::solveInto(const VectorXd& voltages, VectorXd& phi) const {
+    if (voltages.size() != electrodeCount()) {
+        throw std::invalid_argument("Voltage vector size mismatch with electrode count");
+    }
+
+    // Each query is one matrix-vector product: a single vectorized pass over the bases
+    switch (compression_) {
+        case Compression::None:
+            phi.noalias() = bases_ * voltages;
+            break;
+        case Compression::Float32:
+            phi = (basesF_ * voltages.cast<float>()).cast<double>();
+            break;
+        case Compression::LowRank: {
+            VectorXd coeffs = lowRankW_.transpose() * voltages;
+            phi.noalias() = lowRankU_ * coeffs;
+            break;
+        }
+    }
+}
+
+SuperpositionEngine::VectorXd SuperpositionEngine::solve(const VectorXd& voltages) const {
+    VectorXd phi(static_cast<Eigen::Index>(nx_) * ny_);
+    solveInto(voltages, phi);
+    return phi;
+}
+
+SuperpositionEngine::MatrixXd SuperpositionEngine::solveBatch(const MatrixXd& voltages) const {
+    if (voltages.rows() != electrodeCount()) {
+        throw std::invalid_argument("Voltage matrix rows mismatch with electrode count");
+    }
+
+    switch (compression_) {
+        case Compression::None:
+            return bases_ * voltages;
+        case Compression::Float32:
+            return (basesF_ * voltages.cast<float>()).cast<double>();
+        case Compression::LowRank:
+            return lowRankU_ * (lowRankW_.transpose() * voltages);
+    }
+    return MatrixXd();
+}
+
+FieldResult SuperpositionEngine::fieldResult(const VectorXd& voltages) const {
+    ElectrostaticSolver solver;
+    return solver.makeFieldResult(nx_, ny_, solve(voltages), dx_, dy_, epsilon_);
+}
@@ -0,0 +1,125 @@
+#ifndef SUPERPOSITION_ENGINE_H
+#define SUPERPOSITION_ENGINE_H
+
+#include "ElectrostaticSolver.h"
+#include "FieldResult.h"
+#include <Eigen/Dense>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Group of Dirichlet grid points driven by one voltage
+ *
+ * Indices are full-grid indices (coordToIndex) on the plate columns
+ * i = 0 or i = nx - 1, the Dirichlet boundary of the FDM system.
+ */
+struct Electrode {
+    std::string name;
+    std::vector<int> indices;
+};
+
+/**
+ * @class SuperpositionEngine
+ * @brief Instant potentials for arbitrary electrode voltages on a fixed geometry
+ *
+ * With fixed geometry and no free charge the potential is linear in the
+ * electrode voltages: φ(V) = Σₖ Vₖ φₖ, where φₖ is the solution with electrode k
+ * at 1 V and all other Dirichlet points grounded. The engine solves for all
+ * basis potentials once (one sparse LDLᵀ factorization, one solve per
+ * electrode) and then answers each voltage query with a single vectorized
+ * pass over the stored bases instead of a solve.
+ *
+ * Bases can optionally be compressed:
+ * - Float32: bases stored in single precision (half the memory traffic)
+ * - LowRank: truncated SVD of the basis matrix, φ = U (Wᵀ V) with rank r ≤ k
+ */
+class SuperpositionEngine {
+public:
+    using MatrixXd = Eigen::MatrixXd;
+    using VectorXd = Eigen::VectorXd;
+
+    enum class Compression {
+        None,
+        Float32,
+        LowRank
+    };
+
+    /**
+     * @brief Precompute the basis potential of every electrode
+     *
+     * @param nx Number of grid points in x-direction
+     * @param ny Number of grid points in y-direction
+     * @param dx Grid spacing in x-direction (m)
+     * @param dy Grid spacing in y-direction (m)
+     * @param epsilon Permittivity (F/m)
+     * @param electrodes Electrodes on the Dirichlet boundary
+     * @param compression Storage format of the bases
+     * @param rankTolerance LowRank only: drop singular values below rankTolerance * σ_max
+     */
+    SuperpositionEngine(
+        int nx, int ny,
+        double dx, double dy,
+        double epsilon,
+        const std::vector<Electrode>& electrodes,
+        Compression compression = Compression::None,
+        double rankTolerance = 1e-10
+    );
+
+    /**
+     * @brief Potential for a vector of electrode voltages
+     * @param voltages One voltage per electrode (V)
+     * @return Full-grid solution vector (layout of buildFDMSystem)
+     */
+    VectorXd solve(const VectorXd& voltages) const;
+
+    /**
+     * @brief Potential for a vector of electrode voltages, written into phi
+     *
+     * Reuses the storage of phi across queries.
+     */
+    void solveInto(const VectorXd& voltages, VectorXd& phi) const;
+
+    /**
+     * @brief Potentials for several voltage vectors at once
+     * @param voltages Voltage vectors as columns (electrodes x queries)
+     * @return Full-grid solutions as columns (nx*ny x queries)
+     */
+    MatrixXd solveBatch(const MatrixXd& voltages) const;
+
+    /**
+     * @brief Combined potential with lazily evaluated derived fields
+     */
+    FieldResult fieldResult(const VectorXd& voltages) const;
+
+    int nx() const { return nx_; }
+    int ny() const { return ny_; }
+    int electrodeCount() const { return static_cast<int>(electrodes_.size()); }
+    const std::vector<Electrode>& electrodes() const { return electrodes_; }
+    Compression compression() const { return compression_; }
+
+    /**
+     * @brief Number of stored basis vectors (k, or r for LowRank)
+     */
+    int rank() const;
+
+    /**
+     * @brief Bytes used by the stored bases
+     */
+    size_t memoryBytes() const;
+
+private:
+    int nx_;
+    int ny_;
+    double dx_;
+    double dy_;
+    double epsilon_;
+    std::vector<Electrode> electrodes_;
+    Compression compression_;
+
+    MatrixXd bases_;           // None: nx*ny x k
+    Eigen::MatrixXf basesF_;   // Float32: nx*ny x k
+    MatrixXd lowRankU_;        // LowRank: nx*ny x r, columns scaled by σ
+    MatrixXd lowRankW_;        // LowRank: k x r
+};
+
+#endif // SUPERPOSITION_ENGINE_H
@@ -0,0 +1,316 @@
+#include "TreePreconditioner.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <unordered_set>
+#include <utility>
+
+namespace {
+
+/// Edge of the network read from A; v == n is the virtual ground
+struct Edge {
+    int u;
+    int v;
+    double g;
+};
+
+int findRoot(std::vector<int>& parent, int x) {
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+/**
+ * @brief Conductances of A, heaviest first (ties by node pair for determinism)
+ */
+std::vector<Edge> networkEdges(const TreePreconditioner::SparseMatrix& A) {
+    if (A.rows() != A.cols()) {
+        throw std::invalid_argument("Matrix must be square for a tree preconditioner");
+    }
+    int n = static_cast<int>(A.rows());
+    std::vector<Edge> edges;
+    edges.reserve(static_cast<size_t>(A.nonZeros()) / 2 + static_cast<size_t>(n));
+    std::vector<double> rowSum(n, 0.0);
+    std::vector<double> diagonal(n, 0.0);
+    for (int k = 0; k < n; ++k) {
+        for (TreePreconditioner::SparseMatrix::InnerIterator it(A, k); it; ++it) {
+            int i = static_cast<int>(it.row());
+            rowSum[k] += it.value();
+            if (i == k) {
+                diagonal[k] = it.value();
+            } else if (it.value() > 0.0) {
+                throw std::invalid_argument("Positive off-diagonal entry: matrix is not a Laplacian");
+            } else if (i > k && it.value() < 0.0) {
+                edges.push_back({k, i, -it.value()});
+            }
+        }
+    }
+    for (int k = 0; k < n; ++k) {
+        double tolerance = 1e-12 * std::abs(diagonal[k]);
+        if (rowSum[k] < -tolerance) {
+            throw std::invalid_argument("Matrix is not diagonally dominant");
+        }
+        if (rowSum[k] > tolerance) {
+            edges.push_back({k, n, rowSum[k]});
+        }
+    }
+    std::sort(edges.begin(), edges.end(), [](const Edge& a, const Edge& b) {
+        if (a.g != b.g) {
+            return a.g > b.g;
+        }
+        return a.u != b.u ? a.u < b.u : a.v < b.v;
+    });
+    return edges;
+}
+
+} // namespace
+
+TreePreconditioner TreePreconditioner::compute(const SparseMatrix& A, int subtrees) {
+    std::vector<Edge> edges = networkEdges(A);
+    int n = static_cast<int>(A.rows());
+
+    // Maximum-conductance spanning tree (Kruskal)
+    std::vector<int> set(n + 1);
+    for (int k = 0; k <= n; ++k) {
+        set[k] = k;
+    }
+    std::vector<char> inTree(edges.size(), 0);
+    std::vector<int> degree(n + 2, 0);
+    for (size_t e = 0; e < edges.size(); ++e) {
+        int a = findRoot(set, edges[e].u);
+        int b = findRoot(set, edges[e].v);
+        if (a != b) {
+            set[a] = b;
+            inTree[e] = 1;
+            ++degree[edges[e].u + 1];
+            ++degree[edges[e].v + 1];
+        }
+    }
+    for (int k = 0; k <= n; ++k) {
+        degree[k + 1] += degree[k];
+    }
+    std::vector<int> adjacency(degree[n + 1]);
+    std::vector<int> adjacentEdge(degree[n + 1]);
+    std::vector<int> fill(degree.begin(), degree.end() - 1);
+    for (size_t e = 0; e < edges.size(); ++e) {
+        if (inTree[e]) {
+            adjacency[fill[edges[e].u]] = edges[e].v;
+            adjacentEdge[fill[edges[e].u]++] = static_cast<int>(e);
+            adjacency[fill[edges[e].v]] = edges[e].u;
+            adjacentEdge[fill[edges[e].v]++] = static_cast<int>(e);
+        }
+    }
+
+    // Root the tree at ground, parents before children
+    TreePreconditioner p;
+    p.n_ = n;
+    p.parent_.assign(n, -1);
+    p.weight_.assign(n, 0.0);
+    p.order_.reserve(n);
+    std::vector<char> seen(n + 1, 0);
+    std::vector<int> queue{n};
+    seen[n] = 1;
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int u = queue[head];
+        for (int k = degree[u]; k < degree[u + 1]; ++k) {
+            int v = adjacency[k];
+            if (!seen[v]) {
+                seen[v] = 1;
+                p.parent_[v] = u;
+                p.weight_[v] = edges[adjacentEdge[k]].g;
+                p.order_.push_back(v);
+                queue.push_back(v);
+            }
+        }
+    }
+    if (static_cast<int>(p.order_.size()) != n) {
+        throw std::invalid_argument("A block of the matrix has no conductance to ground (singular)");
+    }
+
+    // Eliminate leaves first: pivot_p -= w² / pivot_c, no fill
+    std::vector<double> pivot(n + 1, 0.0);
+    for (int c = 0; c < n; ++c) {
+        pivot[c] += p.weight_[c];
+        pivot[p.parent_[c]] += p.weight_[c];
+    }
+    p.ratio_.assign(n, 0.0);
+    p.invPivot_.assign(n, 0.0);
+    for (int k = n - 1; k >= 0; --k) {
+        int c = p.order_[k];
+        p.ratio_[c] = p.weight_[c] / pivot[c];
+        p.invPivot_[c] = 1.0 / pivot[c];
+        if (p.parent_[c] < n) {
+            pivot[p.parent_[c]] -= p.weight_[c] * p.ratio_[c];
+        }
+    }
+
+    if (subtrees <= 0 || n == 0) {
+        return p;
+    }
+
+    // Vaidya: cut subtrees of at least n / subtrees nodes, bottom-up
+    int target = std::max(1, (n + subtrees - 1) / subtrees);
+    std::vector<int> size(n, 1);
+    std::vector<char> cut(n, 0);
+    for (int k = n - 1; k >= 0; --k) {
+        int c = p.order_[k];
+        if (size[c] >= target) {
+            cut[c] = 1;
+        } else if (p.parent_[c] < n) {
+            size[p.parent_[c]] += size[c];
+        }
+    }
+    std::vector<int> piece(n + 1, 0);     // Piece 0 holds ground
+    int pieces = 1;
+    for (int c : p.order_) {
+        piece[c] = cut[c] ? pieces++ : piece[p.parent_[c]];
+    }
+
+    // Heaviest off-tree edge between each pair of pieces (edges are sorted)
+    std::unordered_set<std::uint64_t> joined;
+    std::vector<Eigen::Triplet<double>> triplets;
+    triplets.reserve(4 * static_cast<size_t>(n));
+    auto addEdge = [&](const Edge& edge) {
+        triplets.emplace_back(edge.u, edge.u, edge.g);
+        if (edge.v < n) {
+            triplets.emplace_back(edge.v, edge.v, edge.g);
+            triplets.emplace_back(edge.u, edge.v, -edge.g);
+            triplets.emplace_back(edge.v, edge.u, -edge.g);
+        }
+    };
+    for (size_t e = 0; e < edges.size(); ++e) {
+        if (inTree[e]) {
+            addEdge(edges[e]);
+            continue;
+        }
+        std::uint64_t a = static_cast<std::uint64_t>(piece[edges[e].u]);
+        std::uint64_t b = static_cast<std::uint64_t>(piece[edges[e].v]);
+        if (a != b && joined.insert((std::min(a, b) << 32) | std::max(a, b)).second) {
+            addEdge(edges[e]);
+            ++p.augmentedEdges_;
+        }
+    }
+    SparseMatrix H(n, n);
+    H.setFromTriplets(triplets.begin(), triplets.end());
+    p.factor_ = SparseCholeskyFactor::compute(H);
+    return p;
+}
+
+TreePreconditioner::VectorXd TreePreconditioner::apply(const VectorXd& r) const {
+    if (r.size() != n_) {
+        throw std::invalid_argument("Vector size mismatch with preconditioner");
+    }
+    if (!factor_.empty()) {
+        return factor_.solve(r);
+    }
+
+    // L D Lᵀ z = r with L(p, c) = -w_c / pivot_c
+    VectorXd z = r;
+    for (int k = n_ - 1; k >= 0; --k) {
+        int c = order_[k];
+        if (parent_[c] < n_) {
+            z(parent_[c]) += ratio_[c] * z(c);
+        }
+    }
+    for (int c : order_) {
+        z(c) *= invPivot_[c];
+        if (parent_[c] < n_) {
+            z(c) += ratio_[c] * z(parent_[c]);
+        }
+    }
+    return z;
+}
+
+double TreePreconditioner::stretch(const SparseMatrix& A) const {
+    if (A.rows() != n_) {
+        throw std::invalid_argument("Matrix size mismatch with preconditioner");
+    }
+    std::vector<Edge> edges = networkEdges(A);
+
+    // Tree resistance from ground to each node
+    std::vector<double> depth(n_ + 1, 0.0);
+    for (int c : order_) {
+        depth[c] = depth[parent_[c]] + 1.0 / weight_[c];
+    }
+
+    // Off-tree edges as LCA queries on both ends
+    double total = 0.0;
+    std::vector<int> queryStart(n_ + 2, 0);
+    std::vector<const Edge*> offTree;
+    for (const Edge& edge : edges) {
+        if (parent_[edge.u] == edge.v || (edge.v < n_ && parent_[edge.v] == edge.u)) {
+            continue;
+        }
+        if (edge.v == n_) {
+            total += edge.g * depth[edge.u];
+            continue;
+        }
+        offTree.push_back(&edge);
+        ++queryStart[edge.u + 1];
+        ++queryStart[edge.v + 1];
+    }
+    for (int k = 0; k <= n_; ++k) {
+        queryStart[k + 1] += queryStart[k];
+    }
+    std::vector<std::pair<int, double>> queries(queryStart[n_ + 1]);
+    std::vector<int> fill(queryStart.begin(), queryStart.end() - 1);
+    for (const Edge* edge : offTree) {
+        queries[fill[edge->u]++] = {edge->v, edge->g};
+        queries[fill[edge->v]++] = {edge->u, edge->g};
+    }
+
+    // Children lists, ground (n_) first
+    std::vector<int> childStart(n_ + 2, 0);
+    for (int c = 0; c < n_; ++c) {
+        ++childStart[parent_[c] + 1];
+    }
+    for (int k = 0; k <= n_; ++k) {
+        childStart[k + 1] += childStart[k];
+    }
+    std::vector<int> children(n_);
+    fill.assign(childStart.begin(), childStart.end() - 1);
+    for (int c : order_) {
+        children[fill[parent_[c]]++] = c;
+    }
+
+    // Tarjan's offline LCA with an explicit DFS stack
+    std::vector<int> set(n_ + 1);
+    std::vector<int> ancestor(n_ + 1);
+    std::vector<char> finished(n_ + 1, 0);
+    std::vector<std::pair<int, int>> stack{{n_, childStart[n_]}};
+    set[n_] = n_;
+    ancestor[n_] = n_;
+    while (!stack.empty()) {
+        int u = stack.back().first;
+        int next = stack.back().second;
+        if (next < childStart[u + 1]) {
+            ++stack.back().second;
+            int c = children[next];
+            set[c] = c;
+            ancestor[c] = c;
+            stack.push_back({c, childStart[c]});
+            continue;
+        }
+        finished[u] = 1;
+        if (u < n_) {
+            for (int k = queryStart[u]; k < queryStart[u + 1]; ++k) {
+                int v = queries[k].first;
+                if (finished[v]) {
+                    int lca = ancestor[findRoot(set, v)];
+                    total += queries[k].second * (depth[u] + depth[v] - 2.0 * depth[lca]);
+                }
+            }
+        }
+        stack.pop_back();
+        if (!stack.empty()) {
+            int p = stack.back().first;
+            int root = findRoot(set, p);
+            set[findRoot(set, u)] = root;
+            ancestor[root] = p;
+        }
+    }
+    return total;
+}
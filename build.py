@@ -40,6 +40,30 @@ def get_eigen_include():
     
     return None
 
+def get_python_module_config():
+    """Include paths and file suffix for the pybind11 extension module (None without pybind11)"""
+    try:
+        import pybind11
+    except ImportError:
+        return None
+    import sysconfig
+    return {
+        'includes': [pybind11.get_include(), sysconfig.get_paths()['include']],
+        'suffix': sysconfig.get_config_var('EXT_SUFFIX') or ('.pyd' if os.name == 'nt' else '.so'),
+        'libdir': str(Path(sys.base_prefix) / 'libs'),
+        'lib': f"python{sys.version_info.major}{sys.version_info.minor}"
+    }
+
+def get_shared_library_config():
+    """File naming for plain shared libraries (C API)"""
+    return {
+        'includes': [],
+        'prefix': '' if os.name == 'nt' else 'lib',
+        'suffix': '.dll' if os.name == 'nt' else '.so',
+        'libdir': None,
+        'lib': None
+    }
+
 def detect_available_compilers():
     """Detect which compilers are available on the system"""
     available = {}
@@ -81,7 +105,7 @@ def select_compiler(available_compilers):
     
     return None
 
-def build_with_msvc(target, source_files, eigen_include, project_dir):
+def build_with_msvc(target, source_files, eigen_include, project_dir, module=None):
     """Build using MSVC compiler"""
     vs_path = Path("C:/Program Files/Microsoft Visual Studio/18/Community")
     vcvars = vs_path / "VC" / "Auxiliary" / "Build" / "vcvars64.bat"
@@ -92,6 +116,12 @@ def build_with_msvc(target, source_files, eigen_include, project_dir):
     
     # Build command using cmd.exe to ensure vcvars is applied
     cmd = f'''cmd /c "call "{vcvars}" >nul 2>&1 && cd /d "{project_dir}" && cl /std:c++latest /EHsc /I"{eigen_include}" {source_list} /Fe:{exe_name}"'''
+    if module:
+        # DLL (Python extension .pyd: pythonXY.lib is linked via pyconfig.h)
+        exe_name = module.get('prefix', '') + target + module['suffix']
+        includes = " ".join(f'/I"{path}"' for path in module['includes'])
+        libdir = f' /link /LIBPATH:"{module["libdir"]}"' if module.get('libdir') else ''
+        cmd = f'''cmd /c "call "{vcvars}" >nul 2>&1 && cd /d "{project_dir}" && cl /std:c++latest /EHsc /O2 /LD /I"{eigen_include}" {includes} {source_list} /Fe:{exe_name}{libdir}"'''
     
     print(f"\n📦 Building: {exe_name}")
     print(f"   Sources: {', '.join(source_files)}\n")
@@ -109,13 +139,21 @@ def build_with_msvc(target, source_files, eigen_include, project_dir):
         print(f"\n❌ Build error: {e}")
         return False
 
-def build_with_gcc(target, source_files, eigen_include, project_dir):
+def build_with_gcc(target, source_files, eigen_include, project_dir, module=None):
     """Build using GCC/MinGW compiler"""
     source_list = " ".join(source_files)
     exe_name = target.replace('.cpp', '.exe')
     
     # GCC command
     cmd = f'g++ -std=c++17 -Wall -Wextra -I"{eigen_include}" {source_list} -o {exe_name}'
+    if module:
+        # Shared library (Python extension: <target><EXT_SUFFIX>)
+        exe_name = module.get('prefix', '') + target + module['suffix']
+        includes = " ".join(f'-I"{path}"' for path in module['includes'])
+        libdir, lib = module['libdir'], module['lib']
+        link = f' -L"{libdir}" -l{lib}' if lib and os.name == 'nt' else ''
+        cmd = (f'g++ -std=c++17 -O2 -Wall -Wextra -shared -fPIC -fvisibility=hidden -I"{eigen_include}" '
+               f'{includes} {source_list} -o {exe_name}{link}')
     
     print(f"\n📦 Building with GCC: {exe_name}")
     print(f"   Sources: {', '.join(source_files)}\n")
@@ -133,13 +171,21 @@ def build_with_gcc(target, source_files, eigen_include, project_dir):
         print(f"\n❌ Build error: {e}")
         return False
 
-def build_with_clang(target, source_files, eigen_include, project_dir):
+def build_with_clang(target, source_files, eigen_include, project_dir, module=None):
     """Build using Clang compiler"""
     source_list = " ".join(source_files)
     exe_name = target.replace('.cpp', '.exe')
     
     # Clang command
     cmd = f'clang++ -std=c++17 -Wall -Wextra -I"{eigen_include}" {source_list} -o {exe_name}'
+    if module:
+        # Shared library (Python extension: <target><EXT_SUFFIX>)
+        exe_name = module.get('prefix', '') + target + module['suffix']
+        includes = " ".join(f'-I"{path}"' for path in module['includes'])
+        libdir, lib = module['libdir'], module['lib']
+        link = f' -L"{libdir}" -l{lib}' if lib and os.name == 'nt' else ''
+        cmd = (f'clang++ -std=c++17 -O2 -Wall -Wextra -shared -fPIC -fvisibility=hidden -I"{eigen_include}" '
+               f'{includes} {source_list} -o {exe_name}{link}')
     
     print(f"\n📦 Building with Clang: {exe_name}")
     print(f"   Sources: {', '.join(source_files)}\n")
@@ -157,8 +203,29 @@ def build_with_clang(target, source_files, eigen_include, project_dir):
         print(f"\n❌ Build error: {e}")
         return False
 
-def build(compiler, target, source_files, eigen_include, project_dir):
-    """Build with selected compiler"""
+def compile_c_sources(compiler, c_sources, project_dir):
+    """Compile plain C sources (e.g. C API clients) as C objects; None on failure"""
+    objects = []
+    for source in c_sources:
+        stem = Path(source).stem
+        if compiler == 'msvc':
+            vcvars = Path("C:/Program Files/Microsoft Visual Studio/18/Community") / "VC" / "Auxiliary" / "Build" / "vcvars64.bat"
+            obj = stem + '.obj'
+            cmd = f'''cmd /c "call "{vcvars}" >nul 2>&1 && cd /d "{project_dir}" && cl /nologo /TC /std:c11 /c {source} /Fo:{obj}"'''
+        else:
+            cc = 'gcc' if compiler == 'gcc' else 'clang'
+            obj = stem + '.o'
+            cmd = f'{cc} -std=c99 -Wall -Wextra -pedantic -c {source} -o {obj}'
+        print(f"\n📦 Compiling C source: {source}")
+        result = subprocess.run(cmd, shell=True, cwd=project_dir, capture_output=False, text=True)
+        if result.returncode != 0:
+            print(f"\n❌ C compilation failed with error code {result.returncode}")
+            return None
+        objects.append(obj)
+    return objects
+
+def build(compiler, target, source_files, eigen_include, project_dir, module=None, c_sources=None):
+    """Build with selected compiler (c_sources are compiled as C and linked in)"""
     builders = {
         'msvc': build_with_msvc,
         'gcc': build_with_gcc,
@@ -170,7 +237,13 @@ def build(compiler, target, source_files, eigen_include, project_dir):
         print(f"❌ Unknown compiler: {compiler}")
         return False
     
-    return builder(target, source_files, eigen_include, project_dir)
+    if c_sources:
+        objects = compile_c_sources(compiler, c_sources, project_dir)
+        if objects is None:
+            return False
+        source_files = objects + source_files
+    
+    return builder(target, source_files, eigen_include, project_dir, module)
 
 def run_executable(exe_name, project_dir):
     """Run the compiled executable"""
@@ -184,8 +257,11 @@ def run_executable(exe_name, project_dir):
     print(f"Running: {exe_name}")
     print(f"{'='*60}\n")
     
+    # Python modules are exercised by a test script
+    command = [sys.executable, str(exe_path)] if exe_path.suffix == '.py' else [str(exe_path)]
+    
     try:
-        subprocess.run([str(exe_path)], cwd=project_dir, check=True)
+        subprocess.run(command, cwd=project_dir, check=True)
         return True
     except subprocess.CalledProcessError:
         print(f"\n❌ Execution failed!")
@@ -219,12 +295,183 @@ def main():
     
     targets = {
         'test_matrix_solver': {
+            'description': 'Basic matrix operations test',
             'exe': 'test_matrix_solver.exe',
             'sources': ['test_matrix_solver.cpp', 'MatrixSolver.cpp']
         },
         'test_electrostatic': {
+            'description': 'FDM electrostatic solver test',
             'exe': 'test_electrostatic.exe',
-            'sources': ['test_electrostatic.cpp', 'ElectrostaticSolver.cpp', 'MatrixSolver.cpp']
+            'sources': ['test_electrostatic.cpp', 'ParameterSweep.cpp', 'ElectrostaticSolver.cpp',
+                        'FieldResult.cpp', 'MatrixSolver.cpp', 'Factorization.cpp', 'JobScheduler.cpp',
+                        'FrameStream.cpp']
+        },
+        'test_factorization_cache': {
+            'description': 'Cold vs warm start with the factorization cache',
+            'exe': 'test_factorization_cache.exe',
+            'sources': ['test_factorization_cache.cpp', 'ElectrostaticSolver.cpp', 'FieldResult.cpp',
+                        'MatrixSolver.cpp', 'Factorization.cpp', 'FactorizationCache.cpp']
+        },
+        'test_nonlinear_poisson': {
+            'description': 'Newton-Krylov Poisson-Boltzmann vs Gouy-Chapman',
+            'exe': 'test_nonlinear_poisson.exe',
+            'sources': ['test_nonlinear_poisson.cpp', 'NonlinearPoissonSolver.cpp',
+                        'ElectrostaticSolver.cpp', 'FieldResult.cpp', 'MatrixSolver.cpp',
+                        'Factorization.cpp']
+        },
+        'test_superposition': {
+            'description': 'Electrode voltage sweep via basis superposition',
+            'exe': 'test_superposition.exe',
+            'sources': ['test_superposition.cpp', 'SuperpositionEngine.cpp',
+                        'ElectrostaticSolver.cpp', 'FieldResult.cpp', 'MatrixSolver.cpp',
+                        'Factorization.cpp']
+        },
+        'test_local_resolve': {
+            'description': 'Local subdomain + multigrid far-field updates',
+            'exe': 'test_local_resolve.exe',
+            'sources': ['test_local_resolve.cpp', 'LocalResolver.cpp', 'Multigrid.cpp',
+                        'Factorization.cpp', 'FactorizationCache.cpp', 'ElectrostaticSolver.cpp',
+                        'MatrixSolver.cpp', 'FieldResult.cpp']
+        },
+        'test_solve_daemon': {
+            'description': 'Batched multi-client solves over a Unix socket',
+            'exe': 'test_solve_daemon.exe',
+            'sources': ['test_solve_daemon.cpp', 'SolveDaemon.cpp', 'ElectrostaticSolver.cpp',
+                        'FieldResult.cpp', 'MatrixSolver.cpp', 'Factorization.cpp',
+                        'FactorizationCache.cpp', 'ResourceEstimator.cpp', 'JobScheduler.cpp',
+                        'Multigrid.cpp']
+        },
+        'solve_daemon': {
+            'description': 'Long-lived solve daemon (prints usage without arguments)',
+            'exe': 'solve_daemon.exe',
+            'sources': ['solve_daemon.cpp', 'SolveDaemon.cpp', 'ElectrostaticSolver.cpp',
+                        'FieldResult.cpp', 'MatrixSolver.cpp', 'Factorization.cpp',
+                        'FactorizationCache.cpp', 'ResourceEstimator.cpp', 'JobScheduler.cpp',
+                        'Multigrid.cpp']
+        },
+        'test_parameter_sweep': {
+            'description': 'Interrupted and resumed parallel sweep',
+            'exe': 'test_parameter_sweep.exe',
+            'sources': ['test_parameter_sweep.cpp', 'ParameterSweep.cpp', 'ElectrostaticSolver.cpp',
+                        'FieldResult.cpp', 'MatrixSolver.cpp', 'Factorization.cpp', 'JobScheduler.cpp',
+                        'FrameStream.cpp']
+        },
+        'test_job_scheduler': {
+            'description': 'Cost model, LPT plan and threaded solve path',
+            'exe': 'test_job_scheduler.exe',
+            'sources': ['test_job_scheduler.cpp', 'JobScheduler.cpp', 'ElectrostaticSolver.cpp',
+                        'FieldResult.cpp', 'MatrixSolver.cpp', 'Factorization.cpp']
+        },
+        'electrostatics': {
+            'description': 'Python module (pybind11) + test_python_bindings.py',
+            'exe': 'test_python_bindings.py',
+            'module': True,
+            'sources': ['python_bindings.cpp', 'ElectrostaticSolver.cpp', 'FieldResult.cpp',
+                        'MatrixSolver.cpp', 'Factorization.cpp', 'ResistiveNetwork.cpp',
+                        'TreePreconditioner.cpp', 'EffectiveResistance.cpp', 'Graph.cpp',
+                        'ShortestPaths.cpp', 'Clustering.cpp',
+                        'LaplacianSpectrum.cpp', 'Reordering.cpp']
+        },
+        'electrostatics_c': {
+            'description': 'Shared library with the C API (electrostatics_c.h)',
+            'exe': 'electrostatics_c.exe',
+            'shared': True,
+            'sources': ['electrostatics_c.cpp', 'ElectrostaticSolver.cpp', 'FieldResult.cpp',
+                        'MatrixSolver.cpp', 'Factorization.cpp', 'FactorizationCache.cpp']
+        },
+        'test_c_api': {
+            'description': 'C API: handles, caller buffers, threads',
+            'exe': 'test_c_api.exe',
+            'c_sources': ['test_c_api.c'],
+            'sources': ['electrostatics_c.cpp', 'ElectrostaticSolver.cpp',
+                        'FieldResult.cpp', 'MatrixSolver.cpp', 'Factorization.cpp',
+                        'FactorizationCache.cpp']
+        },
+        'test_frame_publisher': {
+            'description': 'Shared-memory frame ring with concurrent reader',
+            'exe': 'test_frame_publisher.exe',
+            'sources': ['test_frame_publisher.cpp', 'FrameStream.cpp', 'ElectrostaticSolver.cpp',
+                        'FieldResult.cpp', 'MatrixSolver.cpp', 'Factorization.cpp']
+        },
+        'test_reduction': {
+            'description': 'Thread-count independent sums, norms and integrals',
+            'exe': 'test_reduction.exe',
+            'sources': ['test_reduction.cpp', 'ElectrostaticSolver.cpp', 'FieldResult.cpp',
+                        'MatrixSolver.cpp', 'Factorization.cpp']
+        },
+        'test_resource_estimator': {
+            'description': 'Memory/time prediction and admission control',
+            'exe': 'test_resource_estimator.exe',
+            'sources': ['test_resource_estimator.cpp', 'ResourceEstimator.cpp', 'JobScheduler.cpp',
+                        'Multigrid.cpp', 'ElectrostaticSolver.cpp', 'FieldResult.cpp',
+                        'MatrixSolver.cpp', 'Factorization.cpp', 'FactorizationCache.cpp']
+        },
+        'test_deadline_solve': {
+            'description': 'Deadline-bounded and cancellable solves, background refinement',
+            'exe': 'test_deadline_solve.exe',
+            'sources': ['test_deadline_solve.cpp', 'BackgroundSolve.cpp', 'Multigrid.cpp',
+                        'ElectrostaticSolver.cpp', 'FieldResult.cpp', 'MatrixSolver.cpp',
+                        'Factorization.cpp', 'FactorizationCache.cpp']
+        },
+        'test_out_of_core': {
+            'description': 'Out-of-core CG with memory-mapped row tiles',
+            'exe': 'test_out_of_core.exe',
+            'sources': ['test_out_of_core.cpp', 'OutOfCore.cpp', 'ElectrostaticSolver.cpp',
+                        'FieldResult.cpp', 'MatrixSolver.cpp', 'Factorization.cpp']
+        },
+        'test_resistive_network': {
+            'description': 'Sparse nodal analysis of resistor networks',
+            'exe': 'test_resistive_network.exe',
+            'sources': ['test_resistive_network.cpp', 'ResistiveNetwork.cpp', 'TreePreconditioner.cpp',
+                        'MatrixSolver.cpp', 'Factorization.cpp']
+        },
+        'test_incremental_network': {
+            'description': 'Rank-one updates of a solved resistor network',
+            'exe': 'test_incremental_network.exe',
+            'sources': ['test_incremental_network.cpp', 'ResistiveNetwork.cpp', 'TreePreconditioner.cpp',
+                        'MatrixSolver.cpp', 'Factorization.cpp']
+        },
+        'test_effective_resistance': {
+            'description': 'Exact and sketched effective resistance queries',
+            'exe': 'test_effective_resistance.exe',
+            'sources': ['test_effective_resistance.cpp', 'EffectiveResistance.cpp',
+                        'ResistiveNetwork.cpp', 'TreePreconditioner.cpp', 'MatrixSolver.cpp',
+                        'Factorization.cpp']
+        },
+        'test_tree_preconditioner': {
+            'description': 'Spanning-tree preconditioners for network CG',
+            'exe': 'test_tree_preconditioner.exe',
+            'sources': ['test_tree_preconditioner.cpp', 'TreePreconditioner.cpp',
+                        'ResistiveNetwork.cpp', 'MatrixSolver.cpp', 'Factorization.cpp']
+        },
+        'test_graph': {
+            'description': 'CSR graph core and parallel Watts-Strogatz generator',
+            'exe': 'test_graph.exe',
+            'sources': ['test_graph.cpp', 'Graph.cpp']
+        },
+        'test_shortest_paths': {
+            'description': 'Bit-parallel BFS path-length statistics',
+            'exe': 'test_shortest_paths.exe',
+            'sources': ['test_shortest_paths.cpp', 'ShortestPaths.cpp', 'Graph.cpp']
+        },
+        'test_clustering': {
+            'description': 'Triangle counting and clustering coefficients',
+            'exe': 'test_clustering.exe',
+            'sources': ['test_clustering.cpp', 'Clustering.cpp', 'Graph.cpp']
+        },
+        'test_laplacian_spectrum': {
+            'description': 'Lanczos Fiedler vector and low Laplacian spectrum',
+            'exe': 'test_laplacian_spectrum.exe',
+            'sources': ['test_laplacian_spectrum.cpp', 'LaplacianSpectrum.cpp', 'Graph.cpp',
+                        'ResistiveNetwork.cpp', 'MatrixSolver.cpp', 'Factorization.cpp',
+                        'TreePreconditioner.cpp']
+        },
+        'test_reordering': {
+            'description': 'RCM, minimum degree and nested dissection orderings',
+            'exe': 'test_reordering.exe',
+            'sources': ['test_reordering.cpp', 'Reordering.cpp', 'Graph.cpp',
+                        'ElectrostaticSolver.cpp', 'FieldResult.cpp', 'MatrixSolver.cpp',
+                        'Factorization.cpp', 'ResistiveNetwork.cpp', 'TreePreconditioner.cpp']
         }
     }
     
@@ -240,29 +487,28 @@ def main():
         print("  run [target]    - Run only (no rebuild)")
         print("  all [target]    - Build and run (default)")
         print("\nTargets:")
-        print("  test_matrix_solver   - Matrix solver test")
-        print("  test_electrostatic   - Electrostatic solver test")
-        print("  all                  - Build/run both (default)")
+        for name, info in targets.items():
+            print(f"  {name} - {info['description']}")
+        print("  all - Build/run all (default)")
         print()
         
+        # Numbered menu over the same targets, in the same order
+        choice_map = {str(i): name for i, name in enumerate(targets, 1)}
+        choice_map[str(len(targets) + 1)] = 'all'
+        
         print("Available targets:")
-        print("  1. test_matrix_solver   - Basic matrix operations test")
-        print("  2. test_electrostatic   - FDM electrostatic solver test")
-        print("  3. all                  - Build both")
+        for number, name in choice_map.items():
+            description = targets[name]['description'] if name in targets else 'Build all'
+            print(f"  {number}. {name} - {description}")
         print()
         
         choice = input("Select target to build (default: all): ").strip().lower() or "all"
         
-        # Map numeric choices to target names
-        choice_map = {
-            '1': 'test_matrix_solver',
-            '2': 'test_electrostatic',
-            '3': 'all'
-        }
-        
         target = choice_map.get(choice, choice)
         command = 'all'
     
+    python_module = get_python_module_config()
+    
     # Validate target
     if target == 'all':
         build_list = list(targets.keys())
@@ -278,7 +524,14 @@ def main():
         for target_name in build_list:
             target_info = targets[target_name]
             print(f"\nTarget: {target_name}")
-            if not build(compiler, target_name, target_info['sources'], eigen_include, project_dir):
+            if target_info.get('module') and not python_module:
+                print("⚠ pybind11 not installed (pip install pybind11), skipping")
+                continue
+            module = python_module if target_info.get('module') else None
+            if target_info.get('shared'):
+                module = get_shared_library_config()
+            if not build(compiler, target_name, target_info['sources'], eigen_include, project_dir, module,
+                         target_info.get('c_sources')):
                 return 1
         print(f"\n✓ Build completed!")
         return 0
@@ -287,6 +540,8 @@ def main():
         # Run only
         for target_name in build_list:
             target_info = targets[target_name]
+            if target_info.get('shared'):
+                continue
             print(f"\nTarget: {target_name}")
             if not run_executable(target_info['exe'], project_dir):
                 return 1
@@ -302,11 +557,21 @@ def main():
             print(f"Target: {target_name}")
             print(f"{'='*60}")
             
+            if target_info.get('module') and not python_module:
+                print("⚠ pybind11 not installed (pip install pybind11), skipping")
+                continue
+            
             # Build
-            if not build(compiler, target_name, target_info['sources'], eigen_include, project_dir):
+            module = python_module if target_info.get('module') else None
+            if target_info.get('shared'):
+                module = get_shared_library_config()
+            if not build(compiler, target_name, target_info['sources'], eigen_include, project_dir, module,
+                         target_info.get('c_sources')):
                 return 1
             
-            # Run
+            # Run (libraries have nothing to run)
+            if target_info.get('shared'):
+                continue
             if not run_executable(target_info['exe'], project_dir):
                 return 1
         
@@ -0,0 +1,360 @@
+#define ELECTROSTATICS_C_BUILD
+#include "electrostatics_c.h"
+#include "ElectrostaticSolver.h"
+#include "Factorization.h"
+#include "FactorizationCache.h"
+#include "FieldResult.h"
+#include <exception>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// ========== Handles ==========
+
+struct es_factorization {
+    es_grid grid;
+    std::shared_ptr<const SparseCholeskyFactor> factor;
+};
+
+struct es_solver {
+    es_grid grid;
+    double epsilon;
+    std::vector<double> boundaryValues;     // nx*ny
+    std::vector<double> work;               // Reduced right-hand side / solution
+    std::shared_ptr<const SparseCholeskyFactor> factor;
+    ElectrostaticSolver solver;
+};
+
+struct es_field {
+    es_grid grid;
+    FieldResult result;
+};
+
+namespace {
+
+using RowMajorMatrix = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+thread_local std::string lastError;
+
+/**
+ * Failure with a specific status code (everything else maps by exception type)
+ */
+struct StatusError : std::runtime_error {
+    StatusError(es_status status, const std::string& message)
+        : std::runtime_error(message), status(status) {}
+    es_status status;
+};
+
+/**
+ * Run body() and translate every exception into a status code
+ */
+template <typename Body>
+es_status guarded(Body body) {
+    try {
+        body();
+        return ES_OK;
+    } catch (const StatusError& e) {
+        lastError = e.what();
+        return e.status;
+    } catch (const std::bad_alloc&) {
+        lastError = "Out of memory";
+        return ES_ERROR_OUT_OF_MEMORY;
+    } catch (const std::invalid_argument& e) {
+        lastError = e.what();
+        return ES_ERROR_INVALID_ARGUMENT;
+    } catch (const std::exception& e) {
+        lastError = e.what();
+        return ES_ERROR_INTERNAL;
+    } catch (...) {
+        lastError = "Unknown error";
+        return ES_ERROR_INTERNAL;
+    }
+}
+
+void require(bool condition, const char* message) {
+    if (!condition) {
+        throw StatusError(ES_ERROR_INVALID_ARGUMENT, message);
+    }
+}
+
+void requireBuffer(size_t count, size_t needed, const char* what) {
+    if (count < needed) {
+        throw StatusError(ES_ERROR_BUFFER_TOO_SMALL,
+                          std::string(what) + ": buffer holds " + std::to_string(count) +
+                          " values, " + std::to_string(needed) + " required");
+    }
+}
+
+void checkGrid(const es_grid* grid) {
+    require(grid != nullptr, "Grid is null");
+    require(grid->nx >= 3 && grid->ny >= 3, "Grid must have at least one interior point");
+    require(grid->dx > 0.0 && grid->dy > 0.0, "Grid spacing must be positive");
+}
+
+bool sameGrid(const es_grid& a, const es_grid& b) {
+    return a.nx == b.nx && a.ny == b.ny && a.dx == b.dx && a.dy == b.dy;
+}
+
+size_t interiorSize(const es_grid& grid) {
+    return static_cast<size_t>(grid.nx - 2) * (grid.ny - 2);
+}
+
+size_t gridSize(const es_grid& grid) {
+    return static_cast<size_t>(grid.nx) * grid.ny;
+}
+
+std::shared_ptr<const SparseCholeskyFactor> factorize(const es_grid& grid) {
+    // The operator does not depend on rho, ε or boundary values
+    ElectrostaticSolver solver;
+    std::vector<double> rho(interiorSize(grid), 0.0);
+    std::vector<double> boundaryValues;
+    MatrixSolver::SparseMatrix K;
+    Eigen::VectorXd f;
+    solver.buildReducedFDMSystem(grid.nx, grid.ny, grid.dx, grid.dy, rho, 1.0, K, f, boundaryValues);
+    try {
+        return std::make_shared<SparseCholeskyFactor>(SparseCholeskyFactor::compute(K));
+    } catch (const std::runtime_error& e) {
+        throw StatusError(ES_ERROR_NUMERICAL, e.what());
+    }
+}
+
+FieldResult::Component toComponent(es_component component) {
+    switch (component) {
+        case ES_FIELD_X: return FieldResult::Component::Ex;
+        case ES_FIELD_Y: return FieldResult::Component::Ey;
+        case ES_FIELD_MAGNITUDE: return FieldResult::Component::Magnitude;
+        case ES_ENERGY_DENSITY: return FieldResult::Component::EnergyDensity;
+        default: throw StatusError(ES_ERROR_INVALID_ARGUMENT, "Unknown field component");
+    }
+}
+
+/**
+ * Interior solve of a solver into its work buffer
+ */
+void solveInterior(es_solver* s, const double* rho, size_t rhoCount) {
+    const es_grid& g = s->grid;
+    require(rho == nullptr || rhoCount >= interiorSize(g), "Charge density needs (nx-2)*(ny-2) values");
+    if (!s->factor) {
+        s->factor = factorize(g);
+    }
+    s->work.resize(interiorSize(g));
+    s->solver.buildReducedRightHandSide(g.nx, g.ny, g.dx, g.dy, rho, s->epsilon,
+                                        s->boundaryValues.data(), s->boundaryValues.size(), s->work.data());
+    s->factor->solve(s->work.data(), s->work.data());
+}
+
+} // namespace
+
+// ========== Library ==========
+
+int es_abi_version(void) {
+    return ES_ABI_VERSION;
+}
+
+const char* es_status_string(es_status status) {
+    switch (status) {
+        case ES_OK: return "ok";
+        case ES_ERROR_INVALID_ARGUMENT: return "invalid argument";
+        case ES_ERROR_BUFFER_TOO_SMALL: return "buffer too small";
+        case ES_ERROR_NUMERICAL: return "numerical failure";
+        case ES_ERROR_OUT_OF_MEMORY: return "out of memory";
+        case ES_ERROR_IO: return "I/O error";
+        case ES_ERROR_INTERNAL: return "internal error";
+    }
+    return "unknown status";
+}
+
+const char* es_last_error(void) {
+    return lastError.c_str();
+}
+
+// ========== Factorization ==========
+
+es_status es_factorization_create(const es_grid* grid, es_factorization** out) {
+    return guarded([&] {
+        require(out != nullptr, "Output handle pointer is null");
+        *out = nullptr;
+        checkGrid(grid);
+        auto handle = std::make_unique<es_factorization>();
+        handle->grid = *grid;
+        handle->factor = factorize(*grid);
+        *out = handle.release();
+    });
+}
+
+es_status es_factorization_create_cached(const es_grid* grid, const char* cache_directory,
+                                         es_factorization** out) {
+    return guarded([&] {
+        require(out != nullptr, "Output handle pointer is null");
+        *out = nullptr;
+        checkGrid(grid);
+        require(cache_directory != nullptr, "Cache directory is null");
+
+        ElectrostaticSolver solver;
+        std::uint64_t key = solver.geometryHash(grid->nx, grid->ny, grid->dx, grid->dy);
+        FactorizationCache cache(cache_directory);
+        auto handle = std::make_unique<es_factorization>();
+        handle->grid = *grid;
+
+        // Same bundle layout as the solve daemon, so both share cache files
+        FactorizationBundle bundle;
+        if (cache.load(key, bundle) && bundle.sparseCholesky("reduced/ldlt")) {
+            handle->factor = std::make_shared<SparseCholeskyFactor>(*bundle.sparseCholesky("reduced/ldlt"));
+        } else {
+            handle->factor = factorize(*grid);
+            FactorizationBundle additions;
+            additions.add("reduced/ldlt", *handle->factor);
+            try {
+                cache.update(key, additions);   // Keeps entries stored by other users of the key
+            } catch (const std::exception& e) {
+                throw StatusError(ES_ERROR_IO, e.what());
+            }
+        }
+        *out = handle.release();
+    });
+}
+
+void es_factorization_destroy(es_factorization* factorization) {
+    delete factorization;
+}
+
+es_status es_factorization_size(const es_factorization* factorization, size_t* size) {
+    return guarded([&] {
+        require(factorization != nullptr && size != nullptr, "Null argument");
+        *size = static_cast<size_t>(factorization->factor->size());
+    });
+}
+
+es_status es_factorization_solve(const es_factorization* factorization,
+                                 const double* f, double* u, size_t count) {
+    return guarded([&] {
+        require(factorization != nullptr && f != nullptr && u != nullptr, "Null argument");
+        requireBuffer(count, static_cast<size_t>(factorization->factor->size()), "Right-hand side");
+        factorization->factor->solve(f, u);
+    });
+}
+
+// ========== Solver ==========
+
+es_status es_solver_create(const es_grid* grid, double epsilon, es_solver** out) {
+    return guarded([&] {
+        require(out != nullptr, "Output handle pointer is null");
+        *out = nullptr;
+        checkGrid(grid);
+        require(epsilon > 0.0, "Permittivity must be positive");
+        auto handle = std::make_unique<es_solver>();
+        handle->grid = *grid;
+        handle->epsilon = epsilon;
+        handle->boundaryValues.assign(gridSize(*grid), 0.0);
+        *out = handle.release();
+    });
+}
+
+void es_solver_destroy(es_solver* solver) {
+    delete solver;
+}
+
+es_status es_solver_set_factorization(es_solver* solver, const es_factorization* factorization) {
+    return guarded([&] {
+        require(solver != nullptr && factorization != nullptr, "Null argument");
+        require(sameGrid(solver->grid, factorization->grid), "Factorization belongs to a different grid");
+        solver->factor = factorization->factor;
+    });
+}
+
+es_status es_solver_set_boundary(es_solver* solver, const double* values, size_t count) {
+    return guarded([&] {
+        require(solver != nullptr && values != nullptr, "Null argument");
+        requireBuffer(count, gridSize(solver->grid), "Boundary values");
+        solver->boundaryValues.assign(values, values + gridSize(solver->grid));
+    });
+}
+
+es_status es_solver_set_plates(es_solver* solver, double left, double right) {
+    return guarded([&] {
+        require(solver != nullptr, "Solver is null");
+        const es_grid& g = solver->grid;
+        for (int j = 0; j < g.ny; ++j) {
+            solver->boundaryValues[solver->solver.coordToIndex(0, j, g.nx)] = left;
+            solver->boundaryValues[solver->solver.coordToIndex(g.nx - 1, j, g.nx)] = right;
+        }
+    });
+}
+
+es_status es_solver_solve(es_solver* solver, const double* rho, size_t rho_count,
+                          double* phi, size_t phi_count) {
+    return guarded([&] {
+        require(solver != nullptr && phi != nullptr, "Null argument");
+        const es_grid& g = solver->grid;
+        requireBuffer(phi_count, gridSize(g), "Potential");
+        solveInterior(solver, rho, rho_count);
+        solver->solver.expandReducedSolution(g.nx, g.ny, solver->work.data(), solver->boundaryValues.data(),
+                                             solver->boundaryValues.size(), phi);
+    });
+}
+
+es_status es_solver_solve_field(es_solver* solver, const double* rho, size_t rho_count, es_field** out) {
+    return guarded([&] {
+        require(solver != nullptr && out != nullptr, "Null argument");
+        *out = nullptr;
+        const es_grid& g = solver->grid;
+        solveInterior(solver, rho, rho_count);
+
+        // FieldResult holds φ as an (ny x nx) matrix; the grid layout is x fastest
+        std::vector<double> full(gridSize(g));
+        solver->solver.expandReducedSolution(g.nx, g.ny, solver->work.data(), solver->boundaryValues.data(),
+                                             solver->boundaryValues.size(), full.data());
+        Eigen::Map<const RowMajorMatrix> view(full.data(), g.ny, g.nx);
+        *out = new es_field{g, FieldResult(Eigen::MatrixXd(view), g.dx, g.dy, solver->epsilon)};
+    });
+}
+
+// ========== Fields ==========
+
+es_status es_field_create(const es_grid* grid, double epsilon, const double* phi, size_t count, es_field** out) {
+    return guarded([&] {
+        require(out != nullptr && phi != nullptr, "Null argument");
+        *out = nullptr;
+        checkGrid(grid);
+        require(epsilon > 0.0, "Permittivity must be positive");
+        requireBuffer(count, gridSize(*grid), "Potential");
+        Eigen::Map<const RowMajorMatrix> view(phi, grid->ny, grid->nx);
+        *out = new es_field{*grid, FieldResult(Eigen::MatrixXd(view), grid->dx, grid->dy, epsilon)};
+    });
+}
+
+void es_field_destroy(es_field* field) {
+    delete field;
+}
+
+es_status es_field_grid(const es_field* field, es_grid* grid) {
+    return guarded([&] {
+        require(field != nullptr && grid != nullptr, "Null argument");
+        *grid = field->grid;
+    });
+}
+
+es_status es_field_get(es_field* field, es_component component, double* out, size_t count) {
+    return guarded([&] {
+        require(field != nullptr && out != nullptr, "Null argument");
+        const es_grid& g = field->grid;
+        requireBuffer(count, gridSize(g), "Field");
+        const Eigen::MatrixXd& values = component == ES_POTENTIAL ? field->result.potential()
+                                                                  : field->result.field(toComponent(component));
+
+        // (ny x nx) matrix to the x-fastest grid layout
+        Eigen::Map<RowMajorMatrix>(out, g.ny, g.nx) = values;
+    });
+}
+
+es_status es_field_at(es_field* field, es_component component, int i, int j, double* value) {
+    return guarded([&] {
+        require(field != nullptr && value != nullptr, "Null argument");
+        const es_grid& g = field->grid;
+        require(i >= 0 && i < g.nx && j >= 0 && j < g.ny, "Grid point out of range");
+        *value = component == ES_POTENTIAL ? field->result.potential()(j, i)
+                                           : field->result.at(toComponent(component), i, j);
+    });
+}
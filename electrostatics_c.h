@@ -0,0 +1,173 @@
+#ifndef ELECTROSTATICS_C_H
+#define ELECTROSTATICS_C_H
+
+/**
+ * @file electrostatics_c.h
+ * @brief C API of the electrostatic solver (shared library `electrostatics_c`)
+ *
+ * Plain C99, no Eigen or C++ types. Objects are opaque handles created and
+ * destroyed through this API; all arrays are caller-provided buffers of
+ * doubles, so data is read from and written to the caller's memory directly.
+ * No C++ exception crosses the boundary: every fallible call returns an
+ * es_status and leaves a message for es_last_error().
+ *
+ * Grid layout: a full grid vector has nx*ny values with x fastest,
+ * index = i + j*nx. Charge densities cover the interior points only,
+ * (nx-2)*(ny-2) values, index = (i-1) + (j-1)*(nx-2). Boundaries follow
+ * ElectrostaticSolver: Dirichlet values on the left/right columns, Neumann
+ * (zero normal field) on the top/bottom rows.
+ *
+ * Thread safety:
+ * - Functions never share hidden state between handles; calls on distinct
+ *   handles may run concurrently from any threads.
+ * - es_factorization is immutable after creation. Any number of threads and
+ *   solvers may use one factorization at the same time.
+ * - es_solver and es_field are not synchronized: use each handle from one
+ *   thread at a time (es_field fills caches on first access).
+ * - es_last_error() is per thread.
+ *
+ * Ownership: a solver keeps its own reference to a factorization, so the
+ * factorization handle may be destroyed while solvers still use it. Fields
+ * are independent of the solver that produced them.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#  if defined(ELECTROSTATICS_C_BUILD)
+#    define ES_API __declspec(dllexport)
+#  else
+#    define ES_API __declspec(dllimport)
+#  endif
+#else
+#  define ES_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Incremented on every incompatible change of this header */
+#define ES_ABI_VERSION 1
+
+typedef enum es_status {
+    ES_OK = 0,
+    ES_ERROR_INVALID_ARGUMENT = 1,   /**< Null handle/pointer, bad size or geometry */
+    ES_ERROR_BUFFER_TOO_SMALL = 2,   /**< Caller buffer shorter than required */
+    ES_ERROR_NUMERICAL = 3,          /**< Factorization failed (matrix not SPD) */
+    ES_ERROR_OUT_OF_MEMORY = 4,
+    ES_ERROR_IO = 5,                 /**< Factorization cache could not be read or written */
+    ES_ERROR_INTERNAL = 6
+} es_status;
+
+typedef enum es_component {
+    ES_POTENTIAL = 0,                /**< φ (V) */
+    ES_FIELD_X = 1,                  /**< Ex = -∂φ/∂x (V/m) */
+    ES_FIELD_Y = 2,                  /**< Ey = -∂φ/∂y (V/m) */
+    ES_FIELD_MAGNITUDE = 3,          /**< |E| (V/m) */
+    ES_ENERGY_DENSITY = 4            /**< ½ε|E|² (J/m³) */
+} es_component;
+
+/** Discrete geometry; determines the system matrix */
+typedef struct es_grid {
+    int nx;                          /**< Grid points in x (≥ 3) */
+    int ny;                          /**< Grid points in y (≥ 3) */
+    double dx;                       /**< Spacing in x (m, > 0) */
+    double dy;                       /**< Spacing in y (m, > 0) */
+} es_grid;
+
+typedef struct es_factorization es_factorization;
+typedef struct es_solver es_solver;
+typedef struct es_field es_field;
+
+/* ========== Library ========== */
+
+/** ES_ABI_VERSION the library was built with */
+ES_API int es_abi_version(void);
+
+/** Static description of a status code */
+ES_API const char* es_status_string(es_status status);
+
+/**
+ * Message of the last failed call on this thread ("" if none). Valid until
+ * the next failing call on the same thread.
+ */
+ES_API const char* es_last_error(void);
+
+/* ========== Factorization ========== */
+
+/** Sparse LDLᵀ factorization of the reduced SPD system of a grid */
+ES_API es_status es_factorization_create(const es_grid* grid, es_factorization** out);
+
+/**
+ * Like es_factorization_create, but loads the factor from a
+ * FactorizationCache directory if present and stores it there otherwise
+ */
+ES_API es_status es_factorization_create_cached(const es_grid* grid, const char* cache_directory,
+                                                es_factorization** out);
+
+ES_API void es_factorization_destroy(es_factorization* factorization);
+
+/** Number of interior unknowns (nx-2)*(ny-2) */
+ES_API es_status es_factorization_size(const es_factorization* factorization, size_t* size);
+
+/**
+ * Solve K u = f on the interior unknowns; f and u have es_factorization_size()
+ * values and may be the same buffer
+ */
+ES_API es_status es_factorization_solve(const es_factorization* factorization,
+                                        const double* f, double* u, size_t count);
+
+/* ========== Solver ========== */
+
+/**
+ * Solver for one grid and permittivity; all boundary values start at 0 V.
+ * The factorization is computed on the first solve unless one is attached.
+ */
+ES_API es_status es_solver_create(const es_grid* grid, double epsilon, es_solver** out);
+
+ES_API void es_solver_destroy(es_solver* solver);
+
+/** Attach a factorization of the same grid (shared, not copied) */
+ES_API es_status es_solver_set_factorization(es_solver* solver, const es_factorization* factorization);
+
+/** Dirichlet values for the full grid (nx*ny values; only boundary entries are used) */
+ES_API es_status es_solver_set_boundary(es_solver* solver, const double* values, size_t count);
+
+/** Parallel plates: left column at `left`, right column at `right` (V) */
+ES_API es_status es_solver_set_plates(es_solver* solver, double left, double right);
+
+/**
+ * Solve for the potential of a charge density
+ * @param rho Interior charge density, (nx-2)*(ny-2) values (C/m³); NULL for none
+ * @param phi Output potential on the full grid, nx*ny values
+ */
+ES_API es_status es_solver_solve(es_solver* solver, const double* rho, size_t rho_count,
+                                 double* phi, size_t phi_count);
+
+/** Solve and wrap the potential in a field handle with lazily derived quantities */
+ES_API es_status es_solver_solve_field(es_solver* solver, const double* rho, size_t rho_count,
+                                       es_field** out);
+
+/* ========== Fields ========== */
+
+/** Field handle from a full-grid potential (nx*ny values, copied) */
+ES_API es_status es_field_create(const es_grid* grid, double epsilon, const double* phi, size_t count,
+                                 es_field** out);
+
+ES_API void es_field_destroy(es_field* field);
+
+ES_API es_status es_field_grid(const es_field* field, es_grid* grid);
+
+/** Copy a component for the full grid into `out` (nx*ny values, x fastest) */
+ES_API es_status es_field_get(es_field* field, es_component component, double* out, size_t count);
+
+/** Single grid point (boundary points of derived components are 0) */
+ES_API es_status es_field_at(es_field* field, es_component component, int i, int j, double* value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ELECTROSTATICS_C_H */
@@ -0,0 +1,148 @@
+#!/usr/bin/env python3
+"""
+Reader for the shared-memory frame ring written by FramePublisher (FrameStream.h)
+
+The ring is mapped read-only; frames are copied out under the slot seqlock,
+so a reader never blocks the solver and never returns a half-written frame.
+Layout and protocol are documented in FrameStream.h.
+
+    reader = FrameReader('/electrostatics_frames')
+    frame = reader.latest()          # None until the first frame is published
+    frame.potential                  # (ny, nx) numpy array
+"""
+
+import mmap
+import os
+import struct
+import sys
+from dataclasses import dataclass
+
+import numpy as np
+
+MAGIC = b'SCRB'
+VERSION = 1
+
+# Native byte order and sizes, matching FrameRing::RingHeader / SlotHeader
+RING_HEADER = struct.Struct('=4sIIIQQQ24x')
+SLOT_HEADER = struct.Struct('=QQiiiidddddd48s')
+SEQUENCE = struct.Struct('=Q')
+PUBLISHED_OFFSET = 32
+
+
+@dataclass
+class Frame:
+    """One frame copied out of the ring"""
+    frame: int
+    nx: int
+    ny: int
+    stride: int
+    dx: float
+    dy: float
+    time: float
+    phi_min: float
+    phi_max: float
+    field_max: float
+    label: str
+    potential: np.ndarray          # (ny, nx)
+    field_magnitude: np.ndarray    # (ny, nx)
+
+
+class FrameReader:
+    """Read-only view of a FramePublisher ring on the same machine"""
+
+    def __init__(self, name='/electrostatics_frames'):
+        self.name = name
+        self.retries = 0
+        self._shm = None
+        if os.path.isdir('/dev/shm'):
+            # Linux: map the object directly; no resource tracker involved
+            fd = os.open('/dev/shm/' + name.lstrip('/'), os.O_RDONLY)
+            try:
+                self._buffer = mmap.mmap(fd, 0, access=mmap.ACCESS_READ)
+            finally:
+                os.close(fd)
+        else:
+            from multiprocessing import shared_memory
+            if sys.version_info >= (3, 13):
+                self._shm = shared_memory.SharedMemory(name=name.lstrip('/'), track=False)
+            else:
+                self._shm = shared_memory.SharedMemory(name=name.lstrip('/'))
+                # Attaching must not make this process unlink the publisher's ring at exit
+                from multiprocessing import resource_tracker
+                resource_tracker.unregister(self._shm._name, 'shared_memory')
+            self._buffer = self._shm.buf
+
+        magic, version, self.slot_count, self.header_bytes, self.slot_bytes, self.capacity, _ = \
+            RING_HEADER.unpack_from(self._buffer, 0)
+        if magic != MAGIC or version != VERSION:
+            self.close()
+            raise ValueError(f"{name} is not a frame ring (version {VERSION})")
+
+    def close(self):
+        if self._shm is not None:
+            self._buffer = None
+            self._shm.close()
+            self._shm = None
+        elif self._buffer is not None:
+            self._buffer.close()
+            self._buffer = None
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        self.close()
+
+    def published(self):
+        """Number of frames published so far"""
+        return SEQUENCE.unpack_from(self._buffer, PUBLISHED_OFFSET)[0]
+
+    def read(self, frame_number, max_attempts=1000):
+        """Copy a specific frame; None if not published yet or already overwritten"""
+        offset = self.header_bytes + (frame_number % self.slot_count) * self.slot_bytes
+        for _ in range(max_attempts):
+            if frame_number >= self.published():
+                return None
+            before = SEQUENCE.unpack_from(self._buffer, offset)[0]
+            if before & 1:
+                self.retries += 1
+                continue
+
+            (_, number, nx, ny, stride, _, dx, dy, time, phi_min, phi_max, field_max,
+             label) = SLOT_HEADER.unpack_from(self._buffer, offset)
+            points = max(nx, 0) * max(ny, 0)
+            data = None
+            if points <= self.capacity:
+                data = np.frombuffer(self._buffer, dtype=np.float64, count=2 * points,
+                                     offset=offset + SLOT_HEADER.size).copy()
+
+            if SEQUENCE.unpack_from(self._buffer, offset)[0] != before or data is None:
+                self.retries += 1
+                continue
+            if number != frame_number:
+                return None
+            return Frame(number, nx, ny, stride, dx, dy, time, phi_min, phi_max, field_max,
+                         label.split(b'\0', 1)[0].decode('utf-8', 'replace'),
+                         data[:points].reshape(ny, nx), data[points:].reshape(ny, nx))
+        return None
+
+    def latest(self, max_attempts=1000):
+        """Copy the newest complete frame; None if nothing was published yet"""
+        for _ in range(max_attempts):
+            count = self.published()
+            if count == 0:
+                return None
+            frame = self.read(count - 1, max_attempts=1)
+            if frame is not None:
+                return frame
+        return None
+
+
+if __name__ == '__main__':
+    with FrameReader(sys.argv[1] if len(sys.argv) > 1 else '/electrostatics_frames') as reader:
+        frame = reader.latest()
+        if frame is None:
+            print("No frame published yet")
+        else:
+            print(f"Frame {frame.frame} '{frame.label}': {frame.nx}x{frame.ny} (stride {frame.stride}), "
+                  f"phi in [{frame.phi_min:.4g}, {frame.phi_max:.4g}] V, |E|max {frame.field_max:.4g} V/m")
@@ -0,0 +1,413 @@
+/**
+ * @file python_bindings.cpp
+ * @brief pybind11 module `electrostatics` for MatrixSolver, ElectrostaticSolver, ResistiveNetworkSolver,
+ *        EffectiveResistance and the CSR Graph core
+ *
+ * Arrays cross the boundary without copies where the memory layout allows:
+ * - Dense inputs bind to MatrixSolver::MatrixRef / VectorRef. 1D float64
+ *   arrays and Fortran-ordered (column-major) float64 matrices are used in
+ *   place; other layouts and dtypes are converted once.
+ * - Grid inputs of ElectrostaticSolver (rho, boundary_values) are read in
+ *   place by expand_reduced_solution. build_reduced_system, solve and
+ *   solve_plates copy them once, because buildReducedFDMSystem takes
+ *   std::vector.
+ * - Returned vectors and matrices are moved into numpy arrays that own the
+ *   Eigen storage.
+ * - FieldResult grids are read-only views that keep the FieldResult alive.
+ * - Sparse matrices are converted from scipy.sparse (copied).
+ *
+ * Solves release the GIL, so Python threads can run several of them
+ * concurrently. Inputs must not be modified by other threads during a call.
+ * Python callbacks (solve_preconditioned_cg) re-acquire the GIL while they
+ * run. A FieldResult must only be used from one thread at a time.
+ */
+
+#include "ElectrostaticSolver.h"
+#include "Factorization.h"
+#include "FieldResult.h"
+#include "Graph.h"
+#include "MatrixSolver.h"
+#include "ResistiveNetwork.h"
+#include "ShortestPaths.h"
+#include "Clustering.h"
+#include "LaplacianSpectrum.h"
+#include "Reordering.h"
+#include "EffectiveResistance.h"
+#include <pybind11/eigen.h>
+#include <pybind11/functional.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <stdexcept>
+#include <vector>
+
+namespace py = pybind11;
+using namespace pybind11::literals;
+
+namespace {
+
+using MatrixRef = MatrixSolver::MatrixRef;
+using VectorRef = MatrixSolver::VectorRef;
+using Release = py::call_guard<py::gil_scoped_release>;
+
+std::vector<double> toVector(const VectorRef& v) {
+    return std::vector<double>(v.data(), v.data() + v.size());
+}
+
+/**
+ * Left plate at `voltage`, everything else grounded (test_electrostatic layout)
+ */
+std::vector<double> plateBoundary(ElectrostaticSolver& solver, int nx, int ny, double voltage) {
+    std::vector<double> boundaryValues(static_cast<size_t>(nx) * ny, 0.0);
+    for (int j = 0; j < ny; ++j) {
+        boundaryValues[solver.coordToIndex(0, j, nx)] = voltage;
+    }
+    return boundaryValues;
+}
+
+FieldResult solveReduced(ElectrostaticSolver& solver, int nx, int ny, double dx, double dy,
+                         const std::vector<double>& rho, double epsilon,
+                         const std::vector<double>& boundaryValues) {
+    MatrixSolver::SparseMatrix K;
+    Eigen::VectorXd f;
+    solver.buildReducedFDMSystem(nx, ny, dx, dy, rho, epsilon, K, f, boundaryValues);
+    Eigen::VectorXd u = SparseCholeskyFactor::compute(K).solve(f);
+    return solver.makeFieldResult(nx, ny, solver.expandReducedSolution(nx, ny, u, boundaryValues), dx, dy, epsilon);
+}
+
+} // namespace
+
+PYBIND11_MODULE(electrostatics, m) {
+    m.doc() = "Bindings for MatrixSolver and ElectrostaticSolver (dense inputs used in place where the layout allows)";
+
+    // ========== MatrixSolver ==========
+    py::class_<MatrixSolver::IterativeResult>(m, "IterativeResult")
+        .def_readonly("x", &MatrixSolver::IterativeResult::x)
+        .def_readonly("iterations", &MatrixSolver::IterativeResult::iterations)
+        .def_readonly("relative_residual", &MatrixSolver::IterativeResult::relativeResidual)
+        .def_readonly("error_estimate", &MatrixSolver::IterativeResult::errorEstimate)
+        .def_readonly("converged", &MatrixSolver::IterativeResult::converged)
+        .def_readonly("interrupted", &MatrixSolver::IterativeResult::interrupted);
+
+    py::class_<MatrixSolver>(m, "MatrixSolver")
+        .def(py::init<>())
+        .def("solve_lu", &MatrixSolver::solveLU, "A"_a, "b"_a, Release())
+        .def("solve_qr", &MatrixSolver::solveQR, "A"_a, "b"_a, Release())
+        .def("solve_conjugate_gradient",
+             py::overload_cast<const MatrixSolver::MatrixRef&, const MatrixSolver::VectorRef&, int, double>(
+                 &MatrixSolver::solveConjugateGradient),
+             "A"_a, "b"_a, "max_iterations"_a = -1, "tolerance"_a = 1e-6, Release())
+        .def("solve_gmres",
+             py::overload_cast<const MatrixSolver::MatrixRef&, const MatrixSolver::VectorRef&, int, int, double>(
+                 &MatrixSolver::solveGMRES),
+             "A"_a, "b"_a, "restart"_a = 30, "max_iterations"_a = -1, "tolerance"_a = 1e-6, Release())
+        .def("solve_sparse_cg",
+             py::overload_cast<const MatrixSolver::SparseMatrix&, const MatrixSolver::VectorRef&, int, double>(
+                 &MatrixSolver::solveSparseCG),
+             "A"_a, "b"_a, "max_iterations"_a = -1, "tolerance"_a = 1e-6, Release())
+        .def("solve_sparse_cholesky", &MatrixSolver::solveSparseCholesky, "A"_a, "b"_a, Release())
+        .def("solve_preconditioned_cg",
+             [](MatrixSolver& solver, const MatrixSolver::LinearOperator& A, const Eigen::VectorXd& b,
+                const MatrixSolver::Preconditioner& M, const Eigen::VectorXd& x0, int maxIterations,
+                double tolerance, double timeBudget) {
+                 MatrixSolver::SolveControl control;
+                 if (timeBudget > 0.0) {
+                     control.deadline = Deadline::after(timeBudget);
+                 }
+                 return solver.solvePreconditionedCG(A, b, M, x0, maxIterations, tolerance, control);
+             },
+             "A"_a, "b"_a, "M"_a = py::none(), "x0"_a = Eigen::VectorXd(),
+             "max_iterations"_a = 1000, "tolerance"_a = 1e-10, "time_budget"_a = 0.0, Release())
+        .def("determinant", &MatrixSolver::determinant, "A"_a, Release())
+        .def("inverse", &MatrixSolver::inverse, "A"_a, Release())
+        .def("eigen_decomposition", [](MatrixSolver& solver, const MatrixRef& A) {
+                Eigen::VectorXd values;
+                Eigen::MatrixXd vectors;
+                {
+                    py::gil_scoped_release release;
+                    solver.eigenDecomposition(A, values, vectors);
+                }
+                return py::make_tuple(std::move(values), std::move(vectors));
+            }, "A"_a);
+
+    // ========== FieldResult ==========
+    // Grids are (ny, nx) read-only views into the FieldResult (no copy)
+    py::class_<FieldResult>(m, "FieldResult")
+        .def_property_readonly("nx", &FieldResult::nx)
+        .def_property_readonly("ny", &FieldResult::ny)
+        .def_property_readonly("dx", &FieldResult::dx)
+        .def_property_readonly("dy", &FieldResult::dy)
+        .def_property_readonly("epsilon", &FieldResult::epsilon)
+        .def_property_readonly("potential", &FieldResult::potential, py::return_value_policy::reference_internal)
+        .def_property_readonly("Ex", &FieldResult::Ex, py::return_value_policy::reference_internal)
+        .def_property_readonly("Ey", &FieldResult::Ey, py::return_value_policy::reference_internal)
+        .def_property_readonly("field_magnitude", &FieldResult::fieldMagnitude,
+                               py::return_value_policy::reference_internal)
+        .def_property_readonly("energy_density", &FieldResult::energyDensity,
+                               py::return_value_policy::reference_internal)
+        .def_property_readonly("evaluation_count", &FieldResult::evaluationCount);
+
+    // ========== ElectrostaticSolver ==========
+    py::class_<ElectrostaticSolver, MatrixSolver>(m, "ElectrostaticSolver")
+        .def(py::init<>())
+        .def("build_reduced_system", [](ElectrostaticSolver& solver, int nx, int ny, double dx, double dy,
+                                        const VectorRef& rho, double epsilon, const VectorRef& boundaryValues) {
+                MatrixSolver::SparseMatrix K;
+                Eigen::VectorXd f;
+                {
+                    py::gil_scoped_release release;
+                    solver.buildReducedFDMSystem(nx, ny, dx, dy, toVector(rho), epsilon, K, f, toVector(boundaryValues));
+                }
+                return py::make_tuple(std::move(K), std::move(f));
+            }, "nx"_a, "ny"_a, "dx"_a, "dy"_a, "rho"_a, "epsilon"_a, "boundary_values"_a)
+        .def("expand_reduced_solution", [](ElectrostaticSolver& solver, int nx, int ny,
+                                           const VectorRef& u, const VectorRef& boundaryValues) {
+                if (u.size() != static_cast<Eigen::Index>(nx - 2) * (ny - 2)) {
+                    throw std::invalid_argument("u must have (nx-2)*(ny-2) values");
+                }
+                Eigen::VectorXd phi(static_cast<Eigen::Index>(nx) * ny);
+                solver.expandReducedSolution(nx, ny, u.data(), boundaryValues.data(),
+                                             static_cast<size_t>(boundaryValues.size()), phi.data());
+                return phi;
+            }, "nx"_a, "ny"_a, "u"_a, "boundary_values"_a, Release())
+        .def("geometry_hash", &ElectrostaticSolver::geometryHash, "nx"_a, "ny"_a, "dx"_a, "dy"_a)
+        .def("solve", [](ElectrostaticSolver& solver, int nx, int ny, double dx, double dy,
+                         const VectorRef& rho, double epsilon, const VectorRef& boundaryValues) {
+                return solveReduced(solver, nx, ny, dx, dy, toVector(rho), epsilon, toVector(boundaryValues));
+            }, "nx"_a, "ny"_a, "dx"_a, "dy"_a, "rho"_a, "epsilon"_a, "boundary_values"_a, Release(),
+            "Solve with the reduced SPD system and sparse LDLT; rho has (nx-2)*(ny-2) interior values, "
+            "boundary_values has nx*ny values (x fastest)")
+        .def("solve_plates", [](ElectrostaticSolver& solver, int nx, int ny, double spacing,
+                                double voltage, double epsilon, const VectorRef& rho) {
+                std::vector<double> density = rho.size() ? toVector(rho)
+                                                         : std::vector<double>(static_cast<size_t>(nx - 2) * (ny - 2), 0.0);
+                return solveReduced(solver, nx, ny, spacing, spacing, density, epsilon,
+                                    plateBoundary(solver, nx, ny, voltage));
+            }, "nx"_a = 25, "ny"_a = 25, "spacing"_a = 0.1, "voltage"_a = 100.0, "epsilon"_a = 8.854e-12,
+            "rho"_a = Eigen::VectorXd(), Release(),
+            "Parallel plate problem of test_electrostatic: left plate at voltage, right plate grounded")
+        .def("coord_to_index", &ElectrostaticSolver::coordToIndex, "i"_a, "j"_a, "nx"_a);
+
+    // ========== Resistive networks ==========
+    py::class_<ResistiveNetwork>(m, "ResistiveNetwork")
+        .def(py::init<>())
+        .def("add_node", &ResistiveNetwork::addNode, "id"_a)
+        .def("add_edge", &ResistiveNetwork::addEdge, "u"_a, "v"_a, "resistance"_a)
+        .def("add_edges", [](ResistiveNetwork& network, const std::vector<ResistiveNetwork::NodeId>& u,
+                             const std::vector<ResistiveNetwork::NodeId>& v, const std::vector<double>& resistance) {
+                if (u.size() != v.size() || u.size() != resistance.size()) {
+                    throw std::invalid_argument("u, v and resistance must have the same length");
+                }
+                network.reserve(0, static_cast<size_t>(network.edgeCount()) + u.size());
+                for (size_t e = 0; e < u.size(); ++e) {
+                    network.addEdge(u[e], v[e], resistance[e]);
+                }
+            }, "u"_a, "v"_a, "resistance"_a)
+        .def_static("from_csr", &ResistiveNetwork::fromCSR, "offsets"_a, "targets"_a, "resistances"_a,
+                    "ids"_a = std::vector<ResistiveNetwork::NodeId>(), "symmetric"_a = false)
+        .def("index", &ResistiveNetwork::index, "id"_a)
+        .def("id", &ResistiveNetwork::id, "index"_a)
+        .def_property_readonly("node_count", &ResistiveNetwork::nodeCount)
+        .def_property_readonly("edge_count", &ResistiveNetwork::edgeCount)
+        .def("laplacian", &ResistiveNetwork::laplacian);
+
+    py::enum_<NetworkSolveMethod>(m, "NetworkSolveMethod")
+        .value("AUTO", NetworkSolveMethod::Auto)
+        .value("CHOLESKY", NetworkSolveMethod::Cholesky)
+        .value("CONJUGATE_GRADIENT", NetworkSolveMethod::ConjugateGradient);
+
+    py::enum_<NetworkPreconditioner>(m, "NetworkPreconditioner")
+        .value("JACOBI", NetworkPreconditioner::Jacobi)
+        .value("INCOMPLETE_CHOLESKY", NetworkPreconditioner::IncompleteCholesky)
+        .value("SPANNING_TREE", NetworkPreconditioner::SpanningTree)
+        .value("AUGMENTED_TREE", NetworkPreconditioner::AugmentedTree);
+
+    py::class_<ResistiveNetworkSolver, MatrixSolver>(m, "ResistiveNetworkSolver")
+        .def(py::init([](const ResistiveNetwork& network, ResistiveNetwork::NodeId ground,
+                         NetworkSolveMethod method, double tolerance, NetworkPreconditioner preconditioner) {
+                NetworkSolveOptions options;
+                options.method = method;
+                options.tolerance = tolerance;
+                options.preconditioner = preconditioner;
+                return new ResistiveNetworkSolver(network, ground, options);
+            }), "network"_a, "ground"_a, "method"_a = NetworkSolveMethod::Auto, "tolerance"_a = 1e-10,
+            "preconditioner"_a = NetworkPreconditioner::Jacobi)
+        .def("solve_currents", &ResistiveNetworkSolver::solveCurrents, "currents"_a, Release(),
+             "Node voltages (by node index) for injected currents (by node index)")
+        .def("dc_solution", &ResistiveNetworkSolver::dcSolution, "source"_a, "sink"_a, Release(),
+             "Node voltages (by node index) for +1 A into source and -1 A out of sink")
+        .def("add_edge", &ResistiveNetworkSolver::addEdge, "u"_a, "v"_a, "resistance"_a, Release(),
+             "Add a resistor; the last solution is updated by a rank-one (Sherman-Morrison) update")
+        .def("set_resistance", &ResistiveNetworkSolver::setResistance, "edge"_a, "resistance"_a, Release())
+        .def_property_readonly("voltages", &ResistiveNetworkSolver::voltages)
+        .def_property_readonly("network", &ResistiveNetworkSolver::network)
+        .def_property_readonly("components", &ResistiveNetworkSolver::components)
+        .def_property_readonly("direct", &ResistiveNetworkSolver::direct)
+        .def_property_readonly("last_iterations", &ResistiveNetworkSolver::lastIterations);
+
+    py::class_<EffectiveResistance, ResistiveNetworkSolver>(m, "EffectiveResistance")
+        .def(py::init([](const ResistiveNetwork& network, NetworkSolveMethod method, double tolerance) {
+                NetworkSolveOptions options;
+                options.method = method;
+                options.tolerance = tolerance;
+                return new EffectiveResistance(network, options);
+            }), "network"_a, "method"_a = NetworkSolveMethod::Auto, "tolerance"_a = 1e-10)
+        .def("resistance", &EffectiveResistance::resistance, "u"_a, "v"_a, Release(),
+             "Exact effective resistance between two node IDs (inf across components)")
+        .def("resistances", &EffectiveResistance::resistances, "pairs"_a, "batch"_a = 32, Release(),
+             "Exact effective resistances of a list of (u, v) node ID pairs, solved in batches")
+        .def("build_sketch", [](EffectiveResistance& self, double epsilon, int dimension, std::uint64_t seed) {
+                ResistanceSketchOptions options;
+                options.epsilon = epsilon;
+                options.dimension = dimension;
+                options.seed = seed;
+                self.buildSketch(options);
+            }, "epsilon"_a = 0.3, "dimension"_a = 0, "seed"_a = 93, Release(),
+            "Johnson-Lindenstrauss sketch for approximate(); dimension 0 picks 4 ln(n) / epsilon^2")
+        .def("approximate", &EffectiveResistance::approximate, "u"_a, "v"_a,
+             "Approximate effective resistance from the sketch, O(k) per query")
+        .def_property_readonly("sketch_dimension", &EffectiveResistance::sketchDimension);
+
+    py::class_<Graph>(m, "Graph", "Undirected CSR graph with sorted adjacency")
+        .def_static("from_edges", &Graph::fromEdges, "nodes"_a, "u"_a, "v"_a, "threads"_a = 0, Release())
+        .def_static("ring_lattice", &Graph::ringLattice, "nodes"_a, "k"_a, "threads"_a = 0, Release())
+        .def_static("watts_strogatz", &Graph::wattsStrogatz, "nodes"_a, "k"_a, "p"_a, "seed"_a = 0,
+                    "threads"_a = 0, Release(),
+                    "Watts-Strogatz graph; reproducible for a seed regardless of the thread count")
+        .def_static("connected_watts_strogatz", &Graph::connectedWattsStrogatz, "nodes"_a, "k"_a, "p"_a,
+                    "seed"_a = 0, "tries"_a = 100, "threads"_a = 0, Release())
+        .def_property_readonly("node_count", &Graph::nodeCount)
+        .def_property_readonly("edge_count", &Graph::edgeCount)
+        .def("degree", &Graph::degree, "v"_a)
+        .def("neighbors", [](const Graph& g, int v) {
+                Graph::Neighbors adjacent = g.neighbors(v);
+                return std::vector<int>(adjacent.begin(), adjacent.end());
+            }, "v"_a)
+        .def("has_edge", &Graph::hasEdge, "u"_a, "v"_a)
+        .def_property_readonly("offsets", &Graph::offsets)
+        .def_property_readonly("targets", &Graph::targets)
+        .def("components", [](const Graph& g, int threads) {
+                std::vector<int> labels;
+                int count;
+                {
+                    py::gil_scoped_release release;
+                    count = g.components(&labels, threads);
+                }
+                return py::make_tuple(count, labels);
+            }, "threads"_a = 0, "(number of components, component label of every vertex)")
+        .def("is_connected", &Graph::connected, "threads"_a = 0, Release());
+
+    py::class_<DistanceStats>(m, "DistanceStats")
+        .def_readonly("average_distance", &DistanceStats::averageDistance)
+        .def_readonly("diameter", &DistanceStats::diameter)
+        .def_readonly("distance_sum", &DistanceStats::distanceSum)
+        .def_readonly("pairs", &DistanceStats::pairs)
+        .def_readonly("sources", &DistanceStats::sources)
+        .def_readonly("connected", &DistanceStats::connected)
+        .def_readonly("seconds", &DistanceStats::seconds);
+
+    m.def("average_shortest_path_length", &ShortestPaths::exact, "graph"_a, "threads"_a = 0, Release(),
+          "Exact average shortest path length and diameter by bit-parallel multi-source BFS");
+    m.def("shortest_path_stats", &ShortestPaths::fromSources, "graph"_a, "sources"_a, "threads"_a = 0, Release(),
+          "Distance statistics from the given BFS sources");
+    py::class_<SampledDistanceStats>(m, "SampledDistanceStats")
+        .def_readonly("average_distance", &SampledDistanceStats::averageDistance)
+        .def_readonly("half_width", &SampledDistanceStats::halfWidth)
+        .def_readonly("confidence", &SampledDistanceStats::confidence)
+        .def_readonly("diameter_lower_bound", &SampledDistanceStats::diameterLowerBound)
+        .def_readonly("sources", &SampledDistanceStats::sources)
+        .def_readonly("exact", &SampledDistanceStats::exact)
+        .def_readonly("converged", &SampledDistanceStats::converged)
+        .def_readonly("connected", &SampledDistanceStats::connected)
+        .def_readonly("seconds", &SampledDistanceStats::seconds);
+
+    m.def("sampled_average_shortest_path_length", &ShortestPaths::sampled, "graph"_a, "relative_error"_a = 0.01,
+          "confidence"_a = 0.95, "seed"_a = 0, "max_sources"_a = 0, "threads"_a = 0, Release(),
+          "Average shortest path length from sampled BFS sources, doubling the sample until the "
+          "confidence interval is within relative_error");
+    m.def("bfs_distances", &ShortestPaths::distances, "graph"_a, "source"_a, Release());
+
+    py::class_<ClusteringStats>(m, "ClusteringStats")
+        .def_readonly("local", &ClusteringStats::local)
+        .def_readonly("triangles", &ClusteringStats::triangles)
+        .def_readonly("average", &ClusteringStats::average)
+        .def_readonly("transitivity", &ClusteringStats::transitivity)
+        .def_readonly("total_triangles", &ClusteringStats::totalTriangles)
+        .def_readonly("seconds", &ClusteringStats::seconds);
+
+    m.def("clustering", &Clustering::compute, "graph"_a, "threads"_a = 0, Release(),
+          "Per-vertex triangles and clustering coefficients by degree-ordered merge intersection");
+
+    py::class_<LaplacianSpectrum>(m, "LaplacianSpectrum")
+        .def_readonly("eigenvalues", &LaplacianSpectrum::eigenvalues)
+        .def_readonly("eigenvectors", &LaplacianSpectrum::eigenvectors)
+        .def_readonly("residuals", &LaplacianSpectrum::residuals)
+        .def_readonly("algebraic_connectivity", &LaplacianSpectrum::algebraicConnectivity)
+        .def_readonly("components", &LaplacianSpectrum::components)
+        .def_readonly("iterations", &LaplacianSpectrum::iterations)
+        .def_readonly("restarts", &LaplacianSpectrum::restarts)
+        .def_readonly("converged", &LaplacianSpectrum::converged)
+        .def_readonly("seconds", &LaplacianSpectrum::seconds)
+        .def_property_readonly("fiedler", &LaplacianSpectrum::fiedler);
+
+    auto lanczosOptions = [](int count, int basis, int maxIterations, double tolerance, std::uint64_t seed,
+                             int threads) {
+        LanczosOptions options;
+        options.count = count;
+        options.basis = basis;
+        options.maxIterations = maxIterations;
+        options.tolerance = tolerance;
+        options.seed = seed;
+        options.threads = threads;
+        return options;
+    };
+    m.def("laplacian_spectrum",
+          [lanczosOptions](const Graph& graph, int count, int basis, int maxIterations, double tolerance,
+                           std::uint64_t seed, int threads) {
+              return LaplacianEigensolver::lowest(graph, lanczosOptions(count, basis, maxIterations, tolerance,
+                                                                        seed, threads));
+          },
+          "graph"_a, "count"_a = 1, "basis"_a = 0, "max_iterations"_a = 20000, "tolerance"_a = 1e-8, "seed"_a = 99,
+          "threads"_a = 0, Release(),
+          "Smallest nonzero Laplacian eigenpairs (Fiedler vector first) by thick-restart Lanczos");
+    m.def("laplacian_spectrum",
+          [lanczosOptions](const ResistiveNetwork& network, int count, int basis, int maxIterations,
+                           double tolerance, std::uint64_t seed, int threads) {
+              return LaplacianEigensolver::lowest(network, lanczosOptions(count, basis, maxIterations, tolerance,
+                                                                          seed, threads));
+          },
+          "network"_a, "count"_a = 1, "basis"_a = 0, "max_iterations"_a = 20000, "tolerance"_a = 1e-8,
+          "seed"_a = 99, "threads"_a = 0, Release(),
+          "Smallest nonzero eigenpairs of the conductance-weighted network Laplacian");
+
+    py::class_<OrderingStats>(m, "OrderingStats")
+        .def_readonly("bandwidth", &OrderingStats::bandwidth)
+        .def_readonly("profile", &OrderingStats::profile)
+        .def_readonly("factor_nonzeros", &OrderingStats::factorNonZeros);
+
+    py::class_<ReorderingReport>(m, "ReorderingReport")
+        .def_readonly("before", &ReorderingReport::before)
+        .def_readonly("after", &ReorderingReport::after);
+
+    using SparseMatrix = Reordering::SparseMatrix;
+    py::class_<Reordering>(m, "Reordering", "Symmetric permutation of unknowns (order[new] = old)")
+        .def_static("natural", &Reordering::natural, "n"_a)
+        .def_static("from_order", &Reordering::fromOrder, "order"_a)
+        .def_static("reverse_cuthill_mckee", py::overload_cast<const SparseMatrix&>(&Reordering::reverseCuthillMcKee),
+                    "matrix"_a, Release())
+        .def_static("reverse_cuthill_mckee", py::overload_cast<const Graph&>(&Reordering::reverseCuthillMcKee),
+                    "graph"_a, Release())
+        .def_static("minimum_degree", &Reordering::minimumDegree, "matrix"_a, Release())
+        .def_static("nested_dissection", &Reordering::nestedDissection, "nx"_a, "ny"_a, "leaf"_a = 16)
+        .def_static("statistics", &Reordering::statistics, "matrix"_a, Release(),
+                    "Bandwidth, profile and Cholesky fill of a symmetric matrix as numbered")
+        .def("report", &Reordering::report, "matrix"_a, Release())
+        .def_property_readonly("size", &Reordering::size)
+        .def_property_readonly("order", &Reordering::order)
+        .def_property_readonly("position", &Reordering::position)
+        .def("apply", py::overload_cast<const SparseMatrix&>(&Reordering::apply, py::const_), "matrix"_a)
+        .def("apply", py::overload_cast<const Eigen::VectorXd&>(&Reordering::apply, py::const_), "vector"_a)
+        .def("apply", py::overload_cast<const Eigen::MatrixXd&>(&Reordering::apply, py::const_), "field"_a)
+        .def("restore", py::overload_cast<const Eigen::VectorXd&>(&Reordering::restore, py::const_), "vector"_a)
+        .def("restore", py::overload_cast<const Eigen::MatrixXd&>(&Reordering::restore, py::const_), "field"_a)
+        .def("inverse", &Reordering::inverse);
+}
@@ -0,0 +1,54 @@
+#include "SolveDaemon.h"
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+void printUsage() {
+    std::cout << "Usage: solve_daemon <socket path> [cache directory] [batch window (us)] [memory budget (MiB)]" << std::endl;
+    std::cout << "Serves solves until a client sends Shutdown (see SolveClient)." << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        printUsage();
+        return 0;
+    }
+
+    SolveDaemonOptions options;
+    options.socketPath = argv[1];
+    if (argc > 2) {
+        options.cacheDirectory = argv[2];
+    }
+    try {
+        if (argc > 3) {
+            options.batchWindowMicros = std::stoi(argv[3]);
+        }
+        if (argc > 4) {
+            double mib = std::stod(argv[4]);
+            if (!(mib >= 0.0)) {
+                throw std::invalid_argument("negative memory budget");
+            }
+            options.memoryBudgetBytes = static_cast<size_t>(mib * 1024 * 1024);
+        }
+    } catch (const std::exception&) {
+        std::cerr << "Error: invalid batch window or memory budget" << std::endl;
+        printUsage();
+        return 1;
+    }
+    options.verbose = true;
+
+    try {
+        SolveDaemon daemon(options);
+        daemon.start();
+        daemon.wait();
+        std::cout << daemon.statsReport() << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,189 @@
+/*
+ * Test of the C API (electrostatics_c.h): plain C99, handles and caller buffers only
+ */
+
+#include "electrostatics_c.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#define NX 65
+#define NY 65
+#define THREADS 4
+
+static int ok = 1;
+
+static void check(int condition, const char* label) {
+    printf("  %-58s %s\n", label, condition ? "ok" : "FAILED");
+    if (!condition) {
+        ok = 0;
+    }
+}
+
+/* ========== Concurrent solves sharing one factorization ========== */
+
+typedef struct {
+    const es_factorization* factorization;
+    const double* rho;
+    double voltage;
+    double* phi;
+    es_status status;
+} worker_args;
+
+#if defined(_WIN32)
+static DWORD WINAPI worker(LPVOID arg)
+#else
+static void* worker(void* arg)
+#endif
+{
+    worker_args* w = (worker_args*)arg;
+    es_grid grid = {NX, NY, 1e-3, 1e-3};
+    es_solver* solver = NULL;
+    w->status = es_solver_create(&grid, 8.854e-12, &solver);
+    if (w->status == ES_OK) {
+        w->status = es_solver_set_factorization(solver, w->factorization);
+    }
+    if (w->status == ES_OK) {
+        w->status = es_solver_set_plates(solver, w->voltage, 0.0);
+    }
+    for (int repeat = 0; repeat < 5 && w->status == ES_OK; ++repeat) {
+        w->status = es_solver_solve(solver, w->rho, (NX - 2) * (NY - 2), w->phi, NX * NY);
+    }
+    es_solver_destroy(solver);
+    return 0;
+}
+
+int main(void) {
+    printf("=== C API - Embedding Example ===\n");
+    printf("Problem: Parallel plates through opaque handles and caller-provided buffers\n\n");
+
+    es_grid grid = {NX, NY, 1e-3, 1e-3};
+    double epsilon = 8.854e-12;
+    size_t n = (size_t)NX * NY;
+    size_t m = (size_t)(NX - 2) * (NY - 2);
+    double* phi = (double*)malloc(n * sizeof(double));
+    double* field = (double*)malloc(n * sizeof(double));
+    double* rho = (double*)calloc(m, sizeof(double));
+
+    check(es_abi_version() == ES_ABI_VERSION, "ABI version matches the header");
+
+    /* ========== Uncharged plates: linear potential ========== */
+    es_factorization* factorization = NULL;
+    es_solver* solver = NULL;
+    check(es_factorization_create(&grid, &factorization) == ES_OK, "Factorization created");
+    size_t unknowns = 0;
+    es_factorization_size(factorization, &unknowns);
+    check(unknowns == m, "Factorization has (nx-2)*(ny-2) unknowns");
+
+    es_solver_create(&grid, epsilon, &solver);
+    es_solver_set_factorization(solver, factorization);
+    es_factorization_destroy(factorization);   /* The solver keeps its own reference */
+    es_solver_set_plates(solver, 1.0, 0.0);
+    check(es_solver_solve(solver, NULL, 0, phi, n) == ES_OK, "Solve without charge");
+
+    double maxError = 0.0;
+    for (int j = 0; j < NY; ++j) {
+        for (int i = 0; i < NX; ++i) {
+            double expected = 1.0 - (double)i / (NX - 1);
+            maxError = fmax(maxError, fabs(phi[i + j * NX] - expected));
+        }
+    }
+    printf("  Max deviation from the linear profile: %.2e V\n", maxError);
+    check(maxError < 1e-10, "Potential is linear between the plates");
+
+    /* ========== Field handle ========== */
+    es_field* result = NULL;
+    check(es_solver_solve_field(solver, NULL, 0, &result) == ES_OK, "Solve into a field handle");
+    check(es_field_get(result, ES_FIELD_MAGNITUDE, field, n) == ES_OK, "Copy |E| into a caller buffer");
+    double expectedE = 1.0 / ((NX - 1) * grid.dx);
+    double value = 0.0;
+    es_field_at(result, ES_FIELD_X, NX / 2, NY / 2, &value);
+    printf("  |E| at the centre: %.6f V/m (expected %.6f V/m)\n", field[NX / 2 + (NY / 2) * NX], expectedE);
+    check(fabs(field[NX / 2 + (NY / 2) * NX] - expectedE) < 1e-6 * expectedE && fabs(value - expectedE) < 1e-6 * expectedE,
+          "Uniform field V/d in the interior");
+    es_field_destroy(result);
+
+    /* ========== Charge density ========== */
+    rho[(NX / 2 - 1) + (NY / 2 - 1) * (NX - 2)] = 1e-3;
+    es_solver_solve(solver, rho, m, phi, n);
+    double centre = phi[NX / 2 + (NY / 2) * NX];
+    printf("  Potential at a positive charge: %.6f V (uncharged 0.5 V)\n", centre);
+    check(centre > 0.5, "Positive charge raises the local potential");
+
+    /* ========== Error reporting ========== */
+    check(es_solver_solve(solver, rho, m, phi, n - 1) == ES_ERROR_BUFFER_TOO_SMALL, "Short output buffer rejected");
+    printf("  Message: %s\n", es_last_error());
+    check(strstr(es_last_error(), "required") != NULL, "Message names the required size");
+    es_solver_destroy(solver);
+    check(es_solver_create(NULL, epsilon, &solver) == ES_ERROR_INVALID_ARGUMENT && solver == NULL,
+          "Null grid rejected");
+    es_grid bad = {2, 10, 1e-3, 1e-3};
+    check(es_factorization_create(&bad, &factorization) == ES_ERROR_INVALID_ARGUMENT && factorization == NULL,
+          "Grid without interior rejected");
+    es_field* badField = NULL;
+    check(es_field_create(&grid, 0.0, phi, n, &badField) == ES_ERROR_INVALID_ARGUMENT && badField == NULL,
+          "Field with non-positive permittivity rejected");
+
+    /* ========== Shared factorization from several threads ========== */
+    check(es_factorization_create_cached(&grid, "factor_cache", &factorization) == ES_OK,
+          "Factorization from the cache directory");
+    worker_args args[THREADS];
+    double* results[THREADS];
+    for (int t = 0; t < THREADS; ++t) {
+        results[t] = (double*)malloc(n * sizeof(double));
+        args[t].factorization = factorization;
+        args[t].rho = rho;
+        args[t].voltage = 1.0 + t;
+        args[t].phi = results[t];
+    }
+#if defined(_WIN32)
+    HANDLE threads[THREADS];
+    for (int t = 0; t < THREADS; ++t) {
+        threads[t] = CreateThread(NULL, 0, worker, &args[t], 0, NULL);
+    }
+    WaitForMultipleObjects(THREADS, threads, TRUE, INFINITE);
+    for (int t = 0; t < THREADS; ++t) {
+        CloseHandle(threads[t]);
+    }
+#else
+    pthread_t threads[THREADS];
+    for (int t = 0; t < THREADS; ++t) {
+        pthread_create(&threads[t], NULL, worker, &args[t]);
+    }
+    for (int t = 0; t < THREADS; ++t) {
+        pthread_join(threads[t], NULL);
+    }
+#endif
+
+    /* Superposition: φ(V) - φ(1 V) = (V - 1) · linear profile */
+    double threadError = 0.0;
+    int statusOk = 1;
+    for (int t = 0; t < THREADS; ++t) {
+        statusOk = statusOk && args[t].status == ES_OK;
+        for (int i = 0; i < NX; ++i) {
+            double expected = t * (1.0 - (double)i / (NX - 1));
+            double got = results[t][i + (NY / 3) * NX] - results[0][i + (NY / 3) * NX];
+            threadError = fmax(threadError, fabs(got - expected));
+        }
+    }
+    printf("  %d threads, max superposition error: %.2e V\n", THREADS, threadError);
+    check(statusOk && threadError < 1e-9, "Concurrent solves agree with superposition");
+    es_factorization_destroy(factorization);
+
+    for (int t = 0; t < THREADS; ++t) {
+        free(results[t]);
+    }
+    free(phi);
+    free(field);
+    free(rho);
+
+    printf("\n=== %s ===\n", ok ? "C API checks passed" : "C API checks FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,193 @@
+#include "BackgroundSolve.h"
+#include "ElectrostaticSolver.h"
+#include "Factorization.h"
+#include "Multigrid.h"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+#include <thread>
+
+namespace {
+
+double seconds(const std::chrono::steady_clock::time_point& t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Deadline-Bounded Solves - Anytime Iterative Solver Example ===" << std::endl;
+    std::cout << "Problem: Return the best iterate found within a time budget, keep refining in the background\n"
+              << std::endl;
+
+    bool ok = true;
+
+    // Grounded box with a charged square and a 10 V electrode on the left edge
+    ElectrostaticSolver solver;
+    int n = 401;
+    double h = 1e-3;
+    std::vector<double> rho(static_cast<size_t>(n - 2) * (n - 2), 0.0);
+    for (int j = n / 2 - 10; j <= n / 2 + 10; ++j) {
+        for (int i = n / 2 - 10; i <= n / 2 + 10; ++i) {
+            rho[(i - 1) + (j - 1) * (n - 2)] = 1e-9;
+        }
+    }
+    std::vector<double> boundaryValues(static_cast<size_t>(n) * n, 0.0);
+    for (int j = 0; j < n; ++j) {
+        boundaryValues[solver.coordToIndex(0, j, n)] = 10.0;
+    }
+    MatrixSolver::SparseMatrix K;
+    Eigen::VectorXd f;
+    solver.buildReducedFDMSystem(n, n, h, h, rho, 8.854e-12, K, f, boundaryValues);
+    auto apply = [&](const Eigen::VectorXd& x) { return Eigen::VectorXd(K * x); };
+    DiagonalPreconditioner jacobi = DiagonalPreconditioner::compute(K);
+    auto M = [&](const Eigen::VectorXd& r) { return jacobi.apply(r); };
+
+    Eigen::VectorXd exact = SparseCholeskyFactor::compute(K).solve(f);
+    auto trueError = [&](const Eigen::VectorXd& x) { return (x - exact).norm() / exact.norm(); };
+    std::cout << "System: " << f.size() << " unknowns" << std::endl;
+
+    // ========== Jacobi PCG under a 50 ms budget ==========
+    MatrixSolver::SolveControl control;
+    control.deadline = Deadline::after(0.05);
+    auto t0 = std::chrono::steady_clock::now();
+    MatrixSolver::IterativeResult quick = solver.solvePreconditionedCG(apply, f, M, Eigen::VectorXd(), 100000, 1e-10,
+                                                                       control);
+    double elapsed = seconds(t0);
+    double quickError = trueError(quick.x);
+    std::cout << std::scientific << std::setprecision(2);
+    std::cout << "\nPCG, 50 ms budget: returned after " << std::fixed << elapsed * 1e3 << " ms, "
+              << quick.iterations << " iterations, interrupted " << (quick.interrupted ? "yes" : "no") << std::endl;
+    std::cout << std::scientific << "  residual " << quick.relativeResidual << ", estimated error "
+              << quick.errorEstimate << ", true error " << quickError << std::endl;
+    ok = ok && quick.interrupted && !quick.converged && elapsed < 0.25
+            && std::isfinite(quick.errorEstimate) && quick.errorEstimate >= 0.1 * quickError
+            && quick.errorEstimate <= 1e3 * quickError;
+
+    // Without a limit the control changes nothing
+    MatrixSolver::IterativeResult plain = solver.solvePreconditionedCG(apply, f, M, Eigen::VectorXd(), 5000, 1e-10);
+    MatrixSolver::SolveControl unlimited;
+    int reports = 0;
+    unlimited.progress = [&](const MatrixSolver::IterativeResult&) { ++reports; };
+    MatrixSolver::IterativeResult controlled = solver.solvePreconditionedCG(apply, f, M, Eigen::VectorXd(), 5000,
+                                                                            1e-10, unlimited);
+    double plainError = trueError(plain.x);
+    std::cout << "PCG to 1e-10: " << plain.iterations << " iterations, estimated error " << plain.errorEstimate
+              << ", true error " << plainError << ", " << reports << " progress reports" << std::endl;
+    ok = ok && plain.converged && controlled.converged && !controlled.interrupted
+            && controlled.iterations == plain.iterations && (controlled.x - plain.x).norm() <= 1e-12 * plain.x.norm()
+            && reports >= 1 && plain.errorEstimate >= 0.1 * plainError;
+
+    // ========== Multigrid under a budget ==========
+    Multigrid mg;
+    mg.build(K, n - 2, n - 2);
+    MatrixSolver::SolveControl mgControl;
+    mgControl.deadline = Deadline::after(0.02);
+    t0 = std::chrono::steady_clock::now();
+    MatrixSolver::IterativeResult mgQuick = mg.solve(f, Eigen::VectorXd(), 1e-12, 200, mgControl);
+    elapsed = seconds(t0);
+    MatrixSolver::IterativeResult mgFull = mg.solve(f, Eigen::VectorXd(), 1e-12, 200);
+    std::cout << "\nMultigrid, 20 ms budget: " << std::fixed << elapsed * 1e3 << " ms, " << mgQuick.iterations
+              << " cycles, estimated error " << std::scientific << mgQuick.errorEstimate << ", true error "
+              << trueError(mgQuick.x) << std::endl;
+    std::cout << "Multigrid to 1e-12: " << mgFull.iterations << " cycles, estimated error " << mgFull.errorEstimate
+              << ", true error " << trueError(mgFull.x) << std::endl;
+    ok = ok && elapsed < 0.25 && std::isfinite(mgQuick.errorEstimate) && mgFull.converged
+            && mgFull.errorEstimate < 1e-8 && trueError(mgFull.x) < 1e-8
+            && (mgQuick.converged || mgQuick.interrupted);
+
+    // ========== Best effort now, exact answer later ==========
+    t0 = std::chrono::steady_clock::now();
+    BackgroundSolve background([&](const MatrixSolver::SolveControl& control) {
+        return solver.solvePreconditionedCG(apply, f, M, Eigen::VectorXd(), 100000, 1e-10, control);
+    });
+    MatrixSolver::IterativeResult early = background.waitUntil(Deadline::after(0.05));
+    double earlyTime = seconds(t0);
+    MatrixSolver::IterativeResult final = background.wait();
+    double finalTime = seconds(t0);
+    std::cout << "\nBackground PCG: answer after " << std::fixed << earlyTime * 1e3 << " ms (" << early.iterations
+              << " iterations, true error " << std::scientific << trueError(early.x) << "), converged after "
+              << std::fixed << finalTime * 1e3 << " ms (" << final.iterations << " iterations, true error "
+              << std::scientific << trueError(final.x) << ")" << std::endl;
+    ok = ok && early.interrupted && early.x.size() == f.size() && earlyTime < 0.25
+            && final.converged && !final.interrupted && trueError(final.x) < 1e-6;
+
+    // ========== Cancellation ==========
+    BackgroundSolve cancelled([&](const MatrixSolver::SolveControl& control) {
+        return solver.solvePreconditionedCG(apply, f, M, Eigen::VectorXd(), 1000000, 1e-15, control);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    t0 = std::chrono::steady_clock::now();
+    cancelled.cancel();
+    MatrixSolver::IterativeResult stopped = cancelled.wait();
+    double stopTime = seconds(t0);
+    std::cout << "Cancelled PCG stopped " << std::fixed << stopTime * 1e3 << " ms after cancel() with "
+              << stopped.iterations << " iterations" << std::endl;
+    ok = ok && stopped.interrupted && stopTime < 0.1 && cancelled.finished();
+
+    // ========== Eigen-CG path and GMRES ==========
+    MatrixSolver::SolveControl cgControl;
+    cgControl.deadline = Deadline::after(0.02);
+    t0 = std::chrono::steady_clock::now();
+    MatrixSolver::IterativeResult sparseQuick = solver.solveSparseCG(K, f, 100000, 1e-14, cgControl);
+    elapsed = seconds(t0);
+    std::atomic<bool> cancelFlag{true};
+    MatrixSolver::SolveControl cancelledControl;
+    cancelledControl.cancel = &cancelFlag;
+    MatrixSolver::IterativeResult sparseCancelled = solver.solveSparseCG(K, f, 100000, 1e-14, cancelledControl);
+    std::cout << "\nSparse CG, 20 ms budget: " << std::fixed << elapsed * 1e3 << " ms, " << sparseQuick.iterations
+              << " iterations, true error " << std::scientific << trueError(sparseQuick.x) << std::endl;
+    ok = ok && sparseQuick.interrupted && elapsed < 0.25 && trueError(sparseQuick.x) < 1.0
+            && sparseCancelled.interrupted && sparseCancelled.iterations == 0;
+
+    // Nonsymmetric convection-diffusion: a smaller grid plus an upwind drift along x
+    const int gn = 101;
+    std::vector<double> gRho(static_cast<size_t>(gn - 2) * (gn - 2), 1e-9);
+    std::vector<double> gBoundary(static_cast<size_t>(gn) * gn, 0.0);
+    for (int j = 0; j < gn; ++j) {
+        gBoundary[solver.coordToIndex(0, j, gn)] = 10.0;
+    }
+    MatrixSolver::SparseMatrix G;
+    Eigen::VectorXd g;
+    solver.buildReducedFDMSystem(gn, gn, h, h, gRho, 8.854e-12, G, g, gBoundary);
+    const double drift = 0.5 * G.coeff(0, 0);
+    std::vector<Eigen::Triplet<double>> upwind;
+    for (int j = 0; j < gn - 2; ++j) {
+        for (int i = 0; i < gn - 2; ++i) {
+            int k = i + j * (gn - 2);
+            upwind.emplace_back(k, k, drift);
+            if (i > 0) {
+                upwind.emplace_back(k, k - 1, -drift);
+            }
+        }
+    }
+    MatrixSolver::SparseMatrix U(G.rows(), G.cols());
+    U.setFromTriplets(upwind.begin(), upwind.end());
+    G += U;
+    auto applyG = [&](const Eigen::VectorXd& x) { return Eigen::VectorXd(G * x); };
+    Eigen::VectorXd gInverseDiagonal = G.diagonal().cwiseInverse();
+    auto jacobiG = [&](const Eigen::VectorXd& r) { return Eigen::VectorXd(gInverseDiagonal.cwiseProduct(r)); };
+    auto residualG = [&](const Eigen::VectorXd& x) { return (g - G * x).norm() / g.norm(); };
+
+    MatrixSolver::SolveControl gmresControl;
+    gmresControl.deadline = Deadline::after(0.02);
+    t0 = std::chrono::steady_clock::now();
+    MatrixSolver::IterativeResult gmresQuick = solver.solveGMRES(applyG, g, jacobiG, Eigen::VectorXd(), 30, 1000000,
+                                                                 1e-14, gmresControl);
+    elapsed = seconds(t0);
+    MatrixSolver::IterativeResult gmresFull = solver.solveGMRES(applyG, g, jacobiG, Eigen::VectorXd(), 30, 100000,
+                                                                1e-8);
+    std::cout << "GMRES(30), convection-diffusion " << g.size() << " unknowns, 20 ms budget: " << std::fixed
+              << elapsed * 1e3 << " ms, " << gmresQuick.iterations << " iterations, residual " << std::scientific
+              << gmresQuick.relativeResidual << " (recomputed " << residualG(gmresQuick.x) << ")" << std::endl;
+    std::cout << "GMRES(30) to 1e-8: " << gmresFull.iterations << " iterations, residual "
+              << residualG(gmresFull.x) << std::endl;
+    ok = ok && gmresQuick.interrupted && !gmresQuick.converged && elapsed < 0.25
+            && std::abs(residualG(gmresQuick.x) - gmresQuick.relativeResidual) <= 1e-6 * gmresQuick.relativeResidual
+            && gmresFull.converged && !gmresFull.interrupted && residualG(gmresFull.x) <= 1.01e-8;
+
+    std::cout << "\n=== " << (ok ? "Deadline solve checks passed" : "Deadline solve checks FAILED") << " ===" << std::endl;
+    return ok ? 0 : 1;
+}
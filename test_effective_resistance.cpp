@@ -0,0 +1,184 @@
+#include "EffectiveResistance.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <stdexcept>
+
+namespace {
+
+double seconds(const std::chrono::steady_clock::time_point& t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+/**
+ * nx x ny mesh of random resistors, node ID i + j*nx
+ */
+ResistiveNetwork mesh(int nx, int ny, std::mt19937_64& rng) {
+    std::uniform_real_distribution<double> ohms(1.0, 10.0);
+    ResistiveNetwork network;
+    network.reserve(static_cast<size_t>(nx) * ny, 2 * static_cast<size_t>(nx) * ny);
+    for (int j = 0; j < ny; ++j) {
+        for (int i = 0; i < nx; ++i) {
+            network.addNode(i + j * nx);
+            if (i > 0) {
+                network.addEdge(i + j * nx, i - 1 + j * nx, ohms(rng));
+            }
+            if (j > 0) {
+                network.addEdge(i + j * nx, i + (j - 1) * nx, ohms(rng));
+            }
+        }
+    }
+    return network;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Effective Resistance - Batched Exact and Sketched Queries Example ===" << std::endl;
+    std::cout << "Problem: Resistance between many node pairs through the whole network\n" << std::endl;
+
+    bool ok = true;
+
+    // ========== Ring: R(d) = r d (n - d) / n ==========
+    const int ringSize = 100;
+    ResistiveNetwork ring;
+    for (int k = 0; k < ringSize; ++k) {
+        ring.addEdge(k, (k + 1) % ringSize, 2.0);
+    }
+    EffectiveResistance ringResistance(ring);
+    double ringError = 0.0;
+    for (int d : {1, 10, 37, 50}) {
+        double expected = 2.0 * d * (ringSize - d) / ringSize;
+        ringError = std::max(ringError, std::abs(ringResistance.resistance(5, (5 + d) % ringSize) - expected));
+    }
+    std::cout << "Ring of " << ringSize << " x 2 ohm, R(d) = 2 d (n-d)/n: max error " << std::scientific
+              << std::setprecision(2) << ringError << " ohm" << std::endl;
+    ok = ok && ringError < 1e-10;
+
+    // ========== GraphTesting.py network: all pairs vs. the pseudo-inverse ==========
+    const int edges[][3] = {
+        {1, 2, 10}, {2, 3, 20}, {3, 4, 30}, {4, 1, 40}, {1, 3, 50}, {2, 5, 15}, {5, 6, 25}, {6, 3, 35},
+        {5, 7, 10}, {7, 8, 20}, {8, 9, 30}, {9, 10, 40}, {4, 6, 45}, {2, 8, 22}, {7, 10, 18}, {1, 9, 55},
+        {3, 7, 33}, {6, 10, 27}, {11, 12, 12}, {12, 13, 13}, {13, 14, 14}, {12, 15, 15}, {13, 15, 16},
+        {14, 15, 17}, {13, 16, 18}, {14, 16, 19}, {15, 16, 20}, {14, 7, 21}, {16, 10, 22}};
+    ResistiveNetwork example;
+    for (const auto& edge : edges) {
+        example.addEdge(edge[0], edge[1], edge[2]);
+    }
+    example.addNode(99);    // Isolated
+    Eigen::MatrixXd Lplus = Eigen::MatrixXd(example.laplacian()).topLeftCorner(16, 16)
+                                .completeOrthogonalDecomposition().pseudoInverse();
+    std::vector<EffectiveResistance::NodePair> allPairs;
+    for (int u = 1; u <= 16; ++u) {
+        for (int v = u + 1; v <= 16; ++v) {
+            allPairs.push_back({u, v});
+        }
+    }
+    EffectiveResistance exampleResistance(example);
+    std::vector<double> exact = exampleResistance.resistances(allPairs);
+    double pinvError = 0.0;
+    for (size_t k = 0; k < allPairs.size(); ++k) {
+        int a = example.index(allPairs[k].first);
+        int b = example.index(allPairs[k].second);
+        pinvError = std::max(pinvError, std::abs(exact[k] - (Lplus(a, a) + Lplus(b, b) - 2.0 * Lplus(a, b))));
+    }
+    double r14 = exampleResistance.resistance(1, 4);
+    std::cout << std::fixed << std::setprecision(4) << "GraphTesting network: R(1,4) = " << r14
+              << " ohm (direct 40 ohm resistor, shortest path 40 ohm); " << allPairs.size()
+              << " pairs vs. pseudo-inverse: max error " << std::scientific << std::setprecision(2) << pinvError
+              << std::endl;
+    ok = ok && pinvError < 1e-10 && r14 < 40.0 && std::isinf(exampleResistance.resistance(1, 99))
+            && exampleResistance.resistance(7, 7) == 0.0;
+
+    // ========== Thousands of pairs on a 40k-node mesh ==========
+    std::mt19937_64 rng(93);
+    const int side = 200;
+    ResistiveNetwork network = mesh(side, side, rng);
+    EffectiveResistance engine(network);
+    std::uniform_int_distribution<int> anyNode(0, side * side - 1);
+    std::vector<EffectiveResistance::NodePair> pairs;
+    for (int k = 0; k < 1000; ++k) {
+        pairs.push_back({anyNode(rng), anyNode(rng)});
+    }
+    engine.resistance(0, 1);   // Factorize once
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<double> batched = engine.resistances(pairs);
+    double tBatched = seconds(t0);
+
+    const int single = 100;
+    t0 = std::chrono::steady_clock::now();
+    double singleError = 0.0;
+    for (int k = 0; k < single; ++k) {
+        double r = engine.resistance(pairs[k].first, pairs[k].second);
+        singleError = std::max(singleError, std::abs(r - batched[k]) / batched[k]);
+    }
+    double tSingle = seconds(t0) / single * pairs.size();
+
+    // Pairs among few nodes: solves per distinct node
+    std::vector<EffectiveResistance::NodePair> hubPairs;
+    for (int a = 0; a < 40; ++a) {
+        for (int b = a + 1; b < 40; ++b) {
+            hubPairs.push_back({a * 997, b * 997});
+        }
+    }
+    t0 = std::chrono::steady_clock::now();
+    std::vector<double> hub = engine.resistances(hubPairs);
+    double tHub = seconds(t0);
+    double hubError = std::abs(hub[123] - engine.resistance(hubPairs[123].first, hubPairs[123].second)) / hub[123];
+
+    std::cout << "\n" << side << "x" << side << " mesh, " << pairs.size() << " random pairs: batched "
+              << std::fixed << std::setprecision(3) << tBatched << " s, one at a time ~" << tSingle << " s ("
+              << std::setprecision(1) << tSingle / tBatched << "x)" << std::endl;
+    std::cout << "  " << hubPairs.size() << " pairs among 40 nodes: " << std::setprecision(3) << tHub
+              << " s (40 solves); batch vs. single relative error " << std::scientific << std::setprecision(2)
+              << std::max(singleError, hubError) << std::endl;
+    ok = ok && singleError < 1e-10 && hubError < 1e-10 && tBatched < tSingle;
+
+    // ========== Johnson-Lindenstrauss sketch ==========
+    ResistanceSketchOptions sketchOptions;
+    sketchOptions.dimension = 200;
+    t0 = std::chrono::steady_clock::now();
+    engine.buildSketch(sketchOptions);
+    double tSketch = seconds(t0);
+    t0 = std::chrono::steady_clock::now();
+    double sumError = 0.0;
+    double maxError = 0.0;
+    for (size_t k = 0; k < pairs.size(); ++k) {
+        if (batched[k] == 0.0) {
+            continue;
+        }
+        double error = std::abs(engine.approximate(pairs[k].first, pairs[k].second) / batched[k] - 1.0);
+        sumError += error;
+        maxError = std::max(maxError, error);
+    }
+    double tQuery = seconds(t0) / pairs.size();
+    std::cout << "JL sketch, k = " << engine.sketchDimension() << ": built in " << std::fixed << std::setprecision(2)
+              << tSketch << " s, " << std::setprecision(2) << tQuery * 1e6 << " us per query; relative error mean "
+              << std::setprecision(3) << sumError / pairs.size() << ", max " << maxError << std::endl;
+    ok = ok && sumError / pairs.size() < 0.12 && maxError < 0.5 && tQuery < tBatched / pairs.size();
+
+    // An edge change makes the sketch stale until it is rebuilt
+    size_t probe = 0;
+    while (batched[probe] == 0.0) {
+        ++probe;
+    }
+    engine.setResistance(0, 2.0);
+    bool stale = false;
+    try {
+        engine.approximate(pairs[probe].first, pairs[probe].second);
+    } catch (const std::logic_error&) {
+        stale = true;
+    }
+    engine.buildSketch(sketchOptions);
+    double updated = engine.resistance(pairs[probe].first, pairs[probe].second);
+    double rebuilt = engine.approximate(pairs[probe].first, pairs[probe].second);
+    std::cout << "After setResistance: stale sketch refused " << (stale ? "yes" : "no") << ", rebuilt error "
+              << std::abs(rebuilt / updated - 1.0) << std::endl;
+    ok = ok && stale && std::abs(rebuilt / updated - 1.0) < 0.5;
+
+    std::cout << "\n=== " << (ok ? "Effective resistance checks passed" : "Effective resistance checks FAILED") << " ===" << std::endl;
+    return ok ? 0 : 1;
+}
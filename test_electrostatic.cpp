@@ -1,8 +1,31 @@
 #include "ElectrostaticSolver.h"
+#include "FrameStream.h"
+#include "ParameterSweep.h"
+#include <cstdlib>
 #include <iostream>
 #include <iomanip>
+#include <memory>
+#include <string>
 
-int main() {
+namespace {
+
+void printUsage() {
+    std::cout << "Usage:\n"
+              << "  test_electrostatic [--nx N] [--ny N] [--spacing H] [--voltage V]\n"
+              << "                     [--charge LAYOUT] [--epsilon-r E] [--no-export]\n"
+              << "  test_electrostatic --sweep FILE [--results FILE] [--threads N]\n"
+              << "                     [--max-points N] [--verbose] [--publish NAME]\n\n"
+              << "Without arguments the 25x25 parallel plate capacitor example is solved.\n"
+              << "Sweep files and charge layouts are described in ParameterSweep.h; an\n"
+              << "interrupted sweep resumes from the results file (default: sweep_results.csv).\n"
+              << "--publish streams every computed point into the shared-memory ring NAME\n"
+              << "(e.g. /electrostatics_frames) for visualize_electrostatic.py --live.\n";
+}
+
+/**
+ * Single parallel plate problem solved with dense LU, printed and exported to CSV
+ */
+int runExample(const SweepPoint& point, bool exportCsv) {
     std::cout << "=== Electrostatic Solver - FDM Example ===" << std::endl;
     std::cout << "Problem: Parallel Plate Capacitor\n" << std::endl;
 
@@ -10,14 +33,15 @@ int main() {
 
     // ========== Problem Setup ==========
     // Grid dimensions
-    int nx = 25;  // points in x: 0 to 2.0 m
-    int ny = 25;  // points in y: 0 to 2.0 m
-    double dx = 0.1;  // 0.1 m spacing
-    double dy = 0.1;  // 0.1 m spacing
+    int nx = point.nx;
+    int ny = point.ny;
+    double dx = point.spacing;
+    double dy = point.spacing;
+    double voltage = point.voltage;
 
     // Physical constants
     const double epsilon_0 = 8.854e-12;  // F/m (vacuum permittivity)
-    double epsilon = epsilon_0;
+    double epsilon = point.epsilonR * epsilon_0;
 
     std::cout << "Grid Configuration:" << std::endl;
     std::cout << "  Grid points: " << nx << " x " << ny << std::endl;
@@ -32,10 +56,10 @@ int main() {
     int n_total = nx * ny;
     std::vector<double> boundaryValues(n_total, 0.0);
 
-    // Set left plate to +100V (x=0, all y)
+    // Set left plate to the plate voltage (x=0, all y)
     for (int j = 0; j < ny; ++j) {
         int idx = solver.coordToIndex(0, j, nx);
-        boundaryValues[idx] = 100.0;
+        boundaryValues[idx] = voltage;
     }
 
     // Set right plate to 0V (x=nx-1, all y)
@@ -48,15 +72,19 @@ int main() {
     // (This implements approximate Neumann condition via FDM)
 
     std::cout << "Boundary Conditions (Parallel Plate Capacitor):" << std::endl;
-    std::cout << "  Left plate (x=0): V = 100 V (entire edge)" << std::endl;
+    std::cout << "  Left plate (x=0): V = " << voltage << " V (entire edge)" << std::endl;
     std::cout << "  Right plate (x=" << (nx-1)*dx << "): V = 0 V (entire edge)" << std::endl;
     std::cout << "  Top/Bottom edges: Free (Neumann boundary condition)\n" << std::endl;
 
     // ========== Charge Distribution ==========
-    // For parallel plate capacitor in free space, no charge density
-    std::vector<double> rho((nx - 2) * (ny - 2), 0.0);
+    // Free space by default; other layouts are described in ParameterSweep.h
+    std::vector<double> rho = ParameterSweep::chargeDensity(point.charge, nx, ny, dx);
 
-    std::cout << "Charge Distribution: None (free space problem)\n" << std::endl;
+    if (point.charge == "none") {
+        std::cout << "Charge Distribution: None (free space problem)\n" << std::endl;
+    } else {
+        std::cout << "Charge Distribution: " << point.charge << "\n" << std::endl;
+    }
 
     // ========== Build and Solve System ==========
     std::cout << "Building FDM system..." << std::endl;
@@ -71,7 +99,10 @@ int main() {
     Eigen::VectorXd phi = solver.solveLU(A, b);
 
     // ========== Extract and Display Results ==========
-    Eigen::MatrixXd phi_field = solver.solvePotential(nx, ny, phi);
+    // Derived fields are evaluated lazily: the probes below only touch the
+    // points they print, full grids are computed once for statistics/export
+    FieldResult result = solver.makeFieldResult(nx, ny, phi, dx, dy, epsilon);
+    const Eigen::MatrixXd& phi_field = result.potential();
 
     std::cout << "Potential Field φ (selected points):" << std::endl;
     std::cout << std::fixed << std::setprecision(2);
@@ -83,30 +114,48 @@ int main() {
         std::cout << "  x = " << std::setw(4) << i * dx << " m: φ = " << std::setw(7) << phi_field(j_middle, i) << " V" << std::endl;
     }
 
+    // Probe points along the middle row
+    std::vector<std::pair<int, int>> probes;
+    for (int i = 1; i < nx - 1; i += 4) {
+        probes.push_back({i, j_middle});
+    }
+
     // ========== Compute Electric Field ==========
     std::cout << "\nComputing electric field E = -∇φ..." << std::endl;
-    Eigen::MatrixXd Ex, Ey;
-    solver.computeElectricField(phi_field, dx, dy, Ex, Ey);
-
-    Eigen::MatrixXd E_mag = solver.computeFieldMagnitude(Ex, Ey);
+    std::vector<double> E_probe = result.atPoints(FieldResult::Component::Magnitude, probes);
 
     std::cout << "\nElectric Field Magnitude |E| (selected points):" << std::endl;
     std::cout << "\nField magnitude along y = " << j_middle * dy << " m:" << std::endl;
-    for (int i = 1; i < nx - 1; i += 4) {
-        std::cout << "  x = " << std::setw(4) << i * dx << " m: |E| = " << std::setw(10) << E_mag(j_middle, i) << " V/m" << std::endl;
+    for (size_t k = 0; k < probes.size(); ++k) {
+        std::cout << "  x = " << std::setw(4) << probes[k].first * dx << " m: |E| = " << std::setw(10) << E_probe[k] << " V/m" << std::endl;
     }
 
     // ========== Compute Energy Density ==========
     std::cout << "\nComputing energy density u = (1/2)εE²..." << std::endl;
-    Eigen::MatrixXd u = solver.computeEnergyDensity(Ex, Ey, epsilon);
+    std::vector<double> u_probe = result.atPoints(FieldResult::Component::EnergyDensity, probes);
 
     std::cout << "\nEnergy Density (selected points):" << std::endl;
     std::cout << "\nEnergy density along y = " << j_middle * dy << " m:" << std::endl;
-    for (int i = 1; i < nx - 1; i += 4) {
-        std::cout << "  x = " << std::setw(4) << i * dx << " m: u = " << std::setw(10) << std::scientific << u(j_middle, i) << " J/m³" << std::endl;
+    for (size_t k = 0; k < probes.size(); ++k) {
+        std::cout << "  x = " << std::setw(4) << probes[k].first * dx << " m: u = " << std::setw(10) << std::scientific << u_probe[k] << " J/m³" << std::endl;
     }
+    std::cout << "\nGrid-point evaluations for probes: " << result.evaluationCount()
+              << " (full grid: " << nx * ny << ")" << std::endl;
 
     // ========== Summary Statistics ==========
+    const Eigen::MatrixXd& Ex = result.Ex();
+    const Eigen::MatrixXd& Ey = result.Ey();
+    const Eigen::MatrixXd& E_mag = result.fieldMagnitude();
+    const Eigen::MatrixXd& u = result.energyDensity();
+
+    // Each full grid counts its interior once, |E| and u included
+    long long expectedEvaluations = 2LL * static_cast<long long>(probes.size()) + 4LL * (nx - 2) * (ny - 2);
+    if (result.evaluationCount() != expectedEvaluations) {
+        std::cerr << "Unexpected evaluation count " << result.evaluationCount() << " (expected "
+                  << expectedEvaluations << ")" << std::endl;
+        return 1;
+    }
+
     std::cout << std::fixed << std::setprecision(6);
     std::cout << "\n--- Summary Statistics ---" << std::endl;
     std::cout << "Potential:" << std::endl;
@@ -119,16 +168,21 @@ int main() {
     std::cout << "  Mean: " << E_mag.mean() << " V/m" << std::endl;
 
     std::cout << "\nTotal Energy Density:" << std::endl;
-    double total_energy = u.sum() * dx * dy;
+    double total_energy = result.integral(FieldResult::Component::EnergyDensity);
     std::cout << "  Total (approx): " << std::scientific << total_energy << " J" << std::endl;
 
     std::cout << "\n=== Simulation Complete ===" << std::endl;
     std::cout << "\nPhysical Insight:" << std::endl;
     std::cout << "- The electric field between the plates is approximately uniform" << std::endl;
-    std::cout << "- Field strength ≈ ΔV / d = 100V / 2.0m = 50 V/m" << std::endl;
+    std::cout << std::defaultfloat;
+    std::cout << "- Field strength ≈ ΔV / d = " << voltage << "V / " << (nx-1)*dx << "m = "
+              << voltage / ((nx-1)*dx) << " V/m" << std::endl;
     std::cout << "- The potential varies linearly in the gap (ideal capacitor behavior)" << std::endl;
 
     // ========== Export Results to CSV ==========
+    if (!exportCsv) {
+        return 0;
+    }
     std::cout << "\n--- Exporting results to CSV files ---\n" << std::endl;
     
     solver.exportToCSV("potential.csv", phi_field);
@@ -141,3 +195,105 @@ int main() {
 
     return 0;
 }
+
+/**
+ * Parallel, resumable sweep; results are appended to the results file
+ */
+int runSweep(const std::string& sweepFile, const std::string& resultsFile, int threads, long maxPoints, bool verbose,
+             const std::string& publishName) {
+    std::cout << "=== Electrostatic Solver - Parameter Sweep ===" << std::endl;
+
+    SweepDefinition definition = SweepDefinition::fromFile(sweepFile);
+    ResultsLog log(resultsFile);
+
+    std::cout << "Sweep definition: " << sweepFile << " (" << definition.points().size() << " points)" << std::endl;
+    std::cout << "Results file:     " << resultsFile << " (" << log.size() << " completed runs)" << std::endl;
+
+    std::unique_ptr<FramePublisher> publisher;
+    if (!publishName.empty()) {
+        FramePublisherOptions options;
+        options.name = publishName;
+        publisher = std::make_unique<FramePublisher>(options);
+        std::cout << "Frame ring:       " << publishName << std::endl;
+    }
+
+    SweepSummary summary = ParameterSweep::run(definition, log, threads, maxPoints, verbose, publisher.get());
+
+    std::cout << "\nPoints:   " << summary.total << std::endl;
+    std::cout << "Skipped:  " << summary.skipped << " (already in results file)" << std::endl;
+    std::cout << "Computed: " << summary.computed << std::endl;
+    std::cout << "Failed:   " << summary.failed << std::endl;
+    std::cout << "Time:     " << std::fixed << std::setprecision(2) << summary.seconds << " s" << std::endl;
+
+    return summary.failed == 0 ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    SweepPoint point;   // Defaults: 25x25, 0.1 m, 100 V, no charge, vacuum
+    bool exportCsv = true;
+    std::string sweepFile;
+    std::string resultsFile = "sweep_results.csv";
+    int threads = 0;
+    long maxPoints = -1;
+    bool verbose = false;
+    std::string publishName;
+
+    try {
+        for (int k = 1; k < argc; ++k) {
+            std::string arg = argv[k];
+            auto value = [&]() -> std::string {
+                if (k + 1 >= argc) {
+                    throw std::invalid_argument("Missing value for " + arg);
+                }
+                return argv[++k];
+            };
+
+            if (arg == "--help" || arg == "-h") {
+                printUsage();
+                return 0;
+            } else if (arg == "--nx") {
+                point.nx = std::stoi(value());
+            } else if (arg == "--ny") {
+                point.ny = std::stoi(value());
+            } else if (arg == "--spacing") {
+                point.spacing = std::stod(value());
+            } else if (arg == "--voltage") {
+                point.voltage = std::stod(value());
+            } else if (arg == "--charge") {
+                point.charge = value();
+            } else if (arg == "--epsilon-r") {
+                point.epsilonR = std::stod(value());
+            } else if (arg == "--no-export") {
+                exportCsv = false;
+            } else if (arg == "--sweep") {
+                sweepFile = value();
+            } else if (arg == "--results") {
+                resultsFile = value();
+            } else if (arg == "--threads") {
+                threads = std::stoi(value());
+            } else if (arg == "--max-points") {
+                maxPoints = std::stol(value());
+            } else if (arg == "--verbose") {
+                verbose = true;
+            } else if (arg == "--publish") {
+                publishName = value();
+            } else {
+                throw std::invalid_argument("Unknown argument: " + arg);
+            }
+        }
+
+        if (!sweepFile.empty()) {
+            return runSweep(sweepFile, resultsFile, threads, maxPoints, verbose, publishName);
+        }
+        if (point.nx < 3 || point.ny < 3 || point.spacing <= 0.0 || point.epsilonR <= 0.0) {
+            throw std::invalid_argument("Grid needs at least 3x3 points and positive spacing/permittivity");
+        }
+        return runExample(point, exportCsv);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n" << std::endl;
+        printUsage();
+        return 1;
+    }
+}
@@ -0,0 +1,175 @@
+#include "ElectrostaticSolver.h"
+#include "FactorizationCache.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Factorization Cache - Cold vs Warm Start ===" << std::endl;
+
+    ElectrostaticSolver solver;
+
+    // ========== Problem Setup ==========
+    int nx = 25;
+    int ny = 25;
+    double dx = 0.1;
+    double dy = 0.1;
+    double epsilon = 8.854e-12;
+
+    std::vector<double> boundaryValues(nx * ny, 0.0);
+    for (int j = 0; j < ny; ++j) {
+        boundaryValues[solver.coordToIndex(0, j, nx)] = 100.0;
+    }
+    std::vector<double> rho((nx - 2) * (ny - 2), 0.0);
+
+    Eigen::MatrixXd A;
+    Eigen::VectorXd b;
+    solver.buildFDMSystem(nx, ny, dx, dy, rho, epsilon, A, b, boundaryValues);
+
+    MatrixSolver::SparseMatrix K;
+    Eigen::VectorXd f;
+    solver.buildReducedFDMSystem(nx, ny, dx, dy, rho, epsilon, K, f, boundaryValues);
+
+    std::uint64_t key = solver.geometryHash(nx, ny, dx, dy);
+    std::cout << "Geometry hash: 0x" << std::hex << key << std::dec << std::endl;
+
+    // ========== Reduced SPD System vs Dense FDM System ==========
+    std::cout << "\n--- Reduced SPD system vs dense FDM system ---\n";
+    Eigen::VectorXd phi_dense = solver.solveLU(A, b);
+    SparseCholeskyFactor ldlt = SparseCholeskyFactor::compute(K);
+    Eigen::VectorXd phi_reduced = solver.expandReducedSolution(nx, ny, ldlt.solve(f), boundaryValues);
+    double diff = (phi_dense - phi_reduced).norm();
+    std::cout << "Reduced system size: " << K.rows() << " (nnz = " << K.nonZeros() << ")" << std::endl;
+    std::cout << "Solution difference (dense LU vs sparse LDLT): " << diff << std::endl;
+
+    // ========== Cold Start: Factorize and Store ==========
+    std::cout << "\n--- Cold start: factorize and store ---\n";
+    FactorizationCache cache("factor_cache");
+    cache.remove(key);
+
+    auto start = std::chrono::steady_clock::now();
+    FactorizationBundle bundle;
+    bundle.add("fdm/denseLU", DenseLUFactor::compute(A));
+    bundle.add("reduced/ldlt", SparseCholeskyFactor::compute(K));
+    bundle.add("reduced/jacobi", DiagonalPreconditioner::compute(K));
+    bundle.add("reduced/K", K);
+    double factorMs = elapsedMs(start);
+
+    start = std::chrono::steady_clock::now();
+    cache.store(key, bundle);
+    double storeMs = elapsedMs(start);
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Factorization time: " << factorMs << " ms" << std::endl;
+    std::cout << "Store time:         " << storeMs << " ms" << std::endl;
+    std::cout << "Cache file:         " << cache.pathFor(key) << std::endl;
+
+    // ========== Warm Start: Map and Solve ==========
+    std::cout << "\n--- Warm start: memory-map and solve ---\n";
+    start = std::chrono::steady_clock::now();
+    FactorizationBundle warm;
+    bool hit = cache.load(key, warm);
+    double loadMs = elapsedMs(start);
+
+    std::cout << "Cache hit: " << (hit ? "yes" : "no") << " (" << warm.size() << " objects)" << std::endl;
+    std::cout << "Load time: " << loadMs << " ms" << std::endl;
+
+    if (!hit) {
+        std::cerr << "Error: cache file was not loaded" << std::endl;
+        return 1;
+    }
+
+    Eigen::VectorXd phi_warm_lu = warm.denseLU("fdm/denseLU")->solve(b);
+    Eigen::VectorXd phi_warm_ldlt = solver.expandReducedSolution(
+        nx, ny, warm.sparseCholesky("reduced/ldlt")->solve(f), boundaryValues);
+    Eigen::VectorXd residual = warm.matrix("reduced/K") * warm.sparseCholesky("reduced/ldlt")->solve(f) - f;
+
+    std::cout << std::scientific;
+    std::cout << "Difference (mapped LU vs fresh LU):     " << (phi_warm_lu - phi_dense).norm() << std::endl;
+    std::cout << "Difference (mapped LDLT vs fresh LU):   " << (phi_warm_ldlt - phi_dense).norm() << std::endl;
+    std::cout << "Residual with mapped operator and LDLT: " << residual.norm() << std::endl;
+
+    // A different geometry must miss
+    FactorizationBundle other;
+    bool otherHit = cache.load(solver.geometryHash(nx, ny, dx, 2.0 * dy), other);
+    std::cout << "Different geometry hit: " << (otherHit ? "yes" : "no") << std::endl;
+
+    // ========== Corrupt Files Miss ==========
+    // A file holding only the LDLT factor: header (64 bytes) and one section
+    // entry (112 bytes), then outer, inner, values, diag and perm, each 64-byte aligned
+    FactorizationBundle single;
+    single.add("reduced/ldlt", *warm.sparseCholesky("reduced/ldlt"));
+    const std::string corruptPath = cache.pathFor(key) + ".corrupt";
+    const std::streamoff n = K.rows();
+    const std::streamoff outerAt = 192;
+    const std::streamoff innerAt = (outerAt + 4 * (n + 1) + 63) / 64 * 64;
+    auto rejects = [&](std::streamoff offset, std::int32_t value) {
+        FactorizationCache::writeFile(corruptPath, key, single);
+        {
+            std::fstream file(corruptPath, std::ios::in | std::ios::out | std::ios::binary);
+            file.seekp(offset, offset < 0 ? std::ios::end : std::ios::beg);
+            file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+        FactorizationBundle loaded;
+        return !FactorizationCache::readFile(corruptPath, key, loaded) && loaded.size() == 0;
+    };
+    std::int32_t lastPerm = 0;
+    {
+        FactorizationCache::writeFile(corruptPath, key, single);
+        std::ifstream file(corruptPath, std::ios::binary);
+        file.seekg(-8, std::ios::end);
+        file.read(reinterpret_cast<char*>(&lastPerm), sizeof(lastPerm));   // perm[n - 2]
+    }
+    FactorizationBundle intact;
+    bool intactHit = FactorizationCache::readFile(corruptPath, key, intact);
+    bool corruptMiss = rejects(outerAt + 4, std::numeric_limits<std::int32_t>::max()) &&   // outer not monotone
+                       rejects(innerAt, static_cast<std::int32_t>(n)) &&                    // inner out of range
+                       rejects(-4, -1) &&                                                   // perm out of range
+                       rejects(-4, lastPerm);                                               // perm repeats
+    std::remove(corruptPath.c_str());
+    std::cout << "Corrupt outer/inner/perm arrays rejected: " << (intactHit && corruptMiss ? "yes" : "no")
+              << std::endl;
+
+    // ========== Concurrent Updates Keep Every Entry ==========
+    // Each thread merges its own object under one key; without the per-key
+    // lock, updaters overwrite each other's merged files
+    const std::uint64_t sharedKey = key ^ 0x5a5a5a5aull;
+    cache.remove(sharedKey);
+    const int updaters = 8;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < updaters; ++t) {
+        threads.emplace_back([&, t] {
+            FactorizationBundle additions;
+            additions.add("jacobi/" + std::to_string(t), *warm.diagonal("reduced/jacobi"));
+            cache.update(sharedKey, additions);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    FactorizationBundle merged;
+    bool mergedAll = cache.load(sharedKey, merged) && merged.size() == static_cast<size_t>(updaters);
+    cache.remove(sharedKey);
+    std::cout << "Concurrent updates kept all " << updaters << " entries: " << (mergedAll ? "yes" : "no")
+              << std::endl;
+
+    bool ok = hit && !otherHit && diff < 1e-8 && (phi_warm_lu - phi_dense).norm() < 1e-10 &&
+              (phi_warm_ldlt - phi_dense).norm() < 1e-8 && intactHit && corruptMiss && mergedAll;
+    std::cout << "\n=== " << (ok ? "All cache checks passed" : "Cache checks FAILED") << " ===" << std::endl;
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,159 @@
+#include "FrameStream.h"
+#include "ElectrostaticSolver.h"
+#include "FieldResult.h"
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+int main() {
+    std::cout << "=== Frame Publisher - Shared-Memory Ring Example ===" << std::endl;
+    std::cout << "Problem: A solver streams frames while a reader copies them concurrently\n" << std::endl;
+
+    bool ok = true;
+    const std::string name = "/electrostatics_test_" + std::to_string(::getpid());
+
+    // ========== Downsampling ==========
+    FramePublisherOptions options;
+    options.name = name;
+    options.slots = 4;
+    options.capacity = 33 * 33;
+    FramePublisher publisher(options);
+
+    int strideSmall = publisher.strideFor(25, 25);
+    int strideLarge = publisher.strideFor(257, 129);
+    std::cout << "Slot capacity " << options.capacity << " points: stride " << strideSmall
+              << " for 25x25, " << strideLarge << " for 257x129" << std::endl;
+    ok = ok && strideSmall == 1 && strideLarge == 6;
+
+    // Real solution, published once and read back
+    ElectrostaticSolver solver;
+    int nx = 65;
+    int ny = 33;
+    double h = 0.01;
+    std::vector<double> rho((nx - 2) * (ny - 2), 0.0);
+    std::vector<double> boundaryValues(static_cast<size_t>(nx) * ny, 0.0);
+    for (int j = 0; j < ny; ++j) {
+        boundaryValues[solver.coordToIndex(0, j, nx)] = 10.0;
+    }
+    MatrixSolver::SparseMatrix K;
+    Eigen::VectorXd f;
+    solver.buildReducedFDMSystem(nx, ny, h, h, rho, 8.854e-12, K, f, boundaryValues);
+    Eigen::VectorXd phi = solver.expandReducedSolution(nx, ny, MatrixSolver().solveSparseCholesky(K, f), boundaryValues);
+    FieldResult field = solver.makeFieldResult(nx, ny, phi, h, h, 8.854e-12);
+
+    std::uint64_t first = publisher.publish(field, 0.5, "plates");
+    FrameSubscriber subscriber(name);
+    StreamFrame frame;
+    bool readBack = subscriber.latest(frame);
+    std::cout << "Frame " << first << ": " << frame.nx << "x" << frame.ny << " (stride " << frame.stride
+              << "), label '" << frame.label << "', phi in [" << frame.phiMin << ", " << frame.phiMax << "] V" << std::endl;
+    ok = ok && readBack && first == 0 && frame.stride == 2 && frame.nx == 33 && frame.ny == 17
+            && frame.label == "plates" && frame.time == 0.5 && std::abs(frame.dx - 2 * h) < 1e-15
+            && frame.potential[5 + 3 * frame.nx] == field.potential()(6, 10)
+            && frame.fieldMagnitude[5 + 3 * frame.nx] == field.fieldMagnitude()(6, 10)
+            && frame.phiMax == 10.0;
+
+    // ========== Concurrent writer and reader ==========
+    // Every value of frame k equals k: a torn copy mixes two frame numbers
+    const int frames = 3000;
+    std::atomic<bool> done{false};
+    std::thread writer([&]() {
+        Eigen::MatrixXd grid(32, 32);
+        for (int k = 1; k <= frames; ++k) {
+            grid.setConstant(static_cast<double>(k));
+            publisher.publish(grid, grid, 1.0, 1.0, k, "frame " + std::to_string(k));
+        }
+        done = true;
+    });
+
+    long copies = 0;
+    long torn = 0;
+    std::uint64_t lastSeen = 0;
+    bool monotonic = true;
+    while (!done || copies == 0) {
+        if (!subscriber.latest(frame) || frame.frame == 0) {
+            continue;
+        }
+        copies++;
+        double expected = frame.time;
+        for (size_t i = 0; i < frame.potential.size(); ++i) {
+            if (frame.potential[i] != expected || frame.fieldMagnitude[i] != expected) {
+                torn++;
+                break;
+            }
+        }
+        if (frame.label != "frame " + std::to_string(static_cast<int>(expected)) || frame.frame != expected) {
+            torn++;
+        }
+        monotonic = monotonic && frame.frame >= lastSeen;
+        lastSeen = frame.frame;
+    }
+    writer.join();
+
+    std::cout << "\n" << frames << " frames published, " << copies << " copies read, "
+              << subscriber.retries() << " retried, " << torn << " torn" << std::endl;
+    ok = ok && torn == 0 && monotonic && publisher.published() == frames + 1;
+
+    // ========== Overwritten and future frames ==========
+    bool old = subscriber.read(1, frame);
+    bool newest = subscriber.read(frames, frame) && frame.time == frames;
+    bool future = subscriber.read(frames + 1, frame);
+    std::cout << "Frame 1 overwritten: " << (old ? "no" : "yes") << ", newest readable: "
+              << (newest ? "yes" : "no") << std::endl;
+    ok = ok && !old && newest && !future;
+
+    // ========== Ownership ==========
+    // A second publisher does not take over a live ring
+    bool refused = false;
+    try {
+        FramePublisher second(options);
+    } catch (const std::runtime_error&) {
+        refused = true;
+    }
+    bool intact = subscriber.read(frames, frame) && frame.time == frames;
+    std::cout << "\nSecond publisher on a live ring refused: " << (refused ? "yes" : "no") << std::endl;
+    ok = ok && refused && intact;
+
+    // A ring left behind by a crashed run is only removed on request
+    const std::string staleName = name + "_stale";
+    int staleFd = ::shm_open(staleName.c_str(), O_CREAT | O_RDWR, 0644);
+    if (staleFd >= 0) {
+        ::close(staleFd);
+    }
+    FramePublisherOptions staleOptions = options;
+    staleOptions.name = staleName;
+    bool staleRefused = false;
+    try {
+        FramePublisher stale(staleOptions);
+    } catch (const std::runtime_error&) {
+        staleRefused = true;
+    }
+    staleOptions.replace = true;
+    bool replaced = false;
+    {
+        FramePublisher fresh(staleOptions);
+        replaced = fresh.publish(field, 1.0) == 0 && FrameSubscriber(staleName).latest(frame);
+    }
+    bool removed = ::shm_open(staleName.c_str(), O_RDONLY, 0) < 0;
+    std::cout << "Stale ring refused: " << (staleRefused ? "yes" : "no") << ", replaced on request: "
+              << (replaced ? "yes" : "no") << ", removed by its owner: " << (removed ? "yes" : "no") << std::endl;
+    ok = ok && staleFd >= 0 && staleRefused && replaced && removed;
+
+    // Opening a ring nobody published is an error
+    bool rejected = false;
+    try {
+        FrameSubscriber missing(name + "_missing");
+    } catch (const std::exception&) {
+        rejected = true;
+    }
+    ok = ok && rejected;
+
+    std::cout << "\n=== " << (ok ? "Frame publisher checks passed" : "Frame publisher checks FAILED") << " ===" << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,209 @@
+#include "JobScheduler.h"
+#include "ElectrostaticSolver.h"
+#include "Factorization.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+int main() {
+    std::cout << "=== Job Scheduler - Cost Model and Makespan Example ===" << std::endl;
+    std::cout << "Problem: One large and many small solves on a fixed thread budget\n" << std::endl;
+
+    bool ok = true;
+
+    // ========== Cost model fit ==========
+    CostModel model;
+    for (long n : {1000L, 4000L, 16000L, 64000L}) {
+        model.record("synthetic", n, 2e-8 * std::pow(static_cast<double>(n), 1.7));
+    }
+    auto [c, p] = model.parameters("synthetic");
+    double predicted = model.estimate("synthetic", 250000);
+    double truth = 2e-8 * std::pow(250000.0, 1.7);
+    std::cout << "Fitted model: t(n) = " << std::scientific << std::setprecision(3) << c
+              << " * n^" << std::fixed << std::setprecision(3) << p << std::endl;
+    std::cout << "Extrapolation to n = 250000: " << std::setprecision(3) << predicted
+              << " s (true " << truth << " s)" << std::endl;
+    ok = ok && std::abs(p - 1.7) < 1e-6 && std::abs(predicted / truth - 1.0) < 1e-6;
+
+    // A single size only rescales the prior
+    CostModel single;
+    single.record("ldlt", 10000, 0.5);
+    ok = ok && std::abs(single.estimate("ldlt", 10000) - 0.5) < 1e-9
+            && single.parameters("ldlt").second == CostModel().parameters("ldlt").second;
+
+    // ========== Planned schedule ==========
+    // Arrival order puts the large job last, the worst case for FIFO
+    const int threads = 4;
+    std::vector<Job> jobs;
+    for (int k = 0; k < 12; ++k) {
+        Job job;
+        job.name = "small" + std::to_string(k);
+        job.cost = 0.5;
+        jobs.push_back(job);
+    }
+    Job large;
+    large.name = "large";
+    large.cost = 8.0;
+    large.maxThreads = threads;
+    jobs.push_back(large);
+
+    JobScheduler scheduler(threads);
+    std::vector<ScheduleSlot> plan = scheduler.plan(jobs);
+    std::vector<double> costs;
+    for (const Job& job : jobs) {
+        costs.push_back(job.cost);
+    }
+
+    double plannedMakespan = 0.0;
+    for (const ScheduleSlot& s : plan) {
+        plannedMakespan = std::max(plannedMakespan, s.finish);
+    }
+    double fifo = JobScheduler::fifoMakespan(costs, threads);
+
+    std::cout << "\nPlan on " << threads << " threads (cost units):" << std::endl;
+    for (const ScheduleSlot& s : plan) {
+        if (jobs[s.job].name == "large" || s.job == 0) {
+            std::cout << "  " << std::setw(8) << jobs[s.job].name << "  threads " << s.threads
+                      << "  [" << std::setprecision(2) << s.start << ", " << s.finish << "]" << std::endl;
+        }
+    }
+    std::cout << "Planned makespan: " << plannedMakespan << "  FIFO (1 thread/job): " << fifo << std::endl;
+
+    ok = ok && plan.size() == jobs.size()
+            && plan.front().job == 12 && plan.front().threads > 1 && plan.front().start == 0.0
+            && plannedMakespan < 0.5 * fifo;
+
+    // Backfilling never leaves more threads busy than the budget
+    for (const ScheduleSlot& s : plan) {
+        int busy = 0;
+        for (const ScheduleSlot& o : plan) {
+            if (o.start <= s.start && s.start < o.finish) {
+                busy += o.threads;
+            }
+        }
+        ok = ok && busy <= threads;
+    }
+
+    // ========== Execution ==========
+    // Jobs record what they hold while running; the checks are on the
+    // scheduler's constraints, not on timings
+    std::mutex traceMutex;
+    int busy = 0;
+    int peakBusy = 0;
+    std::vector<int> runs(jobs.size(), 0);
+    std::vector<int> granted(jobs.size(), 0);
+    std::set<std::thread::id> workerIds;
+    for (size_t k = 0; k < jobs.size(); ++k) {
+        jobs[k].run = [&, k](int t) {
+            {
+                std::lock_guard<std::mutex> lock(traceMutex);
+                busy += t;
+                peakBusy = std::max(peakBusy, busy);
+                runs[k]++;
+                granted[k] = t;
+                workerIds.insert(std::this_thread::get_id());
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            std::lock_guard<std::mutex> lock(traceMutex);
+            busy -= t;
+        };
+    }
+    ScheduleReport report = scheduler.run(jobs);
+    bool onceEach = std::all_of(runs.begin(), runs.end(), [](int r) { return r == 1; });
+    bool asPlanned = true;
+    for (const ScheduleSlot& s : plan) {
+        asPlanned = asPlanned && granted[s.job] == s.threads;
+    }
+    std::cout << "\nExecuted: " << report.executed.size() << " jobs, each once: " << (onceEach ? "yes" : "no")
+              << ", peak threads in use " << peakBusy << " / " << threads << ", worker threads " << workerIds.size()
+              << std::endl;
+    ok = ok && report.executed.size() == jobs.size() && onceEach && asPlanned && peakBusy <= threads &&
+         static_cast<int>(workerIds.size()) <= threads;
+
+    // Thousands of jobs run on the fixed worker pool, never more than the budget at once
+    std::vector<Job> sweep(3000);
+    std::atomic<int> sweepRuns{0};
+    workerIds.clear();
+    busy = 0;
+    peakBusy = 0;
+    for (Job& job : sweep) {
+        job.cost = 1e-3;
+        job.run = [&](int t) {
+            {
+                std::lock_guard<std::mutex> lock(traceMutex);
+                busy += t;
+                peakBusy = std::max(peakBusy, busy);
+                workerIds.insert(std::this_thread::get_id());
+            }
+            sweepRuns++;
+            std::lock_guard<std::mutex> lock(traceMutex);
+            busy -= t;
+        };
+    }
+    ScheduleReport sweepReport = scheduler.run(sweep);
+    std::cout << "Sweep of " << sweep.size() << " jobs: " << sweepRuns << " runs on " << workerIds.size()
+              << " worker threads, peak " << peakBusy << " threads in use" << std::endl;
+    ok = ok && sweepRuns == static_cast<int>(sweep.size()) && sweepReport.executed.size() == sweep.size() &&
+         static_cast<int>(workerIds.size()) <= threads && peakBusy <= threads;
+
+    // A failing job is rethrown after every other job has run
+    std::vector<Job> failing(6);
+    std::atomic<int> failingRuns{0};
+    for (size_t k = 0; k < failing.size(); ++k) {
+        failing[k].cost = 1.0;
+        failing[k].run = [&, k](int) {
+            failingRuns++;
+            if (k == 2) {
+                throw std::runtime_error("job 2 failed");
+            }
+        };
+    }
+    bool rethrown = false;
+    try {
+        scheduler.run(failing);
+    } catch (const std::runtime_error& e) {
+        rethrown = std::string(e.what()) == "job 2 failed";
+    }
+    std::cout << "Failing job rethrown after " << failingRuns << " / " << failing.size() << " jobs ran: "
+              << (rethrown ? "yes" : "no") << std::endl;
+    ok = ok && rethrown && failingRuns == static_cast<int>(failing.size());
+
+    // ========== Threaded solve path for large jobs ==========
+    ElectrostaticSolver solver;
+    int nx = 65;
+    int ny = 65;
+    double h = 1e-3;
+    std::vector<double> boundaryValues(nx * ny, 0.0);
+    for (int j = 0; j < ny; ++j) {
+        boundaryValues[solver.coordToIndex(0, j, nx)] = 1.0;
+    }
+    std::vector<double> rho((nx - 2) * (ny - 2), 1e-6);
+    MatrixSolver::SparseMatrix K;
+    Eigen::VectorXd f;
+    solver.buildReducedFDMSystem(nx, ny, h, h, rho, 8.854e-12, K, f, boundaryValues);
+
+    Eigen::VectorXd exact = SparseCholeskyFactor::compute(K).solve(f);
+    BlockJacobiPreconditioner M = BlockJacobiPreconditioner::compute(K, 8, 4);
+    MatrixSolver iterative;
+    MatrixSolver::IterativeResult r = iterative.solvePreconditionedCG(
+        [&](const Eigen::VectorXd& x) { return Eigen::VectorXd(K * x); }, f,
+        [&](const Eigen::VectorXd& x) { return M.apply(x); }, Eigen::VectorXd(), 2000, 1e-12);
+    MatrixSolver::IterativeResult plain = iterative.solvePreconditionedCG(
+        [&](const Eigen::VectorXd& x) { return Eigen::VectorXd(K * x); }, f, nullptr, Eigen::VectorXd(), 2000, 1e-12);
+    double rel = (r.x - exact).norm() / exact.norm();
+
+    std::cout << "\nBlock-Jacobi PCG (" << M.blocks() << " blocks): " << r.iterations << " iterations (CG: "
+              << plain.iterations << "), error vs LDLT " << std::scientific << std::setprecision(2) << rel << std::endl;
+    ok = ok && r.converged && rel < 1e-9 && r.iterations < plain.iterations;
+
+    std::cout << "\n=== " << (ok ? "Job scheduler checks passed" : "Job scheduler checks FAILED") << " ===" << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,167 @@
+#include "LaplacianSpectrum.h"
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+#include <stdexcept>
+
+namespace {
+
+const double PI = 3.14159265358979323846;
+
+/// Laplacian eigenvalues of a path with n vertices: 2 - 2 cos(πk / n)
+double pathEigenvalue(int n, int k) {
+    return 2.0 - 2.0 * std::cos(PI * k / n);
+}
+
+/// Disjoint paths with the given numbers of vertices, numbered one after another
+Graph paths(const std::vector<int>& lengths) {
+    std::vector<int> from;
+    std::vector<int> to;
+    int first = 0;
+    for (int n : lengths) {
+        for (int v = first; v + 1 < first + n; ++v) {
+            from.push_back(v);
+            to.push_back(v + 1);
+        }
+        first += n;
+    }
+    return Graph::fromEdges(first, from, to);
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Laplacian Spectrum - Thick-Restart Lanczos Example ===" << std::endl;
+    std::cout << "Problem: Fiedler vector and low Laplacian spectrum with the nullspace deflated\n" << std::endl;
+
+    bool ok = true;
+    std::cout << std::scientific << std::setprecision(3);
+
+    // ========== Path: closed-form spectrum, tightly clustered low end ==========
+    LanczosOptions options;
+    options.count = 3;
+    LaplacianSpectrum line = LaplacianEigensolver::lowest(paths({400}), options);
+    std::cout << "Path of 400, lowest nonzero eigenvalues:" << std::endl;
+    for (int k = 0; k < 3; ++k) {
+        double exact = pathEigenvalue(400, k + 1);
+        std::cout << "  " << line.eigenvalues[k] << " (exact " << exact << ", residual " << line.residuals[k] << ")"
+                  << std::endl;
+        ok = ok && std::abs(line.eigenvalues[k] - exact) < 1e-9 * exact + 1e-12;
+    }
+    std::cout << "  " << line.iterations << " products, " << line.restarts << " restarts" << std::endl;
+    // Fiedler vector of a path: cos(π (v + ½) / n), monotone along the path
+    Eigen::VectorXd fiedler = line.fiedler();
+    bool monotone = true;
+    for (int v = 1; v < 400; ++v) {
+        monotone = monotone && (fiedler[v] - fiedler[v - 1]) * (fiedler[399] - fiedler[0]) > 0;
+    }
+    ok = ok && line.converged && monotone && line.components == 1;
+
+    // ========== Against the dense eigendecomposition ==========
+    Graph small = Graph::wattsStrogatz(800, 6, 0.3, 99);
+    options.count = 6;
+    LaplacianSpectrum lanczos = LaplacianEigensolver::lowest(small, options);
+    Eigen::MatrixXd L = Eigen::MatrixXd::Zero(800, 800);
+    for (int u = 0; u < 800; ++u) {
+        L(u, u) = small.degree(u);
+        for (int v : small.neighbors(u)) {
+            L(u, v) = -1.0;
+        }
+    }
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> full(L);
+    double worst = (lanczos.eigenvalues - full.eigenvalues().segment(1, 6)).cwiseAbs().maxCoeff();
+    std::cout << "\nWatts-Strogatz n = 800: 6 eigenvalues vs. dense, max difference " << worst << " ("
+              << lanczos.iterations << " products)" << std::endl;
+    ok = ok && lanczos.converged && worst < 1e-9;
+
+    // The same Laplacian as a sparse matrix; non-Laplacians are rejected
+    LaplacianSpectrum sparse = LaplacianEigensolver::lowest(LaplacianEigensolver::SparseMatrix(L.sparseView()), options);
+    ok = ok && sparse.converged && (sparse.eigenvalues - lanczos.eigenvalues).cwiseAbs().maxCoeff() < 1e-9;
+
+    Eigen::Matrix3d cycle;                  // Zero row and column sums, but not symmetric
+    cycle << 1, -1, 0,
+             0, 1, -1,
+             -1, 0, 1;
+    Eigen::Matrix2d negated;                // Symmetric, zero sums, positive off-diagonals
+    negated << -1, 1,
+               1, -1;
+    int rejected = 0;
+    for (const Eigen::MatrixXd& bad : {Eigen::MatrixXd(cycle), Eigen::MatrixXd(negated)}) {
+        try {
+            LaplacianEigensolver::lowest(LaplacianEigensolver::SparseMatrix(bad.sparseView()), options);
+        } catch (const std::invalid_argument&) {
+            ++rejected;
+        }
+    }
+    std::cout << "Sparse input: eigenvalues match the graph path, " << rejected << " / 2 non-Laplacians rejected"
+              << std::endl;
+    ok = ok && rejected == 2;
+
+    // ========== Disconnected: both constant vectors deflated ==========
+    options.count = 2;
+    LaplacianSpectrum split = LaplacianEigensolver::lowest(paths({100, 200}), options);
+    double mean = std::abs(split.fiedler().head(100).sum()) + std::abs(split.fiedler().tail(200).sum());
+    std::cout << "\nPaths of 100 and 200: " << split.components << " components, algebraic connectivity "
+              << split.algebraicConnectivity << ", lowest nonzero " << split.eigenvalues[0] << " and "
+              << split.eigenvalues[1] << std::endl;
+    ok = ok && split.components == 2 && split.algebraicConnectivity == 0.0 && mean < 1e-9
+         && std::abs(split.eigenvalues[0] - pathEigenvalue(200, 1)) < 1e-10
+         && std::abs(split.eigenvalues[1] - pathEigenvalue(200, 2)) < 1e-10;
+
+    // ========== Resistor network: 20 × 30 grid of 0.5 Ω resistors ==========
+    ResistiveNetwork grid;
+    for (int i = 0; i < 20; ++i) {
+        for (int j = 0; j < 30; ++j) {
+            if (i + 1 < 20) {
+                grid.addEdge(i * 30 + j, (i + 1) * 30 + j, 0.5);
+            }
+            if (j + 1 < 30) {
+                grid.addEdge(i * 30 + j, i * 30 + j + 1, 0.5);
+            }
+        }
+    }
+    options.count = 1;
+    LaplacianSpectrum mesh = LaplacianEigensolver::lowest(grid, options);
+    double expected = 2.0 * pathEigenvalue(30, 1);
+    std::cout << "\n20 x 30 grid, 2 S conductances: lambda_2 " << mesh.algebraicConnectivity << " (exact " << expected
+              << ")" << std::endl;
+    ok = ok && std::abs(mesh.algebraicConnectivity - expected) < 1e-9 * expected;
+
+    // ========== Fiedler cut of two clusters joined by one edge ==========
+    std::vector<int> from;
+    std::vector<int> to;
+    Graph cluster = Graph::wattsStrogatz(500, 10, 0.2, 99);
+    for (int u = 0; u < 500; ++u) {
+        for (int v : cluster.neighbors(u)) {
+            if (u < v) {
+                from.insert(from.end(), {u, 500 + u});
+                to.insert(to.end(), {v, 500 + v});
+            }
+        }
+    }
+    from.push_back(0);
+    to.push_back(500);
+    LaplacianSpectrum bridge = LaplacianEigensolver::lowest(Graph::fromEdges(1000, from, to), options);
+    int sideOne = 0;
+    int sideTwo = 0;
+    for (int v = 0; v < 500; ++v) {
+        sideOne += bridge.fiedler()[v] > 0.0;
+        sideTwo += bridge.fiedler()[500 + v] > 0.0;
+    }
+    std::cout << "Two clusters of 500 joined by one edge: Fiedler signs split " << sideOne << "/" << 500 - sideOne
+              << " and " << sideTwo << "/" << 500 - sideTwo << std::endl;
+    ok = ok && ((sideOne == 500 && sideTwo == 0) || (sideOne == 0 && sideTwo == 500));
+
+    // ========== 10^6 vertices ==========
+    Graph big = Graph::wattsStrogatz(1000000, 6, 0.5, 99);
+    options.tolerance = 1e-6;
+    LaplacianSpectrum large = LaplacianEigensolver::lowest(big, options);
+    std::cout << "\nWatts-Strogatz n = 10^6, k = 6, p = 0.5: lambda_2 " << large.eigenvalues[0] << ", "
+              << large.components << " component(s), residual " << large.residuals[0] << ", " << large.iterations
+              << " products in " << std::fixed << std::setprecision(2) << large.seconds << " s" << std::endl;
+    ok = ok && large.converged && large.residuals[0] < 1e-5 * 12.0;
+
+    std::cout << "\n=== " << (ok ? "Laplacian spectrum checks passed" : "Laplacian spectrum checks FAILED") << " ==="
+              << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,107 @@
+#include "ParameterSweep.h"
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <set>
+#include <sstream>
+
+int main() {
+    std::cout << "=== Parameter Sweep - Resumable Parallel Sweep Example ===" << std::endl;
+    std::cout << "Problem: Parallel plates over voltages, spacings and charge layouts\n" << std::endl;
+
+    const std::string definitionFile = "sweep_test_definition.txt";
+    const std::string resultsFile = "sweep_test_results.csv";
+    std::remove(resultsFile.c_str());
+
+    {
+        std::ofstream out(definitionFile);
+        out << "# Test sweep: 2 grids x 2 spacings x 5 voltages x 3 charges = 60 points\n"
+            << "grid      = 25x25, 31x21\n"
+            << "spacing   = 0.05, 0.1\n"
+            << "voltage   = 0:100:5\n"
+            << "charge    = none; point:0.5:0.5:1e-10; gaussian:0.3:0.5:0.1:1e-9\n"
+            << "epsilon_r = 1\n";
+    }
+
+    SweepDefinition definition = SweepDefinition::fromFile(definitionFile);
+    size_t total = definition.points().size();
+    std::cout << "Sweep points: " << total << std::endl;
+
+    // ========== First Run, Interrupted ==========
+    SweepSummary first;
+    {
+        ResultsLog log(resultsFile);
+        first = ParameterSweep::run(definition, log, 4, 25);
+    }
+    std::cout << "\nFirst run (stopped after 25 points): computed " << first.computed
+              << ", skipped " << first.skipped << std::endl;
+
+    // Simulate a crash in the middle of writing a row
+    {
+        std::ofstream out(resultsFile, std::ios::app);
+        out << "deadbeefdeadbeef,25,25,0.1,12";
+    }
+
+    // ========== Restart ==========
+    SweepSummary second;
+    size_t logged;
+    {
+        ResultsLog log(resultsFile);
+        std::cout << "Completed runs found on restart: " << log.size() << std::endl;
+        second = ParameterSweep::run(definition, log, 4);
+        logged = log.size();
+    }
+    std::cout << "Second run: computed " << second.computed << ", skipped " << second.skipped << std::endl;
+
+    // ========== Third Run: Nothing Left ==========
+    ResultsLog log(resultsFile);
+    SweepSummary third = ParameterSweep::run(definition, log, 4);
+    std::cout << "Third run:  computed " << third.computed << ", skipped " << third.skipped << std::endl;
+
+    // ========== Check the Results File ==========
+    std::ifstream in(resultsFile);
+    std::string line;
+    std::getline(in, line);
+    bool headerOk = line == ResultsLog::header();
+
+    std::set<std::string> ids;
+    size_t rows = 0;
+    size_t complete = 0;
+    double worstField = 0.0;
+    while (std::getline(in, line)) {
+        ++rows;
+        std::vector<std::string> c;
+        std::stringstream ss(line);
+        std::string item;
+        while (std::getline(ss, item, ',')) {
+            c.push_back(item);
+        }
+        if (c.size() != 13 || c.back() != "ok") {
+            continue;
+        }
+        ++complete;
+        ids.insert(c[0]);
+
+        // Without charge the field is uniform: |E| = V / ((nx-1) h)
+        if (c[5] == "none") {
+            double expected = std::stod(c[4]) / ((std::stoi(c[1]) - 1) * std::stod(c[3]));
+            worstField = std::max(worstField, std::abs(std::stod(c[9]) - expected));
+        }
+    }
+
+    std::cout << std::scientific << std::setprecision(3);
+    std::cout << "\nRows: " << rows << " (" << complete << " complete, " << ids.size() << " unique run IDs)" << std::endl;
+    std::cout << "Max |E| deviation for uncharged runs: " << worstField << " V/m" << std::endl;
+
+    bool ok = headerOk && first.computed == 25 && second.skipped == 25 && second.computed == total - 25 &&
+              third.computed == 0 && third.skipped == total && logged == total &&
+              complete == total && ids.size() == total && worstField < 1e-8;
+
+    std::remove(definitionFile.c_str());
+    std::remove(resultsFile.c_str());
+
+    std::cout << "\n=== " << (ok ? "Parameter sweep checks passed" : "Parameter sweep checks FAILED") << " ===" << std::endl;
+    return ok ? 0 : 1;
+}
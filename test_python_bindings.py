@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+"""
+Test for the electrostatics Python module (python_bindings.cpp)
+Checks results against numpy, in-place inputs and views, and concurrent solves from Python threads
+"""
+
+import sys
+import time
+from concurrent.futures import ThreadPoolExecutor
+
+import numpy as np
+
+try:
+    import electrostatics
+except ImportError:
+    print("Error: electrostatics module not found. Build it with: python build.py build electrostatics")
+    sys.exit(1)
+
+
+def main():
+    print("=== Python Bindings - Solver Access Without CSV Round-Trips ===")
+    print("Problem: Dense solves and parallel plate sweeps driven from Python\n")
+
+    ok = True
+    rng = np.random.default_rng(42)
+
+    # ========== MatrixSolver ==========
+    solver = electrostatics.MatrixSolver()
+    n = 200
+    A = np.asfortranarray(rng.standard_normal((n, n)) + n * np.eye(n))   # Column-major: used in place
+    b = rng.standard_normal(n)
+    x = solver.solve_lu(A, b)
+    residual = np.linalg.norm(A @ x - b) / np.linalg.norm(b)
+    print(f"solve_lu ({n}x{n}): relative residual {residual:.2e}")
+    ok = ok and residual < 1e-12
+
+    # C-ordered input is converted once and gives the same answer
+    ok = ok and np.allclose(solver.solve_lu(np.ascontiguousarray(A), b), x, rtol=1e-12, atol=0)
+
+    spd = A @ A.T
+    result = solver.solve_preconditioned_cg(lambda v: spd @ v, b, lambda r: r / np.diag(spd),
+                                            max_iterations=2000, tolerance=1e-10)
+    print(f"solve_preconditioned_cg with Python callbacks: {result.iterations} iterations, "
+          f"residual {result.relative_residual:.2e}")
+    ok = ok and result.converged
+
+    # ========== ElectrostaticSolver ==========
+    es = electrostatics.ElectrostaticSolver()
+    field = es.solve_plates(nx=25, ny=25, spacing=0.1, voltage=100.0)
+    phi = field.potential
+    print(f"\nParallel plates 25x25: phi in [{phi.min():.3f}, {phi.max():.3f}] V, "
+          f"max |E| = {field.field_magnitude.max():.3f} V/m")
+
+    # Without charge the potential is linear between the plates
+    expected = 100.0 * (1.0 - np.arange(25) / 24.0)
+    ok = ok and phi.shape == (25, 25) and np.allclose(phi[12, :], expected, atol=1e-9)
+
+    # Field grids are read-only views owned by the FieldResult
+    ok = ok and not phi.flags.owndata and not phi.flags.writeable
+    ok = ok and np.shares_memory(phi, field.potential)
+
+    # Generic entry point agrees with the plate helper
+    boundary = np.zeros(25 * 25)
+    boundary[0::25] = 100.0
+    again = es.solve(25, 25, 0.1, 0.1, np.zeros(23 * 23), 8.854e-12, boundary)
+    ok = ok and np.allclose(again.potential, phi, atol=1e-12)
+
+    # Strided inputs are converted, contiguous ones read in place: same results
+    strided = es.solve(25, 25, 0.1, 0.1, np.zeros(2 * 23 * 23)[::2], 8.854e-12, np.repeat(boundary, 2)[::2])
+    expanded = es.expand_reduced_solution(25, 25, np.ascontiguousarray(phi[1:-1, 1:-1]).ravel(), boundary)
+    print(f"Strided solve and in-place expansion match: "
+          f"{np.allclose(strided.potential, phi, atol=1e-12) and np.allclose(expanded, phi.ravel(), atol=1e-12)}")
+    ok = ok and np.allclose(strided.potential, phi, atol=1e-12)
+    ok = ok and np.allclose(expanded, phi.ravel(), atol=1e-12)
+
+    # ========== Concurrent sweep ==========
+    # Solves release the GIL, so threads overlap
+    voltages = np.linspace(10.0, 100.0, 8)
+    size = 201
+
+    def solve(voltage):
+        local = electrostatics.ElectrostaticSolver()
+        return local.solve_plates(nx=size, ny=size, spacing=0.01, voltage=voltage).potential.max()
+
+    t0 = time.perf_counter()
+    serial = [solve(v) for v in voltages]
+    t1 = time.perf_counter()
+    with ThreadPoolExecutor(max_workers=4) as pool:
+        threaded = list(pool.map(solve, voltages))
+    t2 = time.perf_counter()
+
+    print(f"\nSweep of {len(voltages)} solves ({size}x{size}): serial {t1 - t0:.2f} s, "
+          f"4 threads {t2 - t1:.2f} s")
+    ok = ok and np.allclose(serial, voltages) and np.allclose(threaded, serial, rtol=0, atol=0)
+
+    print(f"\n=== {'Python bindings checks passed' if ok else 'Python bindings checks FAILED'} ===")
+    return 0 if ok else 1
+
+
+if __name__ == '__main__':
+    sys.exit(main())
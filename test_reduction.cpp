@@ -0,0 +1,156 @@
+#include "Reduction.h"
+#include "ElectrostaticSolver.h"
+#include "FieldResult.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <iomanip>
+#include <random>
+
+namespace {
+
+double seconds(const std::chrono::steady_clock::time_point& t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+/**
+ * Reference sum in extended precision with compensation
+ */
+long double referenceDot(const Eigen::VectorXd& x, const Eigen::VectorXd& y) {
+    long double sum = 0.0L;
+    long double compensation = 0.0L;
+    for (Eigen::Index k = 0; k < x.size(); ++k) {
+        long double value = static_cast<long double>(x(k)) * y(k);
+        long double t = sum + value;
+        compensation += (std::abs(sum) >= std::abs(value)) ? (sum - t) + value : (value - t) + sum;
+        sum = t;
+    }
+    return sum + compensation;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Deterministic Reductions - Thread-Count Independence Example ===" << std::endl;
+    std::cout << "Problem: Sums, dot products and norms that do not change with the thread count\n" << std::endl;
+
+    bool ok = true;
+
+    // Mixed signs over twelve orders of magnitude: naive sums lose many digits
+    const long n = 2000000;
+    std::mt19937_64 rng(87);
+    std::uniform_real_distribution<double> mantissa(-1.0, 1.0);
+    std::uniform_int_distribution<int> exponent(-6, 6);
+    Eigen::VectorXd x(n);
+    Eigen::VectorXd y(n);
+    for (long k = 0; k < n; ++k) {
+        x(k) = mantissa(rng) * std::pow(10.0, exponent(rng));
+        y(k) = mantissa(rng);
+    }
+    Eigen::VectorXd ones = Eigen::VectorXd::Ones(n);
+    double exactSum = static_cast<double>(referenceDot(x, ones));
+    double exactDot = static_cast<double>(referenceDot(x, y));
+
+    // ========== Bitwise identical across thread counts ==========
+    ReductionOptions deterministic;
+    double sum1 = Reduction::sum(x, deterministic);
+    double dot1 = Reduction::dot(x, y, deterministic);
+    double norm1 = Reduction::norm(x, deterministic);
+    bool identical = true;
+    for (int threads : {2, 3, 4, 7, 8}) {
+        deterministic.threads = threads;
+        identical = identical && Reduction::sum(x, deterministic) == sum1
+                              && Reduction::dot(x, y, deterministic) == dot1
+                              && Reduction::norm(x, deterministic) == norm1;
+    }
+    std::cout << "Deterministic sum, dot, norm identical for 1-8 threads: " << (identical ? "yes" : "no") << std::endl;
+    ok = ok && identical;
+
+    // ========== Accuracy against an extended-precision reference ==========
+    double naiveSum = x.sum();
+    double naiveDot = x.dot(y);
+    std::cout << std::scientific << std::setprecision(2);
+    std::cout << "Relative error of the sum: deterministic " << std::abs(sum1 - exactSum) / std::abs(exactSum)
+              << ", Eigen " << std::abs(naiveSum - exactSum) / std::abs(exactSum) << std::endl;
+    std::cout << "Relative error of the dot: deterministic " << std::abs(dot1 - exactDot) / std::abs(exactDot)
+              << ", Eigen " << std::abs(naiveDot - exactDot) / std::abs(exactDot) << std::endl;
+    ok = ok && std::abs(sum1 - exactSum) <= 1e-15 * std::abs(exactSum)
+            && std::abs(dot1 - exactDot) <= 1e-15 * std::abs(exactDot);
+
+    // ========== Fast mode ==========
+    ReductionOptions fast{ReductionMode::Fast, 4};
+    double fastSum = Reduction::sum(x, fast);
+    std::cout << "Fast sum (4 threads) relative deviation: " << std::abs(fastSum - exactSum) / std::abs(exactSum) << std::endl;
+    ok = ok && std::abs(fastSum - exactSum) <= 1e-10 * std::abs(exactSum);
+
+    for (int threads : {1, 4}) {
+        auto t0 = std::chrono::steady_clock::now();
+        volatile double sink = 0.0;
+        for (int repeat = 0; repeat < 20; ++repeat) {
+            sink += Reduction::dot(x, y, {ReductionMode::Deterministic, threads});
+        }
+        double tDeterministic = seconds(t0) / 20;
+        t0 = std::chrono::steady_clock::now();
+        for (int repeat = 0; repeat < 20; ++repeat) {
+            sink += Reduction::dot(x, y, {ReductionMode::Fast, threads});
+        }
+        double tFast = seconds(t0) / 20;
+        std::cout << std::fixed << std::setprecision(2) << "Dot of " << n << " values, " << threads
+                  << " thread(s): deterministic " << tDeterministic * 1e3 << " ms, fast " << tFast * 1e3
+                  << " ms" << std::endl;
+    }
+
+    // ========== PCG iterates independent of the thread count ==========
+    ElectrostaticSolver solver;
+    int nx = 301;
+    int ny = 301;
+    double h = 1e-3;
+    std::vector<double> rho((nx - 2) * (ny - 2), 0.0);
+    rho[(nx / 2 - 1) + (ny / 2 - 1) * (nx - 2)] = 1e-6;
+    std::vector<double> boundaryValues(static_cast<size_t>(nx) * ny, 0.0);
+    for (int j = 0; j < ny; ++j) {
+        boundaryValues[solver.coordToIndex(0, j, nx)] = 5.0;
+    }
+    MatrixSolver::SparseMatrix K;
+    Eigen::VectorXd f;
+    solver.buildReducedFDMSystem(nx, ny, h, h, rho, 8.854e-12, K, f, boundaryValues);
+    auto apply = [&](const Eigen::VectorXd& v) { return Eigen::VectorXd(K * v); };
+
+    MatrixSolver pcg;
+    pcg.setReduction({ReductionMode::Deterministic, 1});
+    MatrixSolver::IterativeResult serial = pcg.solvePreconditionedCG(apply, f, nullptr, Eigen::VectorXd(), 2000, 1e-10);
+    pcg.setReduction({ReductionMode::Deterministic, 4});
+    MatrixSolver::IterativeResult parallel = pcg.solvePreconditionedCG(apply, f, nullptr, Eigen::VectorXd(), 2000, 1e-10);
+    bool sameIterates = serial.iterations == parallel.iterations && serial.x == parallel.x;
+    std::cout << "\nCG on " << f.size() << " unknowns: " << serial.iterations << " iterations, 1 and 4 threads "
+              << (sameIterates ? "bitwise identical" : "DIFFER") << std::endl;
+    ok = ok && serial.converged && sameIterates;
+
+    // ========== Energy integral ==========
+    Eigen::VectorXd phi = solver.expandReducedSolution(nx, ny, serial.x, boundaryValues);
+    FieldResult field = solver.makeFieldResult(nx, ny, phi, h, h, 8.854e-12);
+    double energy = field.integral(FieldResult::Component::EnergyDensity);
+    double energy8 = field.integral(FieldResult::Component::EnergyDensity, {ReductionMode::Deterministic, 8});
+    double naiveEnergy = field.energyDensity().sum() * h * h;
+    std::cout << std::scientific << std::setprecision(10) << "Field energy: " << energy << " J/m (u.sum()*dx*dy: "
+              << naiveEnergy << ")" << std::endl;
+    ok = ok && energy == energy8 && std::abs(energy - naiveEnergy) <= 1e-12 * energy;
+
+    // Mismatched sizes are rejected in both modes instead of reading past the shorter vector
+    int rejected = 0;
+    for (ReductionMode mode : {ReductionMode::Deterministic, ReductionMode::Fast}) {
+        ReductionOptions options;
+        options.mode = mode;
+        try {
+            Reduction::dot(Eigen::VectorXd::Ones(10), Eigen::VectorXd::Ones(9), options);
+        } catch (const std::invalid_argument&) {
+            ++rejected;
+        }
+    }
+    std::cout << "Size mismatch rejected in " << rejected << " / 2 modes" << std::endl;
+    ok = ok && rejected == 2;
+
+    std::cout << "\n=== " << (ok ? "Reduction checks passed" : "Reduction checks FAILED") << " ===" << std::endl;
+    return ok ? 0 : 1;
+}
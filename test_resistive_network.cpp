@@ -0,0 +1,165 @@
+#include "ResistiveNetwork.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+#include <random>
+
+namespace {
+
+double seconds(const std::chrono::steady_clock::time_point& t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+/**
+ * The 16-node example network of GraphTesting.py (nodes 1..16, resistances in ohms)
+ */
+ResistiveNetwork exampleNetwork() {
+    const int edges[][3] = {
+        {1, 2, 10}, {2, 3, 20}, {3, 4, 30}, {4, 1, 40}, {1, 3, 50}, {2, 5, 15}, {5, 6, 25}, {6, 3, 35},
+        {5, 7, 10}, {7, 8, 20}, {8, 9, 30}, {9, 10, 40}, {4, 6, 45}, {2, 8, 22}, {7, 10, 18}, {1, 9, 55},
+        {3, 7, 33}, {6, 10, 27}, {11, 12, 12}, {12, 13, 13}, {13, 14, 14}, {12, 15, 15}, {13, 15, 16},
+        {14, 15, 17}, {13, 16, 18}, {14, 16, 19}, {15, 16, 20}, {14, 7, 21}, {16, 10, 22}};
+    ResistiveNetwork network;
+    for (int node = 1; node <= 16; ++node) {
+        network.addNode(node);
+    }
+    for (const auto& edge : edges) {
+        network.addEdge(edge[0], edge[1], edge[2]);
+    }
+    return network;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Resistive Network Solver - Sparse Nodal Analysis Example ===" << std::endl;
+    std::cout << "Problem: Node voltages of resistor networks with hashed node IDs and grounded-node elimination\n"
+              << std::endl;
+
+    bool ok = true;
+
+    // ========== GraphTesting.py network: +1 A into node 11, out of node 16 ==========
+    ResistiveNetwork network = exampleNetwork();
+    ResistiveNetworkSolver direct(network, 16);
+    Eigen::VectorXd v = direct.dcSolution(11, 16);
+
+    // Dense reference as np.linalg.solve(Y_reduced, I_reduced) with the last node grounded
+    Eigen::MatrixXd Y = Eigen::MatrixXd(network.laplacian());
+    Eigen::VectorXd I = Eigen::VectorXd::Zero(16);
+    I(network.index(11)) = 1.0;
+    Eigen::VectorXd dense = Eigen::VectorXd::Zero(16);
+    dense.head(15) = Y.topLeftCorner(15, 15).lu().solve(I.head(15));
+
+    NetworkSolveOptions cgOptions;
+    cgOptions.method = NetworkSolveMethod::ConjugateGradient;
+    ResistiveNetworkSolver iterative(network, 16, cgOptions);
+    Eigen::VectorXd vcg = iterative.dcSolution(11, 16);
+
+    std::cout << "Voltages for +1 A at node 11, node 16 grounded:" << std::endl;
+    std::cout << std::fixed << std::setprecision(4);
+    for (int node = 1; node <= 16; ++node) {
+        std::cout << "  V" << std::setw(2) << std::left << node << std::right << " = " << std::setw(8)
+                  << v(network.index(node)) << " V" << ((node % 4 == 0) ? "\n" : "");
+    }
+    double denseError = (v - dense).norm() / dense.norm();
+    double cgError = (vcg - dense).norm() / dense.norm();
+    Eigen::VectorXd kirchhoff = network.laplacian() * v;
+    kirchhoff(network.index(11)) -= 1.0;
+    kirchhoff(network.index(16)) += 1.0;
+    std::cout << std::scientific << std::setprecision(2) << "Cholesky vs. dense solve: " << denseError
+              << ", CG (" << iterative.lastIterations() << " iterations) vs. dense: " << cgError
+              << ", Kirchhoff residual " << kirchhoff.norm() << std::endl;
+    std::cout << std::fixed << std::setprecision(4) << "Equivalent resistance 11-16: " << v(network.index(11))
+              << " ohm" << std::endl;
+    ok = ok && direct.direct() && !iterative.direct() && denseError < 1e-12 && cgError < 1e-8
+            && kirchhoff.norm() < 1e-12 && direct.components() == 1;
+
+    // ========== Hashed IDs and CSR input ==========
+    const ResistiveNetwork::NodeId base = 1000000000000LL;
+    std::vector<std::int64_t> offsets(17, 0);
+    std::vector<std::vector<std::pair<int, double>>> rows(16);
+    for (int e = 0; e < network.edgeCount(); ++e) {
+        double r = 1.0 / network.conductance(e);
+        rows[network.edgeFrom(e)].push_back({network.edgeTo(e), r});
+        rows[network.edgeTo(e)].push_back({network.edgeFrom(e), r});
+    }
+    std::vector<std::int64_t> targets;
+    std::vector<double> resistances;
+    std::vector<ResistiveNetwork::NodeId> ids;
+    for (int u = 0; u < 16; ++u) {
+        for (const auto& entry : rows[u]) {
+            targets.push_back(entry.first);
+            resistances.push_back(entry.second);
+        }
+        offsets[u + 1] = static_cast<std::int64_t>(targets.size());
+        ids.push_back(base + 7 * network.id(u));
+    }
+    ResistiveNetwork csr = ResistiveNetwork::fromCSR(offsets, targets, resistances, ids, true);
+    ResistiveNetworkSolver csrSolver(csr, base + 7 * 16);
+    Eigen::VectorXd vcsr = csrSolver.dcSolution(base + 7 * 11, base + 7 * 16);
+    double csrDifference = 0.0;
+    for (int node = 1; node <= 16; ++node) {
+        csrDifference = std::max(csrDifference,
+                                 std::abs(vcsr(csr.index(base + 7 * node)) - v(network.index(node))));
+    }
+    std::cout << "Symmetric CSR input with IDs 10^12 + 7k: " << csr.edgeCount() << " resistors, max difference "
+              << std::scientific << csrDifference << std::endl;
+    ok = ok && csr.edgeCount() == network.edgeCount() && csrDifference < 1e-12;
+
+    // ========== Floating components ==========
+    ResistiveNetwork split = exampleNetwork();
+    split.addEdge(100, 101, 5.0);
+    split.addNode(102);
+    ResistiveNetworkSolver splitSolver(split, 16);
+    Eigen::VectorXd currents = Eigen::VectorXd::Zero(split.nodeCount());
+    currents(split.index(101)) = 2.0;
+    currents(split.index(100)) = -2.0;
+    Eigen::VectorXd vsplit = splitSolver.solveCurrents(currents);
+    bool rejected = false;
+    try {
+        splitSolver.dcSolution(100, 16);
+    } catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    std::cout << std::fixed << "Floating components: " << splitSolver.components() - 1 << ", V101 - V100 = "
+              << vsplit(split.index(101)) - vsplit(split.index(100)) << " V, current without return path rejected: "
+              << (rejected ? "yes" : "no") << std::endl;
+    ok = ok && splitSolver.components() == 3 && std::abs(vsplit(split.index(101)) - 10.0) < 1e-12 && rejected;
+
+    // ========== Million-node small-world network ==========
+    const int n = 1000000;
+    std::mt19937_64 rng(91);
+    std::uniform_int_distribution<int> anyNode(0, n - 1);
+    std::uniform_real_distribution<double> ohms(1.0, 100.0);
+    auto t0 = std::chrono::steady_clock::now();
+    ResistiveNetwork large;
+    large.reserve(n, 3 * static_cast<size_t>(n));
+    for (int u = 0; u < n; ++u) {
+        large.addEdge(u, (u + 1) % n, ohms(rng));
+        large.addEdge(u, (u + 2) % n, ohms(rng));
+        int w = anyNode(rng);
+        if (w != u) {
+            large.addEdge(u, w, ohms(rng));
+        }
+    }
+    double tBuild = seconds(t0);
+    t0 = std::chrono::steady_clock::now();
+    ResistiveNetworkSolver largeSolver(large, 0);
+    double tAssemble = seconds(t0);
+    t0 = std::chrono::steady_clock::now();
+    Eigen::VectorXd vlarge = largeSolver.dcSolution(n / 2, 0);
+    double tSolve = seconds(t0);
+    Eigen::VectorXd residual = large.laplacian() * vlarge;
+    residual(large.index(n / 2)) -= 1.0;
+    residual(0) += 1.0;
+    std::cout << "\n" << n << " nodes, " << large.edgeCount() << " resistors: build " << std::setprecision(2)
+              << tBuild << " s, assemble " << tAssemble << " s, " << (largeSolver.direct() ? "Cholesky" : "CG")
+              << " solve " << tSolve << " s (" << largeSolver.lastIterations() << " iterations)" << std::endl;
+    std::cout << "  Equivalent resistance " << vlarge(large.index(n / 2)) << " ohm, Kirchhoff residual "
+              << std::scientific << residual.norm() << std::endl;
+    ok = ok && !largeSolver.direct() && residual.norm() < 1e-8 && tAssemble + tSolve < 30.0;
+
+    std::cout << "\n=== " << (ok ? "Resistive network checks passed" : "Resistive network checks FAILED") << " ===" << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,115 @@
+#include "ResourceEstimator.h"
+#include "ElectrostaticSolver.h"
+#include "Factorization.h"
+#include "Multigrid.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+
+int main() {
+    std::cout << "=== Resource Estimator - Admission Control Example ===" << std::endl;
+    std::cout << "Problem: Predict memory and run time before accepting a solve\n" << std::endl;
+
+    bool ok = true;
+    const double MiB = 1024.0 * 1024.0;
+
+    // ========== Calibration ==========
+    ResourceEstimator estimator;
+    estimator.calibrate({33, 65, 129});
+    std::cout << "Calibrated fill constant: nnz(L) = " << std::fixed << std::setprecision(3)
+              << estimator.fillConstant() << " · m log₂ m" << std::endl;
+    ok = ok && estimator.fillConstant() > 0.5 && estimator.fillConstant() < 5.0;
+
+    // ========== Dense system: N² doubles ==========
+    ResourceEstimate dense = estimator.estimate(25, 25, "dense-lu");
+    std::cout << "\n" << dense.summary() << " (A alone " << dense.matrixBytes / MiB << " MiB)" << std::endl;
+    ok = ok && dense.matrixBytes == 625u * 625u * sizeof(double) && dense.peakBytes > 2 * dense.matrixBytes;
+
+    // ========== Prediction against a real factorization ==========
+    int n = 257;
+    ElectrostaticSolver solver;
+    std::vector<double> rho(static_cast<size_t>(n - 2) * (n - 2), 0.0);
+    std::vector<double> boundaryValues(static_cast<size_t>(n) * n, 0.0);
+    for (int j = 0; j < n; ++j) {
+        boundaryValues[solver.coordToIndex(0, j, n)] = 1.0;
+    }
+    MatrixSolver::SparseMatrix K;
+    Eigen::VectorXd f;
+    auto t0 = std::chrono::steady_clock::now();
+    solver.buildReducedFDMSystem(n, n, 1e-3, 1e-3, rho, 8.854e-12, K, f, boundaryValues);
+    SparseCholeskyFactor factor = SparseCholeskyFactor::compute(K);
+    factor.solve(f);
+    double measured = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    ResourceEstimate ldlt = estimator.estimate(n, n, "ldlt");
+    double actualMatrix = K.nonZeros() * 12.0 + (K.cols() + 1) * 4.0;
+    double actualFactor = factor.nonZeros() * 12.0 + (factor.size() + 1) * 4.0 + factor.size() * 12.0;
+    std::cout << "\n" << ldlt.summary() << std::endl;
+    std::cout << std::setprecision(2) << "  Matrix: predicted " << ldlt.matrixBytes / MiB << " MiB, actual "
+              << actualMatrix / MiB << " MiB" << std::endl;
+    std::cout << "  Factor: predicted " << ldlt.factorBytes / MiB << " MiB, actual " << actualFactor / MiB
+              << " MiB" << std::endl;
+    std::cout << std::setprecision(3) << "  Time:   predicted " << ldlt.seconds << " s, measured " << measured
+              << " s" << std::endl;
+    ok = ok && std::abs(ldlt.matrixBytes / actualMatrix - 1.0) < 0.01
+            && std::abs(ldlt.factorBytes / actualFactor - 1.0) < 0.25
+            && ldlt.seconds < 5.0 * measured && ldlt.seconds > measured / 5.0;
+
+    // Multigrid hierarchy: coarse operators, prolongations, level vectors
+    Multigrid hierarchy;
+    hierarchy.build(K, n - 2, n - 2);
+    double actualHierarchy = 0.0;
+    for (int l = 0; l < hierarchy.levels(); ++l) {
+        if (l > 0) {
+            actualHierarchy += hierarchy.op(l).nonZeros() * 12.0 + (hierarchy.op(l).cols() + 1) * 4.0;
+        }
+        if (l + 1 < hierarchy.levels()) {
+            actualHierarchy += hierarchy.prolongation(l).nonZeros() * 12.0 + (hierarchy.prolongation(l).cols() + 1) * 4.0;
+        }
+        actualHierarchy += 3.0 * hierarchy.size(l) * sizeof(double);
+    }
+    ResourceEstimate multigrid = estimator.estimate(n, n, "pcg", "multigrid");
+    std::cout << std::setprecision(2) << "  Multigrid hierarchy: predicted " << multigrid.factorBytes / MiB
+              << " MiB, actual " << actualHierarchy / MiB << " MiB" << std::endl;
+    ok = ok && std::abs(multigrid.factorBytes / actualHierarchy - 1.0) < 0.15;
+
+    // Iterative solvers need far less memory than the factor on large grids
+    ResourceEstimate mg = estimator.estimate(1025, 1025, "pcg", "multigrid");
+    ResourceEstimate big = estimator.estimate(1025, 1025, "ldlt");
+    std::cout << "\n" << big.summary() << "\n" << mg.summary() << std::endl;
+    ok = ok && mg.peakBytes < big.peakBytes;
+
+    // ========== Admission control ==========
+    ResourceBudget budget;
+    budget.memoryBytes = static_cast<size_t>(256 * MiB);
+
+    AdmissionDecision small = estimator.admit(129, 129, "ldlt", "none", budget);
+    AdmissionDecision denseLarge = estimator.admit(101, 101, "dense-lu", "none", budget);
+    budget.memoryBytes = static_cast<size_t>(512 * MiB);
+    AdmissionDecision huge = estimator.admit(1025, 1025, "ldlt", "none", budget);
+    budget.memoryBytes = static_cast<size_t>(1 * MiB);
+    AdmissionDecision tiny = estimator.admit(1025, 1025, "ldlt", "none", budget);
+
+    std::cout << "\nBudget 256 MiB:" << std::endl;
+    std::cout << "  129x129 ldlt:    accepted (" << (small.action == AdmissionDecision::Action::Accept ? "yes" : "no") << ")" << std::endl;
+    std::cout << "  101x101 dense:   " << denseLarge.reason << std::endl;
+    std::cout << "Budget 512 MiB:\n  1025x1025 ldlt:  " << huge.reason << std::endl;
+    std::cout << "Budget 1 MiB:\n  1025x1025 ldlt:  " << tiny.reason << std::endl;
+    ok = ok && small.action == AdmissionDecision::Action::Accept
+            && denseLarge.action == AdmissionDecision::Action::Reroute && denseLarge.chosen.solver != "dense-lu"
+            && huge.action == AdmissionDecision::Action::Reroute && huge.chosen.solver == "pcg"
+            && huge.chosen.peakBytes <= static_cast<size_t>(512 * MiB)
+            && tiny.action == AdmissionDecision::Action::Reject;
+
+    bool unknown = false;
+    try {
+        estimator.estimate(65, 65, "pcg", "ilu");
+    } catch (const std::invalid_argument&) {
+        unknown = true;
+    }
+    ok = ok && unknown;
+
+    std::cout << "\n=== " << (ok ? "Resource estimator checks passed" : "Resource estimator checks FAILED") << " ===" << std::endl;
+    return ok ? 0 : 1;
+}
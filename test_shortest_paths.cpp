@@ -0,0 +1,129 @@
+#include "ShortestPaths.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+
+namespace {
+
+double seconds(const std::chrono::steady_clock::time_point& t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+/**
+ * One plain BFS per source, as nx.average_shortest_path_length does
+ */
+DistanceStats reference(const Graph& g) {
+    DistanceStats stats;
+    for (int s = 0; s < g.nodeCount(); ++s) {
+        for (int d : ShortestPaths::distances(g, s)) {
+            if (d > 0) {
+                stats.distanceSum += d;
+                ++stats.pairs;
+                stats.diameter = std::max(stats.diameter, d);
+            } else if (d < 0) {
+                stats.connected = false;
+            }
+        }
+    }
+    stats.sources = g.nodeCount();
+    stats.averageDistance = static_cast<double>(stats.distanceSum) / static_cast<double>(stats.pairs);
+    return stats;
+}
+
+bool same(const DistanceStats& a, const DistanceStats& b) {
+    return a.distanceSum == b.distanceSum && a.pairs == b.pairs && a.diameter == b.diameter
+           && a.connected == b.connected && a.sources == b.sources;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Shortest Paths - Bit-Parallel Multi-Source BFS Example ===" << std::endl;
+    std::cout << "Problem: Exact average shortest path length and diameter, 64 BFS per pass\n" << std::endl;
+
+    bool ok = true;
+
+    // ========== Cycle: ASPL n² / (4(n - 1)), diameter n/2 ==========
+    const int cycle = 1000;
+    DistanceStats ring = ShortestPaths::exact(Graph::ringLattice(cycle, 2));
+    double expected = cycle * static_cast<double>(cycle) / (4.0 * (cycle - 1));
+    std::cout << "Cycle of " << cycle << ": ASPL " << std::fixed << std::setprecision(6) << ring.averageDistance
+              << " (exact " << expected << "), diameter " << ring.diameter << std::endl;
+    ok = ok && std::abs(ring.averageDistance - expected) < 1e-9 && ring.diameter == cycle / 2 && ring.connected;
+
+    // ========== Against one BFS per source ==========
+    Graph small = Graph::wattsStrogatz(3000, 6, 0.3, 96);
+    DistanceStats bitParallel = ShortestPaths::exact(small, 1);
+    DistanceStats threaded = ShortestPaths::exact(small, 3);
+    DistanceStats plain = reference(small);
+    std::cout << "Watts-Strogatz n = 3000: ASPL " << bitParallel.averageDistance << ", diameter "
+              << bitParallel.diameter << "; plain BFS " << plain.averageDistance << ", " << plain.diameter
+              << "; 1 vs. 3 threads " << (same(bitParallel, threaded) ? "identical" : "DIFFER") << std::endl;
+    ok = ok && same(bitParallel, plain) && same(bitParallel, threaded);
+
+    // Two components: averaged over reachable pairs, flagged as disconnected
+    Graph split = Graph::fromEdges(7, {0, 1, 2, 3, 4, 5}, {1, 2, 0, 4, 5, 6});
+    DistanceStats parts = ShortestPaths::exact(split);
+    DistanceStats partsReference = reference(split);
+    std::cout << "Triangle + path of 4: ASPL over reachable pairs " << parts.averageDistance << ", diameter "
+              << parts.diameter << ", connected: " << (parts.connected ? "yes" : "no") << std::endl;
+    ok = ok && same(parts, partsReference) && !parts.connected && parts.diameter == 3;
+
+    // ========== GraphTesting size: 10^4 vertices, degree 6 ==========
+    Graph g = Graph::connectedWattsStrogatz(10000, 6, 0.5, 96);
+    auto t0 = std::chrono::steady_clock::now();
+    DistanceStats slow = reference(g);
+    double tPlain = seconds(t0);
+    DistanceStats fast = ShortestPaths::exact(g, 1);
+    std::cout << "\nWatts-Strogatz n = 10^4, k = 6, p = 0.5: ASPL " << fast.averageDistance << ", diameter "
+              << fast.diameter << std::endl;
+    std::cout << "  one BFS per source " << std::setprecision(3) << tPlain << " s, bit-parallel (1 thread) "
+              << fast.seconds << " s (" << std::setprecision(1) << tPlain / fast.seconds << "x)" << std::endl;
+    ok = ok && same(fast, slow) && fast.seconds < tPlain;
+
+    // ========== 3·10^4 vertices: O(n·m) work, O(n) memory per thread ==========
+    Graph big = Graph::connectedWattsStrogatz(30000, 6, 0.5, 96);
+    DistanceStats large = ShortestPaths::exact(big);
+    std::cout << "Watts-Strogatz n = 3*10^4: ASPL " << std::setprecision(6) << large.averageDistance << ", diameter "
+              << large.diameter << ", " << large.pairs << " pairs in " << std::setprecision(2) << large.seconds
+              << " s" << std::endl;
+    ok = ok && large.connected && large.pairs == 30000LL * 29999LL;
+
+    // ========== Sampled sources with confidence intervals ==========
+    std::cout << "\nSampled ASPL (95% confidence):" << std::endl;
+    SampledDistanceStats ringSample = ShortestPaths::sampled(Graph::ringLattice(cycle, 2), 0.01);
+    std::cout << "  Cycle: " << std::setprecision(6) << ringSample.averageDistance << " ± " << ringSample.halfWidth
+              << " from " << ringSample.sources << " sources (every source sees the same distances)" << std::endl;
+    ok = ok && ringSample.converged && ringSample.sources == 64 && std::abs(ringSample.averageDistance - expected) < 1e-9;
+
+    SampledDistanceStats everyone = ShortestPaths::sampled(small, 1e-9);
+    std::cout << "  Bound 1e-9 on n = 3000 runs out of sources: " << everyone.sources << " sources, exact "
+              << (everyone.exact && everyone.averageDistance == bitParallel.averageDistance ? "yes" : "NO") << std::endl;
+    ok = ok && everyone.exact && everyone.sources == 3000 && everyone.averageDistance == bitParallel.averageDistance
+         && everyone.diameterLowerBound == bitParallel.diameter;
+
+    // Coverage of the interval over independent samples
+    const int trials = 200;
+    int covered = 0;
+    std::int64_t used = 0;
+    for (int t = 0; t < trials; ++t) {
+        SampledDistanceStats sample = ShortestPaths::sampled(small, 0.01, 0.95, static_cast<std::uint64_t>(t));
+        covered += std::abs(sample.averageDistance - bitParallel.averageDistance) <= sample.halfWidth;
+        used += sample.sources;
+    }
+    std::cout << "  n = 3000, ±1%: exact value inside the interval in " << covered << "/" << trials
+              << " samples, " << used / trials << " sources on average" << std::endl;
+    ok = ok && covered >= 0.9 * trials;
+
+    // Beyond exact reach: 10^6 vertices (exact would take n/64 batches)
+    Graph huge = Graph::wattsStrogatz(1000000, 6, 0.5, 96);
+    SampledDistanceStats estimate = ShortestPaths::sampled(huge, 0.005, 0.95, 7);
+    std::cout << "  n = 10^6, ±0.5%: " << estimate.averageDistance << " ± " << estimate.halfWidth << " from "
+              << estimate.sources << " sources in " << std::setprecision(2) << estimate.seconds
+              << " s, diameter >= " << estimate.diameterLowerBound << std::endl;
+    ok = ok && estimate.converged && estimate.halfWidth <= 0.005 * estimate.averageDistance;
+
+    std::cout << "\n=== " << (ok ? "Shortest path checks passed" : "Shortest path checks FAILED") << " ===" << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,199 @@
+#include "SolveDaemon.h"
+#include "ElectrostaticSolver.h"
+#include "Factorization.h"
+#include "FactorizationCache.h"
+#include <atomic>
+#include <filesystem>
+#include <iostream>
+#include <iomanip>
+#include <thread>
+
+int main() {
+    std::cout << "=== Solve Daemon - Batched Multi-Client Example ===" << std::endl;
+    std::cout << "Problem: Several clients sending same-geometry solves over a Unix socket\n" << std::endl;
+
+#ifdef _WIN32
+    std::cout << "Unix domain sockets are not available on this platform, skipping." << std::endl;
+    return 0;
+#else
+    ElectrostaticSolver solver;
+
+    // ========== Start Daemon ==========
+    SolveDaemonOptions options;
+    options.socketPath = (std::filesystem::temp_directory_path() / "schrodinger_test_daemon.sock").string();
+    options.cacheDirectory = "factor_cache";
+    options.batchWindowMicros = 3000;
+    options.memoryBudgetBytes = 16u << 20;
+
+    // Another user of the 61x41 key already keeps a multigrid level in the cache file
+    FactorizationCache cache(options.cacheDirectory);
+    const std::uint64_t sharedKey = solver.geometryHash(61, 41, 1e-3, 2e-3);
+    MatrixSolver::SparseMatrix level(2, 2);
+    level.insert(0, 0) = 4.0;
+    level.insert(1, 1) = 4.0;
+    FactorizationBundle existing;
+    existing.add("mg/level1/A", level);
+    cache.store(sharedKey, existing);
+
+    SolveDaemon daemon(options);
+    daemon.start();
+    std::cout << "Daemon listening on " << options.socketPath << std::endl;
+
+    // ========== Problems ==========
+    // Two geometries; every client varies the charge density and plate voltage
+    struct Geometry { int nx, ny; double dx, dy; };
+    const Geometry geometries[] = {{81, 81, 1e-3, 1e-3}, {61, 41, 1e-3, 2e-3}};
+    const double epsilon = 8.854e-12;
+
+    auto makeProblem = [&](const Geometry& g, int seed, std::vector<double>& rho, std::vector<double>& bv) {
+        rho.assign((g.nx - 2) * (g.ny - 2), 0.0);
+        bv.assign(g.nx * g.ny, 0.0);
+        rho[(seed * 37) % rho.size()] = 1e-6 * (1 + seed % 5);
+        for (int j = 0; j < g.ny; ++j) {
+            bv[solver.coordToIndex(0, j, g.nx)] = 1.0 + 0.1 * seed;
+        }
+    };
+
+    // ========== Clients ==========
+    const int clients = 6;
+    const int requestsPerClient = 10;
+    std::atomic<int> failures{0};
+    std::atomic<int> batched{0};
+    double maxError = 0.0;
+    std::mutex errorMutex;
+
+    std::vector<std::thread> threads;
+    for (int c = 0; c < clients; ++c) {
+        threads.emplace_back([&, c] {
+            try {
+                SolveClient client(options.socketPath);
+                ElectrostaticSolver local;
+                for (int r = 0; r < requestsPerClient; ++r) {
+                    const Geometry& g = geometries[(c + r) % 2];
+                    std::vector<double> rho, bv;
+                    makeProblem(g, c * requestsPerClient + r, rho, bv);
+
+                    SolveTiming timing;
+                    Eigen::VectorXd phi = client.solve(g.nx, g.ny, g.dx, g.dy, rho, epsilon, bv, &timing);
+                    if (timing.batchSize > 1) {
+                        batched++;
+                    }
+
+                    // Reference: direct solve in this process
+                    MatrixSolver::SparseMatrix K;
+                    Eigen::VectorXd f;
+                    local.buildReducedFDMSystem(g.nx, g.ny, g.dx, g.dy, rho, epsilon, K, f, bv);
+                    Eigen::VectorXd ref = local.expandReducedSolution(
+                        g.nx, g.ny, SparseCholeskyFactor::compute(K).solve(f), bv);
+
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    maxError = std::max(maxError, (phi - ref).cwiseAbs().maxCoeff());
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "Client " << c << ": " << e.what() << std::endl;
+                failures++;
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    // ========== Error Handling ==========
+    bool rejected = false;
+    try {
+        SolveClient client(options.socketPath);
+        std::vector<double> rho(3, 0.0), bv(25, 0.0);   // Wrong sizes for 5x5
+        client.solve(5, 5, 1e-3, 1e-3, rho, epsilon, bv);
+    } catch (const std::exception& e) {
+        rejected = true;
+        std::cout << "Malformed request rejected: " << e.what() << std::endl;
+    }
+
+    // A 401x401 factorization does not fit the 16 MiB budget
+    bool overBudget = false;
+    try {
+        SolveClient client(options.socketPath);
+        std::vector<double> rho(399 * 399, 0.0), bv(401 * 401, 0.0);
+        client.solve(401, 401, 1e-3, 1e-3, rho, epsilon, bv);
+    } catch (const std::exception& e) {
+        overBudget = std::string(e.what()).find("exceeds the budget") != std::string::npos;
+        std::cout << "Over-budget request rejected: " << e.what() << std::endl;
+    }
+
+    // ========== Statistics ==========
+    std::string stats;
+    {
+        SolveClient client(options.socketPath);
+        stats = client.stats();
+        client.shutdown();
+    }
+    daemon.wait();
+    daemon.stop();
+
+    std::cout << "\n" << stats << std::endl;
+    std::cout << std::scientific << std::setprecision(3);
+    std::cout << "Requests answered in a batch of > 1: " << batched << " / " << clients * requestsPerClient << std::endl;
+    std::cout << "Max difference vs in-process solve:  " << maxError << " V" << std::endl;
+
+    // The daemon added its factor to the file without dropping the multigrid level
+    FactorizationBundle reloaded;
+    bool kept = cache.load(sharedKey, reloaded) && reloaded.sparseCholesky("reduced/ldlt") != nullptr &&
+                reloaded.hasMatrix("mg/level1/A") && reloaded.matrix("mg/level1/A").coeff(1, 1) == 4.0;
+    std::cout << "Existing cache entries kept next to the daemon's factor: " << (kept ? "yes" : "no") << std::endl;
+
+    // ========== Budget on Resident Factors ==========
+    // One 101x101 solve fits the budget, a second geometry does not fit next
+    // to the first factor; repeats and factors on disk are cache hits
+    ResourceEstimate single = ResourceEstimator().estimate(101, 101, "ldlt");
+    SolveDaemonOptions tight = options;
+    tight.socketPath = (std::filesystem::temp_directory_path() / "schrodinger_test_budget.sock").string();
+    tight.memoryBudgetBytes = single.peakBytes + single.factorBytes / 4;
+
+    auto attempt = [&](const SolveDaemonOptions& o, double h, std::string& error) {
+        try {
+            SolveClient client(o.socketPath);
+            std::vector<double> rho(99 * 99, 0.0), bv(101 * 101, 0.0);
+            for (int j = 0; j < 101; ++j) {
+                bv[solver.coordToIndex(0, j, 101)] = 1.0;
+            }
+            client.solve(101, 101, h, h, rho, epsilon, bv);
+            return true;
+        } catch (const std::exception& e) {
+            error = e.what();
+            return false;
+        }
+    };
+    std::string error;
+    bool firstFits = false;
+    bool secondRejected = false;
+    bool repeatFits = false;
+    {
+        SolveDaemon budgeted(tight);
+        budgeted.start();
+        firstFits = attempt(tight, 3e-3, error);
+        secondRejected = !attempt(tight, 4e-3, error) && error.find("committed") != std::string::npos;
+        repeatFits = attempt(tight, 3e-3, error);
+        budgeted.stop();
+    }
+    std::cout << "Second geometry next to a resident factor rejected: " << error << std::endl;
+
+    SolveDaemonOptions tiny = tight;
+    tiny.memoryBudgetBytes = 1u << 20;
+    bool diskHitFits = false;
+    {
+        SolveDaemon restarted(tiny);
+        restarted.start();
+        diskHitFits = attempt(tiny, 3e-3, error);
+        restarted.stop();
+    }
+    std::cout << "Cached geometry accepted under a 1 MiB budget: " << (diskHitFits ? "yes" : "no") << std::endl;
+    bool budgetOk = firstFits && secondRejected && repeatFits && diskHitFits;
+
+    bool ok = failures == 0 && rejected && overBudget && maxError < 1e-10 && kept && budgetOk &&
+              daemon.solvedRequests() == static_cast<std::uint64_t>(clients * requestsPerClient) &&
+              daemon.solvedBatches() < daemon.solvedRequests();
+    std::cout << "\n=== " << (ok ? "Solve daemon checks passed" : "Solve daemon checks FAILED") << " ===" << std::endl;
+    return ok ? 0 : 1;
+#endif
+}
@@ -0,0 +1,115 @@
+#include "SuperpositionEngine.h"
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <random>
+
+namespace {
+
+double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Superposition Engine - Electrode Voltage Sweep ===" << std::endl;
+    std::cout << "Problem: Split left plate (two electrodes) against a grounded right plate\n" << std::endl;
+
+    ElectrostaticSolver solver;
+
+    // ========== Problem Setup ==========
+    int nx = 41;
+    int ny = 41;
+    double dx = 0.05;
+    double dy = 0.05;
+    double epsilon = 8.854e-12;
+
+    Electrode lower{"left-lower", {}};
+    Electrode upper{"left-upper", {}};
+    Electrode right{"right", {}};
+    for (int j = 0; j < ny; ++j) {
+        (j < ny / 2 ? lower : upper).indices.push_back(solver.coordToIndex(0, j, nx));
+        right.indices.push_back(solver.coordToIndex(nx - 1, j, nx));
+    }
+    std::vector<Electrode> electrodes = {lower, upper, right};
+
+    // ========== Precompute Bases ==========
+    auto start = std::chrono::steady_clock::now();
+    SuperpositionEngine engine(nx, ny, dx, dy, epsilon, electrodes);
+    double setupMs = elapsedMs(start);
+
+    SuperpositionEngine engineF(nx, ny, dx, dy, epsilon, electrodes, SuperpositionEngine::Compression::Float32);
+    SuperpositionEngine engineR(nx, ny, dx, dy, epsilon, electrodes, SuperpositionEngine::Compression::LowRank);
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Electrodes: " << engine.electrodeCount() << std::endl;
+    std::cout << "Basis setup time: " << setupMs << " ms" << std::endl;
+    std::cout << "Basis memory (double / float / low-rank): " << engine.memoryBytes() << " / "
+              << engineF.memoryBytes() << " / " << engineR.memoryBytes() << " bytes (rank "
+              << engineR.rank() << ")" << std::endl;
+
+    // ========== Compare Against Direct Solves ==========
+    std::cout << "\n--- Random voltage vectors vs direct dense LU ---\n" << std::endl;
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> volt(-100.0, 100.0);
+    std::vector<double> rho((nx - 2) * (ny - 2), 0.0);
+
+    double maxErr = 0.0;
+    double maxErrF = 0.0;
+    double maxErrR = 0.0;
+    double directMs = 0.0;
+    double queryMs = 0.0;
+    int trials = 3;
+
+    Eigen::VectorXd phi;
+    for (int t = 0; t < trials; ++t) {
+        Eigen::VectorXd V(3);
+        V << volt(rng), volt(rng), volt(rng);
+
+        std::vector<double> boundaryValues(nx * ny, 0.0);
+        for (int e = 0; e < 3; ++e) {
+            for (int idx : electrodes[e].indices) {
+                boundaryValues[idx] = V(e);
+            }
+        }
+
+        start = std::chrono::steady_clock::now();
+        Eigen::MatrixXd A;
+        Eigen::VectorXd b;
+        solver.buildFDMSystem(nx, ny, dx, dy, rho, epsilon, A, b, boundaryValues);
+        Eigen::VectorXd phi_direct = solver.solveLU(A, b);
+        directMs += elapsedMs(start);
+
+        start = std::chrono::steady_clock::now();
+        engine.solveInto(V, phi);
+        queryMs += elapsedMs(start);
+
+        maxErr = std::max(maxErr, (phi - phi_direct).cwiseAbs().maxCoeff());
+        maxErrF = std::max(maxErrF, (engineF.solve(V) - phi_direct).cwiseAbs().maxCoeff());
+        maxErrR = std::max(maxErrR, (engineR.solve(V) - phi_direct).cwiseAbs().maxCoeff());
+    }
+
+    std::cout << "Average direct solve: " << directMs / trials << " ms" << std::endl;
+    std::cout << "Average query:        " << queryMs / trials << " ms" << std::endl;
+    std::cout << std::scientific;
+    std::cout << "Max error (double):   " << maxErr << " V" << std::endl;
+    std::cout << "Max error (float):    " << maxErrF << " V" << std::endl;
+    std::cout << "Max error (low-rank): " << maxErrR << " V" << std::endl;
+
+    // ========== Derived Fields From the Combined Result ==========
+    Eigen::VectorXd V(3);
+    V << 100.0, 100.0, 0.0;
+    FieldResult result = engine.fieldResult(V);
+    double E_center = result.at(FieldResult::Component::Magnitude, nx / 2, ny / 2);
+    double E_expected = 100.0 / ((nx - 1) * dx);
+
+    std::cout << std::fixed;
+    std::cout << "\nUniform plates (100 V / 0 V): |E| at center = " << E_center
+              << " V/m (expected " << E_expected << " V/m)" << std::endl;
+
+    bool ok = maxErr < 1e-8 && maxErrF < 1e-3 && maxErrR < 1e-8 && std::abs(E_center - E_expected) < 1e-6;
+    std::cout << "\n=== " << (ok ? "Superposition checks passed" : "Superposition checks FAILED") << " ===" << std::endl;
+
+    return ok ? 0 : 1;
+}
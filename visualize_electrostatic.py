@@ -2,11 +2,18 @@
 """
 Visualization script for electrostatic solver results
 Reads CSV files generated by test_electrostatic.cpp and creates plots
+
+With --solve the fields come directly from the electrostatics Python module
+(python build.py build electrostatics) instead of CSV files.
+
+With --live [NAME] the frames streamed by a running solver
+(test_electrostatic --sweep FILE --publish NAME) are shown as they arrive.
 """
 
 import numpy as np
 import matplotlib.pyplot as plt
 import os
+import sys
 from pathlib import Path
 
 def load_csv(filename):
@@ -16,26 +23,77 @@ def load_csv(filename):
         return None
     return np.loadtxt(filename, delimiter=',')
 
+def solve_fields():
+    """Solve the test_electrostatic plate problem through the Python bindings (no files)"""
+    import electrostatics
+    field = electrostatics.ElectrostaticSolver().solve_plates(nx=25, ny=25, spacing=0.1, voltage=100.0)
+    return field.potential, field.Ex, field.Ey, field.field_magnitude, field.energy_density
+
+def live_view(name, interval=0.1):
+    """Animate the newest frame of a FramePublisher ring until the window is closed"""
+    from frame_reader import FrameReader
+    try:
+        reader = FrameReader(name)
+    except (FileNotFoundError, ValueError) as e:
+        print(f"Error: cannot open frame ring {name}: {e}")
+        return 1
+    print(f"Following {name} (close the window to stop)")
+
+    fig, (ax1, ax2) = plt.subplots(1, 2, figsize=(14, 6))
+    shown = None
+    while plt.fignum_exists(fig.number):
+        frame = reader.latest()
+        if frame is not None and frame.frame != shown:
+            shown = frame.frame
+            for ax in (ax1, ax2):
+                ax.clear()
+            ax1.contourf(frame.potential, levels=20, cmap='RdYlBu_r')
+            ax1.set_title(f'Electric Potential φ (V)  [{frame.phi_min:.3g}, {frame.phi_max:.3g}]', fontsize=12)
+            ax2.contourf(frame.field_magnitude, levels=20, cmap='hot')
+            ax2.set_title(f'|E| (V/m)  max {frame.field_max:.3g}', fontsize=12)
+            for ax in (ax1, ax2):
+                ax.set_xlabel(f'x (every {frame.stride}. grid point)')
+                ax.set_ylabel('y')
+            fig.suptitle(f"Frame {frame.frame}: {frame.label}  (t = {frame.time:g})", fontweight='bold')
+        plt.pause(interval)
+
+    print(f"Last frame: {shown}, torn copies retried: {reader.retries}")
+    reader.close()
+    return 0
+
 def main():
+    if '--live' in sys.argv[1:]:
+        k = sys.argv.index('--live')
+        name = sys.argv[k + 1] if k + 1 < len(sys.argv) else '/electrostatics_frames'
+        return live_view(name)
+
     print("=" * 60)
     print("Electrostatic Solver - Visualization")
     print("=" * 60)
     print()
     
-    # Load data files
-    print("Loading CSV files...")
-    
-    potential = load_csv('potential.csv')
-    Ex = load_csv('Ex.csv')
-    Ey = load_csv('Ey.csv')
-    E_magnitude = load_csv('E_magnitude.csv')
-    energy_density = load_csv('energy_density.csv')
-    
-    if potential is None:
-        print("Error: potential.csv not found. Run test_electrostatic first.")
-        return 1
+    if '--solve' in sys.argv[1:]:
+        print("Solving with the electrostatics module...")
+        try:
+            potential, Ex, Ey, E_magnitude, energy_density = solve_fields()
+        except ImportError:
+            print("Error: electrostatics module not found. Run: python build.py build electrostatics")
+            return 1
+    else:
+        # Load data files
+        print("Loading CSV files...")
+        
+        potential = load_csv('potential.csv')
+        Ex = load_csv('Ex.csv')
+        Ey = load_csv('Ey.csv')
+        E_magnitude = load_csv('E_magnitude.csv')
+        energy_density = load_csv('energy_density.csv')
+        
+        if potential is None:
+            print("Error: potential.csv not found. Run test_electrostatic first.")
+            return 1
     
-    print("✓ All files loaded successfully\n")
+    print("✓ All fields loaded successfully\n")
     
     # Create figure with subplots
     fig = plt.figure(figsize=(16, 10))
@@ -143,5 +201,4 @@ def main():
     return 0
 
 if __name__ == '__main__':
-    import sys
     sys.exit(main())